@@ -0,0 +1,176 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+/**
+ *  @file       shaderConverterBenchmark.cpp
+ *  @author     Think Silicon
+ *  @date       18/10/2026
+ *  @version    1.0
+ *
+ *  @brief      Measures the ESSL 100 to GLSL 400 conversion time over a corpus of ES2 shaders
+ *
+ */
+
+#include "glslang/shaderConverter.h"
+#include "resources/shaderReflection.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#ifndef SHADER_CORPUS_PATH
+#   define SHADER_CORPUS_PATH           "shaders"
+#endif // SHADER_CORPUS_PATH
+
+/// Number of conversions timed per shader
+#define DEFAULT_ITERATIONS              1000
+
+/// Number of features of the generated uber-shader, ~9 lines each
+#define UBER_SHADER_FEATURES            384
+
+typedef struct {
+    string          name;
+    string          source;
+    shader_type_t   type;
+} shader_entry_t;
+
+static const char * const corpus[] = {
+    "texture.vert",     "texture.frag",
+    "phong.vert",       "phong.frag",
+    "normalmap.vert",   "normalmap.frag",
+    "skinning.vert",    "skinning.frag",
+    "blur.vert",        "blur.frag",
+    "terrain.vert",     "terrain.frag",
+    "shadow.vert",      "shadow.frag",
+    "particles.vert",   "particles.frag"
+};
+
+static bool
+LoadShader(const string &path, shader_entry_t *entry)
+{
+    std::ifstream file(path.c_str(), std::ios::in | std::ios::binary);
+    if(!file) {
+        return false;
+    }
+
+    std::ostringstream contents;
+    contents << file.rdbuf();
+
+    entry->name   = path.substr(path.find_last_of("/\\") + 1);
+    entry->source = contents.str();
+    entry->type   = path.size() > 5 && !path.compare(path.size() - 5, 5, ".vert") ? SHADER_TYPE_VERTEX : SHADER_TYPE_FRAGMENT;
+    return true;
+}
+
+/// Generated uber-shader of a few thousand lines, like the ones shipped by game engines
+static void
+GenerateUberShader(shader_entry_t *entry)
+{
+    std::ostringstream uberShader;
+    uberShader << "#version 100\nprecision mediump float;\n";
+    for(int i = 0; i < UBER_SHADER_FEATURES; ++i) {
+        uberShader << "uniform vec4 color" << i << ", offset" << i << ";\n"
+                   << "varying vec4 var" << i << ";\n"
+                   << "#ifdef FEATURE_" << i << "\n"
+                   << "// feature " << i << " uses __LINE__ and GL_ES\n"
+                   << "vec4 feature" << i << "(vec4 c)\n"
+                   << "{\n"
+                   << "    return c * color" << i << " + offset" << i << " + float(GL_ES);\n"
+                   << "}\n"
+                   << "#endif\n";
+    }
+    uberShader << "void main()\n{\n    gl_FragColor = vec4(1.0);\n}\n";
+
+    entry->name   = "uber.frag (generated)";
+    entry->source = uberShader.str();
+    entry->type   = SHADER_TYPE_FRAGMENT;
+}
+
+/// Returns the average conversion time of the shader in microseconds
+static double
+BenchmarkShader(const shader_entry_t &entry, int iterations)
+{
+    GlslangIoMapResolver ioMapResolver;
+    ShaderReflection     reflection;
+    uniformBlockMap_t    uniformBlockMap;
+
+    ShaderConverter converter;
+    converter.Initialize(entry.type, ESSL_VERSION_100, ESSL_VERSION_400);
+    converter.SetIoMapResolver(&ioMapResolver);
+
+    std::chrono::steady_clock::duration total = std::chrono::steady_clock::duration::zero();
+    for(int i = 0; i < iterations; ++i) {
+        string source(entry.source);
+
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        converter.Convert(source, uniformBlockMap, &reflection, true);
+        total += std::chrono::steady_clock::now() - start;
+    }
+
+    return std::chrono::duration<double, std::micro>(total).count() / iterations;
+}
+
+int
+main(int argc, char **argv)
+{
+    int iterations = DEFAULT_ITERATIONS;
+    std::vector<string> paths;
+
+    for(int i = 1; i < argc; ++i) {
+        if(string(argv[i]) == "-n" && i + 1 < argc) {
+            iterations = std::max(1, atoi(argv[++i]));
+        } else {
+            paths.push_back(argv[i]);
+        }
+    }
+
+    /// Without shaders in the command line, the corpus of this directory is used
+    if(paths.empty()) {
+        for(size_t i = 0; i < sizeof(corpus) / sizeof(corpus[0]); ++i) {
+            paths.push_back(string(SHADER_CORPUS_PATH) + "/" + corpus[i]);
+        }
+    }
+
+    std::vector<shader_entry_t> shaders;
+    for(size_t i = 0; i < paths.size(); ++i) {
+        shader_entry_t entry;
+        if(!LoadShader(paths[i], &entry)) {
+            fprintf(stderr, "Could not read shader: %s\n", paths[i].c_str());
+            return EXIT_FAILURE;
+        }
+        shaders.push_back(entry);
+    }
+
+    shader_entry_t uberShader;
+    GenerateUberShader(&uberShader);
+    shaders.push_back(uberShader);
+
+    printf("%-24s %10s %10s %12s\n", "shader", "bytes", "us/conv", "MB/s");
+
+    double totalTime  = 0.0;
+    size_t totalBytes = 0;
+    for(size_t i = 0; i < shaders.size(); ++i) {
+        const double time = BenchmarkShader(shaders[i], iterations);
+        printf("%-24s %10zu %10.2f %12.2f\n", shaders[i].name.c_str(), shaders[i].source.size(), time, shaders[i].source.size() / time);
+
+        totalTime  += time;
+        totalBytes += shaders[i].source.size();
+    }
+
+    printf("%-24s %10zu %10.2f %12.2f\n", "total", totalBytes, totalTime, totalBytes / totalTime);
+
+    return EXIT_SUCCESS;
+}
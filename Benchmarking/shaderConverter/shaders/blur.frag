@@ -0,0 +1,21 @@
+#ifdef GL_ES
+precision mediump float;
+#endif
+
+uniform sampler2D Texture0;
+uniform vec2 TextureStep;
+
+varying vec2 TextureCoord;
+
+void main(void)
+{
+    /// 9-tap separable gaussian blur, the direction is given by TextureStep
+    vec4 result = texture2D(Texture0, TextureCoord) * 0.2270270270;
+
+    result += texture2D(Texture0, TextureCoord + TextureStep * 1.3846153846) * 0.3162162162;
+    result += texture2D(Texture0, TextureCoord - TextureStep * 1.3846153846) * 0.3162162162;
+    result += texture2D(Texture0, TextureCoord + TextureStep * 3.2307692308) * 0.0702702703;
+    result += texture2D(Texture0, TextureCoord - TextureStep * 3.2307692308) * 0.0702702703;
+
+    gl_FragColor = result;
+}
@@ -0,0 +1,24 @@
+precision mediump float;
+
+uniform sampler2D DiffuseMap;
+uniform sampler2D NormalMap;
+uniform lowp vec4 LightColor;
+uniform mediump float SpecularExponent;
+
+varying vec3 LightDirection;
+varying vec3 ViewDirection;
+varying vec2 TextureCoord;
+
+void main(void)
+{
+    vec3 N = normalize(texture2D(NormalMap, TextureCoord).rgb * 2.0 - 1.0);
+    vec3 L = normalize(LightDirection);
+    vec3 V = normalize(ViewDirection);
+    vec3 H = normalize(L + V);
+
+    float diffuse  = max(dot(N, L), 0.0);
+    float specular = pow(max(dot(N, H), 0.0), SpecularExponent);
+
+    vec4 albedo = texture2D(DiffuseMap, TextureCoord);
+    gl_FragColor = vec4(albedo.rgb * diffuse * LightColor.rgb + specular * LightColor.rgb, albedo.a);
+}
@@ -0,0 +1,31 @@
+attribute vec3 position;
+attribute vec3 normal;
+attribute vec3 tangent;
+attribute vec2 texcoord;
+
+uniform mat4 ModelViewProjectionMatrix;
+uniform mat4 ModelViewMatrix;
+uniform mat4 NormalMatrix;
+uniform vec4 LightSourcePosition;
+
+varying vec3 LightDirection;
+varying vec3 ViewDirection;
+varying vec2 TextureCoord;
+
+void main(void)
+{
+    vec3 n = normalize(vec3(NormalMatrix * vec4(normal, 0.0)));
+    vec3 t = normalize(vec3(NormalMatrix * vec4(tangent, 0.0)));
+    vec3 b = cross(n, t);
+
+    /// Move the light and view vectors to tangent space
+    vec4 eyePosition = ModelViewMatrix * vec4(position, 1.0);
+    vec3 l = LightSourcePosition.xyz - eyePosition.xyz;
+    vec3 v = -eyePosition.xyz;
+
+    LightDirection = vec3(dot(l, t), dot(l, b), dot(l, n));
+    ViewDirection  = vec3(dot(v, t), dot(v, b), dot(v, n));
+    TextureCoord   = texcoord;
+
+    gl_Position = ModelViewProjectionMatrix * vec4(position, 1.0);
+}
@@ -0,0 +1,12 @@
+precision mediump float;
+
+uniform sampler2D Sprite;
+uniform vec4 Color;
+
+varying float Alpha;
+
+void main(void)
+{
+    vec4 sprite = texture2D(Sprite, gl_PointCoord);
+    gl_FragColor = vec4(Color.rgb * sprite.rgb, sprite.a * Alpha);
+}
@@ -0,0 +1,21 @@
+attribute vec3 position;
+attribute vec3 velocity;
+attribute float startTime;
+
+uniform mat4 ModelViewProjectionMatrix;
+uniform float Time;
+uniform float PointSize;
+uniform vec3 Gravity;
+
+varying float Alpha;
+
+void main(void)
+{
+    float t = Time - startTime;
+
+    vec3 p = position + velocity * t + 0.5 * Gravity * t * t;
+
+    Alpha        = clamp(1.0 - t / 3.0, 0.0, 1.0);
+    gl_PointSize = PointSize * Alpha;
+    gl_Position  = ModelViewProjectionMatrix * vec4(p, 1.0);
+}
@@ -0,0 +1,45 @@
+#ifdef GL_ES
+precision mediump float;
+#endif
+
+#define NUM_LIGHTS 4
+
+uniform vec4 LightSourcePosition[NUM_LIGHTS];
+uniform vec3 LightSourceHalfVector[NUM_LIGHTS];
+uniform vec4 LightColor[NUM_LIGHTS];
+uniform vec4 MaterialAmbient,
+             MaterialDiffuse,
+             MaterialSpecular;
+uniform float MaterialShininess;
+uniform sampler2D MaterialTexture0;
+
+varying vec3 Normal;
+varying vec4 Position;
+varying vec2 TextureCoord;
+
+vec4
+compute_color(in vec4 light_position, in vec3 light_half_vector, in vec4 light_color, in vec3 N)
+{
+    vec3 L = normalize(light_position.xyz - Position.xyz);
+    float diffuse = max(dot(N, L), 0.0);
+    float specular = 0.0;
+
+    if (diffuse > 0.0) {
+        vec3 H = normalize(light_half_vector);
+        specular = pow(max(dot(N, H), 0.0), MaterialShininess);
+    }
+
+    return light_color * (MaterialAmbient + diffuse * MaterialDiffuse + specular * MaterialSpecular);
+}
+
+void main(void)
+{
+    vec3 N = normalize(Normal);
+    vec4 result = vec4(0.0);
+
+    for (int i = 0; i < NUM_LIGHTS; ++i) {
+        result += compute_color(LightSourcePosition[i], LightSourceHalfVector[i], LightColor[i], N);
+    }
+
+    gl_FragColor = result * texture2D(MaterialTexture0, TextureCoord);
+}
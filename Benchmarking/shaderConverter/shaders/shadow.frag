@@ -0,0 +1,26 @@
+precision mediump float;
+
+uniform sampler2D ShadowMap;
+uniform vec3 LightDirection;
+uniform vec4 MaterialColor;
+uniform float ShadowBias;
+
+varying vec4 ShadowCoord;
+varying vec3 Normal;
+
+/// The depth is packed in RGBA, as ES 2.0 may not support depth textures
+float
+unpack(vec4 rgba)
+{
+    return dot(rgba, vec4(1.0, 1.0 / 255.0, 1.0 / 65025.0, 1.0 / 16581375.0));
+}
+
+void main(void)
+{
+    vec3 coord = ShadowCoord.xyz / ShadowCoord.w;
+    float depth = unpack(texture2D(ShadowMap, coord.xy));
+    float lit = coord.z - ShadowBias > depth ? 0.5 : 1.0;
+    float diffuse = max(dot(normalize(Normal), -LightDirection), 0.0);
+
+    gl_FragColor = vec4(MaterialColor.rgb * diffuse * lit, MaterialColor.a);
+}
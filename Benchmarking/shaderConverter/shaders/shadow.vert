@@ -0,0 +1,18 @@
+attribute vec3 position;
+attribute vec3 normal;
+
+uniform mat4 ModelViewProjectionMatrix;
+uniform mat4 LightMatrix;
+uniform mat4 NormalMatrix;
+
+varying vec4 ShadowCoord;
+varying vec3 Normal;
+
+void main(void)
+{
+    /// LightMatrix includes the [-1, 1] to [0, 1] bias
+    ShadowCoord = LightMatrix * vec4(position, 1.0);
+    Normal      = (NormalMatrix * vec4(normal, 0.0)).xyz;
+
+    gl_Position = ModelViewProjectionMatrix * vec4(position, 1.0);
+}
@@ -0,0 +1,13 @@
+precision mediump float;
+
+uniform sampler2D Texture;
+uniform vec4 AmbientColor;
+
+varying vec2 TextureCoord;
+varying float Diffuse;
+
+void main(void)
+{
+    vec4 color = texture2D(Texture, TextureCoord);
+    gl_FragColor = vec4(color.rgb * (AmbientColor.rgb + vec3(Diffuse)), color.a);
+}
@@ -0,0 +1,30 @@
+#define MAX_BONES 32
+
+attribute vec3 position;
+attribute vec3 normal;
+attribute vec2 texcoord;
+attribute vec4 boneIndices;
+attribute vec4 boneWeights;
+
+uniform mat4 ViewProjectionMatrix;
+uniform mat4 BoneMatrices[MAX_BONES];
+uniform vec3 LightDirection;
+
+varying vec2 TextureCoord;
+varying float Diffuse;
+
+void main(void)
+{
+    mat4 skin = BoneMatrices[int(boneIndices.x)] * boneWeights.x +
+                BoneMatrices[int(boneIndices.y)] * boneWeights.y +
+                BoneMatrices[int(boneIndices.z)] * boneWeights.z +
+                BoneMatrices[int(boneIndices.w)] * boneWeights.w;
+
+    vec4 skinnedPosition = skin * vec4(position, 1.0);
+    vec3 skinnedNormal   = normalize((skin * vec4(normal, 0.0)).xyz);
+
+    Diffuse      = max(dot(skinnedNormal, -LightDirection), 0.0);
+    TextureCoord = texcoord;
+
+    gl_Position = ViewProjectionMatrix * skinnedPosition;
+}
@@ -0,0 +1,25 @@
+precision mediump float;
+
+uniform sampler2D SplatMap;
+uniform sampler2D Grass, Rock, Sand, Snow;
+uniform vec4 FogColor;
+uniform float FogDensity;
+
+varying vec2 SplatCoord;
+varying vec2 DetailCoord;
+varying float Diffuse;
+varying float FogDepth;
+
+void main(void)
+{
+    vec4 weights = texture2D(SplatMap, SplatCoord);
+
+    vec3 color = texture2D(Grass, DetailCoord).rgb * weights.r +
+                 texture2D(Rock,  DetailCoord).rgb * weights.g +
+                 texture2D(Sand,  DetailCoord).rgb * weights.b +
+                 texture2D(Snow,  DetailCoord).rgb * weights.a;
+
+    float fog = clamp(exp(-FogDensity * FogDepth * FogDepth), 0.0, 1.0);
+
+    gl_FragColor = mix(FogColor, vec4(color * Diffuse, 1.0), fog);
+}
@@ -0,0 +1,23 @@
+attribute vec3 position;
+attribute vec3 normal;
+attribute vec2 texcoord;
+
+uniform mat4 ModelViewProjectionMatrix;
+uniform mat4 ModelViewMatrix;
+uniform vec3 LightDirection;
+uniform float DetailScale;
+
+varying vec2 SplatCoord;
+varying vec2 DetailCoord;
+varying float Diffuse;
+varying float FogDepth;
+
+void main(void)
+{
+    SplatCoord  = texcoord;
+    DetailCoord = texcoord * DetailScale;
+    Diffuse     = max(dot(normalize(normal), -LightDirection), 0.0);
+    FogDepth    = -(ModelViewMatrix * vec4(position, 1.0)).z;
+
+    gl_Position = ModelViewProjectionMatrix * vec4(position, 1.0);
+}
@@ -35,6 +35,25 @@ extern "C" {
 #include "EGL/egl.h"
 #include "vulkan/vulkan.h"
 
+/// Number of frames that can be recorded, executed and presented at the same time.
+/// Each of them owns an acquire and a render-complete semaphore.
+#define GLOVE_MAX_FRAMES_IN_FLIGHT              3
+
+/// the frame sync items of a window surface, used only by the thread the surface is current to
+typedef struct vkSyncItems_t {
+    VkSemaphore                         vkAcquireSemaphores[GLOVE_MAX_FRAMES_IN_FLIGHT];
+    bool                                acquireSemaphoreFlag;
+    VkSemaphore                         vkDrawSemaphores[GLOVE_MAX_FRAMES_IN_FLIGHT];
+    bool                                drawSemaphoreFlag;
+    uint32_t                            frameIndex;
+    uint32_t                            frameCount;
+} vkSyncItems_t;
+
+struct EGLSurfaceInterface_t;
+
+/// acquires the next image of a window surface, recreating the surface images if they are out of date
+typedef EGLBoolean (*acquire_next_image_cb_t)(struct EGLSurfaceInterface_t *eglSurfaceInterface);
+
 typedef struct EGLSurfaceInterface_t {
     void    *surface;
     void    *images;
@@ -48,6 +67,11 @@ typedef struct EGLSurfaceInterface_t {
     uint32_t height;
     uint32_t depthSize;
     uint32_t stencilSize;
+    uint32_t textureFormat;
+    bool     imageAcquired;
+    vkSyncItems_t *syncItems;
+    void    *acquireData;
+    acquire_next_image_cb_t acquireNextImageCb;
 } EGLSurfaceInterface;
 
 typedef void * api_state_t;
@@ -56,15 +80,17 @@ typedef void (*GLPROC)(void);
 
 typedef api_state_t (*init_API_cb_t)();
 typedef void (*terminate_API_cb_t)();
-typedef api_context_t (*create_context_cb_t)();
+typedef api_context_t (*create_context_cb_t)(api_context_t share_context);
 typedef void (*set_read_write_surface_cb_t)(api_context_t api_context, EGLSurfaceInterface *eglReadSurfaceInterface, EGLSurfaceInterface *eglWriteSurfaceInterface);
 typedef void (*delete_shared_surface_data_cb_t)(EGLSurfaceInterface *eglSurfaceInterface);
 typedef void (*delete_context_cb_t)(api_context_t api_context);
 typedef void (*release_system_fbo_cb_t)(api_context_t api_context);
+typedef void (*release_current_cb_t)(api_context_t api_context);
 typedef GLPROC (*get_proc_addr_cb_t)(const char* procname);
 typedef void (*flush_cb_t)(api_context_t api_context);
 typedef void (*finish_cb_t)(api_context_t api_context);
-typedef void (*bind_to_texture_cb_t)(api_context_t api_context, uint32_t bind);
+typedef void (*bind_to_texture_cb_t)(api_context_t api_context, EGLSurfaceInterface *eglSurfaceInterface, uint32_t bind);
+typedef void (*finish_frame_cb_t)(api_context_t api_context);
 
 typedef struct rendering_api_interface {
     api_state_t state;
@@ -79,6 +105,8 @@ typedef struct rendering_api_interface {
     flush_cb_t flush_cb;
     finish_cb_t finish_cb;
     bind_to_texture_cb_t bind_to_texture_cb;
+    finish_frame_cb_t finish_frame_cb;
+    release_current_cb_t release_current_cb;
 } rendering_api_interface_t;
 
 extern rendering_api_interface_t GLES2Interface;
@@ -93,21 +121,23 @@ extern "C" {
 #endif
 #endif
 
-typedef struct vkSyncItems_t {
-    VkSemaphore                         vkAcquireSemaphore;
-    bool                                acquireSemaphoreFlag;
-    VkSemaphore                         vkDrawSemaphore;
-    bool                                drawSemaphoreFlag;
-} vkSyncItems_t;
+/// When set, EGL and the client API run without any window system: no surface
+/// or swapchain extension is enabled and only pbuffers and surfaceless
+/// contexts can be made current.
+#define GLOVE_HEADLESS_ENV                      "GLOVE_HEADLESS"
+
+/// the presentation queue is shared by the contexts of all threads
+typedef void (*queue_lock_cb_t)(void);
 
 typedef struct vkInterface {
     VkInstance                          vkInstance;
-    VkPhysicalDevice                    *vkGpus;
+    VkPhysicalDevice                    vkGpu;
     VkQueue                             vkQueue;
     uint32_t                            vkGraphicsQueueNodeIndex;
     VkDevice                            vkDevice;
     VkPhysicalDeviceMemoryProperties    vkDeviceMemoryProperties;
-    vkSyncItems_t                       *vkSyncItems;
+    queue_lock_cb_t                     lockQueueCb;
+    queue_lock_cb_t                     unlockQueueCb;
 } vkInterface_t;
 
 #endif // __RENDERING_API_INTERFACE_H__
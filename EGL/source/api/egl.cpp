@@ -34,12 +34,14 @@
 #endif // DEBUG_DEPTH
 #define DEBUG_DEPTH                          EGL_LOG_INFO
 
-RenderingThread currentThread;
+thread_local RenderingThread currentThread;
 EGLGlobalResourceManager eglGlobalResourceManager;
 
 #define THREAD_EXEC_RETURN(func)             FUN_ENTRY(DEBUG_DEPTH);                                                      \
                                              return currentThread.func;
 
+#define LOCK_EGL_RESOURCES                   std::lock_guard<std::recursive_mutex> eglLock(eglGlobalResourceManager.GetMutex());
+
 #define CHECK_BAD_DISPLAY(eglDisplayPtr, dpy, erroRetValue)                                                               \
                                              EGLDisplay_t *eglDisplayPtr = eglGlobalResourceManager.FindDisplay(dpy);     \
                                              if(eglGlobalResourceManager.CheckBadDisplay(eglDisplayPtr) == EGL_FALSE)     \
@@ -70,6 +72,7 @@ eglGetDisplay(EGLNativeDisplayType display_id)
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
+    LOCK_EGL_RESOURCES
     EGLDisplay_t *eglDisplay = eglGlobalResourceManager.GetDisplayByID(display_id);
     return reinterpret_cast<EGLDisplay>(eglDisplay);
 }
@@ -101,6 +104,7 @@ eglWaitClient(void)
 EGLBoolean EGLAPIENTRY
 eglReleaseThread(void)
 {
+    LOCK_EGL_RESOURCES
     THREAD_EXEC_RETURN(ReleaseThread());
 }
 
@@ -127,11 +131,14 @@ eglCreateContext(EGLDisplay dpy, EGLConfig config, EGLContext share_context, con
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
+    LOCK_EGL_RESOURCES
     CHECK_BAD_DISPLAY(eglDisplay, dpy, EGL_NO_CONTEXT)
     CHECK_UNINITIALIZED_DISPLAY(eglDriver, eglDisplay, EGL_NO_CONTEXT)
     CHECK_BAD_CONFIG(eglDriver, eglConfig, config, EGL_NO_CONTEXT)
     EGLContext_t* eglShareContext = static_cast<EGLContext_t*>(share_context);
-    // TODO::check for valid context
+    if(eglShareContext != nullptr && eglDriver->CheckBadContext(eglShareContext) == EGL_FALSE) {
+        return EGL_NO_CONTEXT;
+    }
     THREAD_EXEC_RETURN(CreateContext(eglDriver, eglConfig, eglShareContext, attrib_list));
 }
 
@@ -140,6 +147,7 @@ eglDestroyContext(EGLDisplay dpy, EGLContext ctx)
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
+    LOCK_EGL_RESOURCES
     CHECK_BAD_DISPLAY(eglDisplay, dpy, EGL_FALSE)
     CHECK_UNINITIALIZED_DISPLAY(eglDriver, eglDisplay, EGL_FALSE)
     CHECK_BAD_CONTEXT(eglDriver, eglContext, ctx, EGL_FALSE)
@@ -151,6 +159,7 @@ eglMakeCurrent(EGLDisplay dpy, EGLSurface draw, EGLSurface read, EGLContext ctx)
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
+    LOCK_EGL_RESOURCES
     CHECK_BAD_DISPLAY(eglDisplay, dpy, EGL_FALSE)
     DisplayDriver *eglDriver = eglGlobalResourceManager.FindDriver(eglDisplay);
 
@@ -168,6 +177,7 @@ eglQueryContext(EGLDisplay dpy, EGLContext ctx, EGLint attribute, EGLint *value)
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
+    LOCK_EGL_RESOURCES
     CHECK_BAD_DISPLAY(eglDisplay, dpy, EGL_FALSE)
     CHECK_UNINITIALIZED_DISPLAY(eglDriver, eglDisplay, EGL_FALSE)
     CHECK_BAD_CONTEXT(eglDriver, eglContext, ctx, EGL_FALSE)
@@ -191,6 +201,7 @@ eglInitialize(EGLDisplay dpy, EGLint *major, EGLint *minor)
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
+    LOCK_EGL_RESOURCES
     CHECK_BAD_DISPLAY(eglDisplay, dpy, EGL_FALSE)
     // TODO:: EGLDisplay and DisplayDriver could be fused together, as they are 1-1
     DisplayDriver *eglDriver = eglGlobalResourceManager.AddDriver(eglDisplay);
@@ -206,6 +217,7 @@ eglTerminate(EGLDisplay dpy)
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
+    LOCK_EGL_RESOURCES
     CHECK_BAD_DISPLAY(eglDisplay, dpy, EGL_FALSE)
     DisplayDriver *eglDriver = eglGlobalResourceManager.FindDriver(eglDisplay);
     if(eglDriver == nullptr || !eglDriver->Initialized()) {
@@ -233,6 +245,7 @@ eglQueryString(EGLDisplay dpy, EGLint name)
         return getEGLClientExtensions();
     }
 
+    LOCK_EGL_RESOURCES
     CHECK_BAD_DISPLAY(eglDisplay, dpy, nullptr)
     CHECK_UNINITIALIZED_DISPLAY(eglDriver, eglDisplay, nullptr)
 
@@ -250,6 +263,7 @@ eglGetConfigs(EGLDisplay dpy, EGLConfig *configs, EGLint config_size, EGLint *nu
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
+    LOCK_EGL_RESOURCES
     CHECK_BAD_DISPLAY(eglDisplay, dpy, EGL_FALSE)
     CHECK_UNINITIALIZED_DISPLAY(eglDriver, eglDisplay, EGL_FALSE)
     return eglDriver->GetConfigs(configs, config_size, num_config);
@@ -260,6 +274,7 @@ eglChooseConfig(EGLDisplay dpy, const EGLint *attrib_list, EGLConfig *configs, E
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
+    LOCK_EGL_RESOURCES
     CHECK_BAD_DISPLAY(eglDisplay, dpy, EGL_FALSE)
     CHECK_UNINITIALIZED_DISPLAY(eglDriver, eglDisplay, EGL_FALSE)
     return eglDriver->ChooseConfig(attrib_list, configs, config_size, num_config);
@@ -270,6 +285,7 @@ eglGetConfigAttrib(EGLDisplay dpy, EGLConfig config, EGLint attribute, EGLint *v
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
+    LOCK_EGL_RESOURCES
     CHECK_BAD_DISPLAY(eglDisplay, dpy, EGL_FALSE)
     CHECK_UNINITIALIZED_DISPLAY(eglDriver, eglDisplay, EGL_FALSE)
     CHECK_BAD_CONFIG(eglDriver, eglConfig, config, EGL_FALSE)
@@ -281,6 +297,7 @@ eglCreateWindowSurface(EGLDisplay dpy, EGLConfig config, EGLNativeWindowType win
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
+    LOCK_EGL_RESOURCES
     CHECK_BAD_DISPLAY(eglDisplay, dpy, EGL_NO_SURFACE)
     CHECK_UNINITIALIZED_DISPLAY(eglDriver, eglDisplay, EGL_NO_SURFACE)
     CHECK_BAD_CONFIG(eglDriver, eglConfig, config, EGL_NO_SURFACE)
@@ -292,6 +309,7 @@ eglCreatePbufferSurface(EGLDisplay dpy, EGLConfig config, const EGLint *attrib_l
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
+    LOCK_EGL_RESOURCES
     CHECK_BAD_DISPLAY(eglDisplay, dpy, EGL_NO_SURFACE)
     CHECK_UNINITIALIZED_DISPLAY(eglDriver, eglDisplay, EGL_NO_SURFACE)
     CHECK_BAD_CONFIG(eglDriver, eglConfig, config, EGL_NO_SURFACE)
@@ -303,6 +321,7 @@ eglCreatePixmapSurface(EGLDisplay dpy, EGLConfig config, EGLNativePixmapType pix
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
+    LOCK_EGL_RESOURCES
     CHECK_BAD_DISPLAY(eglDisplay, dpy, EGL_NO_SURFACE)
     CHECK_UNINITIALIZED_DISPLAY(eglDriver, eglDisplay, EGL_NO_SURFACE)
     CHECK_BAD_CONFIG(eglDriver, eglConfig, config, EGL_NO_SURFACE)
@@ -314,6 +333,7 @@ eglDestroySurface(EGLDisplay dpy, EGLSurface surface)
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
+    LOCK_EGL_RESOURCES
     CHECK_BAD_DISPLAY(eglDisplay, dpy, EGL_FALSE)
     CHECK_UNINITIALIZED_DISPLAY(eglDriver, eglDisplay, EGL_FALSE)
     CHECK_BAD_SURFACE(eglDriver, eglSurface, surface, EGL_FALSE)
@@ -325,6 +345,7 @@ eglQuerySurface(EGLDisplay dpy, EGLSurface surface, EGLint attribute, EGLint *va
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
+    LOCK_EGL_RESOURCES
     CHECK_BAD_DISPLAY(eglDisplay, dpy, EGL_FALSE)
     CHECK_UNINITIALIZED_DISPLAY(eglDriver, eglDisplay, EGL_FALSE)
     CHECK_BAD_SURFACE(eglDriver, eglSurface, surface, EGL_FALSE)
@@ -337,6 +358,7 @@ eglCreatePbufferFromClientBuffer(EGLDisplay dpy, EGLenum buftype, EGLClientBuffe
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
+    LOCK_EGL_RESOURCES
     CHECK_BAD_DISPLAY(eglDisplay, dpy, EGL_NO_SURFACE)
     CHECK_UNINITIALIZED_DISPLAY(eglDriver, eglDisplay, EGL_NO_SURFACE)
     CHECK_BAD_CONFIG(eglDriver, eglConfig, config, EGL_NO_SURFACE)
@@ -348,6 +370,7 @@ eglSurfaceAttrib(EGLDisplay dpy, EGLSurface surface, EGLint attribute, EGLint va
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
+    LOCK_EGL_RESOURCES
     CHECK_BAD_DISPLAY(eglDisplay, dpy, EGL_FALSE)
     CHECK_UNINITIALIZED_DISPLAY(eglDriver, eglDisplay, EGL_FALSE)
     CHECK_BAD_SURFACE(eglDriver, eglSurface, surface, EGL_FALSE)
@@ -359,6 +382,7 @@ eglBindTexImage(EGLDisplay dpy, EGLSurface surface, EGLint buffer)
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
+    LOCK_EGL_RESOURCES
     CHECK_BAD_DISPLAY(eglDisplay, dpy, EGL_FALSE)
     CHECK_UNINITIALIZED_DISPLAY(eglDriver, eglDisplay, EGL_FALSE)
     CHECK_BAD_SURFACE(eglDriver, eglSurface, surface, EGL_FALSE)
@@ -370,6 +394,7 @@ eglReleaseTexImage(EGLDisplay dpy, EGLSurface surface, EGLint buffer)
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
+    LOCK_EGL_RESOURCES
     CHECK_BAD_DISPLAY(eglDisplay, dpy, EGL_FALSE)
     CHECK_UNINITIALIZED_DISPLAY(eglDriver, eglDisplay, EGL_FALSE)
     CHECK_BAD_SURFACE(eglDriver, eglSurface, surface, EGL_FALSE)
@@ -381,6 +406,7 @@ eglSwapInterval(EGLDisplay dpy, EGLint interval)
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
+    LOCK_EGL_RESOURCES
     CHECK_BAD_DISPLAY(eglDisplay, dpy, EGL_FALSE)
     CHECK_UNINITIALIZED_DISPLAY(eglDriver, eglDisplay, EGL_FALSE)
     return eglDriver->SwapInterval(interval);
@@ -391,10 +417,12 @@ eglSwapBuffers(EGLDisplay dpy, EGLSurface surface)
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
+    // the lock is released while the frame is submitted and presented
+    std::unique_lock<std::recursive_mutex> eglLock(eglGlobalResourceManager.GetMutex());
     CHECK_BAD_DISPLAY(eglDisplay, dpy, EGL_FALSE)
     CHECK_UNINITIALIZED_DISPLAY(eglDriver, eglDisplay, EGL_FALSE)
     CHECK_BAD_SURFACE(eglDriver, eglSurface, surface, EGL_FALSE)
-    return eglDriver->SwapBuffers(eglSurface);
+    return eglDriver->SwapBuffers(eglSurface, &eglLock);
 }
 
 EGLBoolean EGLAPIENTRY
@@ -402,6 +430,7 @@ eglCopyBuffers(EGLDisplay dpy, EGLSurface surface, EGLNativePixmapType target)
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
+    LOCK_EGL_RESOURCES
     CHECK_BAD_DISPLAY(eglDisplay, dpy, EGL_FALSE)
     CHECK_UNINITIALIZED_DISPLAY(eglDriver, eglDisplay, EGL_FALSE)
     CHECK_BAD_SURFACE(eglDriver, eglSurface, surface, EGL_FALSE)
@@ -420,6 +449,7 @@ eglGetProcAddress(const char *procname)
     }
 
     // get GL function pointers
+    LOCK_EGL_RESOURCES
     EGLenum enumAPI = currentThread.QueryAPI();
     if(enumAPI == EGL_OPENGL_ES_API) {
         // Assuming only GLES2 for now
@@ -442,6 +472,7 @@ eglCreateImageKHR(EGLDisplay dpy, EGLContext ctx, EGLenum target, EGLClientBuffe
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
+    LOCK_EGL_RESOURCES
     CHECK_BAD_DISPLAY(eglDisplay, dpy, EGL_NO_IMAGE_KHR)
     CHECK_UNINITIALIZED_DISPLAY(eglDriver, eglDisplay, EGL_NO_IMAGE_KHR)
     CHECK_BAD_CONTEXT(eglDriver, eglContext, ctx, EGL_NO_IMAGE_KHR)
@@ -453,6 +484,7 @@ eglDestroyImageKHR(EGLDisplay dpy, EGLImageKHR image)
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
+    LOCK_EGL_RESOURCES
     CHECK_BAD_DISPLAY(eglDisplay, dpy, EGL_FALSE)
     CHECK_UNINITIALIZED_DISPLAY(eglDriver, eglDisplay, EGL_FALSE)
     return eglDriver->DestroyImageKHR(image);
@@ -464,6 +496,7 @@ eglCreateSyncKHR(EGLDisplay dpy, EGLenum type, const EGLint *attrib_list)
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
+    LOCK_EGL_RESOURCES
     CHECK_BAD_DISPLAY(eglDisplay, dpy, EGL_NO_SYNC_KHR)
     CHECK_UNINITIALIZED_DISPLAY(eglDriver, eglDisplay, EGL_NO_SYNC_KHR)
     return eglDriver->CreateSyncKHR(type, attrib_list);
@@ -474,6 +507,7 @@ eglDestroySyncKHR(EGLDisplay dpy, EGLSyncKHR sync)
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
+    LOCK_EGL_RESOURCES
     CHECK_BAD_DISPLAY(eglDisplay, dpy, EGL_FALSE)
     CHECK_UNINITIALIZED_DISPLAY(eglDriver, eglDisplay, EGL_FALSE)
     return eglDriver->DestroySyncKHR(sync);
@@ -484,6 +518,7 @@ eglClientWaitSyncKHR(EGLDisplay dpy, EGLSyncKHR sync, EGLint flags, EGLTimeKHR t
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
+    LOCK_EGL_RESOURCES
     CHECK_BAD_DISPLAY(eglDisplay, dpy, EGL_FALSE)
     CHECK_UNINITIALIZED_DISPLAY(eglDriver, eglDisplay, EGL_FALSE)
     return eglDriver->ClientWaitSyncKHR(sync, flags, timeout);
@@ -49,7 +49,7 @@ const EGLConfig_t EglConfigs[1] = {
                               EGL_NONE,   // NativeVisualType
                                      0,   // Samples
                                      0,   // SampleBuffers
-                        EGL_WINDOW_BIT,   // SurfaceType
+                EGL_AVAILABLE_SURFACES,   // SurfaceType
                               EGL_NONE,   // TransparentType
                                      0,   // TransparentBlueValue
                                      0,   // TransparentGreenValue
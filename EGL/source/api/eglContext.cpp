@@ -28,11 +28,11 @@
 #include "thread/renderingThread.h"
 #include <algorithm>
 
-EGLContext_t::EGLContext_t(EGLDisplay_t* display, EGLenum rendering_api, EGLConfig_t *config, const EGLint *attribList):
+EGLContext_t::EGLContext_t(EGLDisplay_t* display, EGLenum rendering_api, EGLConfig_t *config, EGLContext_t *shareContext, const EGLint *attribList):
 EGLRefObject(),
 mAPIContext(nullptr), mRenderingAPI(rendering_api), mAPIInterface(nullptr),
 mDisplay(display), mReadSurface(nullptr), mDrawSurface(nullptr),
-mConfig(config), mAttribList(attribList), mClientVersion(1),
+mConfig(config), mAttribList(attribList), mShareContext(shareContext), mClientVersion(1),
 mIsCurrent(false)
 {
     FUN_ENTRY(EGL_LOG_TRACE);
@@ -53,6 +53,15 @@ EGLContext_t::ReleaseSurfaceResources()
     mAPIInterface->release_system_fbo_cb(mAPIContext);
 }
 
+void
+EGLContext_t::SetNotCurrent()
+{
+    FUN_ENTRY(EGL_LOG_TRACE);
+
+    mAPIInterface->release_current_cb(mAPIContext);
+    mIsCurrent = false;
+}
+
 EGLint
 EGLContext_t::GetRenderBuffer() const
 {
@@ -100,7 +109,11 @@ EGLContext_t::Validate()
         return EGL_FALSE;
     }
 
-    // TODO:: generate EGL_BAD_MATCH for incompatible share_contets
+    // objects can only be shared between contexts of the same client API and version
+    if(mShareContext != nullptr && (mShareContext->GetRenderingAPI() != mRenderingAPI || mShareContext->GetClientVersion() != mClientVersion)) {
+        currentThread.RecordError(EGL_BAD_MATCH);
+        return EGL_FALSE;
+    }
 
     return EGL_TRUE;
 }
@@ -122,7 +135,10 @@ EGLContext_t::Create()
         return EGL_FALSE;
     }
 
-    mAPIContext = mAPIInterface->create_context_cb();
+    mAPIContext = mAPIInterface->create_context_cb(mShareContext ? mShareContext->mAPIContext : nullptr);
+
+    // the share context is only needed to join its share group
+    mShareContext = nullptr;
 
     return mAPIContext != nullptr ? EGL_TRUE : EGL_FALSE;
 }
@@ -151,8 +167,8 @@ EGLContext_t::MakeCurrent(EGLDisplay_t *dpy, EGLSurface_t *draw, EGLSurface_t *r
     mDrawSurface = draw;
     mReadSurface = read;
 
-    // TODO: support pbuffers/pixmaps
-    if (draw && draw->GetType() != EGL_WINDOW_BIT) {
+    // TODO: support pixmaps
+    if (draw && draw->GetType() == EGL_PIXMAP_BIT) {
         return EGL_TRUE;
     }
 
@@ -190,11 +206,19 @@ EGLContext_t::Finish()
 }
 
 void
-EGLContext_t::BindToTexture(EGLint bind)
+EGLContext_t::FinishFrame()
+{
+    FUN_ENTRY(EGL_LOG_DEBUG);
+
+    mAPIInterface->finish_frame_cb(mAPIContext);
+}
+
+void
+EGLContext_t::BindToTexture(EGLSurface_t *surface, EGLint bind)
 {
     FUN_ENTRY(EGL_LOG_TRACE);
 
-    mAPIInterface->bind_to_texture_cb(mAPIContext, bind);
+    mAPIInterface->bind_to_texture_cb(mAPIContext, surface->GetEGLSurfaceInterface(), bind);
 }
 
 EGLBoolean
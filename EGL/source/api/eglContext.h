@@ -42,6 +42,7 @@ private:
     class EGLSurface_t          *mDrawSurface;
     struct EGLConfig_t          *mConfig;
     const EGLint                *mAttribList;
+    EGLContext_t                *mShareContext;
     EGLenum                      mClientVersion;
     bool                         mIsCurrent;
 
@@ -50,7 +51,7 @@ private:
     EGLBoolean                   Validate();
 
 public:
-    EGLContext_t(struct EGLDisplay_t * display, EGLenum rendering_api, EGLConfig_t* config, const EGLint *attribList);
+    EGLContext_t(struct EGLDisplay_t * display, EGLenum rendering_api, EGLConfig_t* config, EGLContext_t *shareContext, const EGLint *attribList);
     ~EGLContext_t();
 
     EGLBoolean                   Create();
@@ -59,10 +60,11 @@ public:
     //void                         SetNextImageIndex(uint32_t index);
     void                         Flush();
     void                         Finish();
-    void                         BindToTexture(EGLint bind);
+    void                         FinishFrame();
+    void                         BindToTexture(EGLSurface_t *surface, EGLint bind);
     void                         ReleaseSurfaceResources();
 
-    inline void                  SetNotCurrent()                                { FUN_ENTRY(EGL_LOG_TRACE); mIsCurrent = false; }
+    void                         SetNotCurrent();
 
     inline EGLenum               GetRenderingAPI()                        const { FUN_ENTRY(EGL_LOG_TRACE); return mRenderingAPI; }
     inline EGLDisplay_t         *GetDisplay()                             const { FUN_ENTRY(EGL_LOG_TRACE); return mDisplay; }
@@ -78,6 +78,8 @@ EGLGlobalResourceManager::GetDisplayByID(EGLNativeDisplayType display_id)
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
+
     EGLDisplay_t* dis = FindDisplayByID(display_id);
 
    // create a new display if it does not exist
@@ -115,6 +117,8 @@ EGLGlobalResourceManager::FindDisplay(EGLDisplay display)
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
+
     EGLDisplay_t* dis = nullptr;
     for(int32_t i = 0; i < MAX_NUM_DISPLAYS; ++i) {
         dis = &mEGLDisplayList[i];
@@ -132,6 +136,8 @@ EGLGlobalResourceManager::InitializeDisplay(EGLDisplay dpy, void* displayDriver)
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
+
     EGLDisplay_t *eglDisplay = FindDisplay(dpy);
     if(eglDisplay == nullptr) {
         return EGL_FALSE;
@@ -162,6 +168,8 @@ EGLGlobalResourceManager::TerminateDisplay(EGLDisplay display)
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
+
     EGLDisplay_t *eglDisplay = FindDisplay(display);
     if(eglDisplay == nullptr) {
         return;
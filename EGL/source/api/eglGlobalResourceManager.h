@@ -32,10 +32,13 @@
 #include "eglContext.h"
 #include "eglDisplay.h"
 #include "vector"
+#include <mutex>
 
 class EGLGlobalResourceManager
 {
 protected:
+    // Serializes the EGL calls of all threads; the client API calls do not take it
+    std::recursive_mutex        mMutex;
 
     // Display Drivers
     DisplayDriversContainer     mDisplayDriversContainer;
@@ -56,11 +59,14 @@ public:
     // Error handling
     EGLBoolean                  CheckBadDisplay(const EGLDisplay_t* eglDisplay) const;
 
+    // Locking
+    inline std::recursive_mutex &GetMutex()                                         { FUN_ENTRY(EGL_LOG_TRACE); return mMutex; }
+
     //DisplayDriversContainer functions
-    inline DisplayDriver        *FindDriver(EGLDisplay_t* display)                  { FUN_ENTRY(EGL_LOG_TRACE); return mDisplayDriversContainer.FindDriver(display); }
-    inline DisplayDriver        *AddDriver(EGLDisplay_t* display)                   { FUN_ENTRY(EGL_LOG_TRACE); return mDisplayDriversContainer.AddDriver(display); }
-    inline void                  RemoveDriver(EGLDisplay_t* display)                { FUN_ENTRY(EGL_LOG_TRACE); mDisplayDriversContainer.RemoveDriver(display); }
-    inline EGLBoolean            IsDriverListEmpty()                                { FUN_ENTRY(EGL_LOG_TRACE); return mDisplayDriversContainer.IsEmpty(); }
+    inline DisplayDriver        *FindDriver(EGLDisplay_t* display)                  { FUN_ENTRY(EGL_LOG_TRACE); std::lock_guard<std::recursive_mutex> lock(mMutex); return mDisplayDriversContainer.FindDriver(display); }
+    inline DisplayDriver        *AddDriver(EGLDisplay_t* display)                   { FUN_ENTRY(EGL_LOG_TRACE); std::lock_guard<std::recursive_mutex> lock(mMutex); return mDisplayDriversContainer.AddDriver(display); }
+    inline void                  RemoveDriver(EGLDisplay_t* display)                { FUN_ENTRY(EGL_LOG_TRACE); std::lock_guard<std::recursive_mutex> lock(mMutex); mDisplayDriversContainer.RemoveDriver(display); }
+    inline EGLBoolean            IsDriverListEmpty()                                { FUN_ENTRY(EGL_LOG_TRACE); std::lock_guard<std::recursive_mutex> lock(mMutex); return mDisplayDriversContainer.IsEmpty(); }
 };
 
 extern EGLGlobalResourceManager eglGlobalResourceManager;
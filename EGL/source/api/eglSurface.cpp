@@ -34,7 +34,7 @@ TextureFormat(0), TextureTarget(0), MipmapTexture(EGL_FALSE),
 LargestPbuffer(EGL_FALSE), RenderBuffer(0), VGAlphaFormat(0), VGColorspace(0),
 MipmapLevel(0), MultisampleResolve(0), SwapBehavior(0), HorizontalResolution(0),
 VerticalResolution(0), AspectRatio(0), SwapInterval(1), BindToTexture(EGL_FALSE), PostSubBufferSupportedNV(0),
-CurrentImageIndex(0), mPlatformResources(nullptr)
+CurrentImageIndex(0), SwapchainImageCount(0), SwapchainOutdated(EGL_FALSE), mPlatformResources(nullptr)
 {
     FUN_ENTRY(EGL_LOG_TRACE);
 
@@ -108,6 +108,17 @@ EGLSurface_t::ParseSurfaceAttribList(const EGLint *attrib_list)
             }
             RenderBuffer = val;
             break;
+        case EGL_SWAPCHAIN_IMAGE_COUNT_GLOVE:
+            if(type != EGL_WINDOW_BIT) {
+                err = EGL_BAD_ATTRIBUTE;
+                break;
+            }
+            if(val < 0) {
+                err = EGL_BAD_PARAMETER;
+                break;
+            }
+            SwapchainImageCount = val;
+            break;
         /* pbuffer surface attributes */
         case EGL_WIDTH:
             if(type != EGL_PBUFFER_BIT) {
@@ -265,6 +276,7 @@ EGLSurface_t::InitSurface(EGLint type, EGLConfig_t *conf, const EGLint *attrib_l
     AspectRatio          = EGL_UNKNOWN;
 
     PostSubBufferSupportedNV = EGL_FALSE;
+    SwapchainImageCount      = 0;
 
     *error = ParseSurfaceAttribList(attrib_list);
     if(*error != EGL_SUCCESS) {
@@ -329,6 +341,11 @@ EGLSurface_t::QuerySurface(EGLint attribute, EGLint *value)
     case EGL_RENDER_BUFFER:
         *value = RenderBuffer;
         break;
+    case EGL_SWAPCHAIN_IMAGE_COUNT_GLOVE:
+        if(Type == EGL_WINDOW_BIT && mPlatformResources) {
+            *value = static_cast<EGLint>(GetPlatformSurfaceImageCount());
+        }
+        break;
     case EGL_PIXEL_ASPECT_RATIO:
         *value = AspectRatio;
         break;
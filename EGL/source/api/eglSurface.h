@@ -76,6 +76,10 @@ private:
 
     EGLBoolean                       PostSubBufferSupportedNV;
     EGLint                           CurrentImageIndex;
+    /* requested number of swapchain images, 0 selects the default */
+    EGLint                           SwapchainImageCount;
+    /* True if the swapchain no longer matches the surface attributes (e.g., swap interval) */
+    EGLBoolean                       SwapchainOutdated;
     EGLint                           ColorFormat;
     EGLSurfaceInterface_t            SurfaceInterface;
 
@@ -107,6 +111,7 @@ public:
     inline void                      SetMultisampleResolve(EGLint multisampleResolve)           { FUN_ENTRY(EGL_LOG_TRACE); MultisampleResolve = multisampleResolve; }
     inline void                      SetSwapBehavior(EGLint swapBehavior)                       { FUN_ENTRY(EGL_LOG_TRACE); SwapBehavior = swapBehavior; }
     inline void                      SetBindToTexture(EGLint bindToTexture)                     { FUN_ENTRY(EGL_LOG_TRACE); BindToTexture = bindToTexture; }
+    inline void                      SetSwapchainOutdated(EGLBoolean outdated)                  { FUN_ENTRY(EGL_LOG_TRACE); SwapchainOutdated = outdated; }
            void                      ClampSwapInterval(EGLint swapInterval);
            void                      UpdateRef(bool increaseRef) override;
 
@@ -122,12 +127,19 @@ public:
     inline PlatformResources        *GetPlatformResources()                                     { FUN_ENTRY(EGL_LOG_TRACE); return mPlatformResources; }
     inline uint32_t                  GetPlatformSurfaceImageCount()                             { FUN_ENTRY(EGL_LOG_TRACE); return mPlatformResources->GetSwapchainImageCount(); }
     inline void                     *GetPlatformSurfaceImages()                                 { FUN_ENTRY(EGL_LOG_TRACE); return mPlatformResources->GetSwapchainImages(); }
+    inline void                     *GetPlatformSurfaceSyncItems()                              { FUN_ENTRY(EGL_LOG_TRACE); return mPlatformResources->GetSwapchainSyncItems(); }
 
     inline EGLint                    GetBindToTextureRGB()                                const { FUN_ENTRY(EGL_LOG_TRACE); return BindToTextureRGB; }
     inline EGLint                    GetBindToTextureRGBA()                               const { FUN_ENTRY(EGL_LOG_TRACE); return BindToTextureRGBA; }
+    inline EGLenum                   GetTextureFormat()                                   const { FUN_ENTRY(EGL_LOG_TRACE); return TextureFormat; }
+    inline EGLBoolean                GetLargestPbuffer()                                  const { FUN_ENTRY(EGL_LOG_TRACE); return LargestPbuffer; }
     inline EGLint                    GetSwapInterval()                                    const { FUN_ENTRY(EGL_LOG_TRACE); return SwapInterval; }
     inline EGLBoolean                GetBindToTexture()                                   const { FUN_ENTRY(EGL_LOG_TRACE); return BindToTexture; }
     inline EGLenum                   GetRenderBuffer()                                    const { FUN_ENTRY(EGL_LOG_TRACE); return RenderBuffer; }
+    inline EGLint                    GetSwapchainImageCount()                             const { FUN_ENTRY(EGL_LOG_TRACE); return SwapchainImageCount; }
+    inline EGLBoolean                IsSwapchainOutdated()                                const { FUN_ENTRY(EGL_LOG_TRACE); return SwapchainOutdated; }
+    /// bound to a context that is current to some thread
+    inline bool                      IsCurrent()                                          const { FUN_ENTRY(EGL_LOG_TRACE); return mRefCounter > 0; }
 };
 
 #endif // __EGL_SURFACE_H__
@@ -30,6 +30,7 @@
 #include "utils/egl_defs.h"
 #include "utils/eglUtils.h"
 #include "platform/platformFactory.h"
+#include "api/eglGlobalResourceManager.h"
 #include <algorithm>
 
 #ifdef VK_USE_PLATFORM_ANDROID_KHR
@@ -41,7 +42,7 @@ void setCallingThread(RenderingThread *thread) { callingThread = thread; }
 
 DisplayDriver::DisplayDriver(EGLDisplay_t* eglDisplay)
 : mEGLDisplay(eglDisplay),
-  mActiveContext(nullptr), mWindowInterface(nullptr),
+  mWindowInterface(nullptr),
   mInitialized(false)
 {
     FUN_ENTRY(EGL_LOG_TRACE);
@@ -148,11 +149,11 @@ DisplayDriver::Terminate()
 }
 
 EGLContext
-DisplayDriver::CreateContext(EGLenum rendering_api, EGLConfig_t* config, const EGLint* attribList)
+DisplayDriver::CreateContext(EGLenum rendering_api, EGLConfig_t* config, EGLContext_t *shareContext, const EGLint* attribList)
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
-    EGLContext_t *eglContext = mDisplayDriverResourceManager.AddEGLContext(mEGLDisplay, rendering_api, config, attribList);
+    EGLContext_t *eglContext = mDisplayDriverResourceManager.AddEGLContext(mEGLDisplay, rendering_api, config, shareContext, attribList);
     return static_cast<EGLContext>(eglContext);
 }
 
@@ -269,15 +270,14 @@ DisplayDriver::CreateWindowSurface(EGLConfig_t* eglConfig, EGLNativeWindowType w
     eglSurface->SetPlatformResources(platformResources);
 
     if(mWindowInterface->CreateSurface(mEGLDisplay, win, eglSurface) == EGL_FALSE) {
+        currentThread.RecordError(EGL_BAD_NATIVE_WINDOW);
         delete eglSurface;
         return EGL_NO_SURFACE;
     }
 
     mWindowInterface->AllocateSurfaceImages(eglSurface);
 
-    uint32_t imageNext = 0;
-    mWindowInterface->AcquireNextImage(eglSurface, &imageNext);
-
+    // the first image is acquired when the first frame renders to it
     CreateEGLSurfaceInterface(eglSurface);
 
     return static_cast<EGLSurface>(eglSurface);
@@ -288,7 +288,7 @@ DisplayDriver::CreatePbufferSurface(EGLConfig_t* eglConfig, const EGLint *attrib
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
-    EGLSurface_t *eglSurface = new EGLSurface_t();
+    EGLSurface_t *eglSurface = mDisplayDriverResourceManager.AddEGLSurface();
     if(!eglSurface) {
         currentThread.RecordError(EGL_BAD_ALLOC);
         return EGL_NO_SURFACE;
@@ -297,7 +297,7 @@ DisplayDriver::CreatePbufferSurface(EGLConfig_t* eglConfig, const EGLint *attrib
     EGLint eglError = EGL_SUCCESS;
     if(eglSurface->InitSurface(EGL_PBUFFER_BIT, eglConfig, attrib_list, &eglError) != EGL_TRUE) {
         currentThread.RecordError(eglError);
-        delete eglSurface;
+        mDisplayDriverResourceManager.RemoveEGLSurface(mWindowInterface, eglSurface);
         return EGL_NO_SURFACE;
     }
 
@@ -306,10 +306,31 @@ DisplayDriver::CreatePbufferSurface(EGLConfig_t* eglConfig, const EGLint *attrib
         eglSurface->SetHeight(EglConfigs[0].MaxPbufferHeight);
     }
 
-    //TODO: Pbuffer is not supported
-    NOT_IMPLEMENTED();
+    if(eglSurface->GetWidth()  > eglConfig->MaxPbufferWidth ||
+       eglSurface->GetHeight() > eglConfig->MaxPbufferHeight) {
+        if(eglSurface->GetLargestPbuffer() == EGL_FALSE) {
+            currentThread.RecordError(EGL_BAD_ALLOC);
+            mDisplayDriverResourceManager.RemoveEGLSurface(mWindowInterface, eglSurface);
+            return EGL_NO_SURFACE;
+        }
+        eglSurface->SetWidth(std::min(eglSurface->GetWidth(), eglConfig->MaxPbufferWidth));
+        eglSurface->SetHeight(std::min(eglSurface->GetHeight(), eglConfig->MaxPbufferHeight));
+    }
 
-    return EGL_NO_SURFACE;
+    PlatformResources *platformResources = PlatformFactory::GetResources();
+    eglSurface->SetPlatformResources(platformResources);
+
+    // the pbuffer is an offscreen device image, there is no swapchain to acquire from or present to
+    mWindowInterface->AllocateSurfaceImages(eglSurface);
+    if(!eglSurface->GetPlatformSurfaceImageCount()) {
+        currentThread.RecordError(EGL_BAD_ALLOC);
+        mDisplayDriverResourceManager.RemoveEGLSurface(mWindowInterface, eglSurface);
+        return EGL_NO_SURFACE;
+    }
+
+    CreateEGLSurfaceInterface(eglSurface);
+
+    return static_cast<EGLSurface>(eglSurface);
 }
 
 EGLSurface
@@ -338,6 +359,15 @@ DisplayDriver::CreateEGLSurfaceInterface(EGLSurface_t *eglSurface)
         surfaceInterface->imageCount        = eglSurface->GetPlatformSurfaceImageCount();
         surfaceInterface->depthBuffer       = 0;
         surfaceInterface->contextRef        = 0;
+        surfaceInterface->imageAcquired     = false;
+        surfaceInterface->syncItems         = reinterpret_cast<vkSyncItems_t *>(eglSurface->GetPlatformSurfaceSyncItems());
+        surfaceInterface->acquireData       = reinterpret_cast<void *>(this);
+        surfaceInterface->acquireNextImageCb= AcquireNextImageCb;
+    } else if(eglSurface->GetType() == EGL_PBUFFER_BIT) {
+        // the single pbuffer image is always available, it is never acquired
+        surfaceInterface->images            = eglSurface->GetPlatformSurfaceImages();
+        surfaceInterface->imageCount        = eglSurface->GetPlatformSurfaceImageCount();
+        surfaceInterface->textureFormat     = eglSurface->GetTextureFormat();
     }
     surfaceInterface->type                  = eglSurface->GetType();
     surfaceInterface->width                 = eglSurface->GetWidth();
@@ -431,7 +461,6 @@ DisplayDriver::BindTexImage(EGLSurface_t* eglSurface, EGLint buffer)
         currentThread.RecordError(EGL_BAD_MATCH);
         return EGL_FALSE;
     }
-    //TODO: EGL_BAD_ACCESS is generated if buffer is already bound to a texture.
     if (buffer != EGL_BACK_BUFFER) {
         currentThread.RecordError(EGL_BAD_MATCH);
         return EGL_FALSE;
@@ -447,11 +476,19 @@ DisplayDriver::BindTexImage(EGLSurface_t* eglSurface, EGLint buffer)
         return EGL_FALSE;
     }
 
-    //TODO: We are assuming that the BindTexImage refers to the surface that is currently active for GLOVE.
-    //If we have multiple surfaces for GLES, additional information may need to be passed to GLOVE.
-    mActiveContext->BindToTexture(EGL_TRUE);
-    //If display and surface are the display and surface for the calling thread's current context, eglBindTexImage performs an implicit glFlush
-    mActiveContext->Finish();
+    if(eglSurface->GetBindToTexture() == EGL_TRUE) {
+        currentThread.RecordError(EGL_BAD_ACCESS);
+        return EGL_FALSE;
+    }
+
+    // the pbuffer image is bound to the texture of the calling thread's current context,
+    // after the rendering recorded so far to the pbuffer is flushed
+    EGLContext_t *activeContext = currentThread.GetCurrentContext();
+    if(activeContext == nullptr) {
+        return EGL_FALSE;
+    }
+    activeContext->BindToTexture(eglSurface, EGL_TRUE);
+    eglSurface->SetBindToTexture(EGL_TRUE);
 
     return EGL_TRUE;
 }
@@ -471,7 +508,16 @@ DisplayDriver::ReleaseTexImage(EGLSurface_t* eglSurface, EGLint buffer)
         currentThread.RecordError(EGL_BAD_MATCH);
         return EGL_FALSE;
     }
-    mActiveContext->BindToTexture(EGL_FALSE);
+
+    if(eglSurface->GetBindToTexture() == EGL_FALSE) {
+        return EGL_TRUE;
+    }
+
+    EGLContext_t *activeContext = currentThread.GetCurrentContext();
+    if(activeContext) {
+        activeContext->BindToTexture(eglSurface, EGL_FALSE);
+    }
+    eglSurface->SetBindToTexture(EGL_FALSE);
 
     return EGL_TRUE;
 }
@@ -481,29 +527,32 @@ DisplayDriver::SwapInterval(EGLint interval)
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
-    if(currentThread.GetCurrentContext() == nullptr) {
+    EGLContext_t *activeContext = currentThread.GetCurrentContext();
+    if(activeContext == nullptr) {
         currentThread.RecordError(EGL_BAD_CONTEXT);
         return EGL_FALSE;
     }
 
-    EGLSurface_t* surface = static_cast<EGLSurface_t*>(mActiveContext->GetDrawSurface());
+    EGLSurface_t* surface = static_cast<EGLSurface_t*>(activeContext->GetDrawSurface());
     if(surface == nullptr) {
         currentThread.RecordError(EGL_BAD_SURFACE);
         return EGL_FALSE;
     }
 
     //If the interval remains the same, there is no need to update the surface
-    if(interval != surface->GetSwapInterval()) {
-        surface->ClampSwapInterval(interval);
-        mActiveContext->Finish();
-        UpdateSurface(surface);
+    EGLint previousInterval = surface->GetSwapInterval();
+    surface->ClampSwapInterval(interval);
+
+    //The present mode is switched by recreating the swapchain after the next present
+    if(surface->GetSwapInterval() != previousInterval) {
+        surface->SetSwapchainOutdated(EGL_TRUE);
     }
     return EGL_TRUE;
 }
 
 
 EGLBoolean
-DisplayDriver::SwapBuffers(EGLSurface_t* eglSurface)
+DisplayDriver::SwapBuffers(EGLSurface_t* eglSurface, std::unique_lock<std::recursive_mutex> *eglLock)
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
@@ -515,35 +564,94 @@ DisplayDriver::SwapBuffers(EGLSurface_t* eglSurface)
         return EGL_TRUE;
     }
 
-    mActiveContext->Finish();
+    // the surface has to be current to the calling thread
+    EGLContext_t *activeContext = currentThread.GetCurrentContext();
+    if(activeContext == nullptr || activeContext->GetDrawSurface() != eglSurface) {
+        currentThread.RecordError(EGL_BAD_SURFACE);
+        return EGL_FALSE;
+    }
+
+    // a surface current to this thread cannot be bound or destroyed by another one, so the
+    // frame is submitted and presented without blocking the EGL calls of the other threads;
+    // only the recreation of the surface images takes the lock again
+    eglLock->unlock();
+
+    // submits the frame without waiting for it; the next image is acquired by the next frame
+    activeContext->FinishFrame();
+
+    // the frame acquires its image at the latest here, a failure is already recorded
+    EGLSurfaceInterface_t *surfaceInterface = eglSurface->GetEGLSurfaceInterface();
+    if(!surfaceInterface->imageAcquired) {
+        return EGL_FALSE;
+    }
+
+    EGLBoolean presented = mWindowInterface->PresentImage(eglSurface);
+    surfaceInterface->imageAcquired = false;
 
-    if(mWindowInterface->PresentImage(eglSurface) == EGL_FALSE) {
+    if(presented == EGL_FALSE || eglSurface->IsSwapchainOutdated()) {
         UpdateSurface(eglSurface);
     }
 
+    return EGL_TRUE;
+}
+
+EGLBoolean
+DisplayDriver::AcquireSurfaceImage(EGLSurface_t* eglSurface)
+{
+    FUN_ENTRY(DEBUG_DEPTH);
+
+    // the acquire may block, it only uses the state of a surface that is current to the calling thread
     uint32_t imageIndex;
-    while(mWindowInterface->AcquireNextImage(eglSurface, &imageIndex) == EGL_FALSE) {
+    EGLint error = mWindowInterface->AcquireNextImage(eglSurface, &imageIndex);
+
+    // an out of date swapchain is recreated once, any other failure is reported to the client API
+    if(error == EGL_BAD_SURFACE) {
         UpdateSurface(eglSurface);
+        error = mWindowInterface->AcquireNextImage(eglSurface, &imageIndex);
+    }
+
+    if(error != EGL_SUCCESS) {
+        currentThread.RecordError(error);
+        return EGL_FALSE;
     }
 
-    eglSurface->GetEGLSurfaceInterface()->nextImageIndex = imageIndex;
+    EGLSurfaceInterface_t *surfaceInterface = eglSurface->GetEGLSurfaceInterface();
+    surfaceInterface->nextImageIndex = imageIndex;
+    surfaceInterface->imageAcquired  = true;
 
     return EGL_TRUE;
 }
 
+EGLBoolean
+DisplayDriver::AcquireNextImageCb(EGLSurfaceInterface_t *eglSurfaceInterface)
+{
+    FUN_ENTRY(DEBUG_DEPTH);
+
+    DisplayDriver *displayDriver = reinterpret_cast<DisplayDriver *>(eglSurfaceInterface->acquireData);
+    EGLSurface_t  *eglSurface    = reinterpret_cast<EGLSurface_t *>(eglSurfaceInterface->surface);
+
+    return displayDriver->AcquireSurfaceImage(eglSurface);
+}
+
 void
 DisplayDriver::UpdateSurface(EGLSurface_t* eglSurface)
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
-    assert(mActiveContext != nullptr);
+    // the surface is current to the calling thread, which may not hold the EGL lock
+    std::lock_guard<std::recursive_mutex> lock(eglGlobalResourceManager.GetMutex());
+
+    EGLContext_t *activeContext = currentThread.GetCurrentContext();
+    assert(activeContext != nullptr);
     assert(mWindowInterface != nullptr);
 
-    mActiveContext->ReleaseSurfaceResources();
-    mWindowInterface->DestroySurfaceImages(eglSurface);
-    mWindowInterface->AllocateSurfaceImages(eglSurface);
+    // the context waits for its own use of the surface images and drops its window framebuffer,
+    // the rest of its state is kept. The swapchain is recreated from the current one.
+    activeContext->ReleaseSurfaceResources();
+    mWindowInterface->RecreateSurfaceImages(eglSurface);
+    eglSurface->SetSwapchainOutdated(EGL_FALSE);
     CreateEGLSurfaceInterface(eglSurface);
-    mActiveContext->MakeCurrent(mEGLDisplay, eglSurface, eglSurface);
+    activeContext->MakeCurrent(mEGLDisplay, eglSurface, eglSurface);
 }
 
 EGLBoolean
@@ -682,7 +790,7 @@ DisplayDriver::ClientWaitSyncKHR(EGLSyncKHR sync, EGLint flags, EGLTimeKHR timeo
 
 const char *DisplayDriver::GetExtensions()
 {
-    return "";
+    return "EGL_KHR_surfaceless_context";
 }
 
 EGLBoolean
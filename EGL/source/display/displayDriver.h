@@ -35,6 +35,7 @@
 #include "api/eglDisplay.h"
 #include "displayDriverResourceManager.h"
 #include <vector>
+#include <mutex>
 
 #ifdef DEBUG_DEPTH
 #   undef DEBUG_DEPTH
@@ -46,7 +47,6 @@ void setCallingThread(RenderingThread *thread);
 class DisplayDriver {
 private:
     EGLDisplay_t                *mEGLDisplay;
-    EGLContext_t                *mActiveContext;
     PlatformWindowInterface     *mWindowInterface;
     DisplayDriverResourceManager mDisplayDriverResourceManager;
     bool                         mInitialized;
@@ -54,13 +54,14 @@ private:
     EGLImageKHR                  CreateImageNativeBufferAndroid(EGLContext ctx, EGLenum target, EGLClientBuffer buffer, const EGLint *attrib_list);
     void                         CreateEGLSurfaceInterface(EGLSurface_t *eglSurface);
     void                         UpdateSurface(EGLSurface_t *eglSurface);
+    EGLBoolean                   AcquireSurfaceImage(EGLSurface_t *eglSurface);
+    static EGLBoolean            AcquireNextImageCb(EGLSurfaceInterface_t *eglSurfaceInterface);
 
 public:
 
     DisplayDriver(EGLDisplay_t *eglDisplay);
     ~DisplayDriver(void);
 
-    inline void                  SetActiveContext(EGLContext ctx)               { FUN_ENTRY(EGL_LOG_TRACE); mActiveContext = static_cast<EGLContext_t *>(ctx); }
     inline bool                  Initialized()                            const { FUN_ENTRY(EGL_LOG_TRACE); return mInitialized; }
     void                         CleanMarkedResources(void);
 
@@ -73,7 +74,7 @@ public:
     /// EGL API core functions
     EGLBoolean                   Initialize(EGLint *major, EGLint *minor);
     EGLBoolean                   Terminate(void);
-    EGLContext                   CreateContext(EGLenum rendering_api, EGLConfig_t *config, const EGLint *attribList);
+    EGLContext                   CreateContext(EGLenum rendering_api, EGLConfig_t *config, EGLContext_t *shareContext, const EGLint *attribList);
     EGLBoolean                   DestroyContext(EGLContext_t *eglContext);
     EGLBoolean                   GetConfigs(EGLConfig *configs, EGLint config_size, EGLint *num_config);
     EGLBoolean                   ChooseConfig(const EGLint *attrib_list, EGLConfig *configs, EGLint config_size, EGLint *num_config);
@@ -88,7 +89,7 @@ public:
     EGLBoolean                   BindTexImage(EGLSurface_t* eglSurface, EGLint buffer);
     EGLBoolean                   ReleaseTexImage(EGLSurface_t* eglSurface, EGLint buffer);
     EGLBoolean                   SwapInterval(EGLint interval);
-    EGLBoolean                   SwapBuffers(EGLSurface_t* eglSurface);
+    EGLBoolean                   SwapBuffers(EGLSurface_t* eglSurface, std::unique_lock<std::recursive_mutex> *eglLock);
     EGLBoolean                   CopyBuffers(EGLSurface_t* eglSurface, EGLNativePixmapType target);
     const char*                  GetExtensions();
 
@@ -129,11 +129,11 @@ DisplayDriverResourceManager::FindEGLContext(const EGLContext_t* eglContext) con
 }
 
 EGLContext_t*
-DisplayDriverResourceManager::CreateEGLContext(EGLDisplay_t *display, EGLenum rendering_api, EGLConfig_t *config, const EGLint *attribList)
+DisplayDriverResourceManager::CreateEGLContext(EGLDisplay_t *display, EGLenum rendering_api, EGLConfig_t *config, EGLContext_t *shareContext, const EGLint *attribList)
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
-    EGLContext_t * eglContext = new EGLContext_t(display, rendering_api, config, attribList);
+    EGLContext_t * eglContext = new EGLContext_t(display, rendering_api, config, shareContext, attribList);
 
     if(eglContext->Create() == EGL_FALSE) {
         delete eglContext;
@@ -156,11 +156,11 @@ DisplayDriverResourceManager::DeleteEGLContext(EGLContext_t* eglContext)
 }
 
 EGLContext_t*
-DisplayDriverResourceManager::AddEGLContext(EGLDisplay_t *display, EGLenum rendering_api, EGLConfig_t *config, const EGLint *attribList)
+DisplayDriverResourceManager::AddEGLContext(EGLDisplay_t *display, EGLenum rendering_api, EGLConfig_t *config, EGLContext_t *shareContext, const EGLint *attribList)
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
-    EGLContext_t *eglContext = CreateEGLContext(display, rendering_api, config, attribList);
+    EGLContext_t *eglContext = CreateEGLContext(display, rendering_api, config, shareContext, attribList);
 
     if(eglContext) {
         mContextList.push_back(eglContext);
@@ -40,7 +40,7 @@ protected:
     std::vector<EGLContext_t*>   mContextList;
 
     // EGLContext resources
-    EGLContext_t                *CreateEGLContext(EGLDisplay_t *display, EGLenum rendering_api, EGLConfig_t *config, const EGLint *attribList);
+    EGLContext_t                *CreateEGLContext(EGLDisplay_t *display, EGLenum rendering_api, EGLConfig_t *config, EGLContext_t *shareContext, const EGLint *attribList);
     EGLBoolean                   DeleteEGLContext(EGLContext_t* eglContext);
 
     // EGLSurface resources
@@ -61,7 +61,7 @@ public:
     EGLBoolean                   FindEGLSurface(const EGLSurface_t* eglSurface) const;
 
     // EGLContext resources
-    EGLContext_t                *AddEGLContext(EGLDisplay_t *display, EGLenum rendering_api, EGLConfig_t *config, const EGLint *attribList);
+    EGLContext_t                *AddEGLContext(EGLDisplay_t *display, EGLenum rendering_api, EGLConfig_t *config, EGLContext_t *shareContext, const EGLint *attribList);
     EGLBoolean                   RemoveEGLContext(EGLContext_t* eglContext);
     EGLBoolean                   FindEGLContext(const EGLContext_t* eglContext) const;
 
@@ -31,6 +31,9 @@
 #include "platform/vulkan/WSIWayland.h"
 #endif
 #include "platform/vulkan/WSIPlaneDisplay.h"
+#include "platform/vulkan/WSIHeadless.h"
+#include "rendering_api_interface.h"
+#include <cstdlib>
 
 #ifdef VK_USE_PLATFORM_ANDROID_KHR
 #include "platform/vulkan/WSIAndroid.h"
@@ -87,6 +90,11 @@ PlatformFactory::ChoosePlatform()
 
     PlatformFactory *platformFactory = PlatformFactory::GetInstance();
 
+    if(getenv(GLOVE_HEADLESS_ENV)) {
+        platformFactory->SetPlatformType(PlatformFactory::WSI_HEADLESS);
+        return;
+    }
+
 #ifdef VK_USE_PLATFORM_XCB_KHR
     platformFactory->SetPlatformType(PlatformFactory::WSI_XCB);
     return;
@@ -148,6 +156,13 @@ PlatformFactory::GetWindowInterface()
             return windowInterface;
         }
 
+        case WSI_HEADLESS: {
+            VulkanWindowInterface *windowInterface = new VulkanWindowInterface();
+            WSIHeadless *vulkanWSI = new WSIHeadless();
+            windowInterface->SetWSI(vulkanWSI);
+            return windowInterface;
+        }
+
 #ifdef VK_USE_PLATFORM_ANDROID_KHR
         case WSI_ANDROID: {
             VulkanWindowInterface *windowInterface = new VulkanWindowInterface();
@@ -195,6 +210,7 @@ PlatformFactory::GetResources()
         case WSI_XCB:
         case WSI_WAYLAND:
         case WSI_PLANE_DISPLAY:
+        case WSI_HEADLESS:
             return new VulkanResources();
 
 #ifdef VK_USE_PLATFORM_ANDROID_KHR
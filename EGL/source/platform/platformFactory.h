@@ -37,7 +37,8 @@ public:
         WSI_ANDROID,
         WSI_PLANE_DISPLAY,
         WSI_WINDOWS,
-        WSI_MACOS
+        WSI_MACOS,
+        WSI_HEADLESS
     };
 
 private:
@@ -35,6 +35,7 @@ public:
 
     virtual uint32_t    GetSwapchainImageCount() = 0;
     virtual void       *GetSwapchainImages()     = 0;
+    virtual void       *GetSwapchainSyncItems()  = 0;
 };
 
 #endif // __PLATFORM_RESOURCES_H__
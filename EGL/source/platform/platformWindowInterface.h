@@ -41,8 +41,11 @@ public:
     virtual EGLBoolean           CreateSurface(EGLDisplay_t* dpy, EGLNativeWindowType win, EGLSurface_t *surface) = 0;
     virtual void                 AllocateSurfaceImages(EGLSurface_t *surface) = 0;
     virtual void                 DestroySurfaceImages(EGLSurface_t *eglSurface) = 0;
+    virtual void                 RecreateSurfaceImages(EGLSurface_t *eglSurface) = 0;
     virtual void                 DestroySurface(EGLSurface_t *eglSurface) = 0;
-    virtual EGLBoolean           AcquireNextImage(EGLSurface_t *surface, uint32_t *imageIndex) = 0;
+    /// returns EGL_SUCCESS, EGL_BAD_SURFACE if the surface images are out of date and have to be
+    /// recreated, or the EGL error of any other failure
+    virtual EGLint               AcquireNextImage(EGLSurface_t *surface, uint32_t *imageIndex) = 0;
     virtual EGLBoolean           PresentImage(EGLSurface_t *eglSurface) = 0;
 };
 
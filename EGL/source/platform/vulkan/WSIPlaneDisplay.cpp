@@ -95,10 +95,10 @@ WSIPlaneDisplay::SetPhysicalDeviceDisplayProperties()
 
     VkResult ASSERT_ONLY res;
     uint32_t physicalDeviceDisplayPropertiesCount = 0;
-    res = mWsiPlaneDisplayCallbacks.fpGetPhysicalDeviceDisplayPropertiesKHR(mVkInterface->vkGpus[0], &physicalDeviceDisplayPropertiesCount, nullptr);
+    res = mWsiPlaneDisplayCallbacks.fpGetPhysicalDeviceDisplayPropertiesKHR(mVkInterface->vkGpu, &physicalDeviceDisplayPropertiesCount, nullptr);
     assert(!res);
 
     mDisplayPropertiesList.resize(physicalDeviceDisplayPropertiesCount);
-    res = mWsiPlaneDisplayCallbacks.fpGetPhysicalDeviceDisplayPropertiesKHR(mVkInterface->vkGpus[0], &physicalDeviceDisplayPropertiesCount, mDisplayPropertiesList.data());
+    res = mWsiPlaneDisplayCallbacks.fpGetPhysicalDeviceDisplayPropertiesKHR(mVkInterface->vkGpu, &physicalDeviceDisplayPropertiesCount, mDisplayPropertiesList.data());
     assert(!res);
 }
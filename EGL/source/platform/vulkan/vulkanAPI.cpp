@@ -41,7 +41,7 @@ VulkanAPI::DoesSupportPresent(const VulkanResources *vkResources)
     FUN_ENTRY(DEBUG_DEPTH);
 
     VkBool32 supportsPresent;
-    vkGetPhysicalDeviceSurfaceSupportKHR(mVkInterface->vkGpus[0], mVkInterface->vkGraphicsQueueNodeIndex, vkResources->GetSurface(), &supportsPresent);
+    vkGetPhysicalDeviceSurfaceSupportKHR(mVkInterface->vkGpu, mVkInterface->vkGraphicsQueueNodeIndex, vkResources->GetSurface(), &supportsPresent);
 
     return (supportsPresent == VK_TRUE) ? EGL_TRUE : EGL_FALSE;
 }
@@ -135,7 +135,7 @@ VulkanAPI::GetPhysicalDevFormats(const VulkanResources *vkResources, uint32_t fo
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
-    VkResult  res = vkGetPhysicalDeviceSurfaceFormatsKHR(mVkInterface->vkGpus[0], vkResources->GetSurface(), &formatCount, formats);
+    VkResult  res = vkGetPhysicalDeviceSurfaceFormatsKHR(mVkInterface->vkGpu, vkResources->GetSurface(), &formatCount, formats);
 
     return (VK_SUCCESS == res) ? EGL_TRUE : EGL_FALSE;
 }
@@ -147,7 +147,7 @@ VulkanAPI::GetPhysicalDevFormatsCount(const VulkanResources *vkResources)
 
     VkResult res;
     uint32_t formatCount = 0;
-    res = vkGetPhysicalDeviceSurfaceFormatsKHR(mVkInterface->vkGpus[0], vkResources->GetSurface(), &formatCount, nullptr);
+    res = vkGetPhysicalDeviceSurfaceFormatsKHR(mVkInterface->vkGpu, vkResources->GetSurface(), &formatCount, nullptr);
 
     return (VK_SUCCESS == res) ? formatCount : 0;
 }
@@ -157,7 +157,7 @@ VulkanAPI::GetPhysicalDevFormatProperties(VkFormat format, VkFormatProperties *f
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
-    vkGetPhysicalDeviceFormatProperties(mVkInterface->vkGpus[0], format, formatProperties);
+    vkGetPhysicalDeviceFormatProperties(mVkInterface->vkGpu, format, formatProperties);
 }
 
 EGLBoolean
@@ -165,7 +165,7 @@ VulkanAPI::GetPhysicalDevPresentModes(const VulkanResources *vkResources, uint32
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
-    VkResult res = vkGetPhysicalDeviceSurfacePresentModesKHR(mVkInterface->vkGpus[0], vkResources->GetSurface(), &presentModeCount, presentModes);
+    VkResult res = vkGetPhysicalDeviceSurfacePresentModesKHR(mVkInterface->vkGpu, vkResources->GetSurface(), &presentModeCount, presentModes);
 
     return (VK_SUCCESS == res) ? EGL_TRUE : EGL_FALSE;
 }
@@ -177,7 +177,7 @@ VulkanAPI::GetPhysicalDevPresentModesCount(const VulkanResources *vkResources)
 
     VkResult res;
     uint32_t presentModeCount = 0;
-    res = vkGetPhysicalDeviceSurfacePresentModesKHR(mVkInterface->vkGpus[0], vkResources->GetSurface(), &presentModeCount, nullptr);
+    res = vkGetPhysicalDeviceSurfacePresentModesKHR(mVkInterface->vkGpu, vkResources->GetSurface(), &presentModeCount, nullptr);
 
     return (VK_SUCCESS == res) ? presentModeCount : 0;
 }
@@ -187,7 +187,7 @@ VulkanAPI::GetPhysicalDevSurfaceCapabilities(const VulkanResources *vkResources,
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
-    VkResult res = vkGetPhysicalDeviceSurfaceCapabilitiesKHR(mVkInterface->vkGpus[0], vkResources->GetSurface(), surfCapabilities);
+    VkResult res = vkGetPhysicalDeviceSurfaceCapabilitiesKHR(mVkInterface->vkGpu, vkResources->GetSurface(), surfCapabilities);
 
     return (VK_SUCCESS == res) ? EGL_TRUE : EGL_FALSE;
 }
@@ -197,10 +197,12 @@ VulkanAPI::AcquireNextImage(const VulkanResources *vkResources, uint32_t *imageI
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
+    const vkSyncItems_t *syncItems = vkResources->GetSyncItems();
+
     VkResult res = mWsiCallbacks->fpAcquireNextImageKHR(mVkInterface->vkDevice,
                                                         vkResources->GetSwapchain(),
                                                         UINT64_MAX,
-                                                        mVkInterface->vkSyncItems->vkAcquireSemaphore,
+                                                        syncItems->vkAcquireSemaphores[syncItems->frameIndex],
                                                         VK_NULL_HANDLE,
                                                         imageIndex);
 
@@ -230,12 +232,131 @@ VulkanAPI::PresentImage(const VulkanResources *vkResources, uint32_t imageIndex,
     return res;
 }
 
+VkImage
+VulkanAPI::CreateOffscreenImage(uint32_t width, uint32_t height, VkFormat format, VkDeviceMemory *memory)
+{
+    FUN_ENTRY(DEBUG_DEPTH);
+
+    /// rendered to as a color attachment, sampled when bound to a texture and copied by glReadPixels/glCopyTex(Sub)Image2D
+    VkImageCreateInfo imageInfo;
+    imageInfo.sType                 = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    imageInfo.pNext                 = nullptr;
+    imageInfo.flags                 = 0;
+    imageInfo.imageType             = VK_IMAGE_TYPE_2D;
+    imageInfo.format                = format;
+    imageInfo.extent                = {width, height, 1};
+    imageInfo.mipLevels             = 1;
+    imageInfo.arrayLayers           = 1;
+    imageInfo.samples               = VK_SAMPLE_COUNT_1_BIT;
+    imageInfo.tiling                = VK_IMAGE_TILING_OPTIMAL;
+    imageInfo.usage                 = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT |
+                                      VK_IMAGE_USAGE_TRANSFER_SRC_BIT     | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+    imageInfo.sharingMode           = VK_SHARING_MODE_EXCLUSIVE;
+    imageInfo.queueFamilyIndexCount = 0;
+    imageInfo.pQueueFamilyIndices   = nullptr;
+    imageInfo.initialLayout         = VK_IMAGE_LAYOUT_UNDEFINED;
+
+    VkImage image = VK_NULL_HANDLE;
+    if(vkCreateImage(mVkInterface->vkDevice, &imageInfo, nullptr, &image) != VK_SUCCESS) {
+        return VK_NULL_HANDLE;
+    }
+
+    VkMemoryRequirements memoryRequirements;
+    vkGetImageMemoryRequirements(mVkInterface->vkDevice, image, &memoryRequirements);
+
+    uint32_t memoryTypeIndex = VK_MAX_MEMORY_TYPES;
+    const VkPhysicalDeviceMemoryProperties *memoryProperties = &mVkInterface->vkDeviceMemoryProperties;
+    for(uint32_t i = 0; i < memoryProperties->memoryTypeCount; ++i) {
+        if((memoryRequirements.memoryTypeBits & (1u << i)) &&
+           (memoryProperties->memoryTypes[i].propertyFlags & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT)) {
+            memoryTypeIndex = i;
+            break;
+        }
+    }
+
+    VkMemoryAllocateInfo memoryInfo;
+    memoryInfo.sType           = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    memoryInfo.pNext           = nullptr;
+    memoryInfo.allocationSize  = memoryRequirements.size;
+    memoryInfo.memoryTypeIndex = memoryTypeIndex;
+
+    if(memoryTypeIndex == VK_MAX_MEMORY_TYPES ||
+       vkAllocateMemory(mVkInterface->vkDevice, &memoryInfo, nullptr, memory) != VK_SUCCESS) {
+        vkDestroyImage(mVkInterface->vkDevice, image, nullptr);
+        return VK_NULL_HANDLE;
+    }
+
+    if(vkBindImageMemory(mVkInterface->vkDevice, image, *memory, 0) != VK_SUCCESS) {
+        DestroyOffscreenImage(image, *memory);
+        *memory = VK_NULL_HANDLE;
+        return VK_NULL_HANDLE;
+    }
+
+    return image;
+}
+
 void
-VulkanAPI::DestroySwapchain(const VulkanResources *vkResources)
+VulkanAPI::DestroyOffscreenImage(VkImage image, VkDeviceMemory memory)
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
-    vkDestroySwapchainKHR(mVkInterface->vkDevice, vkResources->GetSwapchain(), nullptr);
+    vkDestroyImage(mVkInterface->vkDevice, image, nullptr);
+    vkFreeMemory(mVkInterface->vkDevice, memory, nullptr);
+}
+
+void
+VulkanAPI::DestroySwapchain(VkSwapchainKHR swapchain)
+{
+    FUN_ENTRY(DEBUG_DEPTH);
+
+    vkDestroySwapchainKHR(mVkInterface->vkDevice, swapchain, nullptr);
+}
+
+EGLBoolean
+VulkanAPI::CreateSyncItems(vkSyncItems_t *syncItems)
+{
+    FUN_ENTRY(DEBUG_DEPTH);
+
+    VkSemaphoreCreateInfo semaphoreCreateInfo;
+    semaphoreCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    semaphoreCreateInfo.pNext = nullptr;
+    semaphoreCreateInfo.flags = 0;
+
+    for(uint32_t i = 0; i < GLOVE_MAX_FRAMES_IN_FLIGHT; ++i) {
+        if(vkCreateSemaphore(mVkInterface->vkDevice, &semaphoreCreateInfo, nullptr, &syncItems->vkAcquireSemaphores[i]) != VK_SUCCESS ||
+           vkCreateSemaphore(mVkInterface->vkDevice, &semaphoreCreateInfo, nullptr, &syncItems->vkDrawSemaphores[i])    != VK_SUCCESS) {
+            DestroySyncItems(syncItems);
+            return EGL_FALSE;
+        }
+    }
+
+    syncItems->acquireSemaphoreFlag = false;
+    syncItems->drawSemaphoreFlag    = false;
+    syncItems->frameIndex           = 0;
+
+    return EGL_TRUE;
+}
+
+void
+VulkanAPI::DestroySyncItems(vkSyncItems_t *syncItems)
+{
+    FUN_ENTRY(DEBUG_DEPTH);
+
+    /// the presents waiting for the semaphores are done once the presentation queue is idle
+    mVkInterface->lockQueueCb();
+    vkQueueWaitIdle(mVkInterface->vkQueue);
+    mVkInterface->unlockQueueCb();
+
+    for(uint32_t i = 0; i < GLOVE_MAX_FRAMES_IN_FLIGHT; ++i) {
+        if(syncItems->vkAcquireSemaphores[i] != VK_NULL_HANDLE) {
+            vkDestroySemaphore(mVkInterface->vkDevice, syncItems->vkAcquireSemaphores[i], nullptr);
+            syncItems->vkAcquireSemaphores[i] = VK_NULL_HANDLE;
+        }
+        if(syncItems->vkDrawSemaphores[i] != VK_NULL_HANDLE) {
+            vkDestroySemaphore(mVkInterface->vkDevice, syncItems->vkDrawSemaphores[i], nullptr);
+            syncItems->vkDrawSemaphores[i] = VK_NULL_HANDLE;
+        }
+    }
 }
 
 void
@@ -64,7 +64,12 @@ public:
     VkResult                     AcquireNextImage(const VulkanResources *vkResources, uint32_t *imageIndex);
     VkResult                     PresentImage(const VulkanResources *vkResources, uint32_t imageIndex, std::vector<VkSemaphore> &vkSemaphores);
 
-    void                         DestroySwapchain(const VulkanResources *vkResources);
+    VkImage                      CreateOffscreenImage(uint32_t width, uint32_t height, VkFormat format, VkDeviceMemory *memory);
+    void                         DestroyOffscreenImage(VkImage image, VkDeviceMemory memory);
+
+    void                         DestroySwapchain(VkSwapchainKHR swapchain);
+    EGLBoolean                   CreateSyncItems(vkSyncItems_t *syncItems);
+    void                         DestroySyncItems(vkSyncItems_t *syncItems);
     void                         DestroyPlatformSurface(const VulkanResources *vkResources);
 
     void                         SetWSICallbacks(const VulkanWSI::wsiCallbacks_t *wsiCallbacks) { mWsiCallbacks = wsiCallbacks; }
@@ -25,9 +25,18 @@
 
 VulkanResources::VulkanResources()
     : mSurface(VK_NULL_HANDLE), mSwapchain(VK_NULL_HANDLE),
-      mSwapChainImageCount(0), mSwapChainImages(nullptr)
+      mSwapChainImageCount(0), mSwapChainImages(nullptr), mOffscreenMemory(VK_NULL_HANDLE)
 {
     FUN_ENTRY(DEBUG_DEPTH);
+
+    for(uint32_t i = 0; i < GLOVE_MAX_FRAMES_IN_FLIGHT; ++i) {
+        mSyncItems.vkAcquireSemaphores[i] = VK_NULL_HANDLE;
+        mSyncItems.vkDrawSemaphores[i]    = VK_NULL_HANDLE;
+    }
+    mSyncItems.acquireSemaphoreFlag = false;
+    mSyncItems.drawSemaphoreFlag    = false;
+    mSyncItems.frameIndex           = 0;
+    mSyncItems.frameCount           = GLOVE_MAX_FRAMES_IN_FLIGHT;
 }
 
 VulkanResources::~VulkanResources()
@@ -25,15 +25,28 @@
 #define __VULKAN_RESOURCES_H__
 
 #include "platform/platformResources.h"
+#include "rendering_api_interface.h"
 #include <vulkan/vulkan.h>
+#include <vector>
 
 class VulkanResources : public PlatformResources
 {
+public:
+    /// a swapchain replaced by a newer one, destroyed once its last presents are done
+    typedef struct retiredSwapchain {
+        VkSwapchainKHR               swapchain;
+        uint32_t                     presentsLeft;
+    } retiredSwapchain_t;
+
 private:
     VkSurfaceKHR                     mSurface;
     VkSwapchainKHR                   mSwapchain;
     uint32_t                         mSwapChainImageCount;
     VkImage                         *mSwapChainImages;
+    VkDeviceMemory                   mOffscreenMemory;
+    std::vector<retiredSwapchain_t>  mRetiredSwapchains;
+    /// acquire and render-complete semaphores of the frames of a window surface
+    vkSyncItems_t                    mSyncItems;
 
 public:
     VulkanResources();
@@ -46,12 +59,18 @@ public:
     inline VkSwapchainKHR            GetSwapchain()                                 const { return mSwapchain; }
     inline uint32_t                  GetSwapchainImageCount()                    override { return mSwapChainImageCount; }
     inline void *                    GetSwapchainImages()                        override { return reinterpret_cast<void *>(mSwapChainImages); }
+    inline void *                    GetSwapchainSyncItems()                     override { return reinterpret_cast<void *>(&mSyncItems); }
+    inline std::vector<retiredSwapchain_t> *GetRetiredSwapchains()                        { return &mRetiredSwapchains; }
+    inline VkDeviceMemory            GetOffscreenMemory()                           const { return mOffscreenMemory; }
+    inline const vkSyncItems_t      *GetSyncItems()                                 const { return &mSyncItems; }
+    inline vkSyncItems_t            *GetSyncItems()                                       { return &mSyncItems; }
 
     // Set Functions
     inline void                      SetSurface(VkSurfaceKHR surface)                     { mSurface              = surface; }
     inline void                      SetSwapchain(VkSwapchainKHR swapchain)               { mSwapchain            = swapchain; }
     inline void                      SetSwapChainImageCount(uint32_t swapChainImageCount) { mSwapChainImageCount  = swapChainImageCount; }
     inline void                      SetSwapChainImages(VkImage *swapChainImages)         { mSwapChainImages      = swapChainImages; }
+    inline void                      SetOffscreenMemory(VkDeviceMemory memory)            { mOffscreenMemory      = memory; }
 };
 
 #endif // #define __VULKAN_RESOURCES_H__
@@ -22,6 +22,10 @@
  */
 
 #include "vulkanWindowInterface.h"
+#include <algorithm>
+
+#define GLOVE_SWAPCHAIN_IMAGES_ENV                      "GLOVE_SWAPCHAIN_IMAGES"
+#define GLOVE_DEFAULT_SWAPCHAIN_IMAGES                  3
 
 VulkanWindowInterface::VulkanWindowInterface(void)
 : mVkInitialized(false), mGLES2Interface(nullptr), mVkAPI(nullptr), mVkWSI(nullptr)
@@ -146,6 +150,35 @@ VulkanWindowInterface::SetSwapchainPresentMode(EGLSurface_t* surface)
     return swapchainPresentMode;
 }
 
+uint32_t
+VulkanWindowInterface::GetSwapchainImageCount(const EGLSurface_t *surface, const VkSurfaceCapabilitiesKHR *surfCapabilities)
+{
+    FUN_ENTRY(DEBUG_DEPTH);
+
+    /// Three images let the application record a frame while another one is
+    /// executed and a third one is on display. The environment overrides the
+    /// surface attribute, which overrides the default.
+    uint32_t imageCount = GLOVE_DEFAULT_SWAPCHAIN_IMAGES;
+    if(surface->GetRenderBuffer() == EGL_SINGLE_BUFFER) {
+        imageCount = surfCapabilities->minImageCount;
+    }
+    if(surface->GetSwapchainImageCount() > 0) {
+        imageCount = static_cast<uint32_t>(surface->GetSwapchainImageCount());
+    }
+
+    const char *envImageCount = getenv(GLOVE_SWAPCHAIN_IMAGES_ENV);
+    if(envImageCount && atoi(envImageCount) > 0) {
+        imageCount = static_cast<uint32_t>(atoi(envImageCount));
+    }
+
+    imageCount = std::max(imageCount, surfCapabilities->minImageCount);
+    if(surfCapabilities->maxImageCount > 0) {
+        imageCount = std::min(imageCount, surfCapabilities->maxImageCount);
+    }
+
+    return imageCount;
+}
+
 void
 VulkanWindowInterface::SetSurfaceColorFormat(EGLSurface_t *surface)
 {
@@ -209,23 +242,31 @@ VulkanWindowInterface::CreateVkSwapchain(EGLSurface_t* surface,
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
-    EGLBoolean ASSERT_ONLY wsiSuccess;
     /// Determine number of buffers
     assert(surfCapabilities.minImageCount >= 1);
-    uint32_t desiredNumberOfSwapChainImages = 2;
+    uint32_t desiredNumberOfSwapChainImages = GetSwapchainImageCount(surface, &surfCapabilities);
 
     VulkanResources *vkResources = dynamic_cast<VulkanResources *>(surface->GetPlatformResources());
     assert(vkResources);
 
-    VkSwapchainKHR vkSwapchain = mVkAPI->CreateSwapchain(vkResources,
-                                                         desiredNumberOfSwapChainImages,
-                                                         surfCapabilities,
-                                                         swapChainExtent,
-                                                         swapchainPresentMode,
-                                                         static_cast<VkFormat>(surface->GetColorFormat()),
-                                                         VK_NULL_HANDLE);
+    /// a swapchain that is still alive is handed over to the new one and retired
+    VkSwapchainKHR oldSwapchain = vkResources->GetSwapchain();
+    VkSwapchainKHR vkSwapchain  = mVkAPI->CreateSwapchain(vkResources,
+                                                          desiredNumberOfSwapChainImages,
+                                                          surfCapabilities,
+                                                          swapChainExtent,
+                                                          swapchainPresentMode,
+                                                          static_cast<VkFormat>(surface->GetColorFormat()),
+                                                          oldSwapchain);
     assert(vkSwapchain != VK_NULL_HANDLE);
 
+    if(oldSwapchain != VK_NULL_HANDLE) {
+        VulkanResources::retiredSwapchain_t retiredSwapchain;
+        retiredSwapchain.swapchain    = oldSwapchain;
+        retiredSwapchain.presentsLeft = vkResources->GetSyncItems()->frameCount;
+        vkResources->GetRetiredSwapchains()->push_back(retiredSwapchain);
+    }
+
     vkResources->SetSwapchain(vkSwapchain);
 }
 
@@ -271,6 +312,11 @@ VulkanWindowInterface::AllocateSurfaceImages(EGLSurface_t* surface)
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
+    if(surface->GetType() == EGL_PBUFFER_BIT) {
+        AllocateOffscreenImage(surface);
+        return;
+    }
+
     CreateSwapchain(surface);
 
     EGLBoolean ASSERT_ONLY wsiSuccess;
@@ -288,30 +334,54 @@ VulkanWindowInterface::AllocateSurfaceImages(EGLSurface_t* surface)
     wsiSuccess = mVkAPI->GetSwapChainImages(vkResources, swapChainImageCount, swapChainImages);
     assert(EGL_TRUE == wsiSuccess);
 
+    vkResources->Release();
     vkResources->SetSwapChainImageCount(swapChainImageCount);
     vkResources->SetSwapChainImages(swapChainImages);
+
+    /// the semaphores of the surface outlive the recreations of its swapchain
+    vkSyncItems_t *syncItems = vkResources->GetSyncItems();
+    if(syncItems->vkAcquireSemaphores[0] == VK_NULL_HANDLE) {
+        wsiSuccess = mVkAPI->CreateSyncItems(syncItems);
+        assert(EGL_TRUE == wsiSuccess);
+    }
+
+    /// there is no point in having more frames in flight than swapchain images
+    syncItems->frameCount = std::min(swapChainImageCount, static_cast<uint32_t>(GLOVE_MAX_FRAMES_IN_FLIGHT));
+    syncItems->frameIndex = syncItems->frameIndex % syncItems->frameCount;
 }
 
-EGLBoolean
+EGLint
 VulkanWindowInterface::AcquireNextImage(EGLSurface_t *surface, uint32_t *imageIndex)
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
-    const VulkanResources *vkResources = dynamic_cast<const VulkanResources *>(surface->GetPlatformResources());
+    VulkanResources *vkResources = dynamic_cast<VulkanResources *>(surface->GetPlatformResources());
     if(vkResources == nullptr) {
-        return EGL_FALSE;
+        return EGL_BAD_SURFACE;
     }
 
+    /// a suboptimal image is still acquired and its semaphore signaled, so it is rendered and
+    /// presented, and the swapchain is recreated when the presentation reports it
     VkResult res = mVkAPI->AcquireNextImage(vkResources, imageIndex);
-    if(res == VK_ERROR_OUT_OF_DATE_KHR || res == VK_SUBOPTIMAL_KHR) {
-        mVkAPI->DeviceWaitIdle();
-
-        return EGL_FALSE;
+    switch(res) {
+    case VK_SUCCESS:
+    case VK_SUBOPTIMAL_KHR:
+        break;
+    case VK_ERROR_OUT_OF_DATE_KHR:
+        return EGL_BAD_SURFACE;
+    case VK_ERROR_OUT_OF_HOST_MEMORY:
+    case VK_ERROR_OUT_OF_DEVICE_MEMORY:
+        return EGL_BAD_ALLOC;
+    case VK_ERROR_DEVICE_LOST:
+        return EGL_CONTEXT_LOST;
+    default:
+        return EGL_BAD_NATIVE_WINDOW;
     }
+    vkResources->GetSyncItems()->acquireSemaphoreFlag = true;
 
     surface->SetCurrentImageIndex(*imageIndex);
 
-    return EGL_TRUE;
+    return EGL_SUCCESS;
 }
 
 void
@@ -321,15 +391,78 @@ VulkanWindowInterface::DestroySwapchain(EGLSurface_t *surface)
 
     VulkanResources *vkResources = dynamic_cast<VulkanResources *>(surface->GetPlatformResources());
     if(vkResources && vkResources->GetSwapchain() != VK_NULL_HANDLE) {
-        mVkAPI->DestroySwapchain(vkResources);
+        mVkAPI->DestroySwapchain(vkResources->GetSwapchain());
         vkResources->SetSwapchain(VK_NULL_HANDLE);
     }
 
     if(vkResources) {
+        ReleaseRetiredSwapchains(vkResources, true);
+        mVkAPI->DestroySyncItems(vkResources->GetSyncItems());
         vkResources->Release();
     }
 }
 
+void
+VulkanWindowInterface::ReleaseRetiredSwapchains(VulkanResources *vkResources, bool force)
+{
+    FUN_ENTRY(DEBUG_DEPTH);
+
+    std::vector<VulkanResources::retiredSwapchain_t> *retiredSwapchains = vkResources->GetRetiredSwapchains();
+    for(auto it = retiredSwapchains->begin(); it != retiredSwapchains->end(); ) {
+        if(force || it->presentsLeft == 0) {
+            mVkAPI->DestroySwapchain(it->swapchain);
+            it = retiredSwapchains->erase(it);
+        } else {
+            --it->presentsLeft;
+            ++it;
+        }
+    }
+}
+
+void
+VulkanWindowInterface::AllocateOffscreenImage(EGLSurface_t *surface)
+{
+    FUN_ENTRY(DEBUG_DEPTH);
+
+    VulkanResources *vkResources = dynamic_cast<VulkanResources *>(surface->GetPlatformResources());
+    assert(vkResources);
+
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    VkImage image = mVkAPI->CreateOffscreenImage(static_cast<uint32_t>(surface->GetWidth()),
+                                                 static_cast<uint32_t>(surface->GetHeight()),
+                                                 mVkPbufferFormat, &memory);
+    if(image == VK_NULL_HANDLE) {
+        return;
+    }
+
+    VkImage *images = new VkImage[1];
+    images[0] = image;
+
+    vkResources->Release();
+    vkResources->SetSwapChainImageCount(1);
+    vkResources->SetSwapChainImages(images);
+    vkResources->SetOffscreenMemory(memory);
+
+    surface->SetColorFormat(static_cast<EGLint>(mVkPbufferFormat));
+    surface->SetCurrentImageIndex(0);
+}
+
+void
+VulkanWindowInterface::DestroyOffscreenImage(EGLSurface_t *surface)
+{
+    FUN_ENTRY(DEBUG_DEPTH);
+
+    VulkanResources *vkResources = dynamic_cast<VulkanResources *>(surface->GetPlatformResources());
+    if(vkResources == nullptr || vkResources->GetOffscreenMemory() == VK_NULL_HANDLE) {
+        return;
+    }
+
+    VkImage *images = reinterpret_cast<VkImage *>(vkResources->GetSwapchainImages());
+    mVkAPI->DestroyOffscreenImage(images[0], vkResources->GetOffscreenMemory());
+    vkResources->SetOffscreenMemory(VK_NULL_HANDLE);
+    vkResources->Release();
+}
+
 void
 VulkanWindowInterface::DestroySurface(EGLSurface_t *surface)
 {
@@ -340,6 +473,8 @@ VulkanWindowInterface::DestroySurface(EGLSurface_t *surface)
         mVkAPI->DestroyPlatformSurface(vkResources);
         vkResources->SetSurface(VK_NULL_HANDLE);
         mGLES2Interface->delete_shared_surface_data_cb(surface->GetEGLSurfaceInterface());
+    } else if(vkResources && surface->GetType() == EGL_PBUFFER_BIT) {
+        mGLES2Interface->delete_shared_surface_data_cb(surface->GetEGLSurfaceInterface());
     }
 }
 
@@ -348,33 +483,57 @@ VulkanWindowInterface::DestroySurfaceImages(EGLSurface_t *surface)
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
+    if(surface->GetType() == EGL_PBUFFER_BIT) {
+        DestroyOffscreenImage(surface);
+        return;
+    }
+
     DestroySwapchain(surface);
 }
 
+void
+VulkanWindowInterface::RecreateSurfaceImages(EGLSurface_t *surface)
+{
+    FUN_ENTRY(DEBUG_DEPTH);
+
+    /// the current swapchain is passed as oldSwapchain, so the new one reuses what it can
+    /// and the old one is only destroyed after the presents queued on it are done.
+    /// The rendering API has already waited for its own use of the old images.
+    AllocateSurfaceImages(surface);
+}
+
 EGLBoolean
 VulkanWindowInterface::PresentImage(EGLSurface_t *surface)
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
+    VulkanResources *vkResources = dynamic_cast<VulkanResources *>(surface->GetPlatformResources());
+    vkSyncItems_t *syncItems = vkResources->GetSyncItems();
+
+    /// wait for the rendering of the frame, and for the acquire if no submission has consumed it
     std::vector<VkSemaphore> pSems;
-    if(mVkInterface->vkSyncItems->drawSemaphoreFlag) {
-        pSems.push_back(mVkInterface->vkSyncItems->vkDrawSemaphore);
-    } else {
-        pSems.push_back(mVkInterface->vkSyncItems->vkAcquireSemaphore);
+    if(syncItems->drawSemaphoreFlag) {
+        pSems.push_back(syncItems->vkDrawSemaphores[syncItems->frameIndex]);
+    }
+    if(syncItems->acquireSemaphoreFlag) {
+        pSems.push_back(syncItems->vkAcquireSemaphores[syncItems->frameIndex]);
     }
 
-    mVkInterface->vkSyncItems->acquireSemaphoreFlag = true;
-    mVkInterface->vkSyncItems->drawSemaphoreFlag = false;
+    /// the next frame acquires and renders with its own pair of semaphores
+    syncItems->frameIndex = (syncItems->frameIndex + 1) % syncItems->frameCount;
+    syncItems->acquireSemaphoreFlag = false;
+    syncItems->drawSemaphoreFlag = false;
 
     uint32_t imageIndex = surface->GetCurrentImageIndex();
-    VkResult res = mVkAPI->PresentImage(dynamic_cast<const VulkanResources *>(surface->GetPlatformResources()), imageIndex, pSems);
-    if(res == VK_ERROR_OUT_OF_DATE_KHR || res == VK_SUBOPTIMAL_KHR) {
-        mVkAPI->DeviceWaitIdle();
+    mVkInterface->lockQueueCb();
+    VkResult res = mVkAPI->PresentImage(vkResources, imageIndex, pSems);
 
-        return EGL_FALSE;
-    }
+    mVkInterface->unlockQueueCb();
 
-    return EGL_TRUE;
+    /// every present on the new swapchain brings the retired ones closer to being idle
+    ReleaseRetiredSwapchains(vkResources, false);
+
+    return (res == VK_ERROR_OUT_OF_DATE_KHR || res == VK_SUBOPTIMAL_KHR) ? EGL_FALSE : EGL_TRUE;
 }
 
 EGLBoolean
@@ -43,6 +43,8 @@ private:
     vkInterface_t *              mVkInterface;
 
     const VkFormat               mVkDefaultFormat = VK_FORMAT_B8G8R8A8_UNORM;
+    /// color attachment and sampling support is mandatory for this format
+    const VkFormat               mVkPbufferFormat = VK_FORMAT_R8G8B8A8_UNORM;
 
     EGLBoolean                   InitializeVulkanAPI();
     void                         TerminateVulkanAPI();
@@ -51,8 +53,13 @@ private:
 
     void                         CreateSwapchain(EGLSurface_t *surface);
     void                         DestroySwapchain(EGLSurface_t *surface);
+    void                         ReleaseRetiredSwapchains(VulkanResources *vkResources, bool force);
+
+    void                         AllocateOffscreenImage(EGLSurface_t *surface);
+    void                         DestroyOffscreenImage(EGLSurface_t *surface);
 
     VkPresentModeKHR             SetSwapchainPresentMode(EGLSurface_t* surface);
+    uint32_t                     GetSwapchainImageCount(const EGLSurface_t *surface, const VkSurfaceCapabilitiesKHR *surfCapabilities);
     void                         SetSurfaceColorFormat(EGLSurface_t *surface);
 
     void                         CreateVkSwapchain(EGLSurface_t* surface,
@@ -69,8 +76,9 @@ public:
     EGLBoolean                   CreateSurface(EGLDisplay_t* dpy, EGLNativeWindowType win, EGLSurface_t *surface) override;
     void                         AllocateSurfaceImages(EGLSurface_t *surface) override;
     void                         DestroySurfaceImages(EGLSurface_t *surface) override;
+    void                         RecreateSurfaceImages(EGLSurface_t *surface) override;
     void                         DestroySurface(EGLSurface_t *surface) override;
-    EGLBoolean                   AcquireNextImage(EGLSurface_t *surface, uint32_t *imageIndex) override;
+    EGLint                       AcquireNextImage(EGLSurface_t *surface, uint32_t *imageIndex) override;
     EGLBoolean                   PresentImage(EGLSurface_t *surface) override;
 
     /// Set Functions
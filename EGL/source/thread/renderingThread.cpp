@@ -44,7 +44,7 @@ const char * const RenderingThread::EGLErrors[] = {   "EGL_SUCCESS",
                                                       "EGL_CONTEXT_LOST"};
 
 RenderingThread::RenderingThread()
-: mCurrentAPI(EGL_OPENGL_ES_API), mLastError(EGL_SUCCESS)
+: mCurrentAPI(EGL_OPENGL_ES_API), mGLESCurrentContext(nullptr), mVGCurrentContext(nullptr), mLastError(EGL_SUCCESS)
 {
     FUN_ENTRY(EGL_LOG_TRACE);
 }
@@ -114,9 +114,25 @@ RenderingThread::ReleaseThread(void)
 {
     FUN_ENTRY(DEBUG_DEPTH);
 
-    NOT_IMPLEMENTED();
+    // release the current context of every client API, so that other threads can make it current
+    const EGLenum apis[] = {EGL_OPENGL_ES_API, EGL_OPENVG_API};
+    for(EGLenum api : apis) {
+        mCurrentAPI = api;
 
-    return EGL_FALSE;
+        EGLContext_t *activeContext = GetCurrentContext();
+        if(activeContext == nullptr) {
+            continue;
+        }
+
+        EGLDisplay_t *eglDisplay = activeContext->GetDisplay();
+        MakeCurrent(eglGlobalResourceManager.FindDriver(eglDisplay), eglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    }
+
+    // the thread returns to its initial state
+    mCurrentAPI = EGL_OPENGL_ES_API;
+    mLastError  = EGL_SUCCESS;
+
+    return EGL_TRUE;
 }
 
 void
@@ -202,7 +218,7 @@ RenderingThread::CreateContext(DisplayDriver* eglDriver, EGLConfig_t* eglConfig,
         return EGL_NO_CONTEXT;
     }
 
-    return eglDriver->CreateContext(mCurrentAPI, eglConfig, attrib_list);
+    return eglDriver->CreateContext(mCurrentAPI, eglConfig, eglShareContext, attrib_list);
 }
 
 EGLBoolean
@@ -255,12 +271,25 @@ RenderingThread::QueryContext(DisplayDriver* eglDriver, EGLContext_t* eglContext
     return EGL_TRUE;
 }
 
+bool
+RenderingThread::IsSurfaceCurrentToOtherThread(const EGLSurface_t* eglSurface, const EGLContext_t* threadContext)
+{
+    if(eglSurface == nullptr || !eglSurface->IsCurrent()) {
+        return false;
+    }
+
+    // a surface is only counted as current by the contexts it is bound to
+    return threadContext == nullptr ||
+           (threadContext->GetDrawSurface() != eglSurface && threadContext->GetReadSurface() != eglSurface);
+}
+
 EGLBoolean
 RenderingThread::ValidateCurrentContext(DisplayDriver* eglDriver, EGLSurface_t* drawSurface, EGLSurface_t* readSurface, EGLContext_t* eglContext)
 {
-    // generate EGL_BAD_MATCH if EGL_NO_CONTEXT and EGL_NO_SURFACE are not specified together
+    // generate EGL_BAD_MATCH if EGL_NO_CONTEXT and EGL_NO_SURFACE are not specified together.
+    // EGL_KHR_surfaceless_context allows a context without surfaces, but then both of them must be EGL_NO_SURFACE
     if((eglContext == EGL_NO_CONTEXT && (drawSurface != EGL_NO_SURFACE || readSurface != EGL_NO_SURFACE)) ||
-       (eglContext != EGL_NO_CONTEXT && (drawSurface == EGL_NO_SURFACE || readSurface == EGL_NO_SURFACE))) {
+       (eglContext != EGL_NO_CONTEXT && ((drawSurface == EGL_NO_SURFACE) != (readSurface == EGL_NO_SURFACE)))) {
         currentThread.RecordError(EGL_BAD_MATCH);
         return EGL_FALSE;
     }
@@ -284,15 +313,19 @@ RenderingThread::ValidateCurrentContext(DisplayDriver* eglDriver, EGLSurface_t*
         currentThread.RecordError(EGL_BAD_MATCH);
     }
 
-    // generate EGL_BAD_MATCH if EGL_NO_CONTEXT and EGL_NO_SURFACE are not specified together
-    if((eglContext == EGL_NO_CONTEXT && (drawSurface != EGL_NO_SURFACE || readSurface != EGL_NO_SURFACE)) ||
-       (eglContext != EGL_NO_CONTEXT && drawSurface == EGL_NO_SURFACE && readSurface == EGL_NO_SURFACE)) {
-        currentThread.RecordError(EGL_BAD_MATCH);
+    // generate EGL_BAD_ACCESS if ctx is current to some other thread, or if either draw or read
+    // are bound to contexts in another thread. The resources current to this thread may be rebound.
+    EGLContext_t *threadContext = GetCurrentContext();
+    if(eglContext != EGL_NO_CONTEXT && eglContext->IsCurrent() && eglContext != threadContext) {
+        currentThread.RecordError(EGL_BAD_ACCESS);
         return EGL_FALSE;
     }
 
-    // TODO:: If ctx is current to some other thread, or if either draw or read are bound to
-    // contexts in another thread, an EGL_BAD_ACCESS error is generated.
+    if(IsSurfaceCurrentToOtherThread(drawSurface, threadContext) ||
+       IsSurfaceCurrentToOtherThread(readSurface, threadContext)) {
+        currentThread.RecordError(EGL_BAD_ACCESS);
+        return EGL_FALSE;
+    }
 
     // TODO:: If binding ctx would exceed the number of current contexts of that client
     // API type supported by the implementation, an EGL_BAD_ACCESS error is generated
@@ -338,7 +371,7 @@ RenderingThread::MakeCurrent(DisplayDriver* eglDriver, EGLDisplay_t* dpy, EGLSur
     }
 
     // mark as not context the last context
-    if(currentContext != nullptr) {
+    if(currentContext != nullptr && currentContext != eglContext) {
         currentContext->SetNotCurrent();
     }
 
@@ -347,8 +380,6 @@ RenderingThread::MakeCurrent(DisplayDriver* eglDriver, EGLDisplay_t* dpy, EGLSur
     currentContext = GetCurrentContext();
     UpdateCurrentContextResourcesRef(currentContext, true);
 
-    eglDriver->SetActiveContext(currentContext);
-
     // clean any marked resources that may have been released after the current call to MakeCurrent
     eglDriver->CleanMarkedResources();
 
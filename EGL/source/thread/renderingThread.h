@@ -39,6 +39,7 @@ private:
     EGLint                  mLastError;
 
     void                    SetCurrentContext(EGLenum renderingAPI, EGLContext_t* eglContext);
+    bool                    IsSurfaceCurrentToOtherThread(const class EGLSurface_t* eglSurface, const EGLContext_t* threadContext);
     EGLBoolean              ValidateCurrentContext(class DisplayDriver* eglDriver, class EGLSurface_t* drawSurface, class EGLSurface_t* readSurface, EGLContext_t* eglContext);
     void                    UpdateCurrentContextResourcesRef(EGLContext_t *eglContext, bool incrementCounters);
 
@@ -64,6 +65,7 @@ public:
     EGLBoolean              WaitNative(EGLint engine);
 };
 
-extern RenderingThread currentThread;
+/// each thread has its own error, bound API and current contexts
+extern thread_local RenderingThread currentThread;
 
 #endif // __RENDERINGTHREAD_H__
@@ -37,6 +37,9 @@
 
 #define EGL_FENCE_WAIT_TIMEOUT                         UINT64_MAX
 
+/// window surface attribute for the number of swapchain images (0 selects the default)
+#define EGL_SWAPCHAIN_IMAGE_COUNT_GLOVE                0x3FF0
+
 #ifndef EGL_SUPPORT_ONLY_PBUFFER_SURFACE
 #   define EGL_SUPPORT_ONLY_PBUFFER_SURFACE            0
 #else
@@ -30,7 +30,7 @@ static api_state_t    gles2_state = nullptr;
 
 api_state_t           init_API();
           void        terminate_API();
-api_context_t         create_context();
+api_context_t         create_context(api_context_t share_context);
 void                  set_read_write_surface(api_context_t api_context, EGLSurfaceInterface *eglReadSurfaceInterface, EGLSurfaceInterface *eglWriteSurfaceInterface);
 void                  delete_shared_surface_data(EGLSurfaceInterface *eglSurfaceInterface);
 void                  delete_context(api_context_t api_context);
@@ -38,8 +38,12 @@ void                  release_system_fbo(api_context_t api_context);
 GLPROC                get_proc_addr(const char* procname);
 void                  flush(api_context_t api_context);
 void                  finish(api_context_t api_context);
-void                  bind_to_texture(api_context_t api_context, uint32_t bind);
+void                  bind_to_texture(api_context_t api_context, EGLSurfaceInterface *eglSurfaceInterface, uint32_t bind);
+void                  finish_frame(api_context_t api_context);
+void                  release_current(api_context_t api_context);
 
+static void           lock_queue(void);
+static void           unlock_queue(void);
 static void           FillInVkInterface(vulkanAPI::vkContext_t* vkContext);
 
 rendering_api_interface_t GLES2Interface = {
@@ -54,7 +58,9 @@ rendering_api_interface_t GLES2Interface = {
     get_proc_addr,
     flush,
     finish,
-    bind_to_texture
+    bind_to_texture,
+    finish_frame,
+    release_current
 };
 
 #ifdef WIN32
@@ -64,15 +70,29 @@ rendering_api_interface_t* EGLAPIENTRY GetGLES2Interface(void)
 }
 #endif
 
+/// presentation uses the first queue, which the draw submissions of some contexts also use
+static void lock_queue(void)
+{
+    vulkanAPI::vkContext_t *vkContext = vulkanAPI::GetContext();
+    vkContext->vkQueues[0].vkMutex.lock();
+}
+
+static void unlock_queue(void)
+{
+    vulkanAPI::vkContext_t *vkContext = vulkanAPI::GetContext();
+    vkContext->vkQueues[0].vkMutex.unlock();
+}
+
 static void FillInVkInterface(vulkanAPI::vkContext_t* vkContext)
 {
     vkInterface.vkInstance = vkContext->vkInstance;
-    vkInterface.vkGpus = &vkContext->vkGpus[0];
+    vkInterface.vkGpu = vkContext->vkGpu;
     vkInterface.vkQueue = vkContext->vkQueue;
     vkInterface.vkGraphicsQueueNodeIndex = vkContext->vkGraphicsQueueNodeIndex;
     vkInterface.vkDeviceMemoryProperties = vkContext->vkDeviceMemoryProperties;
     vkInterface.vkDevice = vkContext->vkDevice;
-    vkInterface.vkSyncItems = vkContext->vkSyncItems;
+    vkInterface.lockQueueCb = lock_queue;
+    vkInterface.unlockQueueCb = unlock_queue;
 }
 
 api_state_t init_API()
@@ -94,11 +114,11 @@ void terminate_API()
     GLLogger::Shutdown();
 }
 
-api_context_t create_context()
+api_context_t create_context(api_context_t share_context)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    Context *ctx = new Context();
+    Context *ctx = new Context(reinterpret_cast<const Context *>(share_context));
     return ctx;
 }
 
@@ -158,10 +178,28 @@ void finish(api_context_t api_context)
     ctx->Finish();
 }
 
-void bind_to_texture(api_context_t api_context, uint32_t bind)
+void bind_to_texture(api_context_t api_context, EGLSurfaceInterface *eglSurfaceInterface, uint32_t bind)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    Context *ctx = reinterpret_cast<Context *>(api_context);
+    ctx->BindTexImage(eglSurfaceInterface, bind ? GL_TRUE : GL_FALSE);
+}
+
+void finish_frame(api_context_t api_context)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    Context *ctx = reinterpret_cast<Context *>(api_context);
+    ctx->FinishFrame();
+}
+
+void release_current(api_context_t api_context)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
     Context *ctx = reinterpret_cast<Context *>(api_context);
-    ctx->BindToTexture(bind);
+    if(GetCurrentContext() == ctx) {
+        SetCurrentContext(nullptr);
+    }
 }
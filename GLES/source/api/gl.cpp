@@ -897,6 +897,42 @@ glEGLImageTargetRenderbufferStorageOES(GLenum target, GLeglImageOES image)
     CONTEXT_EXEC(EGLImageTargetRenderBufferStorageOES(target, image));
 }
 
+void GL_APIENTRY
+glDiscardFramebufferEXT(GLenum target, GLsizei numAttachments, const GLenum *attachments)
+{
+    CONTEXT_EXEC(DiscardFramebufferEXT(target, numAttachments, attachments));
+}
+
+void * GL_APIENTRY
+glMapBufferOES(GLenum target, GLenum access)
+{
+    CONTEXT_EXEC_RETURN(MapBufferOES(target, access));
+}
+
+GLboolean GL_APIENTRY
+glUnmapBufferOES(GLenum target)
+{
+    CONTEXT_EXEC_RETURN(UnmapBufferOES(target));
+}
+
+void GL_APIENTRY
+glGetBufferPointervOES(GLenum target, GLenum pname, void **params)
+{
+    CONTEXT_EXEC(GetBufferPointervOES(target, pname, params));
+}
+
+void * GL_APIENTRY
+glMapBufferRangeEXT(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access)
+{
+    CONTEXT_EXEC_RETURN(MapBufferRangeEXT(target, offset, length, access));
+}
+
+void GL_APIENTRY
+glFlushMappedBufferRangeEXT(GLenum target, GLintptr offset, GLsizeiptr length)
+{
+    CONTEXT_EXEC(FlushMappedBufferRangeEXT(target, offset, length));
+}
+
 void GL_APIENTRY
 glInsertEventMarkerEXT(GLsizei length, const GLchar *marker)
 {
@@ -176,6 +176,18 @@ GL_FUNC_PTR(glViewport)
 ,GL_FUNC_PTR(glEGLImageTargetTexture2DOES),
 GL_FUNC_PTR(glEGLImageTargetRenderbufferStorageOES)
 #endif // GL_OES_EGL_image
+#ifdef GL_EXT_discard_framebuffer
+,GL_FUNC_PTR(glDiscardFramebufferEXT)
+#endif // GL_EXT_discard_framebuffer
+#ifdef GL_OES_mapbuffer
+,GL_FUNC_PTR(glMapBufferOES),
+GL_FUNC_PTR(glUnmapBufferOES),
+GL_FUNC_PTR(glGetBufferPointervOES)
+#endif // GL_OES_mapbuffer
+#ifdef GL_EXT_map_buffer_range
+,GL_FUNC_PTR(glMapBufferRangeEXT),
+GL_FUNC_PTR(glFlushMappedBufferRangeEXT)
+#endif // GL_EXT_map_buffer_range
 #ifdef GL_EXT_debug_marker
 ,GL_FUNC_PTR(glInsertEventMarkerEXT),
 GL_FUNC_PTR(glPushGroupMarkerEXT),
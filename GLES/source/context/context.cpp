@@ -24,7 +24,9 @@
 #include "context.h"
 #include "utils/VkToGlConverter.h"
 
-static Context *currentContext = nullptr;
+/// Each thread has its own current context. Reading it is a single TLS load,
+/// so the GL entry points stay lock-free.
+static thread_local Context *currentContext = nullptr;
 
 Context *GetCurrentContext()
 {
@@ -40,15 +42,15 @@ void SetCurrentContext(Context *ctx)
     currentContext = ctx;
 }
 
-Context::Context()
+Context::Context(const Context *shareContext)
 {
     FUN_ENTRY(GL_LOG_TRACE);
 
     mVkContext            = vulkanAPI::GetContext();
     mCommandBufferManager = new vulkanAPI::CommandBufferManager(mVkContext);
 
-    mResourceManager = new ResourceManager(mVkContext);
-    mShaderCompiler  = new GlslangShaderCompiler();
+    mResourceManager = new ResourceManager(mVkContext, shareContext ? shareContext->mResourceManager->GetShareGroup() : nullptr);
+    mResourceManager->SetCommandBufferManager(mCommandBufferManager);
     mPipeline        = new vulkanAPI::Pipeline(mVkContext);
     mCacheManager    = new CacheManager(mVkContext);
 
@@ -63,6 +65,10 @@ Context::Context()
     mReadSurface  = nullptr;
     mWriteFBO     = nullptr;
     mSystemFBO    = nullptr;
+    mSystemFBOGeneration = 0;
+    for(uint32_t i = 0; i < GLOVE_MAX_FRAMES_IN_FLIGHT; ++i) {
+        mFrameSubmitSerials[i] = 0;
+    }
 
     //If VK_KHR_maintenance1 is supported, then there is no need to invert the Y
     mIsYInverted        = !(vulkanAPI::GetContext()->mIsMaintenanceExtSupported);
@@ -79,11 +85,8 @@ Context::~Context()
 
     ReleaseSystemFBO();
 
-    if(mShaderCompiler != nullptr) {
-        delete mShaderCompiler;
-        mShaderCompiler = nullptr;
-    }
-
+    // buffers the vertex attributes retire on destruction are freed along with the cache manager,
+    // the wait in ReleaseSystemFBO() made sure no submission of this context still uses them
     delete mResourceManager;
     delete mCacheManager;
 
@@ -105,6 +108,16 @@ Context::ReleaseSystemFBO(void)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
+    // frames are no longer waited for on eglSwapBuffers, so the GPU may still be using the
+    // system images. Submit what other framebuffers have recorded and wait for everything.
+    if(mCommandBufferManager) {
+        if(mCommandBufferManager->IsVkDrawCommandBufferRecording()) {
+            mCommandBufferManager->EndVkDrawCommandBuffer();
+            mCommandBufferManager->SubmitVkDrawCommandBuffer();
+        }
+        mCommandBufferManager->WaitLastSubmition();
+    }
+
     for(uint32_t i = 0; i < mSystemTextures.size(); ++i) {
         if(mSystemTextures[i] != nullptr) {
             delete mSystemTextures[i];
@@ -117,16 +130,17 @@ Context::ReleaseSystemFBO(void)
     }
     mSystemFBOMap.clear();
 
+    // the command buffers are idle after the wait above and can be recorded again as they are
     mCacheManager->CleanUpCaches();
 
-    if(mCommandBufferManager) {
-        mCommandBufferManager->DestroyVkCmdBuffers();
-        mCommandBufferManager->AllocateVkCmdBuffers();
+    // a bound framebuffer object outlives the surfaces
+    if(mWriteFBO == mSystemFBO) {
+        mWriteFBO = nullptr;
     }
-
     mReadSurface = nullptr;
     mWriteSurface = nullptr;
-    mWriteFBO = nullptr;
+    mSystemFBO = nullptr;
+    ++mSystemFBOGeneration;
 }
 
 void
@@ -145,13 +159,13 @@ Context::CreateFBOFromEGLSurface(EGLSurfaceInterface *eglSurfaceInterface)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    // TODO: Pbuffer/pixmaps are not properly supported
-    assert(eglSurfaceInterface->type == EGL_WINDOW_BIT);
+    // TODO: Pixmaps are not supported
+    assert(eglSurfaceInterface->type == EGL_WINDOW_BIT || eglSurfaceInterface->type == EGL_PBUFFER_BIT);
 
     Framebuffer *fbo = InitializeFrameBuffer(eglSurfaceInterface);
+    fbo->SetSurfaceType(eglSurfaceInterface->type == EGL_PBUFFER_BIT ? GLOVE_SURFACE_PBUFFER : GLOVE_SURFACE_WINDOW);
     fbo->CreateVkRenderPass(false, false, false, true, true, false);
     fbo->Create();
-    fbo->SetSurfaceType(GLOVE_SURFACE_WINDOW);
 
     return fbo;
 }
@@ -164,6 +178,12 @@ Context::InitializeFrameBuffer(EGLSurfaceInterface *eglSurfaceInterface)
     VkImage *vkImages = static_cast<VkImage *>(eglSurfaceInterface->images);
     Framebuffer *fbo = new Framebuffer(mVkContext);
 
+    // pbuffer images are also sampled through eglBindTexImage and read back directly
+    VkImageUsageFlags usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+    if(eglSurfaceInterface->type == EGL_PBUFFER_BIT) {
+        usage |= VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+    }
+
     // color images
     for(uint32_t i = 0; i < eglSurfaceInterface->imageCount; ++i) {
         Texture *tex = new Texture(mVkContext);
@@ -182,7 +202,7 @@ Context::InitializeFrameBuffer(EGLSurfaceInterface *eglSurfaceInterface)
         tex->SetExplicitType(glType);
 
         tex->SetVkFormat(surfaceColorFormat);
-        tex->SetVkImageUsage(static_cast<VkImageUsageFlagBits>(VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT));
+        tex->SetVkImageUsage(static_cast<VkImageUsageFlagBits>(usage));
         tex->SetVkImageTiling();
         tex->SetVkImageTarget(vulkanAPI::Image::VK_IMAGE_TARGET_2D);
         tex->SetVkImage(vkImages[i]);
@@ -209,7 +229,7 @@ Context::CreateDepthStencil(EGLSurfaceInterface *eglSurfaceInterface)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    VkFormat depthStencilFormat = FindSupportedDepthStencilFormat(mVkContext->vkGpus[0], eglSurfaceInterface->depthSize, eglSurfaceInterface->stencilSize);
+    VkFormat depthStencilFormat = FindSupportedDepthStencilFormat(mVkContext->vkGpu, eglSurfaceInterface->depthSize, eglSurfaceInterface->stencilSize);
 
     if(depthStencilFormat == VK_FORMAT_UNDEFINED) {
         return nullptr;
@@ -270,6 +290,25 @@ Context::SetReadWriteSurfaces(EGLSurfaceInterface *eglReadSurfaceInterface, EGLS
 {
     FUN_ENTRY(GL_LOG_TRACE);
 
+    // the default framebuffer follows the surfaces, framebuffer objects stay bound
+    const bool defaultFramebufferActive = mWriteFBO == nullptr || mWriteFBO == mSystemFBO;
+
+    // EGL_KHR_surfaceless_context: without surfaces there is no default framebuffer
+    if(eglWriteSurfaceInterface == nullptr) {
+        if(mSystemFBO && mSystemFBO == mWriteFBO && mWriteFBO->IsInDrawState()) {
+            EndRendering();
+            mWriteFBO->SetStateIdle();
+        }
+
+        mWriteSurface = nullptr;
+        mReadSurface  = nullptr;
+        mSystemFBO    = nullptr;
+        if(defaultFramebufferActive) {
+            mWriteFBO = nullptr;
+        }
+        return;
+    }
+
     // TODO:: TBD as we do not take into account read surface!
     if(mWriteSurface && mWriteSurface == eglWriteSurfaceInterface->surface) {
         return;
@@ -277,6 +316,7 @@ Context::SetReadWriteSurfaces(EGLSurfaceInterface *eglReadSurfaceInterface, EGLS
 
     FRAMEBUFFER_SURFACES_PAIR readWritePair = {eglReadSurfaceInterface, eglWriteSurfaceInterface};
 
+    Framebuffer *systemFBO = nullptr;
     auto fboIter = mSystemFBOMap.find(readWritePair);
     if(fboIter != mSystemFBOMap.end()) {
         mWriteSurface = fboIter->first.first;
@@ -284,24 +324,84 @@ Context::SetReadWriteSurfaces(EGLSurfaceInterface *eglReadSurfaceInterface, EGLS
 
         // if surface has been invalidated, recreate the FBO (e.g., resized on another context)
         bool surfaceUpdated =
-                (eglWriteSurfaceInterface->width != static_cast<uint32_t>(mWriteFBO->GetWidth())) ||
-                (eglWriteSurfaceInterface->height != static_cast<uint32_t>(mWriteFBO->GetHeight()));
+                (eglWriteSurfaceInterface->width != static_cast<uint32_t>(fboIter->second->GetWidth())) ||
+                (eglWriteSurfaceInterface->height != static_cast<uint32_t>(fboIter->second->GetHeight()));
         if(!surfaceUpdated) {
-            mWriteFBO = fboIter->second;
+            systemFBO = fboIter->second;
         } else {
             ReleaseSystemFBO();
-            mWriteFBO = CreateFBOFromEGLSurface(eglWriteSurfaceInterface);
-            mSystemFBOMap[readWritePair] = mWriteFBO;
+            systemFBO = CreateFBOFromEGLSurface(eglWriteSurfaceInterface);
+            mSystemFBOMap[readWritePair] = systemFBO;
         }
 
     } else {
         mWriteSurface = eglWriteSurfaceInterface;
         mReadSurface  = eglReadSurfaceInterface;
-        mWriteFBO     = CreateFBOFromEGLSurface(eglWriteSurfaceInterface);
-        mSystemFBOMap[readWritePair] = mWriteFBO;
+        systemFBO     = CreateFBOFromEGLSurface(eglWriteSurfaceInterface);
+        mSystemFBOMap[readWritePair] = systemFBO;
     }
 
-    SetSystemFramebuffer(mWriteFBO);
+    if(defaultFramebufferActive) {
+        mWriteFBO = systemFBO;
+    }
+    SetSystemFramebuffer(systemFBO);
+}
+
+void
+Context::BindTexImage(EGLSurfaceInterface *eglSurfaceInterface, GLboolean bind)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    // the system framebuffer this context renders the pbuffer through, if any
+    Framebuffer *surfaceFBO = nullptr;
+    for(auto iter : mSystemFBOMap) {
+        if(iter.second->GetEGLSurfaceInterface() == eglSurfaceInterface) {
+            surfaceFBO = iter.second;
+            break;
+        }
+    }
+
+    VkImage surfaceImage = static_cast<VkImage *>(eglSurfaceInterface->images)[0];
+
+    if(!bind) {
+        if(surfaceFBO) {
+            surfaceFBO->SetBindToTexture(false);
+        }
+
+        auto texIter = mSurfaceTextures.find(eglSurfaceInterface);
+        if(texIter != mSurfaceTextures.end()) {
+            GLuint texId = texIter->second;
+            Texture *tex = !texId                                ? mResourceManager->GetDefaultTexture(GL_TEXTURE_2D) :
+                           mResourceManager->TextureExists(texId) ? mResourceManager->GetTexture(texId) : nullptr;
+
+            // the texture may have been respecified or deleted since
+            if(tex && tex->GetImage()->GetImage() == surfaceImage) {
+                tex->ReleaseSurfaceImage();
+            }
+            mSurfaceTextures.erase(texIter);
+        }
+        return;
+    }
+
+    // eglBindTexImage implicitly flushes the rendering to the pbuffer, which is then
+    // transitioned for sampling; until the release, its render passes end in that layout
+    Flush();
+    if(surfaceFBO) {
+        surfaceFBO->SetBindToTexture(true);
+        surfaceFBO->PrepareVkImage(VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    }
+
+    Texture *activeTexture = mStateManager.GetActiveObjectsState()->GetActiveTexture(GL_TEXTURE_2D);
+    GLenum   format        = eglSurfaceInterface->textureFormat == EGL_TEXTURE_RGB ? GL_RGB : GL_RGBA;
+    if(activeTexture->BindSurfaceImage(surfaceImage, static_cast<VkFormat>(eglSurfaceInterface->surfaceColorFormat), format,
+                                       eglSurfaceInterface->width, eglSurfaceInterface->height)) {
+        // a pbuffer that only another context renders to is left as a color attachment
+        if(surfaceFBO == nullptr) {
+            activeTexture->GetImage()->SetImageLayout(VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+            activeTexture->PrepareVkImageLayout(VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+        }
+        mSurfaceTextures[eglSurfaceInterface] = mResourceManager->GetTextureID(activeTexture);
+    }
 }
 
 void
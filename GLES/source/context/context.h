@@ -56,7 +56,6 @@ private:
     StateManager                                mStateManager;
     ResourceManager                            *mResourceManager;
     CacheManager                               *mCacheManager;
-    ShaderCompiler                             *mShaderCompiler;
     vulkanAPI::Pipeline                        *mPipeline;
     ScreenSpacePass                            *mScreenSpacePass;
     vulkanAPI::CommandBufferManager            *mCommandBufferManager;
@@ -70,10 +69,15 @@ private:
     Framebuffer                                *mWriteFBO;
 
     Framebuffer                                *mSystemFBO;
+    /// bumped whenever the system framebuffers are released, e.g. when EGL recreates the swapchain
+    uint32_t                                    mSystemFBOGeneration;
     vector<Texture *>                           mSystemTextures;
+    uint64_t                                    mFrameSubmitSerials[GLOVE_MAX_FRAMES_IN_FLIGHT];
 
     typedef std::pair<EGLSurfaceInterface*, EGLSurfaceInterface*> FRAMEBUFFER_SURFACES_PAIR;
     std::map<FRAMEBUFFER_SURFACES_PAIR, Framebuffer*> mSystemFBOMap;
+    /// textures that sample a pbuffer through eglBindTexImage
+    std::map<EGLSurfaceInterface*, GLuint>      mSurfaceTextures;
 
 // ------------
 
@@ -85,12 +89,14 @@ private:
     Texture       *CreateDepthStencil(EGLSurfaceInterface *eglSurfaceInterface);
 
     void           PrepareRenderPass(bool clearColorEnabled, bool clearDepthEnabled, bool clearStencilEnabled);
-    void           CreateShaderCompiler(void);
     void           ClearSimple(bool clearColorEnabled, bool clearDepthEnabled, bool clearStencilEnabled);
-    void           ClearWithColorMask(bool clearColorEnabled, bool clearDepthEnabled, bool clearStencilEnabled);
+    void           ClearWithMasks(bool clearColorEnabled, bool clearDepthEnabled, bool clearStencilEnabled);
+    void           ClearAttachments(bool clearColorEnabled, bool clearDepthEnabled, bool clearStencilEnabled);
 
     void UpdateViewportState(vulkanAPI::Pipeline* pipeline);
-    void BeginRendering(bool clearColorEnabled, bool clearDepthEnabled, bool clearStencilEnabled);
+    bool AcquireSurfaceImage(void);
+    bool BeginRendering(void);
+    void EndRendering(void);
     void PushGeometry(uint32_t vertCount, uint32_t firstVertex, bool indexed, GLenum type, const void *indices);
     void UpdateVertexAttributes(uint32_t vertCount, uint32_t firstVertex);
     void UpdateIndices(uint32_t* offset, uint32_t* maxIndex, uint32_t indexCount, GLenum type, const void* indices, BufferObject* ibo);
@@ -98,6 +104,7 @@ private:
     void BindVertexBuffers(VkCommandBuffer *CmdBuffer);
     void BindIndexBuffer(VkCommandBuffer *CmdBuffer, uint32_t offset, VkIndexType type);
     void DrawGeometry(VkCommandBuffer *CmdBuffer, bool indexed, uint32_t firstVertex, uint32_t vertCount);
+    bool CreatePipeline(ShaderProgram *progPtr);
     void SetCapability(GLenum cap, GLboolean enable);
 
     void InitializeDefaultTextures(void);
@@ -105,34 +112,42 @@ private:
     void SetClearRect(void);
     bool SetPipelineProgramShaderStages(ShaderProgram *progPtr);
     void SetSystemFramebuffer(Framebuffer *FBO);
+    bool WaitPackRequests(BufferObject *bo);
 
 // Get Functions
            uint32_t         GetProgramId(const ShaderProgram *progPtr)           { FUN_ENTRY(GL_LOG_TRACE); return (progPtr)   ? mResourceManager->FindShaderProgramID(progPtr) : 0; }
            uint32_t         GetShaderId(const Shader *shaderPtr)                 { FUN_ENTRY(GL_LOG_TRACE); return (shaderPtr) ? mResourceManager->FindShaderID(shaderPtr)      : 0; }
+    inline GLenum           GetColorBufferFormat(void)                     const { FUN_ENTRY(GL_LOG_TRACE); return (mWriteFBO && mWriteFBO->GetColorAttachmentTexture())   ? mWriteFBO->GetColorAttachmentTexture()->GetInternalFormat()   : GL_INVALID_VALUE; }
+    inline GLenum           GetDepthBufferFormat(void)                     const { FUN_ENTRY(GL_LOG_TRACE); return (mWriteFBO && mWriteFBO->GetDepthAttachmentTexture())   ? mWriteFBO->GetDepthAttachmentTexture()->GetInternalFormat()   : GL_INVALID_VALUE; }
+    inline GLenum           GetStencilBufferFormat(void)                   const { FUN_ENTRY(GL_LOG_TRACE); return (mWriteFBO && mWriteFBO->GetStencilAttachmentTexture()) ? mWriteFBO->GetStencilAttachmentTexture()->GetInternalFormat() : GL_INVALID_VALUE; }
 
 // Is/Has Functions
     inline bool             IsDrawModeTriangle(GLenum mode)                const { FUN_ENTRY(GL_LOG_TRACE); return (mode == GL_TRIANGLE_STRIP || mode  == GL_TRIANGLE_FAN || mode == GL_TRIANGLES); }
+    inline bool             HasPendingDrawCommands(void)                   const { FUN_ENTRY(GL_LOG_TRACE); return (mWriteFBO && mWriteFBO->IsInDrawState()) || mCommandBufferManager->IsVkDrawCommandBufferRecording(); }
 // Other Functions
     inline void             RecordError(GLenum error)                            { FUN_ENTRY(GL_LOG_TRACE); if (mStateManager.GetError() == GL_NO_ERROR) { mStateManager.SetError(error); } }
 
 public:
-    Context();
+    /// a context created with a share context uses the objects of its share group
+    explicit Context(const Context *shareContext);
     ~Context();
 
     static void             DestroyAPISurfaceData(const vulkanAPI::vkContext_t *vkContext, EGLSurfaceInterface *eglSurfaceInterface);
 
     void                    ReleaseSystemFBO(void);
+    void                    FinishFrame(void);
 
 // Get Functions
     inline  vulkanAPI::CommandBufferManager *GetVkCommandBufferManager(void)      { FUN_ENTRY(GL_LOG_TRACE); return mCommandBufferManager; }
     inline  StateManager    *GetStateManager(void)                                { FUN_ENTRY(GL_LOG_TRACE); return &mStateManager; }
     inline  ResourceManager *GetResourceManager(void)                             { FUN_ENTRY(GL_LOG_TRACE); return mResourceManager; }
+    inline  CacheManager    *GetCacheManager(void)                                { FUN_ENTRY(GL_LOG_TRACE); return mCacheManager; }
     inline  bool            IsYInverted(void)                              const  { FUN_ENTRY(GL_LOG_TRACE); return mIsYInverted; }
     inline  bool            IsModeLineLoop(void)                           const  { FUN_ENTRY(GL_LOG_TRACE); return mIsModeLineLoop; }
 
 // Set Functions
             void            SetReadWriteSurfaces(EGLSurfaceInterface *eglReadSurfaceInterface, EGLSurfaceInterface *eglWriteSurfaceInterface);
-    inline  void            BindToTexture(GLuint bind)                            { FUN_ENTRY(GL_LOG_DEBUG); mSystemFBO->SetBindToTexture(bind); }
+            void            BindTexImage(EGLSurfaceInterface *eglSurfaceInterface, GLboolean bind);
 
     inline  bool            HasShaderCompiler(void);
 
@@ -283,6 +298,12 @@ public:
 // GL API extension functions
     void            EGLImageTargetTexture2DOES(GLenum target, GLeglImageOES image);
     void            EGLImageTargetRenderBufferStorageOES(GLenum target, GLeglImageOES image);
+    void            DiscardFramebufferEXT(GLenum target, GLsizei numAttachments, const GLenum *attachments);
+    void*           MapBufferOES(GLenum target, GLenum access);
+    GLboolean       UnmapBufferOES(GLenum target);
+    void            GetBufferPointervOES(GLenum target, GLenum pname, void **params);
+    void*           MapBufferRangeEXT(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access);
+    void            FlushMappedBufferRangeEXT(GLenum target, GLintptr offset, GLsizeiptr length);
     void            InsertEventMarkerEXT(GLsizei length, const GLchar *marker);
     void            PushGroupMarkerEXT(GLsizei length, const GLchar *marker);
     void            PopGroupMarkerEXT(void);
@@ -28,7 +28,7 @@ Context::BindBuffer(GLenum target, GLuint buffer)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    if(target != GL_ARRAY_BUFFER && target != GL_ELEMENT_ARRAY_BUFFER) {
+    if(target != GL_ARRAY_BUFFER && target != GL_ELEMENT_ARRAY_BUFFER && target != GL_PIXEL_PACK_BUFFER_NV) {
         RecordError(GL_INVALID_ENUM);
         return;
     }
@@ -36,6 +36,11 @@ Context::BindBuffer(GLenum target, GLuint buffer)
     BufferObject *bo = nullptr;
     if(buffer) {
         bo = mResourceManager->GetBuffer(buffer);
+        // a new target reallocates the data store, which resolves any pending glReadPixels
+        if(bo->GetTarget() != target && !WaitPackRequests(bo)) {
+            RecordError(GL_OUT_OF_MEMORY);
+            return;
+        }
         bo->SetTarget(target);
         bo->SetVkContext(mVkContext);
         bo->Bind();
@@ -54,12 +59,29 @@ Context::BindBuffer(GLenum target, GLuint buffer)
     }
 }
 
+bool
+Context::WaitPackRequests(BufferObject *bo)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    if(!bo->HasPackRequests()) {
+        return true;
+    }
+
+    // the copies may still be recorded, or submitted but not yet executed
+    if(bo->GetPackSerial() > mCommandBufferManager->GetLastSubmitSerial() && !Flush()) {
+        return false;
+    }
+
+    return mCommandBufferManager->WaitSubmission(bo->GetPackSerial());
+}
+
 void
 Context::BufferData(GLenum target, GLsizeiptr size, const void *data, GLenum usage)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    if(target != GL_ARRAY_BUFFER && target != GL_ELEMENT_ARRAY_BUFFER) {
+    if(target != GL_ARRAY_BUFFER && target != GL_ELEMENT_ARRAY_BUFFER && target != GL_PIXEL_PACK_BUFFER_NV) {
         RecordError(GL_INVALID_ENUM);
         return;
     }
@@ -80,6 +102,13 @@ Context::BufferData(GLenum target, GLsizeiptr size, const void *data, GLenum usa
         return;
     }
 
+    // a pending glReadPixels may still be writing into the old data store
+    if(!WaitPackRequests(bo)) {
+        RecordError(GL_OUT_OF_MEMORY);
+        return;
+    }
+
+    bo->Unmap();
     bo->SetUsage(usage);
     if((data && bo->HasData()) || (data == nullptr && bo->GetSize() && (size_t)size != bo->GetSize())) {
         bo->Release();
@@ -100,7 +129,7 @@ Context::BufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const vo
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    if(target != GL_ARRAY_BUFFER && target != GL_ELEMENT_ARRAY_BUFFER) {
+    if(target != GL_ARRAY_BUFFER && target != GL_ELEMENT_ARRAY_BUFFER && target != GL_PIXEL_PACK_BUFFER_NV) {
         RecordError(GL_INVALID_ENUM);
         return;
     }
@@ -116,6 +145,18 @@ Context::BufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const vo
         return;
     }
 
+    if(bo->IsMapped()) {
+        RecordError(GL_INVALID_OPERATION);
+        return;
+    }
+
+    // resolve any pending glReadPixels first, so that they do not overwrite the new data later
+    if(!WaitPackRequests(bo)) {
+        RecordError(GL_OUT_OF_MEMORY);
+        return;
+    }
+    bo->ResolvePackRequests();
+
     bo->UpdateData(size, offset, data);
 
     if(target == GL_ELEMENT_ARRAY_BUFFER || bo->IsIndexBuffer()) {
@@ -137,7 +178,7 @@ Context::DeleteBuffers(GLsizei n, const GLuint* buffers)
         return;
     }
 
-    if(mWriteFBO->IsInDrawState()) {
+    if(HasPendingDrawCommands()) {
         Finish();
     }
 
@@ -164,12 +205,12 @@ Context::GetBufferParameteriv(GLenum target, GLenum pname, GLint* params)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    if(target != GL_ARRAY_BUFFER && target != GL_ELEMENT_ARRAY_BUFFER) {
+    if(target != GL_ARRAY_BUFFER && target != GL_ELEMENT_ARRAY_BUFFER && target != GL_PIXEL_PACK_BUFFER_NV) {
         RecordError(GL_INVALID_ENUM);
         return;
     }
 
-    if(pname != GL_BUFFER_SIZE && pname != GL_BUFFER_USAGE) {
+    if(pname != GL_BUFFER_SIZE && pname != GL_BUFFER_USAGE && pname != GL_BUFFER_ACCESS_OES && pname != GL_BUFFER_MAPPED_OES) {
         RecordError(GL_INVALID_ENUM);
         return;
     }
@@ -181,8 +222,10 @@ Context::GetBufferParameteriv(GLenum target, GLenum pname, GLint* params)
     }
 
     switch(pname) {
-    case GL_BUFFER_SIZE:  *params = static_cast<GLint>(bo->GetSize());  break;
-    case GL_BUFFER_USAGE: *params = static_cast<GLint>(bo->GetUsage()); break;
+    case GL_BUFFER_SIZE:       *params = static_cast<GLint>(bo->GetSize());  break;
+    case GL_BUFFER_USAGE:      *params = static_cast<GLint>(bo->GetUsage()); break;
+    case GL_BUFFER_ACCESS_OES: *params = GL_WRITE_ONLY_OES;                  break;
+    case GL_BUFFER_MAPPED_OES: *params = bo->IsMapped() ? GL_TRUE : GL_FALSE; break;
     }
 }
 
@@ -213,3 +256,150 @@ Context::IsBuffer(GLuint buffer)
 
     return (buffer != 0 && mResourceManager->BufferExists(buffer)) ? GL_TRUE : GL_FALSE;
 }
+
+void *
+Context::MapBufferOES(GLenum target, GLenum access)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    if(target != GL_ARRAY_BUFFER && target != GL_ELEMENT_ARRAY_BUFFER && target != GL_PIXEL_PACK_BUFFER_NV) {
+        RecordError(GL_INVALID_ENUM);
+        return nullptr;
+    }
+
+    if(access != GL_WRITE_ONLY_OES) {
+        RecordError(GL_INVALID_ENUM);
+        return nullptr;
+    }
+
+    BufferObject *bo = mStateManager.GetActiveObjectsState()->GetActiveBufferObject(target);
+    return MapBufferRangeEXT(target, 0, bo ? bo->GetSize() : 0, GL_MAP_WRITE_BIT_EXT);
+}
+
+GLboolean
+Context::UnmapBufferOES(GLenum target)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    if(target != GL_ARRAY_BUFFER && target != GL_ELEMENT_ARRAY_BUFFER && target != GL_PIXEL_PACK_BUFFER_NV) {
+        RecordError(GL_INVALID_ENUM);
+        return GL_FALSE;
+    }
+
+    BufferObject *bo = mStateManager.GetActiveObjectsState()->GetActiveBufferObject(target);
+    if(!bo || !bo->Unmap()) {
+        RecordError(GL_INVALID_OPERATION);
+        return GL_FALSE;
+    }
+
+    if(target == GL_ELEMENT_ARRAY_BUFFER || bo->IsIndexBuffer()) {
+        mPipeline->SetUpdateIndexBuffer(true);
+    }
+
+    return GL_TRUE;
+}
+
+void
+Context::GetBufferPointervOES(GLenum target, GLenum pname, void **params)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    if(target != GL_ARRAY_BUFFER && target != GL_ELEMENT_ARRAY_BUFFER && target != GL_PIXEL_PACK_BUFFER_NV) {
+        RecordError(GL_INVALID_ENUM);
+        return;
+    }
+
+    if(pname != GL_BUFFER_MAP_POINTER_OES) {
+        RecordError(GL_INVALID_ENUM);
+        return;
+    }
+
+    BufferObject *bo = mStateManager.GetActiveObjectsState()->GetActiveBufferObject(target);
+    if(!bo) {
+        RecordError(GL_INVALID_OPERATION);
+        return;
+    }
+
+    *params = bo->GetMapPointer();
+}
+
+void *
+Context::MapBufferRangeEXT(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    if(target != GL_ARRAY_BUFFER && target != GL_ELEMENT_ARRAY_BUFFER && target != GL_PIXEL_PACK_BUFFER_NV) {
+        RecordError(GL_INVALID_ENUM);
+        return nullptr;
+    }
+
+    const GLbitfield validAccess = GL_MAP_READ_BIT_EXT              | GL_MAP_WRITE_BIT_EXT             |
+                                   GL_MAP_INVALIDATE_RANGE_BIT_EXT  | GL_MAP_INVALIDATE_BUFFER_BIT_EXT |
+                                   GL_MAP_FLUSH_EXPLICIT_BIT_EXT    | GL_MAP_UNSYNCHRONIZED_BIT_EXT;
+
+    if(offset < 0 || length <= 0 || (access & ~validAccess)) {
+        RecordError(GL_INVALID_VALUE);
+        return nullptr;
+    }
+
+    BufferObject *bo = mStateManager.GetActiveObjectsState()->GetActiveBufferObject(target);
+    if(!bo || !bo->HasData() || bo->IsMapped()) {
+        RecordError(GL_INVALID_OPERATION);
+        return nullptr;
+    }
+
+    if(static_cast<size_t>(offset + length) > bo->GetSize()) {
+        RecordError(GL_INVALID_VALUE);
+        return nullptr;
+    }
+
+    if(!(access & (GL_MAP_READ_BIT_EXT | GL_MAP_WRITE_BIT_EXT))                                        ||
+       ((access & GL_MAP_READ_BIT_EXT) &&
+        (access & (GL_MAP_INVALIDATE_RANGE_BIT_EXT | GL_MAP_INVALIDATE_BUFFER_BIT_EXT | GL_MAP_UNSYNCHRONIZED_BIT_EXT))) ||
+       ((access & GL_MAP_FLUSH_EXPLICIT_BIT_EXT) && !(access & GL_MAP_WRITE_BIT_EXT))) {
+        RecordError(GL_INVALID_OPERATION);
+        return nullptr;
+    }
+
+    // wait for the GPU unless the application takes over synchronization; pending
+    // glReadPixels always have to land before their pixels can be converted
+    if(!(access & GL_MAP_UNSYNCHRONIZED_BIT_EXT) || bo->HasPackRequests()) {
+        Finish();
+    }
+
+    void *ptr = bo->Map(offset, length, access);
+    if(!ptr) {
+        RecordError(GL_OUT_OF_MEMORY);
+    }
+
+    return ptr;
+}
+
+void
+Context::FlushMappedBufferRangeEXT(GLenum target, GLintptr offset, GLsizeiptr length)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    if(target != GL_ARRAY_BUFFER && target != GL_ELEMENT_ARRAY_BUFFER && target != GL_PIXEL_PACK_BUFFER_NV) {
+        RecordError(GL_INVALID_ENUM);
+        return;
+    }
+
+    if(offset < 0 || length < 0) {
+        RecordError(GL_INVALID_VALUE);
+        return;
+    }
+
+    BufferObject *bo = mStateManager.GetActiveObjectsState()->GetActiveBufferObject(target);
+    if(!bo || !bo->IsMapped() || !(bo->GetMapAccess() & GL_MAP_FLUSH_EXPLICIT_BIT_EXT)) {
+        RecordError(GL_INVALID_OPERATION);
+        return;
+    }
+
+    if(static_cast<size_t>(offset + length) > bo->GetMapLength()) {
+        RecordError(GL_INVALID_VALUE);
+        return;
+    }
+
+    // buffer memory is host coherent, the written range is already visible to the device
+}
@@ -47,12 +47,18 @@ Context::BindFramebuffer(GLenum target, GLuint framebuffer)
         return;
     }
 
-    if(mWriteFBO->IsInDrawState()) {
-        Finish();
+    // close the current pass and keep recording into the same command buffer; the render pass
+    // dependencies order the next pass after it if it samples one of the attachments
+    if(mWriteFBO && mWriteFBO->IsInDrawState()) {
+        EndRendering();
+        mWriteFBO->SetStateIdle();
     }
 
+    // the default framebuffer does not exist while no surface is current
     mWriteFBO = fbo;
-    mWriteFBO->SetStateIdle();
+    if(mWriteFBO) {
+        mWriteFBO->SetStateIdle();
+    }
 
     mStateManager.GetActiveObjectsState()->SetActiveFramebufferObjectID(framebuffer);
     mPipeline->SetUpdatePipeline(true);
@@ -69,9 +75,11 @@ Context::CheckFramebufferStatus(GLenum target)
         return 0;
     }
 
-    return (mStateManager.GetActiveObjectsState()->IsDefaultFramebufferObjectActive()) ?
-            GL_FRAMEBUFFER_COMPLETE :
-            mResourceManager->GetFramebuffer(mStateManager.GetActiveObjectsState()->GetActiveFramebufferObjectID())->CheckStatus();
+    if(mStateManager.GetActiveObjectsState()->IsDefaultFramebufferObjectActive()) {
+        return mSystemFBO ? GL_FRAMEBUFFER_COMPLETE : GL_FRAMEBUFFER_UNDEFINED_OES;
+    }
+
+    return mResourceManager->GetFramebuffer(mStateManager.GetActiveObjectsState()->GetActiveFramebufferObjectID())->CheckStatus();
 }
 
 void
@@ -99,14 +107,16 @@ Context::DeleteFramebuffers(GLsizei n, const GLuint* framebuffers)
             fbo->UnrefAttachment(GL_DEPTH_ATTACHMENT);
             fbo->UnrefAttachment(GL_STENCIL_ATTACHMENT);
 
-            if(mWriteFBO == fbo) {
-
-                if(mWriteFBO->IsInDrawState()) {
-                    Finish();
-                }
+            // the framebuffer may be used by passes that are not submitted yet
+            if(HasPendingDrawCommands()) {
+                Finish();
+            }
 
+            if(mWriteFBO == fbo) {
                 mWriteFBO = mSystemFBO;
-                mWriteFBO->SetStateIdle();
+                if(mWriteFBO) {
+                    mWriteFBO->SetStateIdle();
+                }
 
                 mStateManager.GetActiveObjectsState()->SetActiveFramebufferObjectID(0);
                 mPipeline->SetUpdatePipeline(true);
@@ -119,6 +129,49 @@ Context::DeleteFramebuffers(GLsizei n, const GLuint* framebuffers)
     mResourceManager->CleanPurgeList();
 }
 
+void
+Context::DiscardFramebufferEXT(GLenum target, GLsizei numAttachments, const GLenum *attachments)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    if(target != GL_FRAMEBUFFER) {
+        RecordError(GL_INVALID_ENUM);
+        return;
+    }
+
+    if(numAttachments < 0) {
+        RecordError(GL_INVALID_VALUE);
+        return;
+    }
+
+    if(attachments == nullptr) {
+        return;
+    }
+
+    // the default framebuffer is addressed with GL_COLOR_EXT/GL_DEPTH_EXT/GL_STENCIL_EXT,
+    // framebuffer objects with their attachment points
+    const bool isDefault = mStateManager.GetActiveObjectsState()->IsDefaultFramebufferObjectActive();
+
+    bool discardColor   = false;
+    bool discardDepth   = false;
+    bool discardStencil = false;
+    for(GLsizei i = 0; i < numAttachments; ++i) {
+        switch(attachments[i]) {
+        case GL_COLOR_EXT:              if(!isDefault) { RecordError(GL_INVALID_ENUM); return; } discardColor   = true; break;
+        case GL_DEPTH_EXT:              if(!isDefault) { RecordError(GL_INVALID_ENUM); return; } discardDepth   = true; break;
+        case GL_STENCIL_EXT:            if(!isDefault) { RecordError(GL_INVALID_ENUM); return; } discardStencil = true; break;
+        case GL_COLOR_ATTACHMENT0:      if( isDefault) { RecordError(GL_INVALID_ENUM); return; } discardColor   = true; break;
+        case GL_DEPTH_ATTACHMENT:       if( isDefault) { RecordError(GL_INVALID_ENUM); return; } discardDepth   = true; break;
+        case GL_STENCIL_ATTACHMENT:     if( isDefault) { RecordError(GL_INVALID_ENUM); return; } discardStencil = true; break;
+        default:                        RecordError(GL_INVALID_ENUM); return;
+        }
+    }
+
+    if(mWriteFBO) {
+        mWriteFBO->Discard(discardColor, discardDepth, discardStencil);
+    }
+}
+
 void
 Context::FramebufferRenderbuffer(GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer)
 {
@@ -221,6 +274,12 @@ Context::FramebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget
         Finish();
     }
 
+    // a sample-only texture is reallocated in a renderable format before it is attached
+    if(attachment == GL_COLOR_ATTACHMENT0 && texture && !mResourceManager->GetTexture(texture)->EnableColorAttachment(mCacheManager)) {
+        RecordError(GL_OUT_OF_MEMORY);
+        return;
+    }
+
     mWriteFBO->UnrefAttachment(attachment);
     //If there is a texture attached to this framebuffer that has been deleted
     mWriteFBO->CleanCachedAttachment(attachment);
@@ -75,13 +75,11 @@ Context::DeleteRenderbuffers(GLsizei n, const GLuint *renderbuffers)
 
         if(index && mResourceManager->RenderbufferExists(index)) {
 
-            if( mWriteFBO != mSystemFBO &&
-               ((index == mWriteFBO->GetColorAttachmentName() && GL_RENDERBUFFER == mWriteFBO->GetColorAttachmentType())    ||
-                (index == mWriteFBO->GetDepthAttachmentName() && GL_RENDERBUFFER == mWriteFBO->GetDepthAttachmentType())    ||
-                (index == mWriteFBO->GetStencilAttachmentName() && GL_RENDERBUFFER == mWriteFBO->GetStencilAttachmentType())) &&
-                mWriteFBO->IsInDrawState()) {
+            // the renderbuffer may also be used by passes of other framebuffers that are not submitted yet
+            if(HasPendingDrawCommands()) {
 
-                if(index == mWriteFBO->GetColorAttachmentName() && GL_RENDERBUFFER == mWriteFBO->GetColorAttachmentType()) {
+                if(mWriteFBO != mSystemFBO &&
+                   index == mWriteFBO->GetColorAttachmentName() && GL_RENDERBUFFER == mWriteFBO->GetColorAttachmentType()) {
                     mWriteFBO->SetStateDelete();
                 }
 
@@ -90,20 +88,20 @@ Context::DeleteRenderbuffers(GLsizei n, const GLuint *renderbuffers)
 
             //Check if the renderbuffer is attached to the mWriteFBO
             Renderbuffer *rendbuff = mResourceManager->GetRenderbuffer(index);
-            if(index == mWriteFBO->GetColorAttachmentName() && GL_RENDERBUFFER == mWriteFBO->GetColorAttachmentType()) {
+            if(mWriteFBO && index == mWriteFBO->GetColorAttachmentName() && GL_RENDERBUFFER == mWriteFBO->GetColorAttachmentType()) {
                 mWriteFBO->SetColorAttachment(-1,-1);
                 mWriteFBO->SetColorAttachmentType(GL_NONE);
                 mWriteFBO->SetColorAttachmentName(0);
                 rendbuff->Unbind();
             }
 
-            if(index == mWriteFBO->GetDepthAttachmentName() && GL_RENDERBUFFER == mWriteFBO->GetDepthAttachmentType()) {
+            if(mWriteFBO && index == mWriteFBO->GetDepthAttachmentName() && GL_RENDERBUFFER == mWriteFBO->GetDepthAttachmentType()) {
                 mWriteFBO->SetDepthAttachmentType(GL_NONE);
                 mWriteFBO->SetDepthAttachmentName(0);
                 rendbuff->Unbind();
             }
 
-            if(index == mWriteFBO->GetStencilAttachmentName() && GL_RENDERBUFFER == mWriteFBO->GetStencilAttachmentType()) {
+            if(mWriteFBO && index == mWriteFBO->GetStencilAttachmentName() && GL_RENDERBUFFER == mWriteFBO->GetStencilAttachmentType()) {
                 mWriteFBO->SetStencilAttachmentType(GL_NONE);
                 mWriteFBO->SetStencilAttachmentName(0);
                 rendbuff->Unbind();
@@ -220,15 +218,13 @@ Context::RenderbufferStorage(GLenum target, GLenum internalformat, GLsizei width
         return;
     }
 
-    if(((activeRenderbufferId == mWriteFBO->GetColorAttachmentName()   && GL_RENDERBUFFER == mWriteFBO->GetColorAttachmentType())    ||
-        (activeRenderbufferId == mWriteFBO->GetDepthAttachmentName()   && GL_RENDERBUFFER == mWriteFBO->GetDepthAttachmentType())    ||
-        (activeRenderbufferId == mWriteFBO->GetStencilAttachmentName() && GL_RENDERBUFFER == mWriteFBO->GetStencilAttachmentType())) &&
-        mWriteFBO->IsInDrawState()) {
+    // the renderbuffer may also be used by passes of other framebuffers that are not submitted yet
+    if(HasPendingDrawCommands()) {
         Finish();
     }
 
     Renderbuffer* activeRenderbuffer = mResourceManager->GetRenderbuffer(activeRenderbufferId);
-    if(!activeRenderbuffer->Allocate(width, height, internalformat)) {
+    if(!activeRenderbuffer->Allocate(width, height, internalformat, mCacheManager)) {
         RecordError(GL_OUT_OF_MEMORY);
         return;
     }
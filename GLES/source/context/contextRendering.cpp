@@ -22,6 +22,7 @@
  */
 
 #include "context.h"
+#include "vulkan/pipelineStateLog.h"
 
 void
 Context::PrepareRenderPass(bool clearColorEnabled, bool clearDepthEnabled, bool clearStencilEnabled)
@@ -41,32 +42,96 @@ Context::PrepareRenderPass(bool clearColorEnabled, bool clearDepthEnabled, bool
     GLfloat clearDepthValue    = clearDepthEnabled   ? stateFramebufferOperations->GetClearDepth() : 0.0f;
     uint32_t clearStencilValue = clearStencilEnabled ? stateFramebufferOperations->GetClearStencilMasked() : 0u;
 
-    // Update stencil buffer with mask
-    if(clearStencilEnabled && stateFramebufferOperations->StencilMaskActive()) {
-        mWriteFBO->UpdateClearDepthStencilTexture(clearStencilValue, stateFramebufferOperations->GetStencilMaskFront(), mClearRect);
-        clearStencilValue = 0;
-        clearStencilEnabled = false;
-    }
+    // load ops are only used for clears of the whole framebuffer, so the render area
+    // always covers it and draws recorded later in the same pass are not clipped
+    const Rect renderArea(mWriteFBO->GetX(), mWriteFBO->GetY(), mWriteFBO->GetWidth(), mWriteFBO->GetHeight());
 
-    // perform a screen-space pass
     mWriteFBO->CreateRenderPass(clearColorEnabled, clearDepthEnabled, clearStencilEnabled,
                                 stateFramebufferOperations->IsColorWriteEnabled(),
                                 stateFramebufferOperations->IsDepthWriteEnabled(),
                                 stateFramebufferOperations->IsStencilWriteEnabled(),
                                  clearColorValue, clearDepthValue, clearStencilValue,
-                                 &mClearRect);
-    mWriteFBO->PrepareVkImage(VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
-    mWriteFBO->PrepareVkImage(VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+                                 &renderArea);
 }
 
-void
-Context::BeginRendering(bool clearColorEnabled, bool clearDepthEnabled, bool clearStencilEnabled)
+bool
+Context::AcquireSurfaceImage(void)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    PrepareRenderPass(clearColorEnabled, clearDepthEnabled, clearStencilEnabled);
-    mCommandBufferManager->BeginVkDrawCommandBuffer();
-    mWriteFBO->BeginVkRenderPass();
+    if(mSystemFBO == nullptr || mWriteSurface == nullptr || mWriteSurface->acquireNextImageCb == nullptr) {
+        return true;
+    }
+
+    // the commands recorded from here on use the swapchain image, so their submission
+    // synchronizes with its acquire and presentation
+    mCommandBufferManager->SetSurfaceSyncItems(mWriteSurface->syncItems);
+
+    if(mWriteSurface->imageAcquired) {
+        return true;
+    }
+
+    // the semaphores of this frame slot were last used frameCount frames ago,
+    // that frame has to be done before they are reused
+    const vkSyncItems_t *syncItems = mWriteSurface->syncItems;
+    mCommandBufferManager->WaitSubmission(mFrameSubmitSerials[syncItems->frameIndex]);
+
+    // a lost swapchain is recreated by EGL, which also replaces the system framebuffer
+    // and with it a clear deferred into its load ops, so the clear is deferred again
+    const uint32_t generation = mSystemFBOGeneration;
+    const bool clearPending   = mSystemFBO->IsInClearState();
+    const bool clearColor     = clearPending && mSystemFBO->GetRenderPass()->GetColorClearEnabled();
+    const bool clearDepth     = clearPending && mSystemFBO->GetRenderPass()->GetDepthClearEnabled();
+    const bool clearStencil   = clearPending && mSystemFBO->GetRenderPass()->GetStencilClearEnabled();
+
+    // EGL has recorded why the image could not be acquired
+    if(mWriteSurface->acquireNextImageCb(mWriteSurface) == EGL_FALSE) {
+        return false;
+    }
+
+    if(clearPending && mSystemFBOGeneration != generation && mWriteFBO != nullptr && mWriteFBO == mSystemFBO) {
+        mWriteFBO->SetStateClear();
+        PrepareRenderPass(clearColor, clearDepth, clearStencil);
+    }
+
+    return true;
+}
+
+bool
+Context::BeginRendering(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    // the swapchain image is acquired only when the frame first renders to it
+    if(mWriteFBO == mSystemFBO && !AcquireSurfaceImage()) {
+        RecordError(GL_OUT_OF_MEMORY);
+        return false;
+    }
+
+    if(!mWriteFBO->IsVkRenderPassStarted()) {
+        // a deferred glClear has already prepared a render pass with CLEAR load ops
+        if(!mWriteFBO->IsInClearState()) {
+            PrepareRenderPass(false, false, false);
+        }
+        mCommandBufferManager->BeginVkDrawCommandBuffer();
+        mWriteFBO->BeginVkRenderPass();
+    }
+
+    // only the attachments a pending clear or the write masks let the next commands write have to be stored again
+    StateFramebufferOperations *stateFramebufferOperations = mStateManager.GetFramebufferOperationsState();
+    const vulkanAPI::RenderPass *renderPass                = mWriteFBO->GetRenderPass();
+    const bool                   clearPending              = mWriteFBO->IsInClearState();
+    mWriteFBO->SetContentsDefined(stateFramebufferOperations->IsColorWriteEnabled()   || (clearPending && renderPass->GetColorClearEnabled()),
+                                  stateFramebufferOperations->IsDepthWriteEnabled()   || (clearPending && renderPass->GetDepthClearEnabled()),
+                                  stateFramebufferOperations->IsStencilWriteEnabled() || (clearPending && renderPass->GetStencilClearEnabled()));
+
+    if(mWriteFBO->IsInClearState()) {
+        mWriteFBO->SetStateClearDraw();
+    } else {
+        mWriteFBO->SetStateDraw();
+    }
+
+    return true;
 }
 
 void
@@ -83,14 +148,38 @@ Context::Clear(GLbitfield mask)
         return;
     }
 
+    // acquire before the clear is deferred into the load ops of the system framebuffer,
+    // a lost swapchain replaces that framebuffer
+    if(mWriteFBO == mSystemFBO && !AcquireSurfaceImage()) {
+        RecordError(GL_OUT_OF_MEMORY);
+        return;
+    }
+
+    if(CheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        RecordError(GL_INVALID_FRAMEBUFFER_OPERATION);
+        return;
+    }
+
     SetClearRect();
 
-    // color masks are executed implicitly through a screen-space pass (i.e., need an explicit VkPipeline object)
-    bool performCustomClear = (mStateManager.GetFramebufferOperationsState()->ColorMaskActive() && clearColorEnabled);
+    StateFramebufferOperations *stateFramebufferOperations = mStateManager.GetFramebufferOperationsState();
+
+    // glClear only obeys the front stencil write mask
+    const uint32_t stencilWriteMask = stateFramebufferOperations->GetStencilMaskFront() & 0xFF;
+    if(!stencilWriteMask) {
+        clearStencilEnabled = false;
+        if(!clearColorEnabled && !clearDepthEnabled) {
+            return;
+        }
+    }
+
+    // color and partial stencil masks are executed implicitly through a screen-space pass (i.e., need an explicit VkPipeline object)
+    bool performCustomClear = (stateFramebufferOperations->ColorMaskActive() && clearColorEnabled) ||
+                              (stencilWriteMask != 0xFF && clearStencilEnabled);
     if(!performCustomClear) {
         ClearSimple(clearColorEnabled, clearDepthEnabled, clearStencilEnabled);
     } else {
-        ClearWithColorMask(false, clearDepthEnabled, clearStencilEnabled);
+        ClearWithMasks(clearColorEnabled, clearDepthEnabled, clearStencilEnabled);
     }
 }
 
@@ -99,16 +188,84 @@ Context::ClearSimple(bool clearColorEnabled, bool clearDepthEnabled, bool clearS
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    if(mWriteFBO->IsInDrawState()) {
-        Finish();
+    // nothing has been recorded yet: fold the clear into the load ops of the render pass,
+    // which is begun by the first draw or flush
+    if(mWriteFBO->IsInIdleState() &&
+       mClearRect.x     == mWriteFBO->GetX()     && mClearRect.y      == mWriteFBO->GetY() &&
+       mClearRect.width == mWriteFBO->GetWidth() && mClearRect.height == mWriteFBO->GetHeight()) {
+        mWriteFBO->SetStateClear();
+        PrepareRenderPass(clearColorEnabled, clearDepthEnabled, clearStencilEnabled);
+        return;
+    }
+
+    if(!BeginRendering()) {
+        return;
+    }
+    ClearAttachments(clearColorEnabled, clearDepthEnabled, clearStencilEnabled);
+}
+
+void
+Context::ClearAttachments(bool clearColorEnabled, bool clearDepthEnabled, bool clearStencilEnabled)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    StateFramebufferOperations *stateFramebufferOperations = mStateManager.GetFramebufferOperationsState();
+
+    uint32_t          attachmentCount = 0;
+    VkClearAttachment attachments[2];
+
+    if(clearColorEnabled && mWriteFBO->GetColorAttachmentTexture() && stateFramebufferOperations->IsColorWriteEnabled()) {
+        VkClearAttachment *attachment = &attachments[attachmentCount++];
+        attachment->aspectMask      = VK_IMAGE_ASPECT_COLOR_BIT;
+        attachment->colorAttachment = 0;
+        stateFramebufferOperations->GetClearColor(attachment->clearValue.color.float32);
+        if(mWriteFBO->GetColorAttachmentTexture()->GetFormat() == GL_RGB) {
+            attachment->clearValue.color.float32[3] = 1.0f;
+        }
+    }
+
+    Texture *depthStencilTexture = mWriteFBO->GetDepthStencilAttachmentTexture();
+    if(depthStencilTexture) {
+        VkImageAspectFlags aspectMask = 0;
+        if(clearDepthEnabled && VkFormatIsDepth(depthStencilTexture->GetVkFormat()) && stateFramebufferOperations->IsDepthWriteEnabled()) {
+            aspectMask |= VK_IMAGE_ASPECT_DEPTH_BIT;
+        }
+        if(clearStencilEnabled && VkFormatIsStencil(depthStencilTexture->GetVkFormat()) && stateFramebufferOperations->IsStencilWriteEnabled()) {
+            aspectMask |= VK_IMAGE_ASPECT_STENCIL_BIT;
+        }
+
+        if(aspectMask) {
+            VkClearAttachment *attachment = &attachments[attachmentCount++];
+            attachment->aspectMask                      = aspectMask;
+            attachment->colorAttachment                 = 0;
+            attachment->clearValue.depthStencil.depth   = stateFramebufferOperations->GetClearDepth();
+            attachment->clearValue.depthStencil.stencil = stateFramebufferOperations->GetClearStencilMasked();
+        }
     }
-    mWriteFBO->SetStateClear();
 
-    BeginRendering(clearColorEnabled, clearDepthEnabled, clearStencilEnabled);
+    if(!attachmentCount) {
+        return;
+    }
+
+    VkClearRect clearRect;
+    clearRect.rect.offset.x     = mClearRect.x;
+    clearRect.rect.offset.y     = mClearRect.y;
+    clearRect.rect.extent.width = static_cast<uint32_t>(mClearRect.width);
+    clearRect.rect.extent.height= static_cast<uint32_t>(mClearRect.height);
+    clearRect.baseArrayLayer    = 0;
+    clearRect.layerCount        = 1;
+
+    // the render pass has been begun with secondary command buffer contents
+    const VkCommandBuffer *secondaryCmdBuffer = mCommandBufferManager->AllocateVkSecondaryCmdBuffers(1);
+    mCommandBufferManager->BeginVkSecondaryCommandBuffer(secondaryCmdBuffer, *mWriteFBO->GetVkRenderPass(), *mWriteFBO->GetActiveVkFramebuffer());
+    vkCmdClearAttachments(*secondaryCmdBuffer, attachmentCount, attachments, 1, &clearRect);
+    mCommandBufferManager->EndVkSecondaryCommandBuffer(secondaryCmdBuffer);
+
+    mWriteFBO->ExecuteVkCommandBuffer(secondaryCmdBuffer);
 }
 
 void
-Context::ClearWithColorMask(bool clearColorEnabled, bool clearDepthEnabled, bool clearStencilEnabled)
+Context::ClearWithMasks(bool clearColorEnabled, bool clearDepthEnabled, bool clearStencilEnabled)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
@@ -122,13 +279,22 @@ Context::ClearWithColorMask(bool clearColorEnabled, bool clearDepthEnabled, bool
         return;
     }
 
-    if(mWriteFBO->IsInClearState()) {
-        Finish();
-    }
+    StateFramebufferOperations *stateFramebufferOperations = mStateManager.GetFramebufferOperationsState();
 
-    PrepareRenderPass(clearColorEnabled, clearDepthEnabled, clearStencilEnabled);
+    const bool     colorMasked      = clearColorEnabled && stateFramebufferOperations->ColorMaskActive();
+    const uint32_t stencilWriteMask = stateFramebufferOperations->GetStencilMaskFront() & 0xFF;
+    const bool     stencilMasked    = clearStencilEnabled && stencilWriteMask != 0xFF &&
+                                      mWriteFBO->GetDepthStencilAttachmentTexture() &&
+                                      VkFormatIsStencil(mWriteFBO->GetDepthStencilAttachmentTexture()->GetVkFormat());
 
-    StateFramebufferOperations *stateFramebufferOperations = mStateManager.GetFramebufferOperationsState();
+    if(!BeginRendering()) {
+        return;
+    }
+    ClearAttachments(clearColorEnabled && !colorMasked, clearDepthEnabled, clearStencilEnabled && !stencilMasked);
+
+    if(!colorMasked && !stencilMasked) {
+        return;
+    }
 
     // clearColor is passed as a uniform and masked through VkPipelineColorBlendAttachmentState
     GLfloat clearColorValue[4] = {0.0f,0.0f,0.0f,0.0f};
@@ -137,32 +303,27 @@ Context::ClearWithColorMask(bool clearColorEnabled, bool clearDepthEnabled, bool
         clearColorValue[3] = 1.0f;
     }
 
-    mStateManager.GetFramebufferOperationsState()->GetClearColor(clearColorValue);
-
     mScreenSpacePass->UpdateUniformBufferColor(clearColorValue[0], clearColorValue[1], clearColorValue[2], clearColorValue[3]);
 
-    vulkanAPI::Pipeline* pipeline = mScreenSpacePass->GetPipeline();
-
-    if(mWriteFBO->GetColorAttachmentTexture() && mWriteFBO->GetColorAttachmentTexture()->GetFormat() == GL_RGB) {
+    VkColorComponentFlags colorWriteMask = 0;
+    if(colorMasked && mWriteFBO->GetColorAttachmentTexture() && mWriteFBO->GetColorAttachmentTexture()->GetFormat() == GL_RGB) {
         GLboolean colormask[4];
-        mStateManager.GetFramebufferOperationsState()->GetColorMask(colormask);
+        stateFramebufferOperations->GetColorMask(colormask);
         GLubyte colorMaskPackRGB = GlColorMaskPack(colormask[0], colormask[1], colormask[2], GL_FALSE);
-        pipeline->SetColorBlendAttachmentWriteMask(GLColorMaskToVkColorComponentFlags(colorMaskPackRGB));
-    } else {
-        pipeline->SetColorBlendAttachmentWriteMask(GLColorMaskToVkColorComponentFlags(stateFramebufferOperations->GetColorMask()));
+        colorWriteMask = GLColorMaskToVkColorComponentFlags(colorMaskPackRGB);
+    } else if(colorMasked) {
+        colorWriteMask = GLColorMaskToVkColorComponentFlags(stateFramebufferOperations->GetColorMask());
     }
 
-    pipeline->SetUpdatePipeline(true);
-    pipeline->SetViewport(mClearRect.x, mClearRect.y, mClearRect.width, mClearRect.height);
-    pipeline->SetScissor(mClearRect.x, mClearRect.y, mClearRect.width, mClearRect.height);
-
-    if(!pipeline->Create(mWriteFBO->GetVkRenderPass())) {
-        Finish();
+    if(!mScreenSpacePass->PreparePipeline(colorWriteMask, stencilMasked ? stencilWriteMask : 0, mWriteFBO->GetRenderPass())) {
         return;
     }
 
-    mCommandBufferManager->BeginVkDrawCommandBuffer();
-    mWriteFBO->BeginVkRenderPass();
+    vulkanAPI::Pipeline* pipeline = mScreenSpacePass->GetPipeline();
+    pipeline->SetViewport(mClearRect.x, mClearRect.y, mClearRect.width, mClearRect.height);
+    pipeline->SetScissor(mClearRect.x, mClearRect.y, mClearRect.width, mClearRect.height);
+    pipeline->SetStencilFrontReference(stateFramebufferOperations->GetClearStencilMasked());
+    pipeline->SetStencilBackReference(stateFramebufferOperations->GetClearStencilMasked());
 
     const VkCommandBuffer *secondaryCmdBuffer = mCommandBufferManager->AllocateVkSecondaryCmdBuffers(1);
     mCommandBufferManager->BeginVkSecondaryCommandBuffer(secondaryCmdBuffer, *mWriteFBO->GetVkRenderPass(), *mWriteFBO->GetActiveVkFramebuffer());
@@ -176,9 +337,7 @@ Context::ClearWithColorMask(bool clearColorEnabled, bool clearDepthEnabled, bool
     mScreenSpacePass->Draw(secondaryCmdBuffer);
     mCommandBufferManager->EndVkSecondaryCommandBuffer(secondaryCmdBuffer);
 
-    VkCommandBuffer activeCmdBuffer = mCommandBufferManager->GetActiveCommandBuffer();
-    vkCmdExecuteCommands(activeCmdBuffer, 1, secondaryCmdBuffer);
-    Finish();
+    mWriteFBO->ExecuteVkCommandBuffer(secondaryCmdBuffer);
 }
 
 void
@@ -207,22 +366,38 @@ Context::UpdateViewportState(vulkanAPI::Pipeline* pipeline)
     }
 }
 
-void
-Context::PushGeometry(uint32_t vertCount, uint32_t firstVertex, bool indexed, GLenum type, const void *indices)
+bool
+Context::CreatePipeline(ShaderProgram *progPtr)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    SetClearRect();
+    if(!mPipeline->GetUpdatePipelineState() || !mVkContext->vkPipelineStateLog) {
+        return mPipeline->Create(mWriteFBO->GetVkRenderPass());
+    }
 
-    if(mWriteFBO->IsInClearState()) {
-        mWriteFBO->SetStateClearDraw();
+    vulkanAPI::pipelineStateKey_t key;
+    mPipeline->GetStateKey(&key, mWriteFBO->GetRenderPass()->GetColorFormat(),
+                                 mWriteFBO->GetRenderPass()->GetDepthStencilFormat());
 
-    } else if(mWriteFBO->IsInIdleState()) {
-        mWriteFBO->SetStateDraw();
-        BeginRendering(false,false,false);
+    VkPipeline prewarmed = progPtr->GetPrewarmedPipeline(&key);
+    if(prewarmed != VK_NULL_HANDLE) {
+        mPipeline->UsePrewarmed(prewarmed);
+        return true;
+    }
 
-    } else if(mWriteFBO->IsInClearDrawState()) {
-        mWriteFBO->SetStateDraw();
+    mVkContext->vkPipelineStateLog->Record(progPtr->GetProgramHash(), &key);
+
+    return mPipeline->Create(mWriteFBO->GetVkRenderPass());
+}
+
+void
+Context::PushGeometry(uint32_t vertCount, uint32_t firstVertex, bool indexed, GLenum type, const void *indices)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    SetClearRect();
+    if(!BeginRendering()) {
+        return;
     }
 
     //If the primitives are rendered with GL_LINE_LOOP we have to increment the vertCount.
@@ -250,7 +425,7 @@ Context::PushGeometry(uint32_t vertCount, uint32_t firstVertex, bool indexed, GL
     }
 
     if(SetPipelineProgramShaderStages(mStateManager.GetActiveShaderProgram())) {
-        if(!mPipeline->Create(mWriteFBO->GetVkRenderPass())) {
+        if(!CreatePipeline(mStateManager.GetActiveShaderProgram())) {
             Finish();
             return;
         }
@@ -276,8 +451,7 @@ Context::PushGeometry(uint32_t vertCount, uint32_t firstVertex, bool indexed, GL
     DrawGeometry(secondaryCmdBuffer, indexed, firstVertex, vertCount);
     mCommandBufferManager->EndVkSecondaryCommandBuffer(secondaryCmdBuffer);
 
-    VkCommandBuffer activeCmdBuffer = mCommandBufferManager->GetActiveCommandBuffer();
-    vkCmdExecuteCommands(activeCmdBuffer, 1, secondaryCmdBuffer);
+    mWriteFBO->ExecuteVkCommandBuffer(secondaryCmdBuffer);
 }
 
 void
@@ -440,9 +614,18 @@ Context::Finish(void)
 
     mResourceManager->CleanPurgeList();
 
+    // a surfaceless context with the default framebuffer bound has nothing to transition
+    if(mWriteFBO == nullptr) {
+        mCacheManager->CleanUpCaches();
+        mResourceManager->CleanPurgeList();
+        return;
+    }
+
+    // The render pass final layouts already cover these transitions; only images
+    // that were not rendered to since their allocation still need a barrier here.
     if(!mWriteFBO->IsInDeleteState()) {
         if(mWriteFBO == mSystemFBO) {
-            if(mWriteFBO->GetSurfaceType() == GLOVE_SURFACE_WINDOW) {
+            if(mWriteFBO->GetSurfaceType() == GLOVE_SURFACE_WINDOW && mWriteSurface->imageAcquired) {
                 mWriteFBO->PrepareVkImage(VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
             } else if (mWriteFBO->GetSurfaceType() == GLOVE_SURFACE_PBUFFER) {
                 if(mSystemFBO->GetBindToTexture()) {
@@ -459,23 +642,94 @@ Context::Finish(void)
     mResourceManager->CleanPurgeList();
 }
 
+void
+Context::FinishFrame(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    if(mSystemFBO == nullptr) {
+        Finish();
+        return;
+    }
+
+    // a frame without any rendering still presents an acquired image. If none can be acquired,
+    // EGL fails the swap and a clear deferred into the window framebuffer is dropped with the frame
+    if(!AcquireSurfaceImage() && mSystemFBO->IsInClearState()) {
+        mSystemFBO->SetStateIdle();
+    }
+
+    // a deferred clear is recorded first, so that beginning its render pass does not undo the discard below
+    if(mWriteFBO == mSystemFBO && mSystemFBO->IsInClearState()) {
+        BeginRendering();
+    }
+
+    // the ancillary buffers are undefined after eglSwapBuffers, so they are not written back
+    mSystemFBO->Discard(false, true, true);
+
+    // the frame is submitted but not waited for; its serial throttles the frame that reuses its semaphores
+    if(!Flush()) {
+        return;
+    }
+    if(mWriteSurface->syncItems != nullptr) {
+        mFrameSubmitSerials[mWriteSurface->syncItems->frameIndex] = mCommandBufferManager->GetLastSubmitSerial();
+    }
+
+    // the render pass final layouts normally leave the images in these layouts already
+    if(mSystemFBO->GetSurfaceType() == GLOVE_SURFACE_WINDOW && mWriteSurface->imageAcquired) {
+        mSystemFBO->PrepareVkImage(VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
+    }
+    if(mWriteFBO != mSystemFBO && !mWriteFBO->IsInDeleteState()) {
+        mWriteFBO->PrepareVkImage(VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    }
+    mWriteFBO->SetStateIdle();
+
+    // the next frame is rendered into another swapchain image, whose contents are stale anyway
+    mSystemFBO->Discard(true, false, false);
+
+    // release what the frames that are already done have left behind
+    mCacheManager->CleanUpCaches(mCommandBufferManager->GetCompletedSerial());
+    mResourceManager->CleanPurgeList();
+}
+
 bool
 Context::Flush(void)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    if(mWriteFBO == nullptr) {
-        return false;
+    // a surfaceless context may still have recorded passes of framebuffer objects
+    if(mWriteFBO) {
+        EndRendering();
     }
 
-    if(mWriteFBO->EndVkRenderPass()) {
+    // the command buffer may also hold the passes of previously bound framebuffers
+    if(mCommandBufferManager->IsVkDrawCommandBufferRecording()) {
         mCommandBufferManager->EndVkDrawCommandBuffer();
         mCommandBufferManager->SubmitVkDrawCommandBuffer();
+    } else if(mCommandBufferManager->HasPendingUploads()) {
+        // hand the uploaded images over to the graphics queue, so other contexts can use them
+        mCommandBufferManager->SubmitVkDrawCommandBuffer();
     }
 
+    // objects replaced while recording are released once the submission that used them is done
+    mCacheManager->RetireCaches(mCommandBufferManager->GetLastSubmitSerial());
+    mResourceManager->RetireCaches();
+
     return true;
 }
 
+void
+Context::EndRendering(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    // execute a glClear that no draw has picked up yet
+    if(mWriteFBO->IsInClearState()) {
+        BeginRendering();
+    }
+
+    mWriteFBO->EndVkRenderPass();
+}
+
 void
 Context::SetClearRect(void)
 {
@@ -37,7 +37,8 @@ Context::CompileShader(GLuint shader)
         return;
     }
 
-    CreateShaderCompiler();
+    std::lock_guard<std::mutex> lock(mResourceManager->GetShaderCompilerMutex());
+    mResourceManager->GetShareGroup()->CreateShaderCompiler();
 
     shaderPtr->CompileShader();
 }
@@ -56,7 +57,7 @@ Context::CreateShader(GLenum type)
     Shader *shader = mResourceManager->GetShader(res);
     shader->SetShaderType(type == GL_VERTEX_SHADER ? SHADER_TYPE_VERTEX : SHADER_TYPE_FRAGMENT);
     shader->SetVkContext(mVkContext);
-    shader->SetShaderCompiler(mShaderCompiler);
+    shader->SetShaderCompiler(mResourceManager->GetShaderCompiler());
 
     return mResourceManager->PushShadingObject({SHADER_ID, res});
 }
@@ -77,10 +78,11 @@ Context::DeleteShader(GLuint shader)
 
     shaderPtr->SetMarkForDeletion(true);
 
-    if(shaderPtr->FreeForDeletion()) {
+    // another context of the share group may still use the shader, it is released through the purge list
+    if(shaderPtr->FreeForDeletion() && !mResourceManager->IsShared()) {
         // Flush in case the shader is part of the pipeline
         // Optimization: perform this only when needed or defer deletion
-        if(mWriteFBO->IsInDrawState()) {
+        if(HasPendingDrawCommands()) {
             Flush();
         }
         mResourceManager->EraseShadingObject(shader);
@@ -149,6 +151,7 @@ Context::GetShaderInfoLog(GLuint shader, GLsizei bufsize, GLsizei* length, char*
         return;
     }
 
+    std::lock_guard<std::mutex> lock(mResourceManager->GetShaderCompilerMutex());
     char *log = shaderPtr->GetInfoLog();
 
     if(log) {
@@ -328,30 +331,6 @@ Context::ReleaseShaderCompiler(void)
         return;
     }
 
-    if(mShaderCompiler != nullptr) {
-        delete mShaderCompiler;
-        mShaderCompiler = nullptr;
-    }
-}
-
-void
-Context::CreateShaderCompiler(void)
-{
-    FUN_ENTRY(GL_LOG_DEBUG);
-
-    if(mShaderCompiler == nullptr) {
-        mShaderCompiler = new GlslangShaderCompiler();
-
-        ObjectArray<Shader> *shaderArray = mResourceManager->GetShaderArray();
-        for(typename map<uint32_t, Shader *>::const_iterator it =
-        shaderArray->GetObjects()->begin(); it != shaderArray->GetObjects()->end(); it++) {
-            it->second->SetShaderCompiler(mShaderCompiler);
-        }
-
-        ObjectArray<ShaderProgram> *shaderProgramArray = mResourceManager->GetShaderProgramArray();
-        for(typename map<uint32_t, ShaderProgram *>::const_iterator it =
-        shaderProgramArray->GetObjects()->begin(); it != shaderProgramArray->GetObjects()->end(); it++) {
-            it->second->SetShaderCompiler(mShaderCompiler);
-        }
-    }
+    std::lock_guard<std::mutex> lock(mResourceManager->GetShaderCompilerMutex());
+    mResourceManager->GetShareGroup()->ReleaseShaderCompiler();
 }
@@ -84,8 +84,8 @@ Context::CreateProgram(void)
     GLuint         res     = mResourceManager->AllocateShaderProgram();
     ShaderProgram *progPtr = mResourceManager->GetShaderProgram(res);
     progPtr->SetVkContext(mVkContext);
-    progPtr->SetShaderCompiler(mShaderCompiler);
-    progPtr->SetCacheManager(mCacheManager);
+    progPtr->SetShaderCompiler(mResourceManager->GetShaderCompiler());
+    progPtr->SetCacheManager(mResourceManager->GetShareGroup()->GetCacheManager());
 
     return mResourceManager->PushShadingObject({SHADER_PROGRAM_ID, res});
 }
@@ -106,10 +106,11 @@ Context::DeleteProgram(GLuint program)
 
     progPtr->SetMarkForDeletion(true);
 
-    if(progPtr->FreeForDeletion()) {
+    // another context of the share group may still use the program, it is released through the purge list
+    if(progPtr->FreeForDeletion() && !mResourceManager->IsShared()) {
         // Flush in case the shader is part of the pipeline
         // Optimization: perform this only when needed or defer deletion
-        if(mWriteFBO->IsInDrawState()) {
+        if(HasPendingDrawCommands()) {
             Finish();
         }
         progPtr->DetachShaders();
@@ -146,7 +147,7 @@ Context::DetachShader(GLuint program, GLuint shader)
     if(shaderPtr->GetMarkForDeletion() && shaderPtr->FreeForDeletion()) {
         // Flush in case the shader is part of the pipeline
         // Optimization: perform this only when needed or defer deletion
-        if(mWriteFBO->IsInDrawState()) {
+        if(HasPendingDrawCommands()) {
             Flush();
         }
         mResourceManager->CleanPurgeList();
@@ -296,22 +297,19 @@ Context::GetProgramBinaryOES(GLuint program, GLsizei bufSize, GLsizei *length, G
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    (void)binaryFormat;
-
     ShaderProgram *progPtr = GetProgramPtr(program);
     if(!progPtr) {
         return;
     }
 
-    progPtr->GetBinaryData(binary, length);
-
-    if(bufSize < *length) {
-        *length = 0;
+    if(!progPtr->GetBinaryData(binary, bufSize, length)) {
         RecordError(GL_INVALID_OPERATION);
         return;
     }
 
-    return;
+    if(binaryFormat) {
+        *binaryFormat = GLOVE_DEV_BINARY;
+    }
 }
 
 void
@@ -329,6 +327,7 @@ Context::GetProgramInfoLog(GLuint program, GLsizei bufsize, GLsizei* length, cha
         return;
     }
 
+    std::lock_guard<std::mutex> lock(mResourceManager->GetShaderCompilerMutex());
     char *log = progPtr->GetInfoLog();
     if(log) {
         int len = progPtr->GetInfoLogLength();
@@ -617,19 +616,26 @@ Context::LinkProgram(GLuint program)
         return;
     }
 
-    if(mWriteFBO->IsInDrawState()) {
+    if(HasPendingDrawCommands()) {
         Finish();
     }
 
+    std::lock_guard<std::mutex> lock(mResourceManager->GetShaderCompilerMutex());
+    mResourceManager->GetShareGroup()->CreateShaderCompiler();
+
     progPtr->LinkProgram();
     progPtr->SetShaderModules();
 
+    // a surfaceless context builds the pipeline against the bound framebuffer object, if any
+    Framebuffer *fbo = mSystemFBO ? mSystemFBO : mWriteFBO;
+
     mPipeline->SetUpdatePipeline(progPtr->IsLinked());
-    if(SetPipelineProgramShaderStages(progPtr)) {
+    if(fbo && SetPipelineProgramShaderStages(progPtr)) {
         progPtr->PrepareVertexAttribBufferObjects(0, 0, mResourceManager->GetGenericVertexAttributes(), true);
-        mPipeline->Create(mSystemFBO->GetVkRenderPass());
+        mPipeline->Create(fbo->GetVkRenderPass());
         // rebuild the pipeline next time
         mPipeline->SetUpdatePipeline(true);
+        progPtr->StartPipelineWarmup();
     }
 }
 
@@ -1422,6 +1428,7 @@ Context::ValidateProgram(GLuint program)
         }
     }
 
+    std::lock_guard<std::mutex> lock(mResourceManager->GetShaderCompilerMutex());
     progPtr->Validate();
 
     if(!progPtr->IsValidated()){
@@ -1457,6 +1464,14 @@ Context::ProgramBinaryOES(GLuint program, GLenum binaryFormat, const void *binar
     AttachShader(program, vs);
     AttachShader(program, fs);
 
-    progPtr->UsePrecompiledBinary(binary, length);
+    std::lock_guard<std::mutex> lock(mResourceManager->GetShaderCompilerMutex());
+    mResourceManager->GetShareGroup()->CreateShaderCompiler();
+
+    /// A rejected binary leaves the program unlinked, so that the application falls back to the sources
+    if(!progPtr->UsePrecompiledBinary(binary, length > 0 ? static_cast<size_t>(length) : 0)) {
+        return;
+    }
+
     progPtr->SetShaderModules();
+    progPtr->StartPipelineWarmup();
 }
@@ -74,13 +74,21 @@ Context::ReadPixels(GLint x, GLint y, GLsizei width, GLsizei height, GLenum form
         return;
     }
 
-    if(mWriteFBO != mSystemFBO && mWriteFBO->CheckStatus() != GL_FRAMEBUFFER_COMPLETE) {
+    if(CheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
         RecordError(GL_INVALID_FRAMEBUFFER_OPERATION);
         return;
     }
 
-    if(mWriteFBO->IsInDrawState()) {
-        Finish();
+    // the window contents are read from the image the current frame renders to
+    if(mWriteFBO == mSystemFBO && !AcquireSurfaceImage()) {
+        RecordError(GL_OUT_OF_MEMORY);
+        return;
+    }
+
+    BufferObject *packBuffer = mStateManager.GetActiveObjectsState()->GetActiveBufferObject(GL_PIXEL_PACK_BUFFER_NV);
+    if(packBuffer && packBuffer->IsMapped()) {
+        RecordError(GL_INVALID_OPERATION);
+        return;
     }
 
     Texture* activeTexture = mWriteFBO->GetColorAttachmentTexture();
@@ -101,6 +109,44 @@ Context::ReadPixels(GLint x, GLint y, GLsizei width, GLsizei height, GLenum form
                       mStateManager.GetPixelStorageState()->GetPixelStorePack());
 
     srcRect.y = activeTexture->GetInvertedYOrigin(&srcRect);
+
+    if(packBuffer) {
+        // pixels is an offset into the pack buffer
+        const size_t dstOffset = reinterpret_cast<size_t>(pixels);
+        if(dstOffset + dstRect.GetRectBufferSize() > packBuffer->GetSize()) {
+            RecordError(GL_INVALID_OPERATION);
+            return;
+        }
+
+        if(width == 0 || height == 0) {
+            return;
+        }
+
+        // record the copy behind the pending draws instead of draining the queue;
+        // the pixels are converted when the application maps the buffer
+        EndRendering();
+        mWriteFBO->SetStateIdle();
+        mCommandBufferManager->BeginVkDrawCommandBuffer();
+
+        BufferObject *stagingBuffer = new TransferDstBufferObject(mVkContext);
+        if(!stagingBuffer->Allocate(srcRect.GetRectBufferSize(), nullptr)) {
+            delete stagingBuffer;
+            RecordError(GL_OUT_OF_MEMORY);
+            return;
+        }
+
+        VkCommandBuffer activeCmdBuffer = mCommandBufferManager->GetActiveCommandBuffer();
+        activeTexture->RecordCopyPixels(&activeCmdBuffer, &srcRect, stagingBuffer, 0, 0, false);
+        // the copy goes out with the next submission of the draw command buffer
+        packBuffer->AddPackRequest(stagingBuffer, srcInternalFormat, &srcRect, dstInternalFormat, &dstRect, dstOffset,
+                                   mCommandBufferManager->GetLastSubmitSerial() + 1);
+        return;
+    }
+
+    if(HasPendingDrawCommands()) {
+        Finish();
+    }
+
     activeTexture->CopyPixelsToHost(&srcRect, &dstRect, 0, 0, dstInternalFormat, pixels);
 
 #if GLOVE_SAVE_READPIXELS_TO_FILE == true
@@ -45,6 +45,7 @@ Context::GetBooleanv(GLenum pname, GLboolean* params)
     case GL_CURRENT_PROGRAM:                    *params = GetProgramId(mStateManager.GetActiveShaderProgram()) == 0 ? GL_FALSE : GL_TRUE; break;
     case GL_ARRAY_BUFFER_BINDING:               *params = mStateManager.GetActiveObjectsState()->GetActiveBufferObject(GL_ARRAY_BUFFER)         ? mResourceManager->GetBufferID(mStateManager.GetActiveObjectsState()->GetActiveBufferObject(GL_ARRAY_BUFFER)        ) == 0 ? GL_FALSE : GL_TRUE : GL_FALSE; break;
     case GL_ELEMENT_ARRAY_BUFFER_BINDING:       *params = mStateManager.GetActiveObjectsState()->GetActiveBufferObject(GL_ELEMENT_ARRAY_BUFFER) ? mResourceManager->GetBufferID(mStateManager.GetActiveObjectsState()->GetActiveBufferObject(GL_ELEMENT_ARRAY_BUFFER)) == 0 ? GL_FALSE : GL_TRUE : GL_FALSE; break;
+    case GL_PIXEL_PACK_BUFFER_BINDING_NV:       *params = mStateManager.GetActiveObjectsState()->GetActiveBufferObject(GL_PIXEL_PACK_BUFFER_NV) ? mResourceManager->GetBufferID(mStateManager.GetActiveObjectsState()->GetActiveBufferObject(GL_PIXEL_PACK_BUFFER_NV)) == 0 ? GL_FALSE : GL_TRUE : GL_FALSE; break;
     case GL_NUM_SHADER_BINARY_FORMATS:          *params = GLOVE_NUM_SHADER_BINARY_FORMATS == 0 ? GL_FALSE : GL_TRUE; break;
     case GL_COMPRESSED_TEXTURE_FORMATS:         *params = GL_FALSE; break;
     case GL_NUM_COMPRESSED_TEXTURE_FORMATS:     *params = GL_FALSE; break;
@@ -107,12 +108,12 @@ Context::GetBooleanv(GLenum pname, GLboolean* params)
                                                 params[1] = GL_TRUE; break;
     case GL_ALIASED_POINT_SIZE_RANGE:           params[0] = GL_TRUE;
                                                 params[1] = GL_TRUE; break;
-    case GL_RED_BITS:                           GlFormatToStorageBits(mWriteFBO->GetColorAttachmentTexture()->GetInternalFormat(), params, nullptr, nullptr, nullptr, nullptr, nullptr); break;
-    case GL_BLUE_BITS:                          GlFormatToStorageBits(mWriteFBO->GetColorAttachmentTexture()->GetInternalFormat(), nullptr, params, nullptr, nullptr, nullptr, nullptr); break;
-    case GL_GREEN_BITS:                         GlFormatToStorageBits(mWriteFBO->GetColorAttachmentTexture()->GetInternalFormat(), nullptr, nullptr, params, nullptr, nullptr, nullptr); break;
-    case GL_ALPHA_BITS:                         GlFormatToStorageBits(mWriteFBO->GetColorAttachmentTexture()->GetInternalFormat(), nullptr, nullptr, nullptr, params, nullptr, nullptr); break;
-    case GL_DEPTH_BITS:                         GlFormatToStorageBits(mWriteFBO->GetDepthAttachmentTexture()   ? mWriteFBO->GetDepthAttachmentTexture()->GetInternalFormat()   : GL_INVALID_VALUE, nullptr, nullptr, nullptr, nullptr, params, nullptr); break;
-    case GL_STENCIL_BITS:                       GlFormatToStorageBits(mWriteFBO->GetStencilAttachmentTexture() ? mWriteFBO->GetStencilAttachmentTexture()->GetInternalFormat() : GL_INVALID_VALUE, nullptr, nullptr, nullptr, nullptr, nullptr, params); break;
+    case GL_RED_BITS:                           GlFormatToStorageBits(GetColorBufferFormat(), params, nullptr, nullptr, nullptr, nullptr, nullptr); break;
+    case GL_BLUE_BITS:                          GlFormatToStorageBits(GetColorBufferFormat(), nullptr, params, nullptr, nullptr, nullptr, nullptr); break;
+    case GL_GREEN_BITS:                         GlFormatToStorageBits(GetColorBufferFormat(), nullptr, nullptr, params, nullptr, nullptr, nullptr); break;
+    case GL_ALPHA_BITS:                         GlFormatToStorageBits(GetColorBufferFormat(), nullptr, nullptr, nullptr, params, nullptr, nullptr); break;
+    case GL_DEPTH_BITS:                         GlFormatToStorageBits(GetDepthBufferFormat(), nullptr, nullptr, nullptr, nullptr, params, nullptr); break;
+    case GL_STENCIL_BITS:                       GlFormatToStorageBits(GetStencilBufferFormat(), nullptr, nullptr, nullptr, nullptr, nullptr, params); break;
     case GL_SUBPIXEL_BITS:
     case GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS:
     case GL_MAX_VERTEX_UNIFORM_VECTORS:
@@ -157,12 +158,13 @@ Context::GetIntegerv(GLenum pname, GLint* params)
     case GL_IMPLEMENTATION_COLOR_READ_TYPE:     *params = GL_UNSIGNED_BYTE; break;
     case GL_ARRAY_BUFFER_BINDING:               *params = mStateManager.GetActiveObjectsState()->GetActiveBufferObject(GL_ARRAY_BUFFER)         ? mResourceManager->GetBufferID(mStateManager.GetActiveObjectsState()->GetActiveBufferObject(GL_ARRAY_BUFFER))   : 0; break;
     case GL_ELEMENT_ARRAY_BUFFER_BINDING:       *params = mStateManager.GetActiveObjectsState()->GetActiveBufferObject(GL_ELEMENT_ARRAY_BUFFER) ? mResourceManager->GetBufferID(mStateManager.GetActiveObjectsState()->GetActiveBufferObject(GL_ELEMENT_ARRAY_BUFFER)) : 0; break;
-    case GL_RED_BITS:                           GlFormatToStorageBits(mWriteFBO->GetColorAttachmentTexture()->GetInternalFormat(), params, NULL, NULL, NULL, NULL, NULL); break;
-    case GL_BLUE_BITS:                          GlFormatToStorageBits(mWriteFBO->GetColorAttachmentTexture()->GetInternalFormat(), NULL, params, NULL, NULL, NULL, NULL); break;
-    case GL_GREEN_BITS:                         GlFormatToStorageBits(mWriteFBO->GetColorAttachmentTexture()->GetInternalFormat(), NULL, NULL, params, NULL, NULL, NULL); break;
-    case GL_ALPHA_BITS:                         GlFormatToStorageBits(mWriteFBO->GetColorAttachmentTexture()->GetInternalFormat(), NULL, NULL, NULL, params, NULL, NULL); break;
-    case GL_DEPTH_BITS:                         GlFormatToStorageBits(mWriteFBO->GetDepthAttachmentTexture()   ? mWriteFBO->GetDepthAttachmentTexture()->GetInternalFormat()   : GL_INVALID_VALUE, NULL, NULL, NULL, NULL, params, NULL); break;
-    case GL_STENCIL_BITS:                       GlFormatToStorageBits(mWriteFBO->GetStencilAttachmentTexture() ? mWriteFBO->GetStencilAttachmentTexture()->GetInternalFormat() : GL_INVALID_VALUE, NULL, NULL, NULL, NULL, NULL, params); break;
+    case GL_PIXEL_PACK_BUFFER_BINDING_NV:       *params = mStateManager.GetActiveObjectsState()->GetActiveBufferObject(GL_PIXEL_PACK_BUFFER_NV) ? mResourceManager->GetBufferID(mStateManager.GetActiveObjectsState()->GetActiveBufferObject(GL_PIXEL_PACK_BUFFER_NV)) : 0; break;
+    case GL_RED_BITS:                           GlFormatToStorageBits(GetColorBufferFormat(), params, NULL, NULL, NULL, NULL, NULL); break;
+    case GL_BLUE_BITS:                          GlFormatToStorageBits(GetColorBufferFormat(), NULL, params, NULL, NULL, NULL, NULL); break;
+    case GL_GREEN_BITS:                         GlFormatToStorageBits(GetColorBufferFormat(), NULL, NULL, params, NULL, NULL, NULL); break;
+    case GL_ALPHA_BITS:                         GlFormatToStorageBits(GetColorBufferFormat(), NULL, NULL, NULL, params, NULL, NULL); break;
+    case GL_DEPTH_BITS:                         GlFormatToStorageBits(GetDepthBufferFormat(), NULL, NULL, NULL, NULL, params, NULL); break;
+    case GL_STENCIL_BITS:                       GlFormatToStorageBits(GetStencilBufferFormat(), NULL, NULL, NULL, NULL, NULL, params); break;
     case GL_GENERATE_MIPMAP_HINT:               *params = static_cast<GLint>(mStateManager.GetHintAspectsState()->GetMode(GL_GENERATE_MIPMAP_HINT)); break;
     case GL_BLEND:                              *params = mStateManager.GetFragmentOperationsState()->GetBlendingEnabled(); break;
     case GL_COLOR_CLEAR_VALUE:                  mStateManager.GetFramebufferOperationsState()->GetClearColor(params); break;
@@ -262,6 +264,7 @@ Context::GetFloatv(GLenum pname, GLfloat* params)
     case GL_DEPTH_WRITEMASK:                    *params = static_cast<GLfloat>(mStateManager.GetFramebufferOperationsState()->GetDepthMask()); break;
     case GL_DITHER:                             *params = static_cast<GLfloat>(mStateManager.GetFragmentOperationsState()->GetDitheringEnabled()); break;
     case GL_ELEMENT_ARRAY_BUFFER_BINDING:       *params = mStateManager.GetActiveObjectsState()->GetActiveBufferObject(GL_ELEMENT_ARRAY_BUFFER) ? static_cast<GLfloat>(mResourceManager->GetBufferID(mStateManager.GetActiveObjectsState()->GetActiveBufferObject(GL_ELEMENT_ARRAY_BUFFER))) : 0; break;
+    case GL_PIXEL_PACK_BUFFER_BINDING_NV:       *params = mStateManager.GetActiveObjectsState()->GetActiveBufferObject(GL_PIXEL_PACK_BUFFER_NV) ? static_cast<GLfloat>(mResourceManager->GetBufferID(mStateManager.GetActiveObjectsState()->GetActiveBufferObject(GL_PIXEL_PACK_BUFFER_NV))) : 0; break;
     case GL_FRAMEBUFFER_BINDING:                *params = static_cast<GLfloat>(mStateManager.GetActiveObjectsState()->GetActiveFramebufferObjectID()); break;
     case GL_FRONT_FACE:                         *params = static_cast<GLfloat>(mStateManager.GetRasterizationState()->GetFrontFace()); break;
     case GL_IMPLEMENTATION_COLOR_READ_FORMAT:   *params = GL_RGBA; break;
@@ -293,12 +296,12 @@ Context::GetFloatv(GLenum pname, GLfloat* params)
     case GL_STENCIL_TEST:                       *params = static_cast<GLfloat>(mStateManager.GetFragmentOperationsState()->GetStencilTestEnabled()); break;
     case GL_UNPACK_ALIGNMENT:                   *params = static_cast<GLfloat>(mStateManager.GetPixelStorageState()->GetPixelStoreUnpack()); break;
     case GL_VIEWPORT:                           mStateManager.GetViewportTransformationState()->GetViewportRect(params); break;
-    case GL_RED_BITS:                           GlFormatToStorageBits(mWriteFBO->GetColorAttachmentTexture()->GetInternalFormat(), params, NULL, NULL, NULL, NULL, NULL); break;
-    case GL_BLUE_BITS:                          GlFormatToStorageBits(mWriteFBO->GetColorAttachmentTexture()->GetInternalFormat(), NULL, params, NULL, NULL, NULL, NULL); break;
-    case GL_GREEN_BITS:                         GlFormatToStorageBits(mWriteFBO->GetColorAttachmentTexture()->GetInternalFormat(), NULL, NULL, params, NULL, NULL, NULL); break;
-    case GL_ALPHA_BITS:                         GlFormatToStorageBits(mWriteFBO->GetColorAttachmentTexture()->GetInternalFormat(), NULL, NULL, NULL, params, NULL, NULL); break;
-    case GL_DEPTH_BITS:                         GlFormatToStorageBits(mWriteFBO->GetDepthAttachmentTexture()   ? mWriteFBO->GetDepthAttachmentTexture()->GetInternalFormat()   : GL_INVALID_VALUE, NULL, NULL, NULL, NULL, params, NULL); break;
-    case GL_STENCIL_BITS:                       GlFormatToStorageBits(mWriteFBO->GetStencilAttachmentTexture() ? mWriteFBO->GetStencilAttachmentTexture()->GetInternalFormat() : GL_INVALID_VALUE, NULL, NULL, NULL, NULL, NULL, params); break;
+    case GL_RED_BITS:                           GlFormatToStorageBits(GetColorBufferFormat(), params, NULL, NULL, NULL, NULL, NULL); break;
+    case GL_BLUE_BITS:                          GlFormatToStorageBits(GetColorBufferFormat(), NULL, params, NULL, NULL, NULL, NULL); break;
+    case GL_GREEN_BITS:                         GlFormatToStorageBits(GetColorBufferFormat(), NULL, NULL, params, NULL, NULL, NULL); break;
+    case GL_ALPHA_BITS:                         GlFormatToStorageBits(GetColorBufferFormat(), NULL, NULL, NULL, params, NULL, NULL); break;
+    case GL_DEPTH_BITS:                         GlFormatToStorageBits(GetDepthBufferFormat(), NULL, NULL, NULL, NULL, params, NULL); break;
+    case GL_STENCIL_BITS:                       GlFormatToStorageBits(GetStencilBufferFormat(), NULL, NULL, NULL, NULL, NULL, params); break;
     case GL_ALIASED_LINE_WIDTH_RANGE:           params[0] = 1.0f;
                                                 params[1] = 1.0f; break;
     case GL_ALIASED_POINT_SIZE_RANGE:           params[0] = 1.0f;
@@ -103,28 +103,28 @@ Context::DeleteTextures(GLsizei n, const GLuint* textures)
 
         if (texture && mResourceManager->TextureExists(texture)) {
 
-            if(mWriteFBO->IsInDrawState()) {
-                if(texture == mWriteFBO->GetColorAttachmentName() && GL_TEXTURE == mWriteFBO->GetColorAttachmentType()) {
+            if(HasPendingDrawCommands()) {
+                if(mWriteFBO && texture == mWriteFBO->GetColorAttachmentName() && GL_TEXTURE == mWriteFBO->GetColorAttachmentType()) {
                     mWriteFBO->SetStateDelete();
                 }
                 Finish();
             }
 
             Texture *tex  = mResourceManager->GetTexture(texture);
-            if(texture == mWriteFBO->GetColorAttachmentName() && GL_TEXTURE == mWriteFBO->GetColorAttachmentType()) {
+            if(mWriteFBO && texture == mWriteFBO->GetColorAttachmentName() && GL_TEXTURE == mWriteFBO->GetColorAttachmentType()) {
                 mWriteFBO->SetColorAttachment(-1,-1);
                 mWriteFBO->SetColorAttachmentType(GL_NONE);
                 mWriteFBO->SetColorAttachmentName(0);
                 tex->Unbind();
             }
 
-            if(texture == mWriteFBO->GetDepthAttachmentName() && GL_TEXTURE == mWriteFBO->GetDepthAttachmentType()) {
+            if(mWriteFBO && texture == mWriteFBO->GetDepthAttachmentName() && GL_TEXTURE == mWriteFBO->GetDepthAttachmentType()) {
                 mWriteFBO->SetDepthAttachmentType(GL_NONE);
                 mWriteFBO->SetDepthAttachmentName(0);
                 tex->Unbind();
             }
 
-            if(texture == mWriteFBO->GetStencilAttachmentName() && GL_TEXTURE == mWriteFBO->GetStencilAttachmentType()) {
+            if(mWriteFBO && texture == mWriteFBO->GetStencilAttachmentName() && GL_TEXTURE == mWriteFBO->GetStencilAttachmentType()) {
                 mWriteFBO->SetStencilAttachmentType(GL_NONE);
                 mWriteFBO->SetStencilAttachmentName(0);
                 tex->Unbind();
@@ -173,7 +173,11 @@ Context::GenerateMipmap(GLenum target)
         return;
     }
 
-    activeTexture->GenerateMipmaps(mStateManager.GetHintAspectsState()->GetMode(GL_GENERATE_MIPMAP_HINT));
+    if(HasPendingDrawCommands()) {
+        Finish();
+    }
+
+    activeTexture->GenerateMipmaps(mStateManager.GetHintAspectsState()->GetMode(GL_GENERATE_MIPMAP_HINT), mCacheManager);
 }
 
 void
@@ -398,7 +402,7 @@ Context::TexImage2D(GLenum target, GLint level, GLenum internalformat, GLsizei w
         return;
     }
 
-    if(mWriteFBO->IsInDrawState()) {
+    if(HasPendingDrawCommands()) {
         Finish();
     }
 
@@ -409,9 +413,8 @@ Context::TexImage2D(GLenum target, GLint level, GLenum internalformat, GLsizei w
 
     if(activeTexture->IsCompleted()) {
         // pass contents to the driver
-        VkFormat vkformat = activeTexture->FindSupportedVkColorFormat(GlColorFormatToVkColorFormat(format, type));
-        activeTexture->SetVkFormat(vkformat);
-        activeTexture->Allocate();
+        activeTexture->SelectVkFormat(format, type, mResourceManager->IsTextureAttachedToFBO(activeTexture));
+        activeTexture->Allocate(mCacheManager);
     }
 }
 
@@ -467,7 +470,7 @@ Context::TexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset,
         return;
     }
 
-    if(mWriteFBO->IsInDrawState()) {
+    if(HasPendingDrawCommands()) {
         Finish();
     }
 
@@ -495,9 +498,8 @@ Context::TexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset,
 
     if(activeTexture->IsCompleted()) {
         // pass contents to the driver
-        VkFormat vkformat = activeTexture->FindSupportedVkColorFormat(GlColorFormatToVkColorFormat(format, type));
-        activeTexture->SetVkFormat(vkformat);
-        activeTexture->Allocate();
+        activeTexture->SelectVkFormat(format, type, mResourceManager->IsTextureAttachedToFBO(activeTexture));
+        activeTexture->Allocate(mCacheManager);
     }
 }
 
@@ -535,12 +537,18 @@ Context::CopyTexImage2D(GLenum target, GLint level, GLenum internalformat, GLint
         return;
     }
 
-    if(mWriteFBO != mSystemFBO && mWriteFBO->CheckStatus() != GL_FRAMEBUFFER_COMPLETE) {
+    if(CheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
         RecordError(GL_INVALID_FRAMEBUFFER_OPERATION);
         return;
     }
 
-    if(mWriteFBO->IsInDrawState()) {
+    // the window contents are read from the image the current frame renders to
+    if(mWriteFBO == mSystemFBO && !AcquireSurfaceImage()) {
+        RecordError(GL_OUT_OF_MEMORY);
+        return;
+    }
+
+    if(HasPendingDrawCommands()) {
         Finish();
     }
 
@@ -587,9 +595,8 @@ Context::CopyTexImage2D(GLenum target, GLint level, GLenum internalformat, GLint
 
     if(activeTexture->IsCompleted()) {
         // pass contents to the driver
-        VkFormat vkformat = activeTexture->FindSupportedVkColorFormat(GlColorFormatToVkColorFormat(activeTexture->GetFormat(), activeTexture->GetType()));
-        activeTexture->SetVkFormat(vkformat);
-        activeTexture->Allocate();
+        activeTexture->SelectVkFormat(activeTexture->GetFormat(), activeTexture->GetType(), mResourceManager->IsTextureAttachedToFBO(activeTexture));
+        activeTexture->Allocate(mCacheManager);
     }
 }
 
@@ -618,12 +625,18 @@ Context::CopyTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoff
         return;
     }
 
-    if(mWriteFBO != mSystemFBO && mWriteFBO->CheckStatus() != GL_FRAMEBUFFER_COMPLETE) {
+    if(CheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
         RecordError(GL_INVALID_FRAMEBUFFER_OPERATION);
         return;
     }
 
-    if(mWriteFBO->IsInDrawState()) {
+    // the window contents are read from the image the current frame renders to
+    if(mWriteFBO == mSystemFBO && !AcquireSurfaceImage()) {
+        RecordError(GL_OUT_OF_MEMORY);
+        return;
+    }
+
+    if(HasPendingDrawCommands()) {
         Finish();
     }
 
@@ -669,9 +682,8 @@ Context::CopyTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoff
     delete[] stagePixels;
 
     if(activeTexture->IsCompleted()) {
-        VkFormat vkformat = activeTexture->FindSupportedVkColorFormat(GlColorFormatToVkColorFormat(activeTexture->GetFormat(), activeTexture->GetType()));
-        activeTexture->SetVkFormat(vkformat);
-        activeTexture->Allocate();
+        activeTexture->SelectVkFormat(activeTexture->GetFormat(), activeTexture->GetType(), mResourceManager->IsTextureAttachedToFBO(activeTexture));
+        activeTexture->Allocate(mCacheManager);
     }
 }
 
@@ -19,6 +19,14 @@
  *
  *  @brief      Shaders compilation and linking module. It implements ShaderCompiler interface using glslang 
  *
+ *  @section
+ *
+ *  A program is linked in two passes. The ESSL 100 pass provides the link
+ *  status, the info log and the reflection. The ESSL 400 pass compiles the
+ *  converted sources again to get SPIR-V. The relink cache keeps the results
+ *  of the ESSL 400 pass, so linking identical sources again skips it, but the
+ *  first link of any sources still parses them twice.
+ *
  */
 
 #include <vector>
@@ -33,8 +41,20 @@
 bool             GlslangShaderCompiler::mInitialized = false;
 TBuiltInResource GlslangShaderCompiler::mTBuiltInResource;
 
+/// FNV-1a
+static uint64_t
+HashBytes(uint64_t hash, const void *data, size_t size)
+{
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+    for(size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
 GlslangShaderCompiler::GlslangShaderCompiler()
-: mProgramLinker(nullptr), mShaderConverter(nullptr), mShaderReflection(nullptr),
+: mProgramLinker(nullptr), mShaderConverter(nullptr), mShaderReflection(nullptr), mLinkKeyHash(0),
   mPrintConvertedShader(false), mPrintSpv(false),
   mSaveBinaryToFiles(false), mSaveSourceToFiles(false), mSaveSpvTextToFile(false)
 {
@@ -211,13 +231,102 @@ GlslangShaderCompiler::LinkProgram(uintptr_t program_ptr, ESSL_VERSION version,
         PrintReflection(version);
     }
 
-    if(mPrintReflection[version]) {
-        PrintReflection(version);
-    }
+    CacheLinkedProgram(vertSpv, fragSpv);
 
     return result;
 }
 
+bool
+GlslangShaderCompiler::UseLinkedProgram(bool isYInverted, vector<uint32_t> &vertSpv, vector<uint32_t> &fragSpv)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    /// The ESSL 400 pass depends only on the ESSL 100 sources and on the attribute locations assigned to them
+    mLinkKey.source[SHADER_COMPILER_VERTEX]   = mSourceMap[ESSL_VERSION_100][SHADER_COMPILER_VERTEX];
+    mLinkKey.source[SHADER_COMPILER_FRAGMENT] = mSourceMap[ESSL_VERSION_100][SHADER_COMPILER_FRAGMENT];
+    mLinkKey.isYInverted                      = isYInverted;
+    mLinkKey.attributeLocations.clear();
+    for(uint32_t i = 0; i < mShaderReflection->GetLiveAttributes(); ++i) {
+        mLinkKey.attributeLocations.push_back(mShaderReflection->GetAttributeLocation(i));
+    }
+
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    hash = HashBytes(hash, mLinkKey.source[SHADER_COMPILER_VERTEX].data()  , mLinkKey.source[SHADER_COMPILER_VERTEX].size());
+    hash = HashBytes(hash, mLinkKey.source[SHADER_COMPILER_FRAGMENT].data(), mLinkKey.source[SHADER_COMPILER_FRAGMENT].size());
+    hash = HashBytes(hash, mLinkKey.attributeLocations.data(), mLinkKey.attributeLocations.size() * sizeof(int));
+    hash = HashBytes(hash, &isYInverted, sizeof(isYInverted));
+    mLinkKeyHash = hash;
+
+    if(!IsLinkCacheEnabled()) {
+        return false;
+    }
+
+    std::map<uint64_t, std::list<linkedProgram_t>::iterator>::const_iterator it = mLinkedProgramIndex.find(mLinkKeyHash);
+    if(it == mLinkedProgramIndex.end()) {
+        return false;
+    }
+
+    const linkedProgram_t &linkedProgram = *it->second;
+    const linkKey_t &key = linkedProgram.key;
+    if(key.isYInverted                      != mLinkKey.isYInverted                      ||
+       key.attributeLocations               != mLinkKey.attributeLocations               ||
+       key.source[SHADER_COMPILER_VERTEX]   != mLinkKey.source[SHADER_COMPILER_VERTEX]   ||
+       key.source[SHADER_COMPILER_FRAGMENT] != mLinkKey.source[SHADER_COMPILER_FRAGMENT]) {
+        return false;
+    }
+
+    *mShaderReflection = linkedProgram.reflection;
+    vertSpv            = linkedProgram.spv[SHADER_COMPILER_VERTEX];
+    fragSpv            = linkedProgram.spv[SHADER_COMPILER_FRAGMENT];
+
+    mLinkedPrograms.splice(mLinkedPrograms.begin(), mLinkedPrograms, it->second);
+
+    return true;
+}
+
+bool
+GlslangShaderCompiler::IsLinkCacheEnabled(void)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    /// The debug outputs are produced by the ESSL 400 pass, so it must not be skipped
+    return !(mPrintReflection[ESSL_VERSION_400] || mPrintConvertedShader || mPrintSpv ||
+             mSaveBinaryToFiles || mSaveSourceToFiles || mSaveSpvTextToFile);
+}
+
+void
+GlslangShaderCompiler::CacheLinkedProgram(const vector<uint32_t> &vertSpv, const vector<uint32_t> &fragSpv)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    /// Only links that were looked up first have a key
+    if(!mLinkKeyHash || !IsLinkCacheEnabled()) {
+        return;
+    }
+
+    /// An entry with the same hash is replaced, otherwise the least recently used one is evicted
+    std::map<uint64_t, std::list<linkedProgram_t>::iterator>::iterator it = mLinkedProgramIndex.find(mLinkKeyHash);
+    if(it != mLinkedProgramIndex.end()) {
+        mLinkedPrograms.splice(mLinkedPrograms.begin(), mLinkedPrograms, it->second);
+    } else {
+        if(mLinkedPrograms.size() >= GLOVE_MAX_CACHED_LINKED_PROGRAMS) {
+            mLinkedProgramIndex.erase(mLinkedPrograms.back().hash);
+            mLinkedPrograms.pop_back();
+        }
+        mLinkedPrograms.push_front(linkedProgram_t());
+        mLinkedProgramIndex[mLinkKeyHash] = mLinkedPrograms.begin();
+    }
+
+    linkedProgram_t &linkedProgram = mLinkedPrograms.front();
+    linkedProgram.hash                              = mLinkKeyHash;
+    linkedProgram.key                               = mLinkKey;
+    linkedProgram.reflection                        = *mShaderReflection;
+    linkedProgram.spv[SHADER_COMPILER_VERTEX]       = vertSpv;
+    linkedProgram.spv[SHADER_COMPILER_FRAGMENT]     = fragSpv;
+
+    mLinkKeyHash = 0;
+}
+
 bool
 GlslangShaderCompiler::ValidateProgram(ESSL_VERSION version)
 {
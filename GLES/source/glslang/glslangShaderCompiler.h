@@ -24,6 +24,7 @@
 #ifndef __GLSLANGSHADERCOMPILER_H__
 #define __GLSLANGSHADERCOMPILER_H__
 
+#include <list>
 #include "resources/shaderCompiler.h"
 #include "shaderConverter.h"
 #include "glslangCompiler.h"
@@ -31,6 +32,9 @@
 #include "resources/shaderReflection.h"
 #include "resources/shaderProgram.h"
 
+/// Number of ESSL 400 pass results kept by the relink cache
+#define GLOVE_MAX_CACHED_LINKED_PROGRAMS                32
+
 class GlslangShaderCompiler final : public ShaderCompiler {
 private:
 
@@ -40,6 +44,20 @@ private:
         SHADER_COMPILER_TYPE_MAX
     } shader_compiler_type_t;
 
+    /// Everything that the ESSL 400 pass depends on
+    typedef struct {
+        std::string             source[SHADER_COMPILER_TYPE_MAX];
+        std::vector<int>        attributeLocations;
+        bool                    isYInverted;
+    } linkKey_t;
+
+    typedef struct {
+        uint64_t                hash;
+        linkKey_t               key;
+        ShaderReflection        reflection;
+        std::vector<uint32_t>   spv[SHADER_COMPILER_TYPE_MAX];
+    } linkedProgram_t;
+
     static bool             mInitialized;
     static TBuiltInResource mTBuiltInResource;
 
@@ -52,6 +70,15 @@ private:
                             mSourceMap;
     std::vector<uint32_t>   mSpv[SHADER_COMPILER_TYPE_MAX];
 
+    /// Relink cache: results of the ESSL 400 pass, most recently used first, and their index by the hash of their key.
+    /// It only helps links of sources seen before; a first link still parses the sources twice
+    std::list<linkedProgram_t>
+                            mLinkedPrograms;
+    std::map<uint64_t, std::list<linkedProgram_t>::iterator>
+                            mLinkedProgramIndex;
+    linkKey_t               mLinkKey;
+    uint64_t                mLinkKeyHash;
+
     std::map<ESSL_VERSION, bool> 
                             mPrintReflection;
     bool                    mPrintConvertedShader;
@@ -86,6 +113,10 @@ private:
 /// Release Functions
     void                    Release(void);
 
+/// Relink Cache Functions
+    bool                    IsLinkCacheEnabled(void);
+    void                    CacheLinkedProgram(const vector<uint32_t> &vertSpv, const vector<uint32_t> &fragSpv);
+
 /// Convert Functions
     const char             *ConvertShader(uintptr_t program_ptr, shader_type_t shaderType, ESSL_VERSION version_in, ESSL_VERSION version_out, bool isYInverted);
 
@@ -124,11 +155,15 @@ public:
                                          vector<uint32_t> &vertSpv, 
                                          vector<uint32_t> &fragSpv)           override;
     bool                     ValidateProgram(ESSL_VERSION version)            override;
+    bool                     UseLinkedProgram(bool isYInverted,
+                                              vector<uint32_t> &vertSpv,
+                                              vector<uint32_t> &fragSpv)      override;
     
 /// Reflection Functions
     void                     PrepareReflection(ESSL_VERSION version)          override;
     uint32_t                 SerializeReflection(void* binary)                override { FUN_ENTRY(GL_LOG_TRACE); return mShaderReflection->Serialize(binary);  }
-    uint32_t                 DeserializeReflection(const void* binary)        override { FUN_ENTRY(GL_LOG_TRACE); return mShaderReflection->Deserialize(binary);}
+    uint32_t                 DeserializeReflection(const void* binary,
+                                                   uint32_t size)             override { FUN_ENTRY(GL_LOG_TRACE); return mShaderReflection->Deserialize(binary, size);}
 
 /// Shader Functions
     bool                     PreprocessShader(uintptr_t program_ptr,
@@ -22,6 +22,7 @@
  */
 
 #include "shaderConverter.h"
+#include <algorithm>
 #include "resources/shaderProgram.h"
 #include "utils/glUtils.h"
 #include "utils/glLogger.h"
@@ -74,6 +75,39 @@ const char * const ShaderConverter::shaderLimitsBuiltIns = "#define gl_MaxVertex
                                                            "#define gl_MaxDrawBuffers "                STRINGIFY_MACRO(GLOVE_MAX_DRAW_BUFFERS) "\n"
                                                            "\n";
 
+static inline bool
+IsTokenChar(char c)
+{
+    return ((c >= 'a' && c <= 'z') ||
+            (c >= 'A' && c <= 'Z') ||
+            (c >= '0' && c <= '9') ||
+            (c == '_'));
+}
+
+/// Appends the newlines found in source[start, end) to output and returns whether there were any
+static bool
+AppendNewLines(string *output, const string &source, size_t start, size_t end)
+{
+    const size_t newLines = static_cast<size_t>(std::count(source.begin() + start, source.begin() + end, '\n'));
+    output->append(newLines, '\n');
+    return newLines != 0;
+}
+
+/// Appends source[start, end) to output, replacing each tab with 4 spaces
+static void
+AppendText(string *output, const string &source, size_t start, size_t end)
+{
+    while(start < end) {
+        size_t tab = static_cast<size_t>(std::find(source.begin() + start, source.begin() + end, '\t') - source.begin());
+        output->append(source, start, tab - start);
+        if(tab < end) {
+            output->append("    ");
+            ++tab;
+        }
+        start = tab;
+    }
+}
+
 ShaderConverter::ShaderConverter()
 : mConversionType(SHADER_CONVERSION_INVALID),
   mShaderType(SHADER_TYPE_INVALID),
@@ -106,18 +140,34 @@ ShaderConverter::Convert100To400(std::string& source, const uniformBlockMap_t &u
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    // Replace each tab with 4 spaces. It makes parsing result easy to use.
-    ReplaceAll(source, "\t", "    ");
-    ProcessMacros(source);
-    ProcessHeader(source, uniformBlockMap);
-    ProcessUniforms(source, uniformBlockMap);
-
-    if(mShaderType == SHADER_TYPE_FRAGMENT) {
-        ProcessInvariantQualifier(source);
+    /// The conversion is a single pass over the source, emitting into a new buffer.
+    /// Keywords that need rewriting are handled as they are met, so the cost stays
+    /// linear to the shader size.
+    conversion_state_t state;
+    state.header               = nullptr;
+    state.headerEmitted        = false;
+    state.uniformBlockMap      = &uniformBlockMap;
+    state.reflection           = reflection;
+    state.unusedBlockBindings  = static_cast<uint32_t>(uniformBlockMap.size());
+    state.lineDirectiveEnabled = FindToken("#line", source, 0) != string::npos;
+    mIoMapResolver->CreateVaryingLocationMap(&state.varyingLocations);
+
+    /// The header declares gl_DepthRange as a uniform, so it goes through the same pass
+    string header;
+    state.output = &header;
+    ProcessSource(state, GetHeader(uniformBlockMap));
+
+    string output;
+    output.reserve(header.size() + source.size() + source.size() / 2);
+    state.output = &output;
+    state.header = &header;
+    ProcessSource(state, source);
+
+    /// If #version is not present
+    if(!state.headerEmitted) {
+        output.insert(0, header);
     }
-
-    ProcessVaryings(source);
-    ProcessVertexAttributes(source, reflection);
+    source.swap(output);
 
     if(mShaderType == SHADER_TYPE_VERTEX) {
         if(isYInverted) {
@@ -136,352 +186,389 @@ ShaderConverter::Initialize(shader_type_t shaderType, ESSL_VERSION version_in, E
     mShaderType     = shaderType;
 }
 
-void
-ShaderConverter::ProcessHeader(std::string& source, const uniformBlockMap_t &uniformBlockMap)
+string
+ShaderConverter::GetHeader(const uniformBlockMap_t &uniformBlockMap) const
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
     /// Do not add vulkan_DepthRange declaration if gl_DepthRange is not active in the input shader
     const bool depthRangeActive = uniformBlockMap.find(string("gl_DepthRange")) != uniformBlockMap.cend();
-    const string sourceHeader = string(shaderVersion) +
-                                string(shaderExtensions) +
-                                string(shaderPrecision) +
-                                string(shaderTexture2d) +
-                                string(shaderTextureCube) +
-                                (depthRangeActive ? string(shaderDepthRange) : string("")) +
-                                string(shaderLimitsBuiltIns);
-
-    /// If #version is present
-    size_t found = source.find("#version");
-    if(found != string::npos) {
-        size_t f1 = source.find("\n", found);
-        source.replace(found, f1 - found, sourceHeader);
-    } else {
-        source.insert(0, sourceHeader);
-    }
+
+    return string(shaderVersion) +
+           string(shaderExtensions) +
+           string(shaderPrecision) +
+           string(shaderTexture2d) +
+           string(shaderTextureCube) +
+           (depthRangeActive ? string(shaderDepthRange) : string("")) +
+           string(shaderLimitsBuiltIns);
 }
 
-void
-ShaderConverter::ProcessInvariantQualifier(std::string& source)
+string
+ShaderConverter::GetDeclarationName(const string& source, size_t pos) const
 {
-    FUN_ENTRY(GL_LOG_DEBUG);
+    FUN_ENTRY(GL_LOG_TRACE);
 
-    size_t found;
+    size_t found = SkipWhiteSpaces(source, pos);
 
-    const string invariantStr("invariant");
-    const string invariantVaryingStr("invariant varying");
-    found = FindToken(invariantVaryingStr, source, 0);
-    while(found != string::npos) {
+    /// Either type or precision qualifier
+    string token = GetNextToken(source, found);
+    if(IsPrecisionQualifier(token)) {
+        found = SkipWhiteSpaces(source, found + token.length());
+        token = GetNextToken(source, found);
+    }
 
-        size_t f1 = found;
-        found = SkipWhiteSpaces(source, found + invariantStr.length());
+    /// Definitely type now
+    found = SkipWhiteSpaces(source, found + token.length());
+
+    /// Variable name
+    return GetNextToken(source, found);
+}
+
+bool
+ShaderConverter::IsReservedBlockName(const string& name) const
+{
+    FUN_ENTRY(GL_LOG_TRACE);
 
-        // remove 'invariant' when found before varying (in fragment shaders)
-        source.replace(f1, invariantStr.length(), "");
+    /// uni0, uni1, ... are the names given to the blocks of inactive uniforms
+    if(name.length() <= 3 || name.length() > 12 || name.compare(0, 3, "uni")) {
+        return false;
+    }
 
-        found = FindToken(invariantVaryingStr, source, found);
+    const string index = name.substr(3);
+    if(index.find_first_not_of("0123456789") != string::npos || (index.length() > 1 && index[0] == '0')) {
+        return false;
     }
+
+    const size_t uni_count = (mShaderType == SHADER_TYPE_VERTEX) ? GLOVE_MAX_VERTEX_UNIFORM_VECTORS : GLOVE_MAX_FRAGMENT_UNIFORM_VECTORS;
+    return stoul(index) < uni_count;
 }
 
 void
-ShaderConverter::ProcessMacros(std::string& source)
+ShaderConverter::ProcessSource(conversion_state_t &state, const string& source)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    size_t found;
+    const size_t size = source.size();
+    size_t pos = 0;
 
-    bool linedirectiveEnabled=false;
-    const string linedirective("#line");
-    found = FindToken(linedirective, source, 0);
-    if(found != string::npos) {
-        linedirectiveEnabled = true;
-    }
+    state.lineStart       = true;
+    state.lineIsDirective = false;
+    state.directive.clear();
+    state.prevToken.clear();
 
-    const string lineStr("__LINE__");
-    found = FindToken(lineStr, source, 0);
-    while(found != string::npos) {
+    while(pos < size) {
+        const char c = source[pos];
 
-        size_t f1 = found;
-        found = SkipWhiteSpaces(source, found + lineStr.length());
+        if(IsTokenChar(c)) {
+            size_t end = pos;
+            while(end < size && IsTokenChar(source[end])) {
+                ++end;
+            }
+            const string token(source, pos, end - pos);
+            pos = end;
 
-        int firstNL  = static_cast<int>(source.rfind('\n', f1));
-        int secondNL = static_cast<int>(source.rfind('#' , f1));
+            ProcessToken(state, source, pos, token);
+            state.lineStart = false;
+            continue;
+        }
 
-        // check if is used in a define function & linedirective is not used
-        if(firstNL >= secondNL && !linedirectiveEnabled) {
-            // we have inserted 29 additional lines
-            source.replace(f1, lineStr.length(), "__LINE__ - 29");
+        if(c == '/' && pos + 1 < size && (source[pos + 1] == '/' || source[pos + 1] == '*')) {
+            ProcessComment(state, source, pos);
+            continue;
         }
 
-        found = FindToken(lineStr, source, found);
-    }
+        if(c == '#' && state.lineStart) {
+            ProcessDirective(state, source, pos);
+            continue;
+        }
 
-    const string versionStr("__VERSION__");
-    found = FindToken(versionStr, source, 0);
-    while(found != string::npos) {
+        if(c == '\n') {
+            /// A backslash continues a preprocessor directive on the next line
+            if(!state.lineIsDirective || pos == 0 || source[pos - 1] != '\\') {
+                state.lineStart       = true;
+                state.lineIsDirective = false;
+                state.directive.clear();
+            }
+            state.prevToken.clear();
+        } else if(c != ' ' && c != '\t' && c != '\r') {
+            state.lineStart = false;
+        }
 
-        size_t f1 = found;
-        found = SkipWhiteSpaces(source, found + versionStr.length());
+        // Replace each tab with 4 spaces. It makes parsing result easy to use.
+        if(c == '\t') {
+            state.output->append("    ");
+        } else {
+            state.output->push_back(c);
+        }
+        ++pos;
+    }
+}
 
-        // the actual value is 100 = 400/4
-        source.replace(f1, versionStr.length(), "__VERSION__ / 4");
+void
+ShaderConverter::ProcessComment(conversion_state_t &state, const string& source, size_t &pos)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
 
-        found = FindToken(versionStr, source, found);
+    size_t end;
+    if(source[pos + 1] == '/') {
+        end = source.find('\n', pos + 2);
+        end = (end == string::npos) ? source.size() : end;
+    } else {
+        end = source.find("*/", pos + 2);
+        end = (end == string::npos) ? source.size() : end + 2;
     }
 
-    const  string glStr("GL_ES");
-    found = FindToken(glStr, source, 0);
-    while(found != string::npos) {
+    AppendText(state.output, source, pos, end);
+    pos = end;
+}
+
+void
+ShaderConverter::ProcessDirective(conversion_state_t &state, const string& source, size_t &pos)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
 
-        size_t f1 = found;
-        found = SkipWhiteSpaces(source, found + glStr.length());
+    size_t found = pos + 1;
+    while(found < source.size() && (source[found] == ' ' || source[found] == '\t')) {
+        ++found;
+    }
+    const string directive = GetNextToken(source, found);
 
-        // check if is used in a ifdef function
-        int firstNL  = static_cast<int>(source.rfind('\n', f1));
-        int secondNL = static_cast<int>(source.rfind("#ifdef" , f1));
-        if(firstNL >= secondNL) {
-            // replace with '1' value
-            source.replace(f1, glStr.length(), "1");
-        }
+    /// If #version is present, the header replaces it
+    if(directive == "version" && state.header) {
+        state.output->append(*state.header);
+        state.headerEmitted = true;
 
-        found = FindToken(glStr, source, found);
+        pos = source.find('\n', found);
+        pos = (pos == string::npos) ? source.size() : pos;
+        return;
     }
+
+    state.lineStart       = false;
+    state.lineIsDirective = true;
+    state.directive       = directive;
+    state.output->push_back('#');
+    ++pos;
 }
 
 void
-ShaderConverter::ProcessUniforms(std::string& source, const uniformBlockMap_t &uniformBlockMap)
+ShaderConverter::ProcessToken(conversion_state_t &state, const string& source, size_t &pos, const string& token)
 {
-    FUN_ENTRY(GL_LOG_DEBUG);
+    FUN_ENTRY(GL_LOG_TRACE);
 
-    /// Start of dead uniform blocks where the active end
-    uint32_t unusedBlockBindings = static_cast<uint32_t>(uniformBlockMap.size());
-    uniformBlockMap_t::const_iterator uniBlockIt;
-    string layoutSyntax;
-    string blockSyntax;
-
-    /// Convert uniforms into uniform blocks
-    string token;
-    const string uniformLiteralStr("uniform");
-
-    size_t found = FindToken(uniformLiteralStr, source, 0);
-    while(found != string::npos) {
-        size_t firstNL = source.rfind("\n", found);
-        string commentLine = source.substr(firstNL, found - firstNL);
-        if(commentLine.find("//") != string::npos) {
-            found = FindToken(uniformLiteralStr, source, found + uniformLiteralStr.length());
-            continue;
-        }
+    if(state.lineIsDirective) {
+        ProcessMacro(state, token);
+    } else if(token == "uniform") {
+        ProcessUniform(state, source, pos);
+    } else if(token == "varying") {
+        ProcessVarying(state, source, pos);
+    } else if(token == "attribute") {
+        ProcessVertexAttribute(state, source, pos);
+    } else if(token == "invariant" && mShaderType == SHADER_TYPE_FRAGMENT) {
+        ProcessInvariantQualifier(state, source, pos);
+    } else {
+        ProcessMacro(state, token);
+    }
 
-        size_t f1 = found;
-        found = SkipWhiteSpaces(source, found + uniformLiteralStr.length());
+    state.prevToken = token;
+}
 
-        /// Either type or precision qualifier
-        token = GetNextToken(source, found);
-        string tokenTypeStr = token;
-        string tokenPrecisionStr = "";
+void
+ShaderConverter::ProcessMacro(conversion_state_t &state, const string& token)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
 
-        if(IsPrecisionQualifier(token)) {
-            found = SkipWhiteSpaces(source, found + token.length());
-            token = GetNextToken(source, found);
-            tokenPrecisionStr = token;
+    if(token == "__LINE__") {
+        // check if is used in a define function & linedirective is not used
+        if(!state.lineIsDirective && !state.lineDirectiveEnabled) {
+            // we have inserted 29 additional lines
+            state.output->append("__LINE__ - 29");
+        } else {
+            state.output->append(token);
         }
+    } else if(token == "__VERSION__") {
+        // the actual value is 100 = 400/4
+        state.output->append("__VERSION__ / 4");
+    } else if(token == "GL_ES") {
+        // replace with '1' value, unless it is checked for being defined
+        const bool isChecked = state.lineIsDirective && (state.directive == "ifdef"  ||
+                                                         state.directive == "ifndef" ||
+                                                         state.prevToken == "defined");
+        state.output->append(isChecked ? token : string("1"));
+    } else if(!state.renamedUniforms.empty() && state.renamedUniforms.count(token)) {
+        state.output->append(token);
+        state.output->push_back('_');
+    } else {
+        state.output->append(token);
+    }
+}
 
-        /// Definitely type now
-        if(!CanTypeBeInUniformBlock(token)) {
-            /// Sampler type
-            found = SkipWhiteSpaces(source, found + token.length());
-            /// Variable name
-            token = GetNextToken(source, found);
-
-            uniBlockIt = uniformBlockMap.find(token);
-            if(uniBlockIt != uniformBlockMap.cend()) {
-                layoutSyntax = "layout(binding = " + to_string(uniBlockIt->second.binding) + string(") ");
-            } else {
-                layoutSyntax = "layout(binding = " + to_string(unusedBlockBindings) + string(") ");
-                ++unusedBlockBindings;
-            }
-            source.insert(f1, layoutSyntax);
-
-            found = FindToken(uniformLiteralStr, source, found + token.length() + layoutSyntax.length());
-
-            continue;
-        }
+void
+ShaderConverter::ProcessUniform(conversion_state_t &state, const string& source, size_t &pos)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
 
-        found = SkipWhiteSpaces(source, found + token.length());
+    const size_t declStart = SkipWhiteSpaces(source, pos);
+    const size_t declEnd   = source.find(';', declStart);
+    if(declEnd == string::npos) {
+        state.output->append("uniform");
+        return;
+    }
 
-        /// Variable name
-        token = GetNextToken(source, found);
+    /// Either type or precision qualifier
+    string type       = GetNextToken(source, declStart);
+    string qualifiers = type;
+    size_t found      = SkipWhiteSpaces(source, declStart + type.length());
 
-        /// Check for multiple inline variable declaration
-        bool   multiple_declaration = false;
-        size_t f2  = source.find (",", found + token.length());
-        size_t fNL = source.find (';', found + token.length());
-        blockSyntax = string(";\n") + uniformLiteralStr + " " + tokenTypeStr + " " + tokenPrecisionStr;
-        while(f2 <= fNL) {
-            /// Move every variable on a new line
-            source.replace(found + token.length(), 1, blockSyntax);
-            found = SkipWhiteSpaces(source, found + token.length() + blockSyntax.length() + 1);
-            token = GetNextToken(source, found);
-            f2    = source.find (",", found + token.length());
-
-            multiple_declaration = true;
-        }
+    if(IsPrecisionQualifier(type)) {
+        type        = GetNextToken(source, found);
+        qualifiers += " " + type;
+        found       = SkipWhiteSpaces(source, found + type.length());
+    }
 
-        /// if yes, then goto back to the beginning
-        if(multiple_declaration) {
-            found = f1;
-            continue;
+    /// Every declarator gets its own declaration. The newlines of the source are kept in place
+    /// (and no new ones are added), so that the converted shader keeps the line numbers of the original.
+    size_t gapStart        = pos;
+    size_t declaratorStart = found;
+    int    depth           = 0;
+    for(size_t i = found; i <= declEnd; ++i) {
+        const char c = source[i];
+        if(c == '[' || c == '(') {
+            ++depth;
+        } else if(c == ']' || c == ')') {
+            --depth;
+        } else if(i == declEnd || (c == ',' && !depth)) {
+            size_t declaratorEnd = i;
+            while(declaratorEnd > declaratorStart && IsWhiteSpace(source[declaratorEnd - 1])) {
+                --declaratorEnd;
+            }
+            if(!AppendNewLines(state.output, source, gapStart, declaratorStart) && gapStart != pos) {
+                state.output->push_back(' ');
+            }
+            ProcessUniformDeclarator(state, qualifiers, type, source.substr(declaratorStart, declaratorEnd - declaratorStart));
+            gapStart        = declaratorEnd;
+            declaratorStart = SkipWhiteSpaces(source, i + 1);
         }
+    }
+    AppendNewLines(state.output, source, gapStart, declEnd);
 
-        // Rename uni* variable cases
-        const string uniStr("uni");
-        const size_t uni_count = (mShaderType == SHADER_TYPE_VERTEX) ? GLOVE_MAX_VERTEX_UNIFORM_VECTORS : GLOVE_MAX_FRAGMENT_UNIFORM_VECTORS;
-        for (size_t i = 0; i < uni_count; i++) {
-            const string uniformStr(uniStr + to_string(i));
-            if(!token.compare(uniformStr)) {
-                size_t f1 = FindToken(uniformStr, source, found);
-                while(f1 != string::npos) {
+    pos = declEnd + 1;
+}
 
-                    size_t f2 = f1;
-                    f1 = SkipWhiteSpaces(source, f1 + uniformStr.length());
+void
+ShaderConverter::ProcessUniformDeclarator(conversion_state_t &state, const string& qualifiers, const string& type, string declarator)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
 
-                    source.replace(f2, uniformStr.length(), uniformStr + "_");
+    declarator.erase(declarator.find_last_not_of(" \t\r\n") + 1);
 
-                    f1 = FindToken(uniformStr, source, f1);
-                }
-                break;
-            }
-        }
+    const string name = GetNextToken(declarator, 0);
+    uniformBlockMap_t::const_iterator uniBlockIt;
 
-        if(!token.compare(STRINGIFY_MACRO(GLOVE_VULKAN_DEPTH_RANGE))) {
-            token = std::string("gl_DepthRange");
+    /// Sampler type
+    if(!CanTypeBeInUniformBlock(type)) {
+        uint32_t binding;
+        uniBlockIt = state.uniformBlockMap->find(name);
+        if(uniBlockIt != state.uniformBlockMap->cend()) {
+            binding = uniBlockIt->second.binding;
+        } else {
+            binding = state.unusedBlockBindings++;
         }
 
-        /// Construct uniform block
-        uniBlockIt = uniformBlockMap.find(token);
-        if(uniBlockIt != uniformBlockMap.cend()) {
-            const uniformBlock_t &block = uniBlockIt->second;
-            layoutSyntax = "layout(" + mMemLayoutQualifier + ", binding = " + to_string(block.binding) + string(") ");
-            source.insert(f1, layoutSyntax);
-            f1 += layoutSyntax.length();
+        state.output->append("layout(binding = " + to_string(binding) + ") uniform " + qualifiers + " ");
+        AppendText(state.output, declarator, 0, declarator.size());
+        state.output->push_back(';');
+        return;
+    }
 
-            blockSyntax = block.glslName + string(" {");
-            source.insert(f1 + strlen("uniform\0") + 1, blockSyntax);
-        } else {
-            /// inactive uniform
-            layoutSyntax = "layout(" + mMemLayoutQualifier + ", binding = " + to_string(unusedBlockBindings) + string(") ");
-            source.insert(f1, layoutSyntax);
-            f1 += layoutSyntax.length();
-
-            blockSyntax = string("uni") + to_string(unusedBlockBindings) + string(" {");
-            source.insert(f1 + strlen("uniform\0") + 1, blockSyntax);
-            ++unusedBlockBindings;
-        }
+    // Rename uni* variable cases
+    if(IsReservedBlockName(name)) {
+        state.renamedUniforms.insert(name);
+        declarator.insert(name.length(), "_");
+    }
 
-        /// Close brackets and add block name
-        found = source.find(";", found);
-        blockSyntax = string("};");
-        source.insert(found + 1, blockSyntax);
+    string blockKey = name;
+    if(!name.compare(STRINGIFY_MACRO(GLOVE_VULKAN_DEPTH_RANGE))) {
+        blockKey = std::string("gl_DepthRange");
+    }
 
-        found = FindToken(uniformLiteralStr, source, found);
+    /// Construct uniform block
+    uint32_t binding;
+    string   blockName;
+    uniBlockIt = state.uniformBlockMap->find(blockKey);
+    if(uniBlockIt != state.uniformBlockMap->cend()) {
+        binding   = uniBlockIt->second.binding;
+        blockName = uniBlockIt->second.glslName;
+    } else {
+        /// inactive uniform
+        binding   = state.unusedBlockBindings;
+        blockName = string("uni") + to_string(state.unusedBlockBindings);
+        ++state.unusedBlockBindings;
     }
+
+    state.output->append("layout(" + mMemLayoutQualifier + ", binding = " + to_string(binding) + ") uniform " + blockName + " {" + qualifiers + " ");
+    AppendText(state.output, declarator, 0, declarator.size());
+    state.output->append(";};");
 }
 
 void
-ShaderConverter::ProcessVaryings(std::string& source)
+ShaderConverter::ProcessInvariantQualifier(conversion_state_t &state, const string& source, size_t &pos)
 {
-    FUN_ENTRY(GL_LOG_DEBUG);
-
-    const string varyingLiteralStr("varying");
-
-    std::map<std::string, std::pair<int,bool>> varyingsLocationMap;
-    mIoMapResolver->CreateVaryingLocationMap(&varyingsLocationMap);
-
-    size_t found = FindToken(varyingLiteralStr, source, 0);
-    while(found != string::npos) {
-        size_t f1 = found;
-        found = SkipWhiteSpaces(source, found + varyingLiteralStr.length());
-
-        /// Either type or precision qualifier
-        string token = GetNextToken(source, found);
-        if(IsPrecisionQualifier(token)) {
-            found = SkipWhiteSpaces(source, found + token.length());
-            token = GetNextToken(source, found);
-        }
-        /// Definitely type now
-        found = SkipWhiteSpaces(source, found + token.length());
-
-        /// Variable name
-        token = GetNextToken(source, found);
-
-        if(varyingsLocationMap.find(token) != varyingsLocationMap.end()) {
-            string layoutSyntax = string("layout(location = ") +
-                                  to_string(varyingsLocationMap[token].first) +
-                                  (mShaderType == SHADER_TYPE_VERTEX ? string(") out") : string(") in"));
-
-            //  Check for varying type mismatch
-            //  replace line with dummy word in order to make compilation fail.
-            //  TODO: This is a process that should be executed in the linking step! Not here.
-            if(mShaderType == SHADER_TYPE_FRAGMENT && !varyingsLocationMap[token].second) {
-                source.replace(f1, varyingLiteralStr.length(), "xxx");
-            } else {
-                source.replace(f1, varyingLiteralStr.length(), layoutSyntax);
-            }
-        } else {
-            source.replace(f1, varyingLiteralStr.length(), "");
-        }
+    FUN_ENTRY(GL_LOG_TRACE);
 
-        found = FindToken(varyingLiteralStr, source, found);
+    // remove 'invariant' when found before varying (in fragment shaders)
+    if(GetNextToken(source, SkipWhiteSpaces(source, pos)) != "varying") {
+        state.output->append("invariant");
     }
 }
 
 void
-ShaderConverter::ProcessVertexAttributes(std::string& source, ShaderReflection* reflection)
+ShaderConverter::ProcessVarying(conversion_state_t &state, const string& source, size_t &pos)
 {
-    FUN_ENTRY(GL_LOG_DEBUG);
+    FUN_ENTRY(GL_LOG_TRACE);
 
-    std::vector<int> loc;
+    const string name = GetDeclarationName(source, pos);
 
-    if(!reflection->GetLiveAttributes()) {
+    std::map<std::string, std::pair<int,bool>>::const_iterator it = state.varyingLocations.find(name);
+    if(it == state.varyingLocations.cend()) {
         return;
     }
 
-    /// Handle vertex attributes
-    const string attributeLiteralStr("attribute");
+    //  Check for varying type mismatch
+    //  replace line with dummy word in order to make compilation fail.
+    //  TODO: This is a process that should be executed in the linking step! Not here.
+    if(mShaderType == SHADER_TYPE_FRAGMENT && !it->second.second) {
+        state.output->append("xxx");
+        return;
+    }
 
-    size_t found = FindToken(attributeLiteralStr, source, 0);
-    while(found != string::npos) {
-        size_t f1 = found;
-        found = SkipWhiteSpaces(source, found + attributeLiteralStr.length());
+    state.output->append(string("layout(location = ") +
+                         to_string(it->second.first) +
+                         (mShaderType == SHADER_TYPE_VERTEX ? string(") out") : string(") in")));
+}
 
-        /// Either type or precision qualifier
-        string token = GetNextToken(source, found);
-        if(IsPrecisionQualifier(token)) {
-            found = SkipWhiteSpaces(source, found + token.length());
-            token = GetNextToken(source, found);
-        }
+void
+ShaderConverter::ProcessVertexAttribute(conversion_state_t &state, const string& source, size_t &pos)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
 
-        /// Definitely type now
-        found = SkipWhiteSpaces(source, found + token.length());
-        /// Variable name
-        token = GetNextToken(source, found);
+    if(!state.reflection->GetLiveAttributes()) {
+        state.output->append("attribute");
+        return;
+    }
 
-        int location = reflection->GetAttributeLocation(token.c_str());
+    const string name = GetDeclarationName(source, pos);
+    const int location = state.reflection->GetAttributeLocation(name.c_str());
 
-        std::vector<int>::iterator it = std::find (loc.begin(), loc.end(), location);
-        if(location >=0 && it == loc.end()) {
-            string layoutSyntax = string("layout(location = ") + to_string(location) + string(") in");
-            source.replace(f1, attributeLiteralStr.length(), layoutSyntax);
-            for (int j = 0; j < (int)OccupiedLocationsPerGlType(reflection->GetAttributeType(token.c_str())); j++) {
-                loc.push_back(location + j);
-            }
-        } else {
-            source.erase(f1, attributeLiteralStr.length() + 1);
-            found = f1;
+    std::vector<int> &loc = state.attributeLocations;
+    if(location >= 0 && std::find(loc.begin(), loc.end(), location) == loc.end()) {
+        state.output->append(string("layout(location = ") + to_string(location) + string(") in"));
+        for (int j = 0; j < (int)OccupiedLocationsPerGlType(state.reflection->GetAttributeType(name.c_str())); j++) {
+            loc.push_back(location + j);
         }
-        found = FindToken(attributeLiteralStr, source, found);
+    } else if(pos < source.size()) {
+        /// drop the qualifier along with the white space that follows it
+        ++pos;
     }
-
 }
 
 void
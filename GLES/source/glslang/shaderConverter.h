@@ -29,6 +29,7 @@
 #include "glslangIoMapResolver.h"
 #include "utils/parser_helpers.h"
 #include "glslangUtils.h"
+#include <set>
 
 class ShaderConverter {
 public:
@@ -48,6 +49,24 @@ private:
         SHADER_CONVERSION_100_400
     } shader_conversion_type_t;
 
+    /// State of the single conversion pass, shared by the header and the shader source
+    typedef struct {
+        string                                         *output;
+        const string                                   *header;
+        bool                                            headerEmitted;
+        const uniformBlockMap_t                        *uniformBlockMap;
+        ShaderReflection                               *reflection;
+        std::map<std::string, std::pair<int,bool>>      varyingLocations;
+        std::set<std::string>                           renamedUniforms;
+        std::vector<int>                                attributeLocations;
+        uint32_t                                        unusedBlockBindings;
+        bool                                            lineDirectiveEnabled;
+        bool                                            lineStart;
+        bool                                            lineIsDirective;
+        std::string                                     directive;
+        std::string                                     prevToken;
+    } conversion_state_t;
+
     static const char * const   shaderVersion;
     static const char * const   shaderExtensions;
     static const char * const   shaderPrecision;
@@ -63,18 +82,27 @@ private:
     GlslangIoMapResolver       *mIoMapResolver;
 
 /// Process Functions
-    void ProcessMacros(std::string& source);
-    void ProcessHeader(string& source, const uniformBlockMap_t &uniformBlockMap);
-    void ProcessUniforms(string& source, const uniformBlockMap_t &uniformBlockMap);
-    void ProcessInvariantQualifier(std::string& source);
-    void ProcessVaryings(string& source);
-    void ProcessVertexAttributes(string& source, ShaderReflection* reflection);
+    void ProcessSource(conversion_state_t &state, const string& source);
+    void ProcessDirective(conversion_state_t &state, const string& source, size_t &pos);
+    void ProcessComment(conversion_state_t &state, const string& source, size_t &pos);
+    void ProcessToken(conversion_state_t &state, const string& source, size_t &pos, const string& token);
+    void ProcessMacro(conversion_state_t &state, const string& token);
+    void ProcessUniform(conversion_state_t &state, const string& source, size_t &pos);
+    void ProcessUniformDeclarator(conversion_state_t &state, const string& qualifiers, const string& type, string declarator);
+    void ProcessInvariantQualifier(conversion_state_t &state, const string& source, size_t &pos);
+    void ProcessVarying(conversion_state_t &state, const string& source, size_t &pos);
+    void ProcessVertexAttribute(conversion_state_t &state, const string& source, size_t &pos);
 
 /// Convert Functions
     void Convert100To400(string& source, const uniformBlockMap_t &uniformBlockMap, ShaderReflection* reflection, bool isYInverted);
     void ConvertGLToVulkanCoordSystem(string& source);
     void ConvertGLToVulkanDepthRange(string& source);
 
+/// Get Functions
+    string GetHeader(const uniformBlockMap_t &uniformBlockMap) const;
+    string GetDeclarationName(const string& source, size_t pos) const;
+    bool   IsReservedBlockName(const string& name) const;
+
     shader_conversion_type_t EsslVersionToShaderConversionType(ESSL_VERSION version_in, ESSL_VERSION version_out);
 };
 
@@ -30,7 +30,8 @@
 #include "bufferObject.h"
 
 BufferObject::BufferObject(const vulkanAPI::vkContext_t *vkContext, const VkBufferUsageFlags vkBufferUsageFlags, const VkSharingMode vkSharingMode, const VkFlags vkFlags)
-: mVkContext(vkContext), mUsage(GL_STATIC_DRAW), mTarget(GL_INVALID_VALUE), mAllocated(false)
+: mVkContext(vkContext), mUsage(GL_STATIC_DRAW), mTarget(GL_INVALID_VALUE), mAllocated(false),
+  mMapPointer(nullptr), mMapAccess(0), mMapOffset(0), mMapLength(0), mPackSerial(0)
 {
     FUN_ENTRY(GL_LOG_TRACE);
 
@@ -42,6 +43,8 @@ BufferObject::~BufferObject()
 {
     FUN_ENTRY(GL_LOG_TRACE);
 
+    ReleasePackRequests();
+
     delete mBuffer;
     delete mMemory;
 }
@@ -51,6 +54,9 @@ BufferObject::Release()
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
+    Unmap();
+    ReleasePackRequests();
+
     mBuffer->Release();
     mMemory->Release();
     mAllocated = false;
@@ -87,6 +93,116 @@ BufferObject::UpdateData(size_t size, size_t offset, const void *data)
     mMemory->UpdateData(size, offset, data);
 }
 
+void *
+BufferObject::Map(size_t offset, size_t length, GLbitfield access)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    assert(!IsMapped());
+
+    // the GPU has finished the copies by now, so the pixels can be converted in place
+    ResolvePackRequests();
+
+    mMapPointer = mMemory->Map(length, offset);
+    if(mMapPointer) {
+        mMapAccess = access;
+        mMapOffset = offset;
+        mMapLength = length;
+    }
+
+    return mMapPointer;
+}
+
+bool
+BufferObject::Unmap(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    if(!IsMapped()) {
+        return false;
+    }
+
+    mMemory->Unmap();
+    mMapPointer = nullptr;
+    mMapAccess  = 0;
+    mMapOffset  = 0;
+    mMapLength  = 0;
+
+    return true;
+}
+
+void
+BufferObject::AddPackRequest(BufferObject *stagingBuffer,
+                             GLenum srcFormat, const ImageRect *srcRect,
+                             GLenum dstFormat, const ImageRect *dstRect, size_t dstOffset,
+                             uint64_t submitSerial)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    packRequest_t request;
+    request.stagingBuffer = stagingBuffer;
+    request.srcFormat     = srcFormat;
+    request.srcRect       = *srcRect;
+    request.dstFormat     = dstFormat;
+    request.dstRect       = *dstRect;
+    request.dstOffset     = dstOffset;
+
+    mPackRequests.push_back(request);
+
+    // the copies are done once the latest submission carrying one of them is
+    if(mPackSerial < submitSerial) {
+        mPackSerial = submitSerial;
+    }
+}
+
+void
+BufferObject::ResolvePackRequests(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    if(mPackRequests.empty()) {
+        return;
+    }
+
+    uint8_t *dstData = static_cast<uint8_t *>(mMemory->Map(GetSize(), 0));
+    if(dstData == nullptr) {
+        return;
+    }
+
+    // requests are resolved in submission order, so later readbacks overwrite earlier ones
+    for(auto &request : mPackRequests) {
+        const size_t srcSize = request.srcRect.GetRectBufferSize();
+        uint8_t *srcData = new uint8_t[srcSize];
+        request.stagingBuffer->GetData(srcSize, 0, srcData);
+
+        ImageRect srcRect = request.srcRect;
+        ImageRect dstRect = request.dstRect;
+        srcRect.x = 0; srcRect.y = 0;
+        dstRect.x = 0; dstRect.y = 0;
+        ConvertPixels(request.srcFormat, request.dstFormat,
+                      &srcRect, srcData,
+                      &dstRect, dstData + request.dstOffset,
+                      true);
+
+        delete[] srcData;
+    }
+
+    mMemory->Unmap();
+
+    ReleasePackRequests();
+}
+
+void
+BufferObject::ReleasePackRequests(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    for(auto &request : mPackRequests) {
+        delete request.stagingBuffer;
+    }
+    mPackRequests.clear();
+}
+
 void
 BufferObject::SetTarget(GLenum target)
 {
@@ -96,8 +212,10 @@ BufferObject::SetTarget(GLenum target)
     // already allocated, e.g., vertex buffer is also an index buffer and vice-versa
     if(mTarget != target && mTarget != GL_INVALID_VALUE) {
         VkBufferUsageFlags combinedBuffers =
-                static_cast<VkBufferUsageFlags>(VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT);
+                static_cast<VkBufferUsageFlags>(VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT |
+                                                VK_BUFFER_USAGE_TRANSFER_DST_BIT);
         if(mBuffer->GetFlags() != combinedBuffers && mAllocated == true) {
+            ResolvePackRequests();
             size_t size = mBuffer->GetSize();
             uint8_t *srcData = new uint8_t[size];
             this->GetData(size, 0, srcData);
@@ -110,6 +228,8 @@ BufferObject::SetTarget(GLenum target)
         mBuffer->SetFlags(VK_BUFFER_USAGE_VERTEX_BUFFER_BIT);
     } else if(target == GL_ELEMENT_ARRAY_BUFFER) {
         mBuffer->SetFlags(VK_BUFFER_USAGE_INDEX_BUFFER_BIT);
+    } else if(target == GL_PIXEL_PACK_BUFFER_NV) {
+        mBuffer->SetFlags(VK_BUFFER_USAGE_TRANSFER_DST_BIT);
     }
     mTarget = target;
 }
@@ -29,9 +29,22 @@
 #include "vulkan/buffer.h"
 #include "vulkan/memory.h"
 #include "refObject.h"
+#include "rect.h"
+#include <vector>
 
 class BufferObject : public refObject {
 private:
+    /// glReadPixels into a pixel pack buffer copies the raw pixels into a staging
+    /// buffer on the GPU; they are converted into the buffer when it is mapped
+    typedef struct packRequest {
+        BufferObject       *stagingBuffer;
+        GLenum              srcFormat;
+        ImageRect           srcRect;
+        GLenum              dstFormat;
+        ImageRect           dstRect;
+        size_t              dstOffset;
+    } packRequest_t;
+
     const
     vulkanAPI::vkContext_t* mVkContext;
 
@@ -41,6 +54,16 @@ private:
 
     vulkanAPI::Memory*      mMemory;
 
+    void*                   mMapPointer;
+    GLbitfield              mMapAccess;
+    size_t                  mMapOffset;
+    size_t                  mMapLength;
+
+    std::vector<packRequest_t> mPackRequests;
+    uint64_t                mPackSerial;
+
+    void                    ReleasePackRequests(void);
+
 protected:
     vulkanAPI::Buffer*      mBuffer;
 
@@ -59,6 +82,18 @@ public:
 
 // Update Functions
     void                    UpdateData(size_t size, size_t offset, const void *data);
+    inline void             HostReadBarrier(VkCommandBuffer *activeCmdBuffer)  const   { FUN_ENTRY(GL_LOG_TRACE); mBuffer->HostReadBarrier(activeCmdBuffer); }
+
+// Map Functions
+    void*                   Map(size_t offset, size_t length, GLbitfield access);
+    bool                    Unmap(void);
+
+// Pack Functions
+    void                    AddPackRequest(BufferObject *stagingBuffer,
+                                           GLenum srcFormat, const ImageRect *srcRect,
+                                           GLenum dstFormat, const ImageRect *dstRect, size_t dstOffset,
+                                           uint64_t submitSerial);
+    void                    ResolvePackRequests(void);
 
 // Get Functions
     bool                    GetData(size_t size,
@@ -67,6 +102,11 @@ public:
     inline GLenum           GetTarget(void)                             const   { FUN_ENTRY(GL_LOG_TRACE); return mTarget; }
     inline size_t           GetSize(void)                               const   { FUN_ENTRY(GL_LOG_TRACE); return mBuffer->GetSize(); }
     inline VkBuffer         GetVkBuffer(void)                                   { FUN_ENTRY(GL_LOG_TRACE); return mBuffer->GetVkBuffer(); }
+    inline void*            GetMapPointer(void)                         const   { FUN_ENTRY(GL_LOG_TRACE); return mMapPointer; }
+    inline GLbitfield       GetMapAccess(void)                          const   { FUN_ENTRY(GL_LOG_TRACE); return mMapAccess; }
+    inline size_t           GetMapOffset(void)                          const   { FUN_ENTRY(GL_LOG_TRACE); return mMapOffset; }
+    inline size_t           GetMapLength(void)                          const   { FUN_ENTRY(GL_LOG_TRACE); return mMapLength; }
+    inline uint64_t         GetPackSerial(void)                         const   { FUN_ENTRY(GL_LOG_TRACE); return mPackSerial; }
 
 // Set Functions
     void                    SetTarget(GLenum target);
@@ -77,6 +117,8 @@ public:
 // Has/Is Functions
     inline bool             HasData(void)                               const   { FUN_ENTRY(GL_LOG_TRACE); return mBuffer->GetVkBuffer() != VK_NULL_HANDLE; }
     inline bool             IsIndexBuffer(void)                         const   { FUN_ENTRY(GL_LOG_TRACE); return mBuffer->GetFlags() & VK_BUFFER_USAGE_INDEX_BUFFER_BIT; }
+    inline bool             IsMapped(void)                              const   { FUN_ENTRY(GL_LOG_TRACE); return mMapPointer != nullptr; }
+    inline bool             HasPackRequests(void)                       const   { FUN_ENTRY(GL_LOG_TRACE); return !mPackRequests.empty(); }
 };
 
 class IndexBufferObject : public BufferObject
@@ -34,7 +34,9 @@
 Framebuffer::Framebuffer(const vulkanAPI::vkContext_t *vkContext)
 : mVkContext(vkContext),
 mTarget(GL_INVALID_VALUE), mState(IDLE),
-mUpdated(true), mSizeUpdated(false), mDepthStencilTexture(nullptr),
+mUpdated(true), mSizeUpdated(false),
+mColorUndefined(false), mDepthUndefined(false), mStencilUndefined(false),
+mDepthStencilTexture(nullptr),
 mBindToTexture(false), mSurfaceType(GLOVE_SURFACE_INVALID),
 mIsSystem(false), mEGLSurfaceInterface(nullptr),
 mCacheColorTexture(nullptr), mCacheDepthTexture(nullptr), mCacheStencilTexture(nullptr),
@@ -251,6 +253,12 @@ Framebuffer::CheckStatus(void)
         return GL_FRAMEBUFFER_INCOMPLETE_ATTACHMENT;
     }
 
+    /// a compact format the device cannot render to was kept sample-only
+    if(GetColorAttachmentType() == GL_TEXTURE &&
+       !(GetColorAttachmentTexture()->GetVkImageUsage() & VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT)) {
+        return GL_FRAMEBUFFER_UNSUPPORTED;
+    }
+
     if(GetColorAttachmentType() != GL_NONE && GetDepthAttachmentType() != GL_NONE) {
         if(GetColorAttachmentTexture()->GetWidth()  != GetDepthAttachmentTexture()->GetWidth() ||
            GetColorAttachmentTexture()->GetHeight() != GetDepthAttachmentTexture()->GetHeight()) {
@@ -289,6 +297,17 @@ Framebuffer::CreateVkRenderPass(bool clearColorEnabled, bool clearDepthEnabled,
     mRenderPass->SetDepthWriteEnabled(writeDepthEnabled);
     mRenderPass->SetStencilWriteEnabled(writeStencilEnabled);
 
+    mRenderPass->SetColorLoadEnabled(!mColorUndefined);
+    mRenderPass->SetDepthLoadEnabled(!mDepthUndefined);
+    mRenderPass->SetStencilLoadEnabled(!mStencilUndefined);
+
+    mRenderPass->SetColorLayouts(GetColorAttachmentTexture() ?
+                                 GetColorAttachmentTexture()->GetVkImageLayout() : VK_IMAGE_LAYOUT_UNDEFINED,
+                                 GetColorAttachmentFinalLayout());
+    mRenderPass->SetDepthStencilLayouts(mDepthStencilTexture ?
+                                        mDepthStencilTexture->GetVkImageLayout() : VK_IMAGE_LAYOUT_UNDEFINED,
+                                        VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
+
     return mRenderPass->Create(GetColorAttachmentTexture() ?
                                GetColorAttachmentTexture()->GetVkFormat() : VK_FORMAT_UNDEFINED,
                                mDepthStencilTexture ?
@@ -321,7 +340,7 @@ Framebuffer::CreateDepthStencilTexture(void)
             GetStencilAttachmentTexture() ? GetStencilAttachmentTexture()->GetInternalFormat() : GL_INVALID_VALUE);
 
         // convert to supported format
-        vkformat = FindSupportedDepthStencilFormat(mVkContext->vkGpus[0], GetVkFormatDepthBits(vkformat), GetVkFormatStencilBits(vkformat));
+        vkformat = FindSupportedDepthStencilFormat(mVkContext->vkGpu, GetVkFormatDepthBits(vkformat), GetVkFormatStencilBits(vkformat));
         mDepthStencilTexture->SetVkFormat(vkformat);
         mDepthStencilTexture->SetVkImageUsage(static_cast<VkImageUsageFlagBits>(VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT));
         mDepthStencilTexture->SetVkImageLayout(VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
@@ -339,58 +358,6 @@ Framebuffer::CreateDepthStencilTexture(void)
     }
 }
 
-void
-Framebuffer::UpdateClearDepthStencilTexture(uint32_t clearStencil, uint32_t stencilMaskFront, const Rect& clearRect)
-{
-    GLenum glFormat = VkFormatToGlInternalformat(mDepthStencilTexture->GetVkFormat());
-    size_t numElements = GlInternalFormatTypeToNumElements(glFormat, mDepthStencilTexture->GetExplicitType());
-    ImageRect srcRect(clearRect, numElements, 1, Texture::GetDefaultInternalAlignment());
-
-    ImageRect dstRect = srcRect;
-    dstRect.x = 0;
-    dstRect.y = 0;
-    size_t dstByteSize = dstRect.GetRectBufferSize();
-    uint8_t* dstData = new uint8_t[dstByteSize];
-
-    //retrieve the stored stencil data
-    mDepthStencilTexture->SetDataNoInvertion(true);
-    mDepthStencilTexture->SetImageBufferCopyStencil(true);
-    mDepthStencilTexture->CopyPixelsToHost(&srcRect, &dstRect, 0, 0, glFormat, dstData);
-
-    // size of an entire row in bytes
-    uint32_t dataRowStride = dstRect.GetRectAlignedRowInBytes();
-
-    // rectangle offset in the memory block
-    uint32_t dataCurrentRowIndex = dstRect.GetStartRowIndex(dataRowStride);
-
-    // obtain ptr locations with the byte offset
-    uint8_t* dataPtr = static_cast<uint8_t*>(dstData) + dataCurrentRowIndex;
-
-    GLint depthBits = 0;
-    GLint stencilBits = 0;
-    GlFormatToStorageBits(glFormat, nullptr, nullptr, nullptr, nullptr, &depthBits, &stencilBits);
-    assert(stencilBits > 0);
-
-    // perform the conversion
-    for(int row = 0; row < srcRect.height; ++row) {
-        for(int col = 0; col < srcRect.width; ++col) {
-            uint32_t dataIndex = col * srcRect.GetPixelByteOffset();
-            uint8_t oldStencilValue = dataPtr[dataIndex];
-            uint8_t newStencilValue = (clearStencil & 0xFF) | ((oldStencilValue & 0xFF) & (~(stencilMaskFront & 0xFF)));
-
-            dataPtr[dataIndex] = newStencilValue;
-        }
-        // offset by the number of bytes per row
-        dataPtr = dataPtr + dataRowStride;
-    }
-
-    //update the stencil data
-    mDepthStencilTexture->CopyPixelsFromHost(&dstRect, &srcRect, 0, 0, glFormat, dstData);
-    mDepthStencilTexture->SetImageBufferCopyStencil(false);
-
-    delete[] dstData;
-}
-
 void
 Framebuffer::CheckForUpdatedResources()
 {
@@ -622,13 +589,7 @@ Framebuffer::CreateRenderPass(bool clearColorEnabled, bool clearDepthEnabled, bo
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    if(mUpdated || mSizeUpdated ||
-       static_cast<bool>(mRenderPass->GetColorClearEnabled())   != clearColorEnabled    ||
-       static_cast<bool>(mRenderPass->GetDepthClearEnabled())   != clearDepthEnabled    ||
-       static_cast<bool>(mRenderPass->GetStencilClearEnabled()) != clearStencilEnabled  ||
-       static_cast<bool>(mRenderPass->GetColorWriteEnabled())   != writeColorEnabled    ||
-       static_cast<bool>(mRenderPass->GetDepthWriteEnabled())   != writeDepthEnabled    ||
-       static_cast<bool>(mRenderPass->GetStencilWriteEnabled()) != writeStencilEnabled) {
+    if(mUpdated || mSizeUpdated) {
 
         if(!mIsSystem && mSizeUpdated) {
             CreateDepthStencilTexture();
@@ -639,9 +600,22 @@ Framebuffer::CreateRenderPass(bool clearColorEnabled, bool clearDepthEnabled, bo
         Create();
 
         mUpdated = false;
+    } else if(static_cast<bool>(mRenderPass->GetColorClearEnabled())   != clearColorEnabled    ||
+              static_cast<bool>(mRenderPass->GetDepthClearEnabled())   != clearDepthEnabled    ||
+              static_cast<bool>(mRenderPass->GetStencilClearEnabled()) != clearStencilEnabled  ||
+              static_cast<bool>(mRenderPass->GetColorWriteEnabled())   != writeColorEnabled    ||
+              static_cast<bool>(mRenderPass->GetDepthWriteEnabled())   != writeDepthEnabled    ||
+              static_cast<bool>(mRenderPass->GetStencilWriteEnabled()) != writeStencilEnabled  ||
+              static_cast<bool>(mRenderPass->GetColorLoadEnabled())    == mColorUndefined      ||
+              static_cast<bool>(mRenderPass->GetDepthLoadEnabled())    == mDepthUndefined      ||
+              static_cast<bool>(mRenderPass->GetStencilLoadEnabled())  == mStencilUndefined    ||
+              UpdatedAttachmentLayouts()) {
+        /// load/store ops and layouts do not affect render pass compatibility,
+        /// so the cached variant is picked up and the VkFramebuffers are kept
+        CreateVkRenderPass(clearColorEnabled, clearDepthEnabled, clearStencilEnabled,
+                           writeColorEnabled, writeDepthEnabled, writeStencilEnabled);
     }
 
-
     const VkRect2D clearRect2D = { {clearRect->x, clearRect->y},
                                    {(uint32_t)clearRect->width, (uint32_t)clearRect->height}};
 
@@ -655,11 +629,24 @@ Framebuffer::BeginVkRenderPass()
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    assert(GetCurrentContext());
-    vulkanAPI::CommandBufferManager *commandBufferManager = GetCurrentContext()->GetVkCommandBufferManager();
-    VkCommandBuffer activeCmdBuffer = commandBufferManager->GetActiveCommandBuffer();
     size_t bufferIndex = GetCurrentBufferIndex();
-    mRenderPass->Begin(&activeCmdBuffer, mFramebuffers[bufferIndex]->GetFramebuffer(), true);
+    mRenderPass->Begin(mFramebuffers[bufferIndex]->GetFramebuffer());
+
+    /// the render pass leaves the attachments in their final layouts
+    if(GetColorAttachmentTexture()) {
+        GetColorAttachmentTexture()->SetVkImageLayout(mRenderPass->GetColorFinalLayout());
+    }
+    if(mDepthStencilTexture) {
+        mDepthStencilTexture->SetVkImageLayout(mRenderPass->GetDepthStencilFinalLayout());
+    }
+}
+
+void
+Framebuffer::ExecuteVkCommandBuffer(const VkCommandBuffer *secondaryCmdBuffer)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    mRenderPass->Execute(secondaryCmdBuffer);
 }
 
 bool
@@ -667,12 +654,63 @@ Framebuffer::EndVkRenderPass(void)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
+    /// attachments discarded after the last draw do not need to be written back
+    mRenderPass->SetColorStoreEnabled(!mColorUndefined);
+    mRenderPass->SetDepthStoreEnabled(!mDepthUndefined);
+    mRenderPass->SetStencilStoreEnabled(!mStencilUndefined);
+
     assert(GetCurrentContext());
     vulkanAPI::CommandBufferManager *commandBufferManager = GetCurrentContext()->GetVkCommandBufferManager();
     VkCommandBuffer activeCmdBuffer = commandBufferManager->GetActiveCommandBuffer();
     return mRenderPass->End(&activeCmdBuffer);
 }
 
+void
+Framebuffer::Discard(bool discardColor, bool discardDepth, bool discardStencil)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    /// the next render pass does not load them, and the current one
+    /// does not store them unless it draws again before ending
+    mColorUndefined   |= discardColor;
+    mDepthUndefined   |= discardDepth;
+    mStencilUndefined |= discardStencil;
+}
+
+VkImageLayout
+Framebuffer::GetColorAttachmentFinalLayout(void) const
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    if(!mIsSystem) {
+        return VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    }
+
+    if(mSurfaceType == GLOVE_SURFACE_WINDOW) {
+        return VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+    }
+
+    if(mSurfaceType == GLOVE_SURFACE_PBUFFER && mBindToTexture) {
+        return VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    }
+
+    return VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+}
+
+bool
+Framebuffer::UpdatedAttachmentLayouts(void) const
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    if(GetColorAttachmentTexture() &&
+      (GetColorAttachmentTexture()->GetVkImageLayout() != mRenderPass->GetColorInitialLayout() ||
+       GetColorAttachmentFinalLayout()                 != mRenderPass->GetColorFinalLayout())) {
+        return true;
+    }
+
+    return mDepthStencilTexture && mDepthStencilTexture->GetVkImageLayout() != mRenderPass->GetDepthStencilInitialLayout();
+}
+
 void
 Framebuffer::PrepareVkImage(VkImageLayout newImageLayout)
 {
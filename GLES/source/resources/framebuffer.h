@@ -57,6 +57,11 @@ private:
     bool                            mUpdated;
     bool                            mSizeUpdated;
 
+    /// contents discarded by glDiscardFramebufferEXT or eglSwapBuffers
+    bool                            mColorUndefined;
+    bool                            mDepthUndefined;
+    bool                            mStencilUndefined;
+
     vulkanAPI::RenderPass*          mRenderPass;
     vector<vulkanAPI::Framebuffer*> mFramebuffers;
 
@@ -88,7 +93,6 @@ public:
 // Create Functions
     bool                    Create(void);
     void                    CreateDepthStencilTexture(void);
-    void                    UpdateClearDepthStencilTexture(uint32_t clearStencil, uint32_t stencilMaskFront, const Rect& clearRect);
 
 // RenderPass Functions
     bool                    CreateVkRenderPass(bool clearColorEnabled, bool clearDepthEnabled, bool clearStencilEnabled,
@@ -97,8 +101,12 @@ public:
                                                bool writeColorEnabled, bool writeDepthEnabled, bool writeStencilEnabled,
                                                const float *colorValue, float depthValue, uint32_t stencilValue, const Rect *clearRect);
     void                    BeginVkRenderPass(void);
+    void                    ExecuteVkCommandBuffer(const VkCommandBuffer *secondaryCmdBuffer);
     bool                    EndVkRenderPass(void);
+    void                    Discard(bool discardColor, bool discardDepth, bool discardStencil);
     void                    PrepareVkImage(VkImageLayout newImageLayout);
+    VkImageLayout           GetColorAttachmentFinalLayout(void)         const;
+    bool                    UpdatedAttachmentLayouts(void)              const;
 
 // Add Functions
     void                    AddColorAttachment(Texture *texture);
@@ -155,6 +163,7 @@ public:
            Texture *        GetStencilAttachmentTexture(void)           const;
     inline GLint            GetBindToTexture(void)                      const   { FUN_ENTRY(GL_LOG_TRACE); return mBindToTexture;                  }
     inline GLint            GetSurfaceType(void)                        const   { FUN_ENTRY(GL_LOG_TRACE); return mSurfaceType;                    }
+    inline const EGLSurfaceInterface_t *GetEGLSurfaceInterface(void)    const   { FUN_ENTRY(GL_LOG_TRACE); return mEGLSurfaceInterface;            }
 
 // Set Functions
     inline void             SetEGLSurfaceInterface(const EGLSurfaceInterface_t* eglSurfaceInterface) { FUN_ENTRY(GL_LOG_TRACE); mEGLSurfaceInterface = eglSurfaceInterface; }
@@ -165,6 +174,8 @@ public:
                             ObjectArray<Renderbuffer>       *rbArray)           { FUN_ENTRY(GL_LOG_TRACE); mTextureArray = texArray; mRenderbufferArray = rbArray; }
 
     inline void             SetUpdated(void)                                    { FUN_ENTRY(GL_LOG_TRACE); mUpdated     = true;   }
+    inline void             SetContentsDefined(bool color,
+                                               bool depth, bool stencil)        { FUN_ENTRY(GL_LOG_TRACE); mColorUndefined &= !color; mDepthUndefined &= !depth; mStencilUndefined &= !stencil; }
     inline void             SetIsSystem(void)                                   { FUN_ENTRY(GL_LOG_TRACE); mIsSystem    = true;   }
     inline void             SetStateIdle(void)                                  { FUN_ENTRY(GL_LOG_TRACE); mState       = IDLE;   }
     inline void             SetStateClear(void)                                 { FUN_ENTRY(GL_LOG_TRACE); mState       = CLEAR;  }
@@ -203,6 +214,7 @@ public:
     inline bool             IsInClearDrawState(void)                            { FUN_ENTRY(GL_LOG_TRACE); return (mState == CLEAR_DRAW); }
     inline bool             IsInDeleteState(void)                               { FUN_ENTRY(GL_LOG_TRACE); return (mState == IN_DELETE); }
     inline bool             IsInDrawState(void)                                 { FUN_ENTRY(GL_LOG_TRACE); return !IsInIdleState(); }
+    inline bool             IsVkRenderPassStarted(void)                 const   { FUN_ENTRY(GL_LOG_TRACE); return mRenderPass->IsStarted(); }
 };
 
 #endif // __FRAMEBUFFER_H__
@@ -27,6 +27,7 @@
 
 #include "genericVertexAttribute.h"
 #include "utils/glUtils.h"
+#include "utils/workerPool.h"
 
 GenericVertexAttribute::GenericVertexAttribute()
 : mElements(4), mType(GL_FLOAT), mNormalized(false), mStride(0), mEnabled(false),
@@ -136,40 +137,69 @@ GenericVertexAttribute::UpdateGenericValueVBO(bool& updatedVBO)
     return vbo;
 }
 
-void
-GenericVertexAttribute::ConvertFixedBufferToFloat(BufferObject* vbo, size_t byteSize,
-                                                  void *srcData, size_t numVertices)
+// vertices shared by the bands of a GL_FIXED to GL_FLOAT conversion
+typedef struct fixedToFloatBand {
+    const uint8_t*  srcBuffer;
+    uint8_t*        dstBuffer;
+    size_t          offset;
+    size_t          numElements;
+    size_t          stride;
+} fixedToFloatBand_t;
+
+static void
+ConvertFixedToFloatBand(size_t vertexBegin, size_t vertexEnd, void *data)
 {
-    FUN_ENTRY(GL_LOG_DEBUG);
-
-    const uint8_t* srcBuffer = static_cast<const uint8_t*>(srcData);
-    uint8_t* dstBuffer = new uint8_t[byteSize];
-
-    // this is needed to preserve data in case the buffer contains
-    // other data as well. For efficiency it can be commented out.
-    memcpy(dstBuffer, srcBuffer, byteSize);
+    const fixedToFloatBand_t *band = static_cast<const fixedToFloatBand_t *>(data);
 
     // move the buffers by the corresponding offset (if any)
-    const size_t offset = GetOffset();
-    const size_t numElements = static_cast<size_t>(GetNumElements());
-    const size_t stride = static_cast<size_t>(GetStride());
-
-    for(size_t ver = 0; ver < numVertices; ++ver) {
-        size_t vertexIndex = offset + ver * stride;
-        for(size_t el = 0; el < numElements; ++el) {
+    for(size_t ver = vertexBegin; ver < vertexEnd; ++ver) {
+        size_t vertexIndex = band->offset + ver * band->stride;
+        for(size_t el = 0; el < band->numElements; ++el) {
             size_t srcIndex = vertexIndex + el * sizeof(GLfixed);
             size_t dstIndex = vertexIndex + el * sizeof(float);
-            const GLfixed* val = reinterpret_cast<const GLfixed*>(&srcBuffer[srcIndex]);
+            const GLfixed* val = reinterpret_cast<const GLfixed*>(&band->srcBuffer[srcIndex]);
             float fval = static_cast<float>(*val) / float(1<<16);
             uint8_t* fvalp = reinterpret_cast<uint8_t*>(&fval);
             for(size_t b = 0; b < sizeof(GLfloat); ++b) {
-                dstBuffer[dstIndex + b] = fvalp[b];
+                band->dstBuffer[dstIndex + b] = fvalp[b];
             }
         }
     }
+}
+
+void
+GenericVertexAttribute::ConvertFixedBufferToFloat(BufferObject* vbo, size_t byteSize,
+                                                  void *srcData, size_t numVertices)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    vbo->Allocate(byteSize, nullptr);
+
+    // convert straight into the buffer memory
+    uint8_t* dstBuffer = static_cast<uint8_t*>(vbo->Map(0, byteSize, GL_MAP_WRITE_BIT_EXT));
+    if(dstBuffer == nullptr) {
+        return;
+    }
+
+    fixedToFloatBand_t band;
+    band.srcBuffer   = static_cast<const uint8_t*>(srcData);
+    band.dstBuffer   = dstBuffer;
+    band.offset      = GetOffset();
+    band.numElements = static_cast<size_t>(GetNumElements());
+    band.stride      = static_cast<size_t>(GetStride());
+
+    // this is needed to preserve data in case the buffer contains
+    // other data as well. For efficiency it can be commented out.
+    memcpy(band.dstBuffer, band.srcBuffer, byteSize);
+
+    // vertices only overlap when the attribute is not strided
+    if(band.stride) {
+        WorkerPool::GetInstance()->Run(numVertices, byteSize, ConvertFixedToFloatBand, &band);
+    } else {
+        ConvertFixedToFloatBand(0, numVertices, &band);
+    }
 
-    vbo->Allocate(byteSize, dstBuffer);
-    delete[] dstBuffer;
+    vbo->Unmap();
 }
 
 void
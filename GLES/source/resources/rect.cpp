@@ -29,6 +29,8 @@
 
 #include "rect.h"
 #include "utils/glLogger.h"
+#include "utils/workerPool.h"
+#include <cstddef>
 
 Rect::Rect(int _x, int _y, int _width, int _height)
 : x(_x), y(_y), width(_width), height(_height)
@@ -100,21 +102,85 @@ InvertImageYAxis(uint8_t *image, const ImageRect* rect)
     // size of an entire row in bytes
     const uint32_t rowStride = rect->GetRectAlignedRowInBytes();
 
-    uint8_t *tmpRow = new uint8_t[rowStride];
     uint8_t *srcRow = static_cast<uint8_t *>(image);
     uint8_t *dstRow = static_cast<uint8_t *>(image) + ((rect->height - 1) * rowStride);
 
-    // switch rows
+    // switch rows in place
     for(uint32_t i = 0; i < (uint32_t)(rect->height >> 1); ++i) {
-        memcpy(tmpRow, dstRow, rowStride);
-        memcpy(dstRow, srcRow, rowStride);
-        memcpy(srcRow, tmpRow, rowStride);
+        std::swap_ranges(srcRow, srcRow + rowStride, dstRow);
 
         srcRow += rowStride;
         dstRow -= rowStride;
     }
+}
+
+// returns the first destination row and the step between rows, walking the
+// destination bottom-up when the image has to be flipped on the Y axis
+static inline uint8_t *
+GetDstRowStart(const ImageRect* srcRect, const ImageRect* dstRect, void* dstData, uint32_t dstRowStride, bool invertY, ptrdiff_t *dstRowStep)
+{
+    if(invertY) {
+        ImageRect lastRow = *dstRect;
+        lastRow.y = dstRect->y + srcRect->height - 1;
+        *dstRowStep = -static_cast<ptrdiff_t>(dstRowStride);
+        return static_cast<uint8_t*>(dstData) + lastRow.GetStartRowIndex(dstRowStride);
+    }
+
+    *dstRowStep = static_cast<ptrdiff_t>(dstRowStride);
+    return static_cast<uint8_t*>(dstData) + dstRect->GetStartRowIndex(dstRowStride);
+}
+
+// rows shared by the bands of a pixel copy
+typedef struct copyPixelsBand {
+    const uint8_t*  srcPtr;
+    uint8_t*        dstPtr;
+    uint32_t        srcRowStride;
+    ptrdiff_t       dstRowStep;
+    uint32_t        dataRowSize;
+    int             width;
+    uint32_t        srcPixelSize;
+    uint32_t        dstPixelSize;
+    Color         (*SrcColorFunPtr)(const uint8_t*);
+    void          (*DstColorFunPtr)(Color&, uint8_t*);
+} copyPixelsBand_t;
+
+static void
+CopyPixelsConvertBand(size_t rowBegin, size_t rowEnd, void *data)
+{
+    const copyPixelsBand_t *band = static_cast<const copyPixelsBand_t *>(data);
 
-    delete[] tmpRow;
+    const uint8_t* srcPtr = band->srcPtr + rowBegin * band->srcRowStride;
+    uint8_t* dstPtr = band->dstPtr + static_cast<ptrdiff_t>(rowBegin) * band->dstRowStep;
+
+    // perform the conversion
+    for(size_t row = rowBegin; row < rowEnd; ++row) {
+        for(int col = 0; col < band->width; ++col) {
+            const uint32_t srcIndex = col * band->srcPixelSize;
+            const uint32_t dstIndex = col * band->dstPixelSize;
+            Color color = band->SrcColorFunPtr(&srcPtr[srcIndex]);
+            band->DstColorFunPtr(color, &dstPtr[dstIndex]);
+        }
+        // offset by the number of bytes per row
+        dstPtr = dstPtr + band->dstRowStep;
+        srcPtr = srcPtr + band->srcRowStride;
+    }
+}
+
+static void
+CopyPixelsNoConversionBand(size_t rowBegin, size_t rowEnd, void *data)
+{
+    const copyPixelsBand_t *band = static_cast<const copyPixelsBand_t *>(data);
+
+    const uint8_t* srcPtr = band->srcPtr + rowBegin * band->srcRowStride;
+    uint8_t* dstPtr = band->dstPtr + static_cast<ptrdiff_t>(rowBegin) * band->dstRowStep;
+
+    // copy each row separately
+    for(size_t row = rowBegin; row < rowEnd; ++row) {
+        memcpy(static_cast<void*>(dstPtr), static_cast<const void*>(srcPtr), band->dataRowSize);
+        // offset by the number of bytes per row
+        srcPtr += band->srcRowStride;
+        dstPtr += band->dstRowStep;
+    }
 }
 
 // converts and copies pixels between two buffers with different formats
@@ -126,33 +192,32 @@ CopyPixelsConvert(
             const ImageRect* dstRect,
             void* dstData,
             Color (*SrcColorFunPtr)(const uint8_t*),
-            void (*DstColorFunPtr)(Color&, uint8_t*))
+            void (*DstColorFunPtr)(Color&, uint8_t*),
+            bool invertY)
 {
+    if(srcRect->height <= 0) {
+        return;
+    }
+
+    copyPixelsBand_t band;
 
     // size of an entire row in bytes
-    const uint32_t srcRowStride = srcRect->GetRectAlignedRowInBytes();
+    band.srcRowStride = srcRect->GetRectAlignedRowInBytes();
     const uint32_t dstRowStride = dstRect->GetRectAlignedRowInBytes();
 
-    // rectangle offset in the memory block
-    const uint32_t srcCurrentRowIndex = srcRect->GetStartRowIndex(srcRowStride);
-    const uint32_t dstCurrentRowIndex = dstRect->GetStartRowIndex(dstRowStride);
+    // obtain ptr locations with the byte offset of the rectangle in the memory block
+    band.srcPtr = static_cast<const uint8_t*>(srcData) + srcRect->GetStartRowIndex(band.srcRowStride);
+    band.dstPtr = GetDstRowStart(srcRect, dstRect, dstData, dstRowStride, invertY, &band.dstRowStep);
 
-    // obtain ptr locations with the byte offset
-    const uint8_t* srcPtr = static_cast<const uint8_t*>(srcData) + srcCurrentRowIndex;
-    uint8_t* dstPtr = static_cast<uint8_t*>(dstData) + dstCurrentRowIndex;
+    band.dataRowSize    = srcRect->GetDataRowSize();
+    band.width          = srcRect->width;
+    band.srcPixelSize   = srcRect->GetPixelByteOffset();
+    band.dstPixelSize   = dstRect->GetPixelByteOffset();
+    band.SrcColorFunPtr = SrcColorFunPtr;
+    band.DstColorFunPtr = DstColorFunPtr;
 
-    // perform the conversion
-    for(int row = 0; row < srcRect->height; ++row) {
-        for(int col = 0; col < srcRect->width; ++col) {
-            const uint32_t srcIndex = col * srcRect->GetPixelByteOffset();
-            const uint32_t dstIndex = col * dstRect->GetPixelByteOffset();
-            Color color = SrcColorFunPtr(&srcPtr[srcIndex]);
-            DstColorFunPtr(color, &dstPtr[dstIndex]);
-        }
-        // offset by the number of bytes per row
-        dstPtr = dstPtr + dstRowStride;
-        srcPtr = srcPtr + srcRowStride;
-    }
+    WorkerPool::GetInstance()->Run(srcRect->height, srcRect->GetRectBufferSize() + dstRect->GetRectBufferSize(),
+                                   CopyPixelsConvertBand, &band);
 }
 
 // copies pixels between two buffers
@@ -162,42 +227,47 @@ CopyPixelsNoConversion(
             const ImageRect* srcRect,
             const void* srcData,
             const ImageRect* dstRect,
-            void* dstData)
+            void* dstData,
+            bool invertY)
 {
     assert(srcRect->mNumElements == dstRect->mNumElements);
 
-    // size of an entire row in bytes
-    uint32_t srcRowStride = srcRect->GetRectAlignedRowInBytes();
-    uint32_t dstRowStride = dstRect->GetRectAlignedRowInBytes();
+    if(srcRect->height <= 0) {
+        return;
+    }
+
+    copyPixelsBand_t band;
 
-    // rectangle offset in the memory block
-    uint32_t srcCurrentRowIndex = srcRect->GetStartRowIndex(srcRowStride);
-    uint32_t dstCurrentRowIndex = dstRect->GetStartRowIndex(dstRowStride);
+    // size of an entire row in bytes
+    band.srcRowStride = srcRect->GetRectAlignedRowInBytes();
+    const uint32_t dstRowStride = dstRect->GetRectAlignedRowInBytes();
 
-    // obtain ptr locations with the byte offset
-    const uint8_t* srcPtr = static_cast<const uint8_t*>(srcData) + srcCurrentRowIndex;
-    uint8_t* dstPtr = static_cast<uint8_t*>(dstData) + dstCurrentRowIndex;
+    // obtain ptr locations with the byte offset of the rectangle in the memory block
+    band.srcPtr = static_cast<const uint8_t*>(srcData) + srcRect->GetStartRowIndex(band.srcRowStride);
+    band.dstPtr = GetDstRowStart(srcRect, dstRect, dstData, dstRowStride, invertY, &band.dstRowStep);
 
     // get the buffer size for each row containing the actual data
     // (i.e., without any padding applied)
-    const uint32_t dataRowSize = srcRect->GetDataRowSize();
-
-    // copy each row separately
-    for(int row = 0; row < srcRect->height; ++row) {
-        memcpy(static_cast<void*>(dstPtr), static_cast<const void*>(srcPtr), dataRowSize);
-        // offset by the number of bytes per row
-        srcPtr += srcRowStride;
-        dstPtr += dstRowStride;
-    }
+    band.dataRowSize    = srcRect->GetDataRowSize();
+    band.width          = srcRect->width;
+    band.srcPixelSize   = srcRect->GetPixelByteOffset();
+    band.dstPixelSize   = dstRect->GetPixelByteOffset();
+    band.SrcColorFunPtr = nullptr;
+    band.DstColorFunPtr = nullptr;
+
+    WorkerPool::GetInstance()->Run(srcRect->height, srcRect->GetRectBufferSize() + dstRect->GetRectBufferSize(),
+                                   CopyPixelsNoConversionBand, &band);
 }
 
-// copies and converts pixels between buffers
+// copies and converts pixels between buffers, optionally flipping
+// the rows on the Y axis in the same pass
 void
 ConvertPixels(GLenum srcFormat, GLenum dstFormat,
               ImageRect* srcRect,
               const void* srcData,
               ImageRect* dstRect,
-              void* dstData)
+              void* dstData,
+              bool invertY)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
@@ -207,24 +277,24 @@ ConvertPixels(GLenum srcFormat, GLenum dstFormat,
         switch(dstFormat) {
         case GL_BGRA8_EXT:
         case GL_BGRA_EXT:
-            CopyPixelsNoConversion(srcRect, srcData, dstRect, dstData);
+            CopyPixelsNoConversion(srcRect, srcData, dstRect, dstData, invertY);
             break;
         case GL_RGBA:
         case GL_RGBA8_OES:
-            CopyPixelsConvert(srcRect, srcData, dstRect, dstData, &Color::FromBGRA, &Color::ConvertToRGBA);
+            CopyPixelsConvert(srcRect, srcData, dstRect, dstData, &Color::FromBGRA, &Color::ConvertToRGBA, invertY);
             break;
         case GL_LUMINANCE_ALPHA:
-            CopyPixelsConvert(srcRect, srcData, dstRect, dstData, &Color::FromBGRA, &Color::ConvertToLuminanceAlpha);
+            CopyPixelsConvert(srcRect, srcData, dstRect, dstData, &Color::FromBGRA, &Color::ConvertToLuminanceAlpha, invertY);
             break;
         case GL_LUMINANCE:
-            CopyPixelsConvert(srcRect, srcData, dstRect, dstData, &Color::FromBGRA, &Color::ConvertToLuminance);
+            CopyPixelsConvert(srcRect, srcData, dstRect, dstData, &Color::FromBGRA, &Color::ConvertToLuminance, invertY);
             break;
         case GL_ALPHA:
-            CopyPixelsConvert(srcRect, srcData, dstRect, dstData, &Color::FromBGRA, &Color::ConvertToAlpha);
+            CopyPixelsConvert(srcRect, srcData, dstRect, dstData, &Color::FromBGRA, &Color::ConvertToAlpha, invertY);
             break;
         case GL_RGB:
         case GL_RGB8_OES:
-            CopyPixelsConvert(srcRect, srcData, dstRect, dstData, &Color::FromBGRA, &Color::ConvertToRGB);
+            CopyPixelsConvert(srcRect, srcData, dstRect, dstData, &Color::FromBGRA, &Color::ConvertToRGB, invertY);
             break;
 
         default: NOT_FOUND_ENUM(dstFormat); break;
@@ -235,14 +305,14 @@ ConvertPixels(GLenum srcFormat, GLenum dstFormat,
         switch(dstFormat) {
         case GL_RGBA:
         case GL_RGBA8_OES:
-            CopyPixelsNoConversion(srcRect, srcData, dstRect, dstData);
+            CopyPixelsNoConversion(srcRect, srcData, dstRect, dstData, invertY);
             break;
         case GL_RGB:
         case GL_RGB8_OES:
-            CopyPixelsConvert(srcRect, srcData, dstRect, dstData, &Color::FromRGBA, &Color::ConvertToRGB);
+            CopyPixelsConvert(srcRect, srcData, dstRect, dstData, &Color::FromRGBA, &Color::ConvertToRGB, invertY);
             break;
         case GL_ALPHA:
-            CopyPixelsConvert(srcRect, srcData, dstRect, dstData, &Color::FromRGBA, &Color::ConvertToAlpha);
+            CopyPixelsConvert(srcRect, srcData, dstRect, dstData, &Color::FromRGBA, &Color::ConvertToAlpha, invertY);
             break;
 
         default: NOT_FOUND_ENUM(dstFormat); break;
@@ -254,10 +324,10 @@ ConvertPixels(GLenum srcFormat, GLenum dstFormat,
         switch(dstFormat) {
         case GL_RGB:
         case GL_RGB8_OES:
-            CopyPixelsNoConversion(srcRect, srcData, dstRect, dstData);
+            CopyPixelsNoConversion(srcRect, srcData, dstRect, dstData, invertY);
             break;
         case GL_RGBA8_OES:
-            CopyPixelsConvert(srcRect, srcData, dstRect, dstData, &Color::FromRGB, &Color::ConvertToRGBA);
+            CopyPixelsConvert(srcRect, srcData, dstRect, dstData, &Color::FromRGB, &Color::ConvertToRGBA, invertY);
             break;
         default: NOT_FOUND_ENUM(dstFormat); break;
         }
@@ -266,14 +336,14 @@ ConvertPixels(GLenum srcFormat, GLenum dstFormat,
     case GL_LUMINANCE_ALPHA: {
         switch(dstFormat) {
         case GL_LUMINANCE_ALPHA:
-            CopyPixelsNoConversion(srcRect, srcData, dstRect, dstData);
+            CopyPixelsNoConversion(srcRect, srcData, dstRect, dstData, invertY);
             break;
         case GL_LUMINANCE:
-            CopyPixelsConvert(srcRect, srcData, dstRect, dstData, &Color::FromLuminanceAlpha, &Color::ConvertToLuminance);
+            CopyPixelsConvert(srcRect, srcData, dstRect, dstData, &Color::FromLuminanceAlpha, &Color::ConvertToLuminance, invertY);
             break;
         case GL_RGBA:
         case GL_RGBA8_OES:
-            CopyPixelsConvert(srcRect, srcData, dstRect, dstData, &Color::FromLuminanceAlpha, &Color::ConvertToRGBA);
+            CopyPixelsConvert(srcRect, srcData, dstRect, dstData, &Color::FromLuminanceAlpha, &Color::ConvertToRGBA, invertY);
             break;
         default: NOT_FOUND_ENUM(dstFormat); break;
         }
@@ -282,14 +352,14 @@ ConvertPixels(GLenum srcFormat, GLenum dstFormat,
     case GL_LUMINANCE: {
         switch(dstFormat) {
         case GL_LUMINANCE:
-            CopyPixelsNoConversion(srcRect, srcData, dstRect, dstData);
+            CopyPixelsNoConversion(srcRect, srcData, dstRect, dstData, invertY);
             break;
         case GL_LUMINANCE_ALPHA:
-            CopyPixelsConvert(srcRect, srcData, dstRect, dstData, &Color::FromLuminance, &Color::ConvertToLuminanceAlpha);
+            CopyPixelsConvert(srcRect, srcData, dstRect, dstData, &Color::FromLuminance, &Color::ConvertToLuminanceAlpha, invertY);
             break;
         case GL_RGBA:
         case GL_RGBA8_OES:
-            CopyPixelsConvert(srcRect, srcData, dstRect, dstData, &Color::FromLuminance, &Color::ConvertToRGBA);
+            CopyPixelsConvert(srcRect, srcData, dstRect, dstData, &Color::FromLuminance, &Color::ConvertToRGBA, invertY);
             break;
         default: NOT_FOUND_ENUM(dstFormat); break;
         }
@@ -298,11 +368,11 @@ ConvertPixels(GLenum srcFormat, GLenum dstFormat,
     case GL_ALPHA: {
         switch(dstFormat) {
         case GL_ALPHA:
-            CopyPixelsNoConversion(srcRect, srcData, dstRect, dstData);
+            CopyPixelsNoConversion(srcRect, srcData, dstRect, dstData, invertY);
             break;
         case GL_RGBA:
         case GL_RGBA8_OES:
-            CopyPixelsConvert(srcRect, srcData, dstRect, dstData, &Color::FromAlpha, &Color::ConvertToRGBA);
+            CopyPixelsConvert(srcRect, srcData, dstRect, dstData, &Color::FromAlpha, &Color::ConvertToRGBA, invertY);
             break;
         default: NOT_FOUND_ENUM(dstFormat); break;
         }
@@ -311,11 +381,11 @@ ConvertPixels(GLenum srcFormat, GLenum dstFormat,
     case GL_RGBA4:
         switch(dstFormat) {
         case GL_RGBA4:
-            CopyPixelsNoConversion(srcRect, srcData, dstRect, dstData);
+            CopyPixelsNoConversion(srcRect, srcData, dstRect, dstData, invertY);
             break;
         case GL_RGBA:
         case GL_RGBA8_OES:
-            CopyPixelsConvert(srcRect, srcData, dstRect, dstData, &Color::From4444, &Color::ConvertToRGBA);
+            CopyPixelsConvert(srcRect, srcData, dstRect, dstData, &Color::From4444, &Color::ConvertToRGBA, invertY);
             break;
         default: NOT_FOUND_ENUM(dstFormat); break;
         }
@@ -324,11 +394,11 @@ ConvertPixels(GLenum srcFormat, GLenum dstFormat,
     case GL_RGB5_A1:
         switch(dstFormat) {
         case GL_RGB5_A1:
-            CopyPixelsNoConversion(srcRect, srcData, dstRect, dstData);
+            CopyPixelsNoConversion(srcRect, srcData, dstRect, dstData, invertY);
             break;
         case GL_RGBA:
         case GL_RGBA8_OES:
-            CopyPixelsConvert(srcRect, srcData, dstRect, dstData, &Color::From5551, &Color::ConvertToRGBA);
+            CopyPixelsConvert(srcRect, srcData, dstRect, dstData, &Color::From5551, &Color::ConvertToRGBA, invertY);
             break;
         default: NOT_FOUND_ENUM(dstFormat); break;
         }
@@ -337,15 +407,15 @@ ConvertPixels(GLenum srcFormat, GLenum dstFormat,
     case GL_RGB565:
         switch(dstFormat) {
         case GL_RGB565:
-            CopyPixelsNoConversion(srcRect, srcData, dstRect, dstData);
+            CopyPixelsNoConversion(srcRect, srcData, dstRect, dstData, invertY);
             break;
         case GL_RGBA:
         case GL_RGB8_OES:
         case GL_RGBA8_OES:
-            CopyPixelsConvert(srcRect, srcData, dstRect, dstData, &Color::From565, &Color::ConvertToRGBA);
+            CopyPixelsConvert(srcRect, srcData, dstRect, dstData, &Color::From565, &Color::ConvertToRGBA, invertY);
             break;
         case GL_LUMINANCE:
-            CopyPixelsConvert(srcRect, srcData, dstRect, dstData, &Color::From565, &Color::ConvertToLuminance);
+            CopyPixelsConvert(srcRect, srcData, dstRect, dstData, &Color::From565, &Color::ConvertToLuminance, invertY);
             break;
         default: NOT_FOUND_ENUM(dstFormat); break;
         }
@@ -356,7 +426,7 @@ ConvertPixels(GLenum srcFormat, GLenum dstFormat,
         switch(dstFormat) {
         case GL_UNSIGNED_INT_24_8_OES:
         case GL_DEPTH24_STENCIL8_OES:
-            CopyPixelsNoConversion(srcRect, srcData, dstRect, dstData);
+            CopyPixelsNoConversion(srcRect, srcData, dstRect, dstData, invertY);
             break;
         default: NOT_FOUND_ENUM(dstFormat); break;
         }
@@ -365,7 +435,7 @@ ConvertPixels(GLenum srcFormat, GLenum dstFormat,
     case GL_STENCIL_INDEX8_OES:
        switch(dstFormat) {
        case GL_STENCIL_INDEX8_OES:
-           CopyPixelsNoConversion(srcRect, srcData, dstRect, dstData);
+           CopyPixelsNoConversion(srcRect, srcData, dstRect, dstData, invertY);
            break;
        default: NOT_FOUND_ENUM(dstFormat); break;
        }
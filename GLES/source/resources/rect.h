@@ -77,18 +77,21 @@ void                    CopyPixelsNoConversion(
                         const ImageRect* srcRect,
                         const void* srcData,
                         const ImageRect* dstRect,
-                        void* dstData);
+                        void* dstData,
+                        bool invertY = false);
 void                    CopyPixelsConvert(
                         const ImageRect* srcRect,
                         const void* srcData,
                         const ImageRect* dstRect,
                         void* dstData,
                         Color (*SrcColorFunPtr)(const uint8_t*),
-                                          void (*DstColorFunPtr)(struct Color&, uint8_t*));
+                                          void (*DstColorFunPtr)(struct Color&, uint8_t*),
+                        bool invertY = false);
 void                    ConvertPixels(GLenum srcFormat , GLenum dstFormat,
                         ImageRect* srcRect,
                         const void* srcData,
                         ImageRect* dstRect,
-                        void* dstData);
+                        void* dstData,
+                        bool invertY = false);
 
 #endif // __RECT_H__
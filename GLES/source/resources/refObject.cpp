@@ -39,7 +39,6 @@ refObject::Bind()
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    //TODO: mutex lock
     refCount++;
     return 0;
 }
@@ -49,7 +48,6 @@ refObject::Unbind()
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    //TODO: mutex lock
     refCount--;
     assert(refCount >= 0);
     return 0;
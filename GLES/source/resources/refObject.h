@@ -25,11 +25,14 @@
 #define __REFOBJECT_H_
 
 #include "utils/glLogger.h"
+#include <atomic>
 
+/// Objects of a share group are bound by the contexts of several threads,
+/// so the reference count is atomic.
 class refObject {
 private:
-    int   refCount;
-    int   markForDeletion;
+    std::atomic<int>  refCount;
+    std::atomic<bool> markForDeletion;
 
 public:
 // Constructor
@@ -40,7 +43,7 @@ public:
 
     int Bind();
     int Unbind();
-    int GetRefCount()                             { FUN_ENTRY(GL_LOG_TRACE); return refCount; }
+    int GetRefCount()                       const { FUN_ENTRY(GL_LOG_TRACE); return refCount; }
     bool FreeForDeletion()                  const { FUN_ENTRY(GL_LOG_TRACE); return refCount == 0; }
     bool GetMarkForDeletion()                     { FUN_ENTRY(GL_LOG_TRACE); return markForDeletion; }
     void SetMarkForDeletion(bool flag)            { FUN_ENTRY(GL_LOG_TRACE); markForDeletion = flag;}
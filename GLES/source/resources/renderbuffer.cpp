@@ -66,7 +66,7 @@ Renderbuffer::InitTexture(void)
 }
 
 bool
-Renderbuffer::Allocate(GLint width, GLint height, GLenum internalformat)
+Renderbuffer::Allocate(GLint width, GLint height, GLenum internalformat, CacheManager *cacheManager)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
@@ -83,7 +83,7 @@ Renderbuffer::Allocate(GLint width, GLint height, GLenum internalformat)
         mTexture->SetVkImageUsage(static_cast<VkImageUsageFlagBits>(VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT));
     } else {
         // convert to supported format
-        vkformat = FindSupportedDepthStencilFormat(mVkContext->vkGpus[0], GetVkFormatDepthBits(vkformat), GetVkFormatStencilBits(vkformat));
+        vkformat = FindSupportedDepthStencilFormat(mVkContext->vkGpu, GetVkFormatDepthBits(vkformat), GetVkFormatStencilBits(vkformat));
         mTexture->SetVkFormat(vkformat);
         mTexture->SetVkImageUsage(static_cast<VkImageUsageFlagBits>(VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT));
     }
@@ -92,5 +92,5 @@ Renderbuffer::Allocate(GLint width, GLint height, GLenum internalformat)
     mTexture->SetState(width, height, 0, 0, GlInternalFormatToGlFormat(mInternalFormat),
                        GlInternalFormatToGlType(mInternalFormat), Texture::GetDefaultInternalAlignment(), nullptr);
 
-    return mTexture->Allocate();
+    return mTexture->Allocate(cacheManager);
 }
@@ -42,7 +42,7 @@ public:
     ~Renderbuffer();
 
 // Allocate Functions
-           bool        Allocate(GLint width, GLint height, GLenum internalformat);
+           bool        Allocate(GLint width, GLint height, GLenum internalformat, CacheManager *cacheManager = nullptr);
 
 // Release Functions
            void        Release(void);
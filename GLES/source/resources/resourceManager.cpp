@@ -28,13 +28,23 @@
 
 #include "resourceManager.h"
 
-ResourceManager::ResourceManager(const vulkanAPI::vkContext_t *vkContext):
+ResourceManager::ResourceManager(const vulkanAPI::vkContext_t *vkContext, ShareGroup *shareGroup):
     mVkContext(vkContext),
-    mShadingObjectCount(1),
+    mShareGroup(shareGroup ? shareGroup : new ShareGroup(vkContext)),
+    mCommandBufferManager(nullptr),
+    mCacheManager(nullptr),
     mGenericVertexAttributes(GLOVE_MAX_VERTEX_ATTRIBS)
 {
     FUN_ENTRY(GL_LOG_TRACE);
 
+    mShareGroup->Ref();
+
+    mBuffers        = mShareGroup->GetBufferArray();
+    mRenderbuffers  = mShareGroup->GetRenderbufferArray();
+    mTextures       = mShareGroup->GetTextureArray();
+    mShaders        = mShareGroup->GetShaderArray();
+    mShaderPrograms = mShareGroup->GetShaderProgramArray();
+
     CreateDefaultTextures();
 
     for(auto& gva : mGenericVertexAttributes) {
@@ -53,16 +63,37 @@ ResourceManager::~ResourceManager()
         gva.Release();
     }
     mGenericVertexAttributes.clear();
+
+    if(mCommandBufferManager != nullptr) {
+        mShareGroup->RemoveMember(mCommandBufferManager);
+    }
+
+    // the shared objects are destroyed along with the last context of the group
+    if(mShareGroup->Unref() == 0) {
+        delete mShareGroup;
+    }
+    mShareGroup = nullptr;
 }
 
 void
 ResourceManager::SetCacheManager(CacheManager *cacheManager)
 {
+    mCacheManager = cacheManager;
+
     for(auto& gva : mGenericVertexAttributes) {
         gva.SetCacheManager(cacheManager);
     }
 }
 
+void
+ResourceManager::SetCommandBufferManager(const vulkanAPI::CommandBufferManager *commandBufferManager)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    mCommandBufferManager = commandBufferManager;
+    mShareGroup->AddMember(commandBufferManager);
+}
+
 void
 ResourceManager::CreateDefaultTextures()
 {
@@ -85,62 +116,6 @@ ResourceManager::CreateDefaultTextures()
     mDefaultTextureCubeMap->InitState();
 }
 
-
-uint32_t
-ResourceManager::PushShadingObject(const ShadingNamespace_t& obj)
-{
-    FUN_ENTRY(GL_LOG_TRACE);
-    mShadingObjectPool[mShadingObjectCount] = obj;
-    return mShadingObjectCount++;
-}
-
-void
-ResourceManager::EraseShadingObject(uint32_t id)
-{
-    FUN_ENTRY(GL_LOG_TRACE);
-    mShadingObjectPool.erase(id);
-}
-
-GLboolean
-ResourceManager::IsShadingObject(GLuint index, shadingNamespaceType_t type) const
-{
-    FUN_ENTRY(GL_LOG_DEBUG);
-
-    if(!index || index >= mShadingObjectCount || !ShadingObjectExists(index)) {
-        return GL_FALSE;
-    }
-
-    ShadingNamespace_t shadId = mShadingObjectPool.find(index)->second;
-    return (shadId.arrayIndex && shadId.type == type) ? GL_TRUE : GL_FALSE;
-}
-
-uint32_t
-ResourceManager::FindShaderID(const Shader *shader)
-{
-    FUN_ENTRY(GL_LOG_DEBUG);
-
-    for(shadingPoolIDs_t::iterator it = mShadingObjectPool.begin(); it != mShadingObjectPool.end(); ++it) {
-        if(it->second.type == SHADER_ID && GetShaderID(shader) == it->second.arrayIndex) {
-            return it->first;
-        }
-    }
-    return 0;
-}
-
-uint32_t
-ResourceManager::FindShaderProgramID(const ShaderProgram *program)
-{
-   FUN_ENTRY(GL_LOG_DEBUG);
-
-   for(shadingPoolIDs_t::iterator it = mShadingObjectPool.begin(); it != mShadingObjectPool.end(); ++it) {
-        if(it->second.type == SHADER_PROGRAM_ID && GetShaderProgramID(program) == it->second.arrayIndex) {
-            return it->first;
-        }
-    }
-    return 0;
-}
-
-
 void
 ResourceManager::UpdateFramebufferObjects(GLuint index, GLenum target)
 {
@@ -174,65 +149,6 @@ ResourceManager::IsTextureAttachedToFBO(const Texture *texture)
     return false;
 }
 
-void
-ResourceManager::CleanPurgeList()
-{
-    FUN_ENTRY(GL_LOG_DEBUG);
-
-    //Buffers
-    for (auto it = mPurgeListBufferObject.begin(); it != mPurgeListBufferObject.end(); ) {
-        if ((*it)->GetRefCount() == 0) {
-            delete *it;
-            it = mPurgeListBufferObject.erase(it);
-        } else {
-            ++it;
-        }
-    }
-    //Textures
-    for (auto it = mPurgeListTexture.begin(); it != mPurgeListTexture.end(); ) {
-        if ((*it)->GetRefCount() == 0) {
-            delete *it;
-            it = mPurgeListTexture.erase(it);
-        } else {
-            ++it;
-        }
-    }
-    //Shader Programs
-    for (auto it = mPurgeListShaderPrograms.begin(); it != mPurgeListShaderPrograms.end();) {
-        ShaderProgram* shaderProgramPtr = *it;
-        if (shaderProgramPtr->FreeForDeletion()) {
-            shaderProgramPtr->DetachShaders();
-            uint32_t id = FindShaderProgramID(shaderProgramPtr);
-            EraseShadingObject(id);
-            DeallocateShaderProgram(shaderProgramPtr);
-            it = mPurgeListShaderPrograms.erase(it);
-        } else {
-            ++it;
-        }
-    }
-    //Shaders
-    for (auto it = mPurgeListShaders.begin(); it != mPurgeListShaders.end();) {
-        Shader* shaderPtr = *it;
-        if (shaderPtr->FreeForDeletion()) {
-            uint32_t id = FindShaderID(shaderPtr);
-            EraseShadingObject(id);
-            DeallocateShader(shaderPtr);
-            it = mPurgeListShaders.erase(it);
-        } else {
-            ++it;
-        }
-    }
-    //Renderbuffer
-    for (auto it = mPurgeListRenderbuffers.begin(); it != mPurgeListRenderbuffers.end(); ) {
-        if ((*it)->GetRefCount() == 0) {
-            delete *it;
-            it = mPurgeListRenderbuffers.erase(it);
-        } else {
-            ++it;
-        }
-    }
-}
-
 void
 ResourceManager::FramebufferCacheAttachement(Texture *texture, GLuint index)
 {
@@ -24,128 +24,115 @@
 #ifndef __RESOURCEMANAGER_H__
 #define __RESOURCEMANAGER_H__
 
-#include "resources/bufferObject.h"
 #include "resources/framebuffer.h"
-#include "resources/shaderProgram.h"
-#include "resources/renderbuffer.h"
-#include "resources/shader.h"
-#include "resources/texture.h"
-#include "utils/cacheManager.h"
-
-typedef enum {
-    NO_ID,
-    SHADER_ID,
-    SHADER_PROGRAM_ID
-} shadingNamespaceType_t;
-
-typedef struct {
-    shadingNamespaceType_t                 type;
-    uint32_t                               arrayIndex;
-} ShadingNamespace_t;
+#include "resources/shareGroup.h"
 
+/// Textures, buffers, renderbuffers, shaders and programs live in a ShareGroup that
+/// may be shared with other contexts; framebuffers and vertex attributes are per context.
 class ResourceManager {
 private:
 
     const vulkanAPI::vkContext_t              *mVkContext;
-    typedef ObjectArray<Texture>               TextureArray;
-    typedef ObjectArray<BufferObject>          BufferArray;
-    typedef ObjectArray<Shader>                ShaderArray;
-    typedef ObjectArray<ShaderProgram>         ShaderProgramArray;
-    typedef ObjectArray<Renderbuffer>          RenderbufferArray;
+    typedef ShareGroup::TextureArray           TextureArray;
+    typedef ShareGroup::BufferArray            BufferArray;
+    typedef ShareGroup::ShaderArray            ShaderArray;
+    typedef ShareGroup::ShaderProgramArray     ShaderProgramArray;
+    typedef ShareGroup::RenderbufferArray      RenderbufferArray;
     typedef ObjectArray<Framebuffer>           FramebufferArray;
-    typedef map<uint32_t, ShadingNamespace_t>  shadingPoolIDs_t;
 
-    BufferArray                                mBuffers;
-    RenderbufferArray                          mRenderbuffers;
-    FramebufferArray                           mFramebuffers;
-    TextureArray                               mTextures;
+    ShareGroup                                *mShareGroup;
+    const vulkanAPI::CommandBufferManager     *mCommandBufferManager;
+    CacheManager                              *mCacheManager;
 
-    uint32_t                                   mShadingObjectCount;
-    shadingPoolIDs_t                           mShadingObjectPool;
-    ShaderArray                                mShaders;
-    ShaderProgramArray                         mShaderPrograms;
+    BufferArray                               *mBuffers;
+    RenderbufferArray                         *mRenderbuffers;
+    FramebufferArray                           mFramebuffers;
+    TextureArray                              *mTextures;
+    ShaderArray                               *mShaders;
+    ShaderProgramArray                        *mShaderPrograms;
 
     Texture                                   *mDefaultTexture2D;
     Texture                                   *mDefaultTextureCubeMap;
     std::vector<GenericVertexAttribute>        mGenericVertexAttributes;
-    std::vector<BufferObject*>                 mPurgeListBufferObject;
-    std::vector<Texture*>                      mPurgeListTexture;
-    std::vector<Shader*>                       mPurgeListShaders;
-    std::vector<ShaderProgram*>                mPurgeListShaderPrograms;
-    std::vector<Renderbuffer*>                 mPurgeListRenderbuffers;
 
 public:
-    ResourceManager(const vulkanAPI::vkContext_t *vkContext);
+    ResourceManager(const vulkanAPI::vkContext_t *vkContext, ShareGroup *shareGroup);
     ~ResourceManager();
 
 // Allocate/Deallocate Functions
-    inline GLuint              AllocateTexture(void)                            { FUN_ENTRY(GL_LOG_TRACE); return mTextures.Allocate(); }
-    inline GLuint              AllocateBuffer(void)                             { FUN_ENTRY(GL_LOG_TRACE); return mBuffers.Allocate(); }
-    inline GLuint              AllocateRenderbuffer(void)                       { FUN_ENTRY(GL_LOG_TRACE); return mRenderbuffers.Allocate(); }
+    inline GLuint              AllocateTexture(void)                            { FUN_ENTRY(GL_LOG_TRACE); return mTextures->Allocate(); }
+    inline GLuint              AllocateBuffer(void)                             { FUN_ENTRY(GL_LOG_TRACE); return mBuffers->Allocate(); }
+    inline GLuint              AllocateRenderbuffer(void)                       { FUN_ENTRY(GL_LOG_TRACE); return mRenderbuffers->Allocate(); }
     inline GLuint              AllocateFramebuffer(void)                        { FUN_ENTRY(GL_LOG_TRACE); return mFramebuffers.Allocate(); }
-    inline GLuint              AllocateShader(void)                             { FUN_ENTRY(GL_LOG_TRACE); return mShaders.Allocate(); }
-    inline GLuint              AllocateShaderProgram(void)                      { FUN_ENTRY(GL_LOG_TRACE); return mShaderPrograms.Allocate(); }
-    inline void                DeallocateTexture(uint32_t index)                { FUN_ENTRY(GL_LOG_TRACE); mTextures.Deallocate(index); }
-    inline void                DeallocateBuffer(uint32_t index)                 { FUN_ENTRY(GL_LOG_TRACE); mBuffers.Deallocate(index); }
-    inline void                DeallocateRenderbuffer(uint32_t index)           { FUN_ENTRY(GL_LOG_TRACE); mRenderbuffers.Deallocate(index); }
+    inline GLuint              AllocateShader(void)                             { FUN_ENTRY(GL_LOG_TRACE); return mShaders->Allocate(); }
+    inline GLuint              AllocateShaderProgram(void)                      { FUN_ENTRY(GL_LOG_TRACE); return mShaderPrograms->Allocate(); }
+    inline void                DeallocateTexture(uint32_t index)                { FUN_ENTRY(GL_LOG_TRACE); mTextures->Deallocate(index); }
+    inline void                DeallocateBuffer(uint32_t index)                 { FUN_ENTRY(GL_LOG_TRACE); mBuffers->Deallocate(index); }
+    inline void                DeallocateRenderbuffer(uint32_t index)           { FUN_ENTRY(GL_LOG_TRACE); mRenderbuffers->Deallocate(index); }
     inline void                DeallocateFramebuffer(uint32_t index)            { FUN_ENTRY(GL_LOG_TRACE); mFramebuffers.Deallocate(index); }
-    inline void                DeallocateShader(Shader *shader)                 { FUN_ENTRY(GL_LOG_TRACE); mShaders.Deallocate(mShaders.GetObjectId(shader)); }
-    inline void                DeallocateShaderProgram(ShaderProgram *program)  { FUN_ENTRY(GL_LOG_TRACE); mShaderPrograms.Deallocate(mShaderPrograms.GetObjectId(program)); }
-    inline void                RemoveFromListTexture(uint32_t index)            { FUN_ENTRY(GL_LOG_TRACE); mTextures.RemoveFromList(index); }
-    inline void                RemoveFromListBuffer(uint32_t index)             { FUN_ENTRY(GL_LOG_TRACE); mBuffers.RemoveFromList(index); }
-    inline void                RemoveFromListRenderbuffer(uint32_t index)       { FUN_ENTRY(GL_LOG_TRACE); mRenderbuffers.RemoveFromList(index); }
+    inline void                DeallocateShader(Shader *shader)                 { FUN_ENTRY(GL_LOG_TRACE); mShaders->Deallocate(mShaders->GetObjectId(shader)); }
+    inline void                DeallocateShaderProgram(ShaderProgram *program)  { FUN_ENTRY(GL_LOG_TRACE); mShaderPrograms->Deallocate(mShaderPrograms->GetObjectId(program)); }
+    inline void                RemoveFromListTexture(uint32_t index)            { FUN_ENTRY(GL_LOG_TRACE); mTextures->RemoveFromList(index); }
+    inline void                RemoveFromListBuffer(uint32_t index)             { FUN_ENTRY(GL_LOG_TRACE); mBuffers->RemoveFromList(index); }
+    inline void                RemoveFromListRenderbuffer(uint32_t index)       { FUN_ENTRY(GL_LOG_TRACE); mRenderbuffers->RemoveFromList(index); }
 
 // Get Functions
     inline std::vector<GenericVertexAttribute>& GetGenericVertexAttributes(void) { FUN_ENTRY(GL_LOG_TRACE); return mGenericVertexAttributes; }
     inline GenericVertexAttribute* GetGenericVertexAttribute(size_t index)      { FUN_ENTRY(GL_LOG_TRACE); return &mGenericVertexAttributes[index]; }
 
-    inline TextureArray       *GetTextureArray(void)                            { FUN_ENTRY(GL_LOG_TRACE); return &mTextures; }
-    inline ShaderArray        *GetShaderArray(void)                             { FUN_ENTRY(GL_LOG_TRACE); return &mShaders;  }
-    inline ShaderProgramArray *GetShaderProgramArray(void)                      { FUN_ENTRY(GL_LOG_TRACE); return &mShaderPrograms; }
-    inline RenderbufferArray  *GetRenderbufferArray(void)                       { FUN_ENTRY(GL_LOG_TRACE); return &mRenderbuffers; }
+    inline ShareGroup         *GetShareGroup(void)                              { FUN_ENTRY(GL_LOG_TRACE); return mShareGroup; }
+    inline TextureArray       *GetTextureArray(void)                            { FUN_ENTRY(GL_LOG_TRACE); return mTextures; }
+    inline ShaderArray        *GetShaderArray(void)                             { FUN_ENTRY(GL_LOG_TRACE); return mShaders;  }
+    inline ShaderProgramArray *GetShaderProgramArray(void)                      { FUN_ENTRY(GL_LOG_TRACE); return mShaderPrograms; }
+    inline RenderbufferArray  *GetRenderbufferArray(void)                       { FUN_ENTRY(GL_LOG_TRACE); return mRenderbuffers; }
 
-    inline Texture *           GetTexture(GLuint index)                         { FUN_ENTRY(GL_LOG_TRACE); return mTextures.GetObject(index); }
+    inline Texture *           GetTexture(GLuint index)                         { FUN_ENTRY(GL_LOG_TRACE); return mTextures->GetObject(index); }
     inline Texture *           GetDefaultTexture(GLenum target)                 { FUN_ENTRY(GL_LOG_TRACE); return target == GL_TEXTURE_2D ? mDefaultTexture2D : mDefaultTextureCubeMap; }
     inline Framebuffer *       GetFramebuffer(GLuint index)                     { FUN_ENTRY(GL_LOG_TRACE); return mFramebuffers.GetObject(index); }
-    inline Renderbuffer *      GetRenderbuffer(GLuint index)                    { FUN_ENTRY(GL_LOG_TRACE); return mRenderbuffers.GetObject(index); }
-    inline BufferObject *      GetBuffer(GLuint index)                          { FUN_ENTRY(GL_LOG_TRACE); return mBuffers.GetObject(index); }
-    inline uint32_t            GetTextureID(const Texture *texture)             { FUN_ENTRY(GL_LOG_TRACE); return (texture == mDefaultTexture2D) || (texture == mDefaultTextureCubeMap) ? 0 : mTextures.GetObjectId(texture); }
-    inline uint32_t            GetBufferID(const BufferObject *bo)              { FUN_ENTRY(GL_LOG_TRACE); return mBuffers.GetObjectId(bo); }
-    inline Shader *            GetShader(GLuint index)                          { FUN_ENTRY(GL_LOG_TRACE); return mShaders.GetObject(index); }
-    inline ShaderProgram *     GetShaderProgram(GLuint index)                   { FUN_ENTRY(GL_LOG_TRACE); return mShaderPrograms.GetObject(index); }
-    inline uint32_t            GetShaderID(const Shader *shader)                { FUN_ENTRY(GL_LOG_TRACE); return mShaders.GetObjectId(shader); }
-    inline uint32_t            GetShaderProgramID(const ShaderProgram *program) { FUN_ENTRY(GL_LOG_TRACE); return mShaderPrograms.GetObjectId(program); }
-    inline uint32_t            GetShadingObjectCount(void)                const { FUN_ENTRY(GL_LOG_TRACE); return mShadingObjectCount; }
-    inline ShadingNamespace_t  GetShadingObject(GLuint index)                   { FUN_ENTRY(GL_LOG_TRACE); return mShadingObjectPool[index]; }
-    
+    inline Renderbuffer *      GetRenderbuffer(GLuint index)                    { FUN_ENTRY(GL_LOG_TRACE); return mRenderbuffers->GetObject(index); }
+    inline BufferObject *      GetBuffer(GLuint index)                          { FUN_ENTRY(GL_LOG_TRACE); return mBuffers->GetObject(index); }
+    inline uint32_t            GetTextureID(const Texture *texture)             { FUN_ENTRY(GL_LOG_TRACE); return (texture == mDefaultTexture2D) || (texture == mDefaultTextureCubeMap) ? 0 : mTextures->GetObjectId(texture); }
+    inline uint32_t            GetBufferID(const BufferObject *bo)              { FUN_ENTRY(GL_LOG_TRACE); return mBuffers->GetObjectId(bo); }
+    inline Shader *            GetShader(GLuint index)                          { FUN_ENTRY(GL_LOG_TRACE); return mShaders->GetObject(index); }
+    inline ShaderProgram *     GetShaderProgram(GLuint index)                   { FUN_ENTRY(GL_LOG_TRACE); return mShaderPrograms->GetObject(index); }
+    inline uint32_t            GetShaderID(const Shader *shader)                { FUN_ENTRY(GL_LOG_TRACE); return mShaders->GetObjectId(shader); }
+    inline uint32_t            GetShaderProgramID(const ShaderProgram *program) { FUN_ENTRY(GL_LOG_TRACE); return mShaderPrograms->GetObjectId(program); }
+    inline uint32_t            GetShadingObjectCount(void)                const { FUN_ENTRY(GL_LOG_TRACE); return mShareGroup->GetShadingObjectCount(); }
+    inline ShadingNamespace_t  GetShadingObject(GLuint index)                   { FUN_ENTRY(GL_LOG_TRACE); return mShareGroup->GetShadingObject(index); }
+    inline ShaderCompiler     *GetShaderCompiler(void)                          { FUN_ENTRY(GL_LOG_TRACE); return mShareGroup->GetShaderCompiler(); }
+    inline std::mutex&         GetShaderCompilerMutex(void)                     { FUN_ENTRY(GL_LOG_TRACE); return mShareGroup->GetCompilerMutex(); }
+    inline bool                IsShared(void)                             const { FUN_ENTRY(GL_LOG_TRACE); return mShareGroup->IsShared(); }
+
 // Set Functions
     void                       SetCacheManager(CacheManager *cacheManager);
+    void                       SetCommandBufferManager(const vulkanAPI::CommandBufferManager *commandBufferManager);
 
 // Map Functions
-           uint32_t            PushShadingObject(const ShadingNamespace_t& obj);
-           void                EraseShadingObject(GLuint index);
+    inline uint32_t            PushShadingObject(const ShadingNamespace_t& obj) { FUN_ENTRY(GL_LOG_TRACE); return mShareGroup->PushShadingObject(obj); }
+    inline void                EraseShadingObject(GLuint index)                 { FUN_ENTRY(GL_LOG_TRACE); mShareGroup->EraseShadingObject(index); }
 
-    inline bool                TextureExists(GLuint index)                const { FUN_ENTRY(GL_LOG_TRACE); return mTextures.ObjectExists(index); }
-    inline bool                BufferExists(GLuint index)                 const { FUN_ENTRY(GL_LOG_TRACE); return mBuffers.ObjectExists(index); }
-    inline bool                RenderbufferExists(GLuint index)           const { FUN_ENTRY(GL_LOG_TRACE); return mRenderbuffers.ObjectExists(index); }
+    inline bool                TextureExists(GLuint index)                const { FUN_ENTRY(GL_LOG_TRACE); return mTextures->ObjectExists(index); }
+    inline bool                BufferExists(GLuint index)                 const { FUN_ENTRY(GL_LOG_TRACE); return mBuffers->ObjectExists(index); }
+    inline bool                RenderbufferExists(GLuint index)           const { FUN_ENTRY(GL_LOG_TRACE); return mRenderbuffers->ObjectExists(index); }
     inline bool                FramebufferExists(GLuint index)            const { FUN_ENTRY(GL_LOG_TRACE); return mFramebuffers.ObjectExists(index); }
-    inline bool                ShadingObjectExists(GLuint index)          const { FUN_ENTRY(GL_LOG_TRACE); return mShadingObjectPool.find(index) != mShadingObjectPool.end(); }
+    inline bool                ShadingObjectExists(GLuint index)          const { FUN_ENTRY(GL_LOG_TRACE); return mShareGroup->ShadingObjectExists(index); }
 
-           GLboolean           IsShadingObject(GLuint index, shadingNamespaceType_t type) const;
+    inline GLboolean           IsShadingObject(GLuint index, shadingNamespaceType_t type) const { FUN_ENTRY(GL_LOG_TRACE); return mShareGroup->IsShadingObject(index, type); }
     bool                       IsTextureAttachedToFBO(const Texture *texture);
-    uint32_t                   FindShaderID(const Shader *shader);
-    uint32_t                   FindShaderProgramID(const ShaderProgram *program);
+    inline uint32_t            FindShaderID(const Shader *shader)               { FUN_ENTRY(GL_LOG_TRACE); return mShareGroup->FindShaderID(shader); }
+    inline uint32_t            FindShaderProgramID(const ShaderProgram *program) { FUN_ENTRY(GL_LOG_TRACE); return mShareGroup->FindShaderProgramID(program); }
 
     void                       UpdateFramebufferObjects(GLuint index, GLenum target);
     void                       CreateDefaultTextures(void);
 
 //PurgeList Functions
-    void                       AddToPurgeList(BufferObject *object)             { FUN_ENTRY(GL_LOG_TRACE); mPurgeListBufferObject.push_back(object); }
-    void                       AddToPurgeList(Texture *object)                  { FUN_ENTRY(GL_LOG_TRACE); mPurgeListTexture.push_back(object); }
-    void                       AddToPurgeList(Shader *object)                   { FUN_ENTRY(GL_LOG_TRACE); mPurgeListShaders.push_back(object); }
-    void                       AddToPurgeList(ShaderProgram *object)            { FUN_ENTRY(GL_LOG_TRACE); mPurgeListShaderPrograms.push_back(object); }
-    void                       AddToPurgeList(Renderbuffer *object)             { FUN_ENTRY(GL_LOG_TRACE); mPurgeListRenderbuffers.push_back(object); }
-    void                       CleanPurgeList();
+    void                       AddToPurgeList(BufferObject *object)             { FUN_ENTRY(GL_LOG_TRACE); mShareGroup->AddToPurgeList(object); }
+    void                       AddToPurgeList(Texture *object)                  { FUN_ENTRY(GL_LOG_TRACE); mShareGroup->AddToPurgeList(object); }
+    void                       AddToPurgeList(Shader *object)                   { FUN_ENTRY(GL_LOG_TRACE); mShareGroup->AddToPurgeList(object); }
+    void                       AddToPurgeList(ShaderProgram *object)            { FUN_ENTRY(GL_LOG_TRACE); mShareGroup->AddToPurgeList(object); }
+    void                       AddToPurgeList(Renderbuffer *object)             { FUN_ENTRY(GL_LOG_TRACE); mShareGroup->AddToPurgeList(object); }
+    void                       RetireCaches()                                   { FUN_ENTRY(GL_LOG_TRACE); mShareGroup->RetireCaches(); }
+    void                       CleanPurgeList()                                 { FUN_ENTRY(GL_LOG_TRACE); mShareGroup->CleanPurgeList(); }
     void                       FramebufferCacheAttachement(Texture *texture, GLuint index);
     void                       FramebufferCacheAttachement(Renderbuffer *renderbuffer, GLuint index);
 };
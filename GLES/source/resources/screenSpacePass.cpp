@@ -285,7 +285,8 @@ ScreenSpacePass::CreateDefaultPipelineStates()
     mPipeline->SetVertexInputState(&mVertexInputInfo);
 
     std::vector<VkDynamicState> states = {VK_DYNAMIC_STATE_VIEWPORT,
-                                          VK_DYNAMIC_STATE_SCISSOR};
+                                          VK_DYNAMIC_STATE_SCISSOR,
+                                          VK_DYNAMIC_STATE_STENCIL_REFERENCE};
     mPipeline->CreateDynamicState(states);
 
     mPipeline->SetDepthTestEnable(false);
@@ -300,6 +301,10 @@ ScreenSpacePass::Destroy()
 
     DestroyShaderData();
     DestroyMeshData();
+    for(auto &pipeline : mMaskedPipelines) {
+        vkDestroyPipeline(mVkContext->vkDevice, pipeline.second, nullptr);
+    }
+    mMaskedPipelines.clear();
     if(mPipeline != nullptr) {
        delete mPipeline;
        mPipeline = nullptr;
@@ -327,6 +332,47 @@ ScreenSpacePass::UpdateUniformBufferColor(float r, float g, float b, float a)
     return true;
 }
 
+bool
+ScreenSpacePass::PreparePipeline(VkColorComponentFlags colorWriteMask, uint32_t stencilWriteMask, vulkanAPI::RenderPass *renderPass)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    const maskedPipelineKey_t key = std::make_tuple(colorWriteMask, stencilWriteMask,
+                                                    renderPass->GetColorFormat(), renderPass->GetDepthStencilFormat());
+
+    auto it = mMaskedPipelines.find(key);
+    if(it != mMaskedPipelines.end()) {
+        mPipeline->UsePrewarmed(it->second);
+        return true;
+    }
+
+    mPipeline->SetColorBlendAttachmentWriteMask(colorWriteMask);
+
+    // the stencil reference is dynamic and is replaced under the write mask for every covered pixel
+    mPipeline->SetStencilTestEnable(stencilWriteMask != 0);
+    mPipeline->SetStencilFrontCompareOp(VK_COMPARE_OP_ALWAYS);
+    mPipeline->SetStencilFrontFailOp(VK_STENCIL_OP_KEEP);
+    mPipeline->SetStencilFrontPassOp(VK_STENCIL_OP_REPLACE);
+    mPipeline->SetStencilFrontZFailOp(VK_STENCIL_OP_REPLACE);
+    mPipeline->SetStencilFrontCompareMask(0xFF);
+    mPipeline->SetStencilFrontWriteMask(stencilWriteMask);
+    mPipeline->SetStencilBackCompareOp(VK_COMPARE_OP_ALWAYS);
+    mPipeline->SetStencilBackFailOp(VK_STENCIL_OP_KEEP);
+    mPipeline->SetStencilBackPassOp(VK_STENCIL_OP_REPLACE);
+    mPipeline->SetStencilBackZFailOp(VK_STENCIL_OP_REPLACE);
+    mPipeline->SetStencilBackCompareMask(0xFF);
+    mPipeline->SetStencilBackWriteMask(stencilWriteMask);
+
+    mPipeline->SetUpdatePipeline(true);
+    if(!mPipeline->Create(renderPass->GetRenderPass())) {
+        return false;
+    }
+
+    mMaskedPipelines[key] = mPipeline->DetachPipeline();
+
+    return true;
+}
+
 void
 ScreenSpacePass::BindPipeline(const VkCommandBuffer *cmdBuffer) const
 {
@@ -17,7 +17,7 @@
  *  @date       26/10/2018
  *  @version    1.0
  *
- *  @brief      Screen Space Vulkan Pass used for various operations (e.g., clear with ColorMask)
+ *  @brief      Screen Space Vulkan Pass used for various operations (e.g., clear with color or stencil write masks)
  *
  */
 
@@ -33,6 +33,7 @@
 #include "vulkan/pipelineCache.h"
 #include <string>
 #include <utility>
+#include <tuple>
 #include <map>
 
 class ScreenSpacePass {
@@ -81,6 +82,10 @@ struct ShaderData {
     vulkanAPI::PipelineCache                   *mPipelineCache;
     vulkanAPI::Pipeline*                        mPipeline;
 
+    // one pipeline per color/stencil write mask and attachment formats, owned by the pass
+    typedef std::tuple<VkColorComponentFlags, uint32_t, VkFormat, VkFormat> maskedPipelineKey_t;
+    std::map<maskedPipelineKey_t, VkPipeline>   mMaskedPipelines;
+
     // buffers
 
     bool                                        mInitialized;
@@ -119,6 +124,7 @@ public:
     void                                        BindPipeline(const VkCommandBuffer *cmdBuffer) const;
     void                                        Draw(const VkCommandBuffer *cmdBuffer) const;
     bool                                        UpdateUniformBufferColor(float r, float g, float b, float a);
+    bool                                        PreparePipeline(VkColorComponentFlags colorWriteMask, uint32_t stencilWriteMask, vulkanAPI::RenderPass *renderPass);
 
 // Get Functions
     inline bool                                 Valid()                           {  FUN_ENTRY(GL_LOG_TRACE); return mValid; }
@@ -39,11 +39,12 @@ public:
 /// Shader Program Functions
     virtual bool                LinkProgram(uintptr_t program_ptr, ESSL_VERSION version, vector<uint32_t> &vertSpv, vector<uint32_t> &fragSpv) = 0;
     virtual bool                ValidateProgram(ESSL_VERSION version) = 0;
+    virtual bool                UseLinkedProgram(bool isYInverted, vector<uint32_t> &vertSpv, vector<uint32_t> &fragSpv) = 0;
     
 /// Reflection Functions
     virtual void                PrepareReflection(ESSL_VERSION version) = 0;
     virtual uint32_t            SerializeReflection(void* binary) = 0;
-    virtual uint32_t            DeserializeReflection(const void* binary) = 0;
+    virtual uint32_t            DeserializeReflection(const void* binary, uint32_t size) = 0;
     virtual void                PrintUniformReflection(void) = 0;    
 
 /// Get Functions
@@ -28,6 +28,38 @@
 
 #include "shaderProgram.h"
 #include "context/context.h"
+#include "vulkan/pipelineStateLog.h"
+
+/// Program binaries start with this header, followed by the serialized reflection,
+/// and the SPIR-V of the vertex and fragment shaders. Pipelines are not part of it,
+/// they are kept by the device-wide pipeline cache which is shared by all programs.
+/// The checksum covers the whole binary, computed with a zero checksum field.
+#define GLOVE_PROGRAM_BINARY_MAGIC                      0x50564C47 // "GLVP"
+#define GLOVE_PROGRAM_BINARY_VERSION                    2
+
+typedef struct {
+    uint32_t                                            magic;
+    uint32_t                                            version;
+    uint32_t                                            vendorID;
+    uint32_t                                            deviceID;
+    uint32_t                                            driverVersion;
+    uint8_t                                             pipelineCacheUUID[VK_UUID_SIZE];
+    uint32_t                                            reflectionSize;
+    uint32_t                                            spirvSize[MAX_SHADERS];
+    uint32_t                                            checksum;
+} programBinaryHeader_t;
+
+/// FNV-1a
+static uint32_t
+ProgramBinaryChecksum(uint32_t hash, const void *data, size_t size)
+{
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+    for(size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 0x01000193u;
+    }
+    return hash;
+}
 
 ShaderProgram::ShaderProgram(const vulkanAPI::vkContext_t *vkContext)
 : refObject()
@@ -55,6 +87,9 @@ ShaderProgram::ShaderProgram(const vulkanAPI::vkContext_t *vkContext)
     mVkPipelineLayout = VK_NULL_HANDLE;
 
     mPipelineCache = new vulkanAPI::PipelineCache(mVkContext);
+    mPipelineWarmup = new vulkanAPI::PipelineWarmup(mVkContext);
+    mProgramHash = 0;
+    mCacheManager = nullptr;
 
     mStageCount = 0;
 
@@ -81,6 +116,11 @@ ShaderProgram::~ShaderProgram()
         mPipelineCache = nullptr;
     }
 
+    if(mPipelineWarmup) {
+        delete mPipelineWarmup;
+        mPipelineWarmup = nullptr;
+    }
+
     if(mExplicitIbo != nullptr) {
         delete mExplicitIbo;
         mExplicitIbo = nullptr;
@@ -222,59 +262,6 @@ ShaderProgram::DetachShaders()
     }
 }
 
-uint32_t
-ShaderProgram::SerializeShadersSpirv(void *binary)
-{
-    FUN_ENTRY(GL_LOG_DEBUG);
-
-    uint8_t *rawDataPtr = reinterpret_cast<uint8_t *>(binary);
-    uint32_t *u32DataPtr = nullptr;
-    uint32_t vsSpirvSize = static_cast<int>(4 * mShaderSPVsize[0]);
-    uint32_t fsSpirvSize = static_cast<int>(4 * mShaderSPVsize[1]);
-
-    u32DataPtr = reinterpret_cast<uint32_t *>(rawDataPtr);
-    *u32DataPtr = vsSpirvSize;
-    rawDataPtr += sizeof(uint32_t);
-    memcpy(rawDataPtr, mShaderSPVdata[0], vsSpirvSize);
-    rawDataPtr += vsSpirvSize;
-
-    u32DataPtr = reinterpret_cast<uint32_t *>(rawDataPtr);
-    *u32DataPtr = fsSpirvSize;
-    rawDataPtr += sizeof(uint32_t);
-    memcpy(rawDataPtr, mShaderSPVdata[1], fsSpirvSize);
-
-    return 2 * sizeof(uint32_t) + vsSpirvSize + fsSpirvSize;
-}
-
-uint32_t
-ShaderProgram::DeserializeShadersSpirv(const void *binary)
-{
-    FUN_ENTRY(GL_LOG_DEBUG);
-
-    const uint8_t *rawDataPtr = reinterpret_cast<const uint8_t *>(binary);
-    const uint32_t *u32DataPtr = nullptr;
-    std::vector<uint32_t> &vsSpirvData = GetVertexShader()->GetSPV();
-    std::vector<uint32_t> &fsSpirvData = GetFragmentShader()->GetSPV();
-    uint32_t vsSpirvSize = 0;
-    uint32_t fsSpirvSize = 0;
-
-    u32DataPtr = reinterpret_cast<const uint32_t *>(rawDataPtr);
-    vsSpirvSize = *u32DataPtr;\
-    rawDataPtr += sizeof(uint32_t);
-    u32DataPtr = reinterpret_cast<const uint32_t *>(rawDataPtr);
-    std::copy(u32DataPtr, u32DataPtr + vsSpirvSize /4, back_inserter(vsSpirvData));
-    rawDataPtr += vsSpirvSize;
-
-    u32DataPtr = reinterpret_cast<const uint32_t *>(rawDataPtr);
-    fsSpirvSize = *u32DataPtr;
-    rawDataPtr += sizeof(uint32_t);
-    u32DataPtr = reinterpret_cast<const uint32_t *>(rawDataPtr);
-    std::copy(u32DataPtr, u32DataPtr + fsSpirvSize /4, back_inserter(fsSpirvData));
-    rawDataPtr += fsSpirvSize;
-
-    return 2 * sizeof(uint32_t) + vsSpirvSize + fsSpirvSize;
-}
-
 const ShaderResourceInterface::attribute *
 ShaderProgram::GetVertexAttribute(int index) const
 {
@@ -307,16 +294,30 @@ ShaderProgram::GetAttributeLocation(const char *name) const
     return mShaderResourceInterface.GetAttributeLocation(name);
 }
 
-VkPipelineCache
-ShaderProgram::GetVkPipelineCache(void)
+vulkanAPI::PipelineCache *
+ShaderProgram::GetPipelineCache(void)
 {
     FUN_ENTRY(GL_LOG_TRACE);
 
+    // pipelines of all programs are built against the device-wide cache,
+    // the program cache is only a fallback if the former is not available
+    if(mVkContext->vkPipelineCache && mVkContext->vkPipelineCache->GetPipelineCache() != VK_NULL_HANDLE) {
+        return mVkContext->vkPipelineCache;
+    }
+
     if(mPipelineCache->GetPipelineCache() == VK_NULL_HANDLE) {
         mPipelineCache->Create(nullptr, 0);
     }
 
-    return mPipelineCache->GetPipelineCache();
+    return mPipelineCache;
+}
+
+VkPipelineCache
+ShaderProgram::GetVkPipelineCache(void)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    return GetPipelineCache()->GetPipelineCache();
 }
 
 const std::string&
@@ -401,14 +402,18 @@ ShaderProgram::LinkProgram()
 
     Context *context = GetCurrentContext();
     assert(context);
-    mLinked = mShaderCompiler->PreprocessShader((uintptr_t)this, SHADER_TYPE_VERTEX  , ESSL_VERSION_100, ESSL_VERSION_400, context->IsYInverted()) &&
-              mShaderCompiler->PreprocessShader((uintptr_t)this, SHADER_TYPE_FRAGMENT, ESSL_VERSION_100, ESSL_VERSION_400, context->IsYInverted());
-    if(!mLinked) {
-        return false;
-    }
-    mLinked = mShaderCompiler->LinkProgram((uintptr_t)this, ESSL_VERSION_400, GetVertexShader()->GetSPV(), GetFragmentShader()->GetSPV());
-    if(!mLinked) {
-        return false;
+
+    /// The relink cache returns the ESSL 400 pass of sources linked before; new sources are compiled a second time
+    if(!mShaderCompiler->UseLinkedProgram(context->IsYInverted(), GetVertexShader()->GetSPV(), GetFragmentShader()->GetSPV())) {
+        mLinked = mShaderCompiler->PreprocessShader((uintptr_t)this, SHADER_TYPE_VERTEX  , ESSL_VERSION_100, ESSL_VERSION_400, context->IsYInverted()) &&
+                  mShaderCompiler->PreprocessShader((uintptr_t)this, SHADER_TYPE_FRAGMENT, ESSL_VERSION_100, ESSL_VERSION_400, context->IsYInverted());
+        if(!mLinked) {
+            return false;
+        }
+        mLinked = mShaderCompiler->LinkProgram((uintptr_t)this, ESSL_VERSION_400, GetVertexShader()->GetSPV(), GetFragmentShader()->GetSPV());
+        if(!mLinked) {
+            return false;
+        }
     }
     BuildShaderResourceInterface();
 
@@ -689,45 +694,121 @@ ShaderProgram::GenerateVertexInputProperties(std::vector<GenericVertexAttribute>
     mVkPipelineVertexInput.vertexAttributeDescriptionCount = count;
 }
 
-void
+bool
 ShaderProgram::UsePrecompiledBinary(const void *binary, size_t binarySize)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    mLinked = true;
+    mLinked        = false;
+    mIsPrecompiled = false;
+
+    programBinaryHeader_t header;
+    if(!binary || binarySize < sizeof(programBinaryHeader_t)) {
+        return false;
+    }
+    memcpy(&header, binary, sizeof(programBinaryHeader_t));
+
+    /// Binaries of another format version, device or driver are rejected, so that the application recompiles
+    const VkPhysicalDeviceProperties &deviceProperties = mVkContext->vkDeviceProperties;
+    if(header.magic         != GLOVE_PROGRAM_BINARY_MAGIC       ||
+       header.version       != GLOVE_PROGRAM_BINARY_VERSION     ||
+       header.vendorID      != deviceProperties.vendorID        ||
+       header.deviceID      != deviceProperties.deviceID        ||
+       header.driverVersion != deviceProperties.driverVersion   ||
+       memcmp(header.pipelineCacheUUID, deviceProperties.pipelineCacheUUID, VK_UUID_SIZE)) {
+        return false;
+    }
+
+    const uint64_t payloadSize = static_cast<uint64_t>(header.reflectionSize) + header.spirvSize[0] + header.spirvSize[1];
+    if(payloadSize != binarySize - sizeof(programBinaryHeader_t)) {
+        return false;
+    }
+
+    for(uint32_t i = 0; i < MAX_SHADERS; ++i) {
+        if(!header.spirvSize[i] || header.spirvSize[i] % sizeof(uint32_t)) {
+            return false;
+        }
+    }
+
+    const uint32_t checksum = header.checksum;
+    header.checksum = 0;
+    uint32_t hash = ProgramBinaryChecksum(0x811c9dc5u, &header, sizeof(programBinaryHeader_t));
+    hash = ProgramBinaryChecksum(hash, reinterpret_cast<const uint8_t *>(binary) + sizeof(programBinaryHeader_t), binarySize - sizeof(programBinaryHeader_t));
+    if(hash != checksum) {
+        return false;
+    }
 
     ResetVulkanVertexInput();
 
-    uint32_t reflectionOffset = mShaderCompiler->DeserializeReflection(binary);
-    uint32_t spirvOffset = DeserializeShadersSpirv(reinterpret_cast<const uint8_t *>(binary) + reflectionOffset);
-    const uint8_t *vulkanDataPtr = reinterpret_cast<const uint8_t *>(binary) + reflectionOffset + spirvOffset;
+    const uint8_t *rawDataPtr = reinterpret_cast<const uint8_t *>(binary) + sizeof(programBinaryHeader_t);
+    if(mShaderCompiler->DeserializeReflection(rawDataPtr, header.reflectionSize) != header.reflectionSize) {
+        return false;
+    }
+    rawDataPtr += header.reflectionSize;
 
-    BuildShaderResourceInterface();
+    Shader *shaders[MAX_SHADERS] = { GetVertexShader(), GetFragmentShader() };
+    for(uint32_t i = 0; i < MAX_SHADERS; ++i) {
+        std::vector<uint32_t> &spirvData = shaders[i]->GetSPV();
+        spirvData.resize(header.spirvSize[i] / sizeof(uint32_t));
+        memcpy(spirvData.data(), rawDataPtr, header.spirvSize[i]);
+        rawDataPtr += header.spirvSize[i];
+    }
 
-    mPipelineCache->Create(vulkanDataPtr, binarySize - reflectionOffset);
+    BuildShaderResourceInterface();
 
+    mLinked        = true;
     mIsPrecompiled = true;
+
+    return true;
 }
 
-void
-ShaderProgram::GetBinaryData(void *binary, GLsizei *binarySize)
+bool
+ShaderProgram::GetBinaryData(void *binary, GLsizei bufSize, GLsizei *length)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    uint32_t reflectionOffset = mShaderCompiler->SerializeReflection(binary);
+    if(length) {
+        *length = 0;
+    }
 
-    uint8_t *spirvDataPtr = reinterpret_cast<uint8_t *>(binary) + reflectionOffset;
-    uint32_t spirvOffset = SerializeShadersSpirv(spirvDataPtr);
+    const size_t binaryLength = static_cast<size_t>(GetBinaryLength());
+    if(!binaryLength || bufSize < 0 || static_cast<size_t>(bufSize) < binaryLength) {
+        return false;
+    }
 
-    uint8_t *vulkanDataPtr = reinterpret_cast<uint8_t *>(binary) + reflectionOffset + spirvOffset;
-    size_t vulkanDataSize = *binarySize;
+    programBinaryHeader_t header;
+    memset(&header, 0, sizeof(programBinaryHeader_t));
 
-    if(mPipelineCache->GetPipelineCache() != VK_NULL_HANDLE) {
-        mPipelineCache->GetData(reinterpret_cast<void *>(vulkanDataPtr), &vulkanDataSize);
-        *binarySize = vulkanDataSize + reflectionOffset + spirvOffset;
-    } else {
-        *binarySize = 0;
+    const VkPhysicalDeviceProperties &deviceProperties = mVkContext->vkDeviceProperties;
+    header.magic          = GLOVE_PROGRAM_BINARY_MAGIC;
+    header.version        = GLOVE_PROGRAM_BINARY_VERSION;
+    header.vendorID       = deviceProperties.vendorID;
+    header.deviceID       = deviceProperties.deviceID;
+    header.driverVersion  = deviceProperties.driverVersion;
+    memcpy(header.pipelineCacheUUID, deviceProperties.pipelineCacheUUID, VK_UUID_SIZE);
+    header.reflectionSize = static_cast<uint32_t>(mReflectionBinary.size());
+
+    uint8_t *rawDataPtr = reinterpret_cast<uint8_t *>(binary) + sizeof(programBinaryHeader_t);
+    memcpy(rawDataPtr, mReflectionBinary.data(), mReflectionBinary.size());
+    rawDataPtr += mReflectionBinary.size();
+
+    for(uint32_t i = 0; i < MAX_SHADERS; ++i) {
+        header.spirvSize[i] = static_cast<uint32_t>(sizeof(uint32_t) * mShaderSPVsize[i]);
+        memcpy(rawDataPtr, mShaderSPVdata[i], header.spirvSize[i]);
+        rawDataPtr += header.spirvSize[i];
+    }
+
+    const size_t payloadSize = header.reflectionSize + header.spirvSize[0] + header.spirvSize[1];
+    uint32_t hash = ProgramBinaryChecksum(0x811c9dc5u, &header, sizeof(programBinaryHeader_t));
+    hash = ProgramBinaryChecksum(hash, reinterpret_cast<uint8_t *>(binary) + sizeof(programBinaryHeader_t), payloadSize);
+    header.checksum = hash;
+    memcpy(binary, &header, sizeof(programBinaryHeader_t));
+
+    if(length) {
+        *length = static_cast<GLsizei>(sizeof(programBinaryHeader_t) + payloadSize);
     }
+
+    return true;
 }
 
 GLsizei
@@ -735,14 +816,13 @@ ShaderProgram::GetBinaryLength(void)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    size_t vkPipelineCacheDataLength = 0;
-    uint32_t spirvSize = 2 * sizeof(uint32_t) + 4 * (mShaderSPVsize[0] + mShaderSPVsize[1]);
-
-    if(mPipelineCache->GetPipelineCache() != VK_NULL_HANDLE) {
-        mPipelineCache->GetData(nullptr, &vkPipelineCacheDataLength);
+    if(!mLinked) {
+        return 0;
     }
 
-    return vkPipelineCacheDataLength + mShaderResourceInterface.GetReflectionSize() + spirvSize;
+    return static_cast<GLsizei>(sizeof(programBinaryHeader_t)                            +
+                                mReflectionBinary.size()                                 +
+                                sizeof(uint32_t) * (mShaderSPVsize[0] + mShaderSPVsize[1]));
 }
 
 char *
@@ -803,6 +883,9 @@ ShaderProgram::ReleaseVkObjects(void)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
+    /// the warmup thread builds its pipelines with the current pipeline layout
+    mPipelineWarmup->Release(mCacheManager);
+
     if(mVkPipelineLayout != VK_NULL_HANDLE) {
         vkDestroyPipelineLayout(mVkContext->vkDevice, mVkPipelineLayout, nullptr);
         mVkPipelineLayout = VK_NULL_HANDLE;
@@ -864,6 +947,42 @@ ShaderProgram::SetShaderModules(void)
         mShaderSPVdata[1]  = shader->GetSPV().data();
         mVkShaderStages[1] = VK_SHADER_STAGE_FRAGMENT_BIT;
     }
+
+    ComputeProgramHash();
+}
+
+void
+ShaderProgram::ComputeProgramHash(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    /// FNV-1a over the SPIR-V of all stages, stable across runs
+    mProgramHash = 0xcbf29ce484222325ULL;
+    for(uint32_t i = 0; i < MAX_SHADERS; ++i) {
+        Shader *shader = mShaders[i];
+        if(!shader) {
+            continue;
+        }
+        for(uint32_t word : shader->GetSPV()) {
+            mProgramHash = (mProgramHash ^ word) * 0x100000001b3ULL;
+        }
+    }
+}
+
+void
+ShaderProgram::StartPipelineWarmup(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    if(!mVkContext->vkPipelineStateLog || !mLinked || mStageCount != MAX_SHADERS) {
+        return;
+    }
+
+    std::vector<vulkanAPI::pipelineStateKey_t> keys;
+    mVkContext->vkPipelineStateLog->GetStates(mProgramHash, &keys);
+
+    mPipelineWarmup->Release(mCacheManager);
+    mPipelineWarmup->Start(keys, mVkPipelineLayout, GetVertexShader()->GetSPV(), GetFragmentShader()->GetSPV());
 }
 
 bool
@@ -1245,7 +1364,6 @@ ShaderProgram::UpdateAttributeInterface(void)
 
     mShaderResourceInterface.SetReflection(mShaderCompiler->GetShaderReflection());
     mShaderResourceInterface.UpdateAttributeInterface();
-    mShaderResourceInterface.SetReflectionSize();
     mShaderResourceInterface.SetReflection(nullptr);
 }
 
@@ -1257,6 +1375,10 @@ ShaderProgram::BuildShaderResourceInterface(void)
     mShaderResourceInterface.SetReflection(mShaderCompiler->GetShaderReflection());
     mShaderResourceInterface.CreateInterface();
     mShaderResourceInterface.SetReflection(nullptr);
+
+    /// Kept for glGetProgramBinaryOES, since the compiler's reflection is replaced by the next link
+    mReflectionBinary.resize(mShaderCompiler->GetShaderReflection()->GetSerializedSize());
+    mShaderCompiler->SerializeReflection(mReflectionBinary.data());
     mShaderResourceInterface.AllocateUniformClientData();
     mShaderResourceInterface.AllocateUniformBufferObjects(mVkContext);
 
@@ -29,6 +29,7 @@
 #include "utils/cacheManager.h"
 #include "genericVertexAttribute.h"
 #include "vulkan/pipelineCache.h"
+#include "vulkan/pipelineWarmup.h"
 #include "refObject.h"
 
 class Context;
@@ -44,6 +45,8 @@ private:
     VkPipelineLayout                                    mVkPipelineLayout;
 
     vulkanAPI::PipelineCache                           *mPipelineCache;
+    vulkanAPI::PipelineWarmup                          *mPipelineWarmup;
+    uint64_t                                            mProgramHash;
     CacheManager                                       *mCacheManager;
 
     VkPipelineVertexInputStateCreateInfo                mVkPipelineVertexInput;
@@ -76,6 +79,7 @@ private:
 
     ShaderCompiler                                     *mShaderCompiler;
     ShaderResourceInterface                             mShaderResourceInterface;
+    std::vector<uint8_t>                                mReflectionBinary;
 
     bool                                                ValidateProgram(void);
     void                                                ReleaseVkObjects(void);
@@ -85,8 +89,8 @@ private:
     bool                                                CreateDescriptorSet(void);
     void                                                UpdateSamplerDescriptors(void);
 
-    uint32_t                                            SerializeShadersSpirv(void *binary);
-    uint32_t                                            DeserializeShadersSpirv(const void *binary);
+    vulkanAPI::PipelineCache                           *GetPipelineCache(void);
+    void                                                ComputeProgramHash(void);
 
     void                                                ResetVulkanVertexInput(void);
     void                                                UpdateAttributeInterface(void);
@@ -120,10 +124,14 @@ public:
     bool                                                ValidateSamplers(void);
     void                                                EnableUpdateOfDescriptorSets(void)                  { FUN_ENTRY(GL_LOG_TRACE); mUpdateDescriptorSets = true; }
 
-    void                                                UsePrecompiledBinary(const void *binary, size_t binarySize);
-    void                                                GetBinaryData(void *binary, GLsizei *binarySize);
+    bool                                                UsePrecompiledBinary(const void *binary, size_t binarySize);
+    bool                                                GetBinaryData(void *binary, GLsizei bufSize, GLsizei *length);
     GLsizei                                             GetBinaryLength(void);
 
+    void                                                StartPipelineWarmup(void);
+    VkPipeline                                          GetPrewarmedPipeline(const vulkanAPI::pipelineStateKey_t *key) { FUN_ENTRY(GL_LOG_TRACE); return mPipelineWarmup->GetPipeline(key); }
+    uint64_t                                            GetProgramHash(void)                        const   { FUN_ENTRY(GL_LOG_TRACE); return mProgramHash; }
+
     uint32_t                                            GetNumberOfActiveUniforms(void)             const   { FUN_ENTRY(GL_LOG_TRACE); return mShaderResourceInterface.GetLiveUniforms(); }
     int                                                 GetUniformLocation(const char *name)        const   { FUN_ENTRY(GL_LOG_TRACE); return mShaderResourceInterface.GetUniformLocation(name); }
     const ShaderResourceInterface::uniform             *GetUniform(uint32_t index)                  const   { FUN_ENTRY(GL_LOG_TRACE); return mShaderResourceInterface.GetUniform(index); }
@@ -146,7 +154,7 @@ public:
     const VkBuffer                                     *GetActiveVertexVkBuffers(void)              const   { FUN_ENTRY(GL_LOG_TRACE); return mActiveVertexVkBuffers; }
     VkBuffer                                            GetActiveIndexVkBuffer(void)                const   { FUN_ENTRY(GL_LOG_TRACE); return mActiveIndexVkBuffer; }
 
-    void                                                SetVkContext(const vulkanAPI::vkContext_t *vkContext) { FUN_ENTRY(GL_LOG_TRACE); mVkContext = vkContext; mPipelineCache->SetContext(mVkContext);}
+    void                                                SetVkContext(const vulkanAPI::vkContext_t *vkContext) { FUN_ENTRY(GL_LOG_TRACE); mVkContext = vkContext; mPipelineCache->SetContext(mVkContext); mPipelineWarmup->SetContext(mVkContext); }
     void                                                SetShaderCompiler(ShaderCompiler* shaderCompiler)   { FUN_ENTRY(GL_LOG_TRACE); assert(shaderCompiler != nullptr); mShaderCompiler = shaderCompiler; }
     void                                                SetStagesIDs(uint32_t index, uint32_t id)           { FUN_ENTRY(GL_LOG_TRACE); mStagesIDs[index] = id; }
 
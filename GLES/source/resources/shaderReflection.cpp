@@ -41,152 +41,210 @@ ShaderReflection::Reset(void)
     memset(&mReflectionData, 0, sizeof(reflectionData));
 }
 
+/// The serialized reflection holds only the live entries. It starts with
+/// the entry counts and the string table size, followed by fixed-size
+/// records and a string table with the zero-terminated names:
+///     attribute:      name offset, type, location
+///     uniform:        name offset, location, block index, array size, type, offset
+///     uniform block:  name offset, binding, block size, stage, opaque
+#define REFLECTION_HEADER_SIZE              (4 * sizeof(uint32_t))
+#define REFLECTION_ATTRIBUTE_RECORD_SIZE    (3 * sizeof(uint32_t))
+#define REFLECTION_UNIFORM_RECORD_SIZE      (6 * sizeof(uint32_t))
+#define REFLECTION_BLOCK_RECORD_SIZE        (5 * sizeof(uint32_t))
+
+static inline void
+WriteU32(uint8_t **dst, uint32_t value)
+{
+    memcpy(*dst, &value, sizeof(uint32_t));
+    *dst += sizeof(uint32_t);
+}
+
+static inline uint32_t
+ReadU32(const uint8_t **src)
+{
+    uint32_t value;
+    memcpy(&value, *src, sizeof(uint32_t));
+    *src += sizeof(uint32_t);
+    return value;
+}
+
+static void
+WriteName(uint8_t **dst, const char *name, uint8_t *stringTable, uint32_t *stringTableOffset)
+{
+    const uint32_t length = static_cast<uint32_t>(strlen(name)) + 1;
+
+    memcpy(stringTable + *stringTableOffset, name, length);
+    WriteU32(dst, *stringTableOffset);
+    *stringTableOffset += length;
+}
+
+static bool
+ReadName(const uint8_t **src, char *name, uint32_t maxLength, const uint8_t *stringTable, uint32_t stringTableSize)
+{
+    const uint32_t offset = ReadU32(src);
+    if(offset >= stringTableSize) {
+        return false;
+    }
+
+    /// names must be zero-terminated inside the table and fit in the reflection arrays
+    const char  *tableName = reinterpret_cast<const char *>(stringTable + offset);
+    const size_t length    = strnlen(tableName, stringTableSize - offset);
+    if(length >= maxLength || length == stringTableSize - offset) {
+        return false;
+    }
+
+    memcpy(name, tableName, length + 1);
+    return true;
+}
+
+uint32_t
+ShaderReflection::GetSerializedSize(void) const
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    uint32_t stringTableSize = 0;
+    for(uint32_t i = 0; i < mReflectionData.mLiveAttributes; ++i) {
+        stringTableSize += strlen(mReflectionData.mAttributeReflection[i].name) + 1;
+    }
+    for(uint32_t i = 0; i < mReflectionData.mLiveUniforms; ++i) {
+        stringTableSize += strlen(mReflectionData.mUniformReflection[i].reflectionName) + 1;
+    }
+    for(uint32_t i = 0; i < mReflectionData.mLiveUniformBlocks; ++i) {
+        stringTableSize += strlen(mReflectionData.mUniformBlockReflection[i].glslBlockName) + 1;
+    }
+
+    /// keep whatever follows the reflection 4-byte aligned
+    stringTableSize = (stringTableSize + 3) & ~3u;
+
+    return REFLECTION_HEADER_SIZE                                                +
+           mReflectionData.mLiveAttributes    * REFLECTION_ATTRIBUTE_RECORD_SIZE +
+           mReflectionData.mLiveUniforms      * REFLECTION_UNIFORM_RECORD_SIZE   +
+           mReflectionData.mLiveUniformBlocks * REFLECTION_BLOCK_RECORD_SIZE     +
+           stringTableSize;
+}
+
 uint32_t
 ShaderReflection::Serialize(void *binary) const
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    uint8_t *rawDataPtr = reinterpret_cast<uint8_t *>(binary);
-    uint32_t *u32DataPtr = nullptr;
+    const uint32_t size        = GetSerializedSize();
+    const uint32_t recordsSize = REFLECTION_HEADER_SIZE                                                +
+                                 mReflectionData.mLiveAttributes    * REFLECTION_ATTRIBUTE_RECORD_SIZE +
+                                 mReflectionData.mLiveUniforms      * REFLECTION_UNIFORM_RECORD_SIZE   +
+                                 mReflectionData.mLiveUniformBlocks * REFLECTION_BLOCK_RECORD_SIZE;
 
-    u32DataPtr = reinterpret_cast<uint32_t *>(rawDataPtr);
-    *u32DataPtr = mReflectionData.mLiveAttributes;
-    rawDataPtr += sizeof(uint32_t);
+    uint8_t *rawDataPtr      = reinterpret_cast<uint8_t *>(binary);
+    uint8_t *stringTable     = rawDataPtr + recordsSize;
+    uint32_t stringTableSize = size - recordsSize;
+    uint32_t stringOffset    = 0;
 
-    for(uint32_t i = 0; i < mReflectionData.mLiveAttributes; ++i) {
-        memcpy(rawDataPtr, mReflectionData.mAttributeReflection[i].name, GLSLANG_MAX_ATTRIBUTE_NAME_LENGTH);
-        rawDataPtr += GLSLANG_MAX_ATTRIBUTE_NAME_LENGTH;
-        u32DataPtr = reinterpret_cast<uint32_t *>(rawDataPtr);
-        *u32DataPtr = mReflectionData.mAttributeReflection[i].type;
-        rawDataPtr += sizeof(uint32_t);
-        u32DataPtr = reinterpret_cast<uint32_t *>(rawDataPtr);
-        *u32DataPtr = mReflectionData.mAttributeReflection[i].location;
-        rawDataPtr += sizeof(uint32_t);
-    }
+    memset(stringTable, 0, stringTableSize);
 
-    rawDataPtr += (GLSLANG_MAX_ATTRIBUTES - mReflectionData.mLiveAttributes) * sizeof(attribute);
+    WriteU32(&rawDataPtr, mReflectionData.mLiveAttributes);
+    WriteU32(&rawDataPtr, mReflectionData.mLiveUniforms);
+    WriteU32(&rawDataPtr, mReflectionData.mLiveUniformBlocks);
+    WriteU32(&rawDataPtr, stringTableSize);
 
-    u32DataPtr = reinterpret_cast<uint32_t *>(rawDataPtr);
-    *u32DataPtr = mReflectionData.mLiveUniforms;
-    rawDataPtr += sizeof(uint32_t);
+    for(uint32_t i = 0; i < mReflectionData.mLiveAttributes; ++i) {
+        const attribute &attr = mReflectionData.mAttributeReflection[i];
+        WriteName(&rawDataPtr, attr.name, stringTable, &stringOffset);
+        WriteU32(&rawDataPtr, attr.type);
+        WriteU32(&rawDataPtr, static_cast<uint32_t>(attr.location));
+    }
 
     for(uint32_t i = 0; i < mReflectionData.mLiveUniforms; ++i) {
-        memcpy(rawDataPtr, mReflectionData.mUniformReflection[i].reflectionName, GLSLANG_MAX_UNIFORM_NAME_LENGTH);
-        rawDataPtr += GLSLANG_MAX_UNIFORM_NAME_LENGTH;
-        u32DataPtr = reinterpret_cast<uint32_t *>(rawDataPtr);
-        *u32DataPtr = mReflectionData.mUniformReflection[i].location;
-        rawDataPtr += sizeof(uint32_t);
-        u32DataPtr = reinterpret_cast<uint32_t *>(rawDataPtr);
-        *u32DataPtr = mReflectionData.mUniformReflection[i].blockIndex;
-        rawDataPtr += sizeof(uint32_t);
-        u32DataPtr = reinterpret_cast<uint32_t *>(rawDataPtr);
-        *u32DataPtr = mReflectionData.mUniformReflection[i].arraySize;
-        rawDataPtr += sizeof(uint32_t);
-        u32DataPtr = reinterpret_cast<uint32_t *>(rawDataPtr);
-        *u32DataPtr = mReflectionData.mUniformReflection[i].glType;
-        rawDataPtr += sizeof(uint32_t);
-        u32DataPtr = reinterpret_cast<uint32_t *>(rawDataPtr);
-        *u32DataPtr = mReflectionData.mUniformReflection[i].offset;
-        rawDataPtr += sizeof(uint32_t);
-    }
-
-    rawDataPtr += (GLSLANG_MAX_UNIFORMS - mReflectionData.mLiveUniforms) * sizeof(uniform);
-
-    u32DataPtr = reinterpret_cast<uint32_t *>(rawDataPtr);
-    *u32DataPtr = mReflectionData.mLiveUniformBlocks;
-    rawDataPtr += sizeof(uint32_t);
+        const uniform &uni = mReflectionData.mUniformReflection[i];
+        WriteName(&rawDataPtr, uni.reflectionName, stringTable, &stringOffset);
+        WriteU32(&rawDataPtr, uni.location);
+        WriteU32(&rawDataPtr, uni.blockIndex);
+        WriteU32(&rawDataPtr, static_cast<uint32_t>(uni.arraySize));
+        WriteU32(&rawDataPtr, uni.glType);
+        WriteU32(&rawDataPtr, static_cast<uint32_t>(uni.offset));
+    }
 
     for(uint32_t i = 0; i < mReflectionData.mLiveUniformBlocks; ++i) {
-        memcpy(rawDataPtr, mReflectionData.mUniformBlockReflection[i].glslBlockName, GLSLANG_MAX_UNIFORM_BLOCK_NAME_LENGTH);
-        rawDataPtr += GLSLANG_MAX_UNIFORM_BLOCK_NAME_LENGTH;
-        u32DataPtr = reinterpret_cast<uint32_t *>(rawDataPtr);
-        *u32DataPtr = mReflectionData.mUniformBlockReflection[i].binding;
-        rawDataPtr += sizeof(uint32_t);
-        u32DataPtr = reinterpret_cast<uint32_t *>(rawDataPtr);
-        *u32DataPtr = mReflectionData.mUniformBlockReflection[i].blockSize;
-        rawDataPtr += sizeof(uint32_t);
-        u32DataPtr = reinterpret_cast<uint32_t *>(rawDataPtr);
-        *u32DataPtr = mReflectionData.mUniformBlockReflection[i].blockStage;
-        rawDataPtr += sizeof(uint32_t);
-        *rawDataPtr = mReflectionData.mUniformBlockReflection[i].isOpaque;
-        rawDataPtr += sizeof(bool);
-    }
-
-    return sizeof(reflectionData);
+        const uniformBlock &block = mReflectionData.mUniformBlockReflection[i];
+        WriteName(&rawDataPtr, block.glslBlockName, stringTable, &stringOffset);
+        WriteU32(&rawDataPtr, block.binding);
+        WriteU32(&rawDataPtr, static_cast<uint32_t>(block.blockSize));
+        WriteU32(&rawDataPtr, static_cast<uint32_t>(block.blockStage));
+        WriteU32(&rawDataPtr, block.isOpaque ? 1 : 0);
+    }
+
+    assert(rawDataPtr == stringTable);
+
+    return size;
 }
 
 uint32_t
-ShaderReflection::Deserialize(const void *binary)
+ShaderReflection::Deserialize(const void *binary, uint32_t size)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
+    Reset();
+
+    if(size < REFLECTION_HEADER_SIZE) {
+        return 0;
+    }
+
     const uint8_t *rawDataPtr = reinterpret_cast<const uint8_t *>(binary);
-    const uint32_t *u32DataPtr = nullptr;
+    const uint32_t liveAttributes    = ReadU32(&rawDataPtr);
+    const uint32_t liveUniforms      = ReadU32(&rawDataPtr);
+    const uint32_t liveUniformBlocks = ReadU32(&rawDataPtr);
+    const uint32_t stringTableSize   = ReadU32(&rawDataPtr);
 
-    u32DataPtr = reinterpret_cast<const uint32_t *>(rawDataPtr);
-    mReflectionData.mLiveAttributes = *u32DataPtr;
-    rawDataPtr += sizeof(uint32_t);
+    if(liveAttributes > GLSLANG_MAX_ATTRIBUTES || liveUniforms > GLSLANG_MAX_UNIFORMS || liveUniformBlocks > GLSLANG_MAX_UNIFORM_BLOCKS) {
+        return 0;
+    }
 
-    for(uint32_t i = 0; i < mReflectionData.mLiveAttributes; ++i) {
-        memcpy(mReflectionData.mAttributeReflection[i].name, rawDataPtr, GLSLANG_MAX_ATTRIBUTE_NAME_LENGTH);
-        rawDataPtr += GLSLANG_MAX_ATTRIBUTE_NAME_LENGTH;
-        u32DataPtr = reinterpret_cast<const uint32_t *>(rawDataPtr);
-        mReflectionData.mAttributeReflection[i].type = *u32DataPtr;
-        rawDataPtr += sizeof(uint32_t);
-        u32DataPtr = reinterpret_cast<const uint32_t *>(rawDataPtr);
-        mReflectionData.mAttributeReflection[i].location = *u32DataPtr;
-        rawDataPtr += sizeof(uint32_t);
+    const uint32_t recordsSize = REFLECTION_HEADER_SIZE                                 +
+                                 liveAttributes    * REFLECTION_ATTRIBUTE_RECORD_SIZE   +
+                                 liveUniforms      * REFLECTION_UNIFORM_RECORD_SIZE     +
+                                 liveUniformBlocks * REFLECTION_BLOCK_RECORD_SIZE;
+    if(stringTableSize > size || recordsSize > size - stringTableSize) {
+        return 0;
     }
 
-    rawDataPtr += (GLSLANG_MAX_ATTRIBUTES - mReflectionData.mLiveAttributes) * sizeof(attribute);
+    const uint8_t *stringTable = reinterpret_cast<const uint8_t *>(binary) + recordsSize;
+    bool valid = true;
 
-    u32DataPtr = reinterpret_cast<const uint32_t *>(rawDataPtr);
-    mReflectionData.mLiveUniforms = *u32DataPtr;
-    rawDataPtr += sizeof(uint32_t);
+    for(uint32_t i = 0; i < liveAttributes; ++i) {
+        attribute &attr = mReflectionData.mAttributeReflection[i];
+        valid = ReadName(&rawDataPtr, attr.name, GLSLANG_MAX_ATTRIBUTE_NAME_LENGTH, stringTable, stringTableSize) && valid;
+        attr.type     = ReadU32(&rawDataPtr);
+        attr.location = static_cast<int>(ReadU32(&rawDataPtr));
+    }
 
-    for(uint32_t i = 0; i < mReflectionData.mLiveUniforms; ++i) {
-        memcpy(mReflectionData.mUniformReflection[i].reflectionName, rawDataPtr, GLSLANG_MAX_UNIFORM_NAME_LENGTH);
-        rawDataPtr += GLSLANG_MAX_UNIFORM_NAME_LENGTH;
-        u32DataPtr = reinterpret_cast<const uint32_t *>(rawDataPtr);
-        mReflectionData.mUniformReflection[i].location = *u32DataPtr;
-        rawDataPtr += sizeof(uint32_t);
-        u32DataPtr = reinterpret_cast<const uint32_t *>(rawDataPtr);
-        mReflectionData.mUniformReflection[i].blockIndex = *u32DataPtr;
-        rawDataPtr += sizeof(uint32_t);
-        u32DataPtr = reinterpret_cast<const uint32_t *>(rawDataPtr);
-        mReflectionData.mUniformReflection[i].arraySize = *u32DataPtr;
-        rawDataPtr += sizeof(uint32_t);
-        u32DataPtr = reinterpret_cast<const uint32_t *>(rawDataPtr);
-        mReflectionData.mUniformReflection[i].glType = *u32DataPtr;
-        rawDataPtr += sizeof(uint32_t);
-        u32DataPtr = reinterpret_cast<const uint32_t *>(rawDataPtr);
-        mReflectionData.mUniformReflection[i].offset = *u32DataPtr;
-        rawDataPtr += sizeof(uint32_t);
-    }
-
-    rawDataPtr += (GLSLANG_MAX_UNIFORMS - mReflectionData.mLiveUniforms) * sizeof(uniform);
-
-    u32DataPtr = reinterpret_cast<const uint32_t *>(rawDataPtr);
-    mReflectionData.mLiveUniformBlocks = *u32DataPtr;
-    rawDataPtr += sizeof(uint32_t);
+    for(uint32_t i = 0; i < liveUniforms; ++i) {
+        uniform &uni = mReflectionData.mUniformReflection[i];
+        valid = ReadName(&rawDataPtr, uni.reflectionName, GLSLANG_MAX_UNIFORM_NAME_LENGTH, stringTable, stringTableSize) && valid;
+        uni.location   = ReadU32(&rawDataPtr);
+        uni.blockIndex = ReadU32(&rawDataPtr);
+        uni.arraySize  = static_cast<int32_t>(ReadU32(&rawDataPtr));
+        uni.glType     = ReadU32(&rawDataPtr);
+        uni.offset     = ReadU32(&rawDataPtr);
+    }
 
-    for(uint32_t i = 0; i < mReflectionData.mLiveUniformBlocks; ++i) {
-        memcpy(mReflectionData.mUniformBlockReflection[i].glslBlockName, rawDataPtr, GLSLANG_MAX_UNIFORM_BLOCK_NAME_LENGTH);
-        rawDataPtr += GLSLANG_MAX_UNIFORM_BLOCK_NAME_LENGTH;
-        u32DataPtr = reinterpret_cast<const uint32_t *>(rawDataPtr);
-        mReflectionData.mUniformBlockReflection[i].binding = *u32DataPtr;
-        rawDataPtr += sizeof(uint32_t);
-        u32DataPtr = reinterpret_cast<const uint32_t *>(rawDataPtr);
-        mReflectionData.mUniformBlockReflection[i].blockSize = *u32DataPtr;
-        rawDataPtr += sizeof(uint32_t);
-        u32DataPtr = reinterpret_cast<const uint32_t *>(rawDataPtr);
-        mReflectionData.mUniformBlockReflection[i].blockStage = static_cast<shader_type_t>(*u32DataPtr);
-        rawDataPtr += sizeof(uint32_t);
-        mReflectionData.mUniformBlockReflection[i].isOpaque = *rawDataPtr;
-        rawDataPtr += sizeof(bool);
-    }
-
-    return sizeof(reflectionData);
+    for(uint32_t i = 0; i < liveUniformBlocks; ++i) {
+        uniformBlock &block = mReflectionData.mUniformBlockReflection[i];
+        valid = ReadName(&rawDataPtr, block.glslBlockName, GLSLANG_MAX_UNIFORM_BLOCK_NAME_LENGTH, stringTable, stringTableSize) && valid;
+        block.binding    = ReadU32(&rawDataPtr);
+        block.blockSize  = ReadU32(&rawDataPtr);
+        block.blockStage = static_cast<shader_type_t>(ReadU32(&rawDataPtr));
+        block.isOpaque   = ReadU32(&rawDataPtr) != 0;
+    }
+
+    if(!valid) {
+        Reset();
+        return 0;
+    }
+
+    mReflectionData.mLiveAttributes    = liveAttributes;
+    mReflectionData.mLiveUniforms      = liveUniforms;
+    mReflectionData.mLiveUniformBlocks = liveUniformBlocks;
+
+    return recordsSize + stringTableSize;
 }
 
 void
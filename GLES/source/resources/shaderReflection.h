@@ -80,10 +80,10 @@ public:
     void                 Reset(void);
     void                 Print(void)                                                   const;
     uint32_t             Serialize(void *binary)                                       const;
-    uint32_t             Deserialize(const void *binary);    
+    uint32_t             Deserialize(const void *binary, uint32_t size);
  
   /// Get Functions 
-    inline uint32_t      GetReflectionSize(void)                                       const { FUN_ENTRY(GL_LOG_TRACE); return sizeof(reflectionData); }
+    uint32_t             GetSerializedSize(void)                                       const;
     inline uint32_t      GetLiveAttributes(void)                                       const { FUN_ENTRY(GL_LOG_TRACE); return mReflectionData.mLiveAttributes; }
     inline uint32_t      GetLiveUniforms(void)                                         const { FUN_ENTRY(GL_LOG_TRACE); return mReflectionData.mLiveUniforms; }
     inline uint32_t      GetLiveUniformBlocks(void)                                    const { FUN_ENTRY(GL_LOG_TRACE); return mReflectionData.mLiveUniformBlocks; }
@@ -34,7 +34,7 @@
 
 ShaderResourceInterface::ShaderResourceInterface()
 : mLiveAttributes(0), mLiveUniforms(0), mLiveUniformBlocks(0),
-  mActiveAttributeMaxLength(0), mActiveUniformMaxLength(0), mReflectionSize(0), mCacheManager(nullptr)
+  mActiveAttributeMaxLength(0), mActiveUniformMaxLength(0), mCacheManager(nullptr)
 {
     FUN_ENTRY(GL_LOG_TRACE);
 }
@@ -144,7 +144,6 @@ private:
 
     size_t                                  mActiveAttributeMaxLength;
     size_t                                  mActiveUniformMaxLength;
-    uint32_t                                mReflectionSize;
 
     ShaderReflection*                       mShaderReflection;
 
@@ -173,9 +172,6 @@ public:
     inline size_t                           GetActiveAttribMaxLen(void)            const { FUN_ENTRY(GL_LOG_TRACE); return mActiveAttributeMaxLength;  }
     inline size_t                           GetActiveUniformMaxLen(void)           const { FUN_ENTRY(GL_LOG_TRACE); return mActiveUniformMaxLength;    }
 
-
-    inline uint32_t                         GetReflectionSize(void)                const { FUN_ENTRY(GL_LOG_TRACE); return mReflectionSize; }
-
     const  string&                          GetAttributeName(int index)            const { FUN_ENTRY(GL_LOG_TRACE); return mAttributeInterface[index].name; }
     int                                     GetAttributeType(int index)            const { FUN_ENTRY(GL_LOG_TRACE); return mAttributeInterface[index].type; }
     int                                     GetAttributeLocation(const char *name) const;
@@ -206,7 +202,6 @@ public:
 /// Set Functions
     inline void                             SetCacheManager(CacheManager *cacheManager)          { FUN_ENTRY(GL_LOG_TRACE); mCacheManager     = cacheManager; }
     inline void                             SetReflection(ShaderReflection* reflection)          { FUN_ENTRY(GL_LOG_TRACE); mShaderReflection = reflection; };
-    inline void                             SetReflectionSize(void)                              { FUN_ENTRY(GL_LOG_TRACE); mReflectionSize   = mShaderReflection->GetReflectionSize(); }
     inline void                             SetCustomAttribsLayout(const char *name, int index)  { FUN_ENTRY(GL_LOG_TRACE); mCustomAttributesLayout[std::string(name)] = index; }    
     void                                    SetActiveAttributeMaxLength(void);
     void                                    SetActiveUniformMaxLength(void);
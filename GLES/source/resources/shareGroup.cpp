@@ -0,0 +1,383 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+/**
+ *  @file       shareGroup.cpp
+ *  @author     Think Silicon
+ *  @date       18/10/2026
+ *  @version    1.0
+ *
+ *  @brief      Objects shared by the contexts created with a share_context
+ *
+ *  @section
+ *
+ *  Textures, buffers, renderbuffers, shaders and programs, along with their
+ *  names, are shared by all the contexts of a share group; framebuffers,
+ *  vertex attributes and the default textures stay in each context. The
+ *  group is reference counted by its contexts and is destroyed with the
+ *  last one.
+ *
+ *  Contexts of different threads may still be executing commands that use
+ *  an object when it is deleted. The object records the last submission of
+ *  every context of the group and is released once the fences of all of
+ *  them have signaled, so no context has to wait for the others to go idle.
+ *
+ */
+
+#include "shareGroup.h"
+#include "glslang/glslangShaderCompiler.h"
+#include "vulkan/commandBufferManager.h"
+#include <algorithm>
+
+ShareGroup::ShareGroup(const vulkanAPI::vkContext_t *vkContext)
+: mRefCount(0), mCacheManager(vkContext), mShadingObjectCount(1)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    mShaderCompiler = new GlslangShaderCompiler();
+}
+
+ShareGroup::~ShareGroup()
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    // the objects deleted through the purge lists are no longer in the arrays
+    for(auto &entry : mPurgeListBufferObject) {
+        delete entry.object;
+    }
+    for(auto &entry : mPurgeListTexture) {
+        delete entry.object;
+    }
+    for(auto &entry : mPurgeListRenderbuffers) {
+        delete entry.object;
+    }
+    for(auto &entry : mRetiredCaches) {
+        delete entry.object;
+    }
+
+    if(mShaderCompiler != nullptr) {
+        delete mShaderCompiler;
+        mShaderCompiler = nullptr;
+    }
+}
+
+void
+ShareGroup::AddMember(const vulkanAPI::CommandBufferManager *commandBufferManager)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
+    mMembers.push_back(commandBufferManager);
+}
+
+void
+ShareGroup::RemoveMember(const vulkanAPI::CommandBufferManager *commandBufferManager)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
+    mMembers.erase(std::remove(mMembers.begin(), mMembers.end(), commandBufferManager), mMembers.end());
+}
+
+ShareGroup::submitSerials_t
+ShareGroup::GetSubmitSerials(void)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    // commands another context is still recording are covered by the submission they will go out with
+    submitSerials_t serials;
+    for(auto member : mMembers) {
+        serials.push_back(std::make_pair(member, std::max(member->GetLastSubmitSerial(), member->GetRecordingSerial())));
+    }
+
+    return serials;
+}
+
+bool
+ShareGroup::AreSubmissionsCompleted(const submitSerials_t& serials)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    for(auto &serial : serials) {
+        // a context that has left the group waited for its submissions when it was destroyed
+        if(std::find(mMembers.begin(), mMembers.end(), serial.first) == mMembers.end()) {
+            continue;
+        }
+        if(serial.first->GetCompletedSerial() < serial.second) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void
+ShareGroup::CreateShaderCompiler(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    if(mShaderCompiler != nullptr) {
+        return;
+    }
+
+    mShaderCompiler = new GlslangShaderCompiler();
+
+    {
+        std::lock_guard<std::mutex> lock(mShaders.GetMutex());
+        for(auto &it : *mShaders.GetObjects()) {
+            it.second->SetShaderCompiler(mShaderCompiler);
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mShaderPrograms.GetMutex());
+        for(auto &it : *mShaderPrograms.GetObjects()) {
+            it.second->SetShaderCompiler(mShaderCompiler);
+        }
+    }
+}
+
+void
+ShareGroup::ReleaseShaderCompiler(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    if(mShaderCompiler != nullptr) {
+        delete mShaderCompiler;
+        mShaderCompiler = nullptr;
+    }
+}
+
+uint32_t
+ShareGroup::PushShadingObject(const ShadingNamespace_t& obj)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
+    mShadingObjectPool[mShadingObjectCount] = obj;
+    return mShadingObjectCount++;
+}
+
+void
+ShareGroup::EraseShadingObject(uint32_t id)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
+    mShadingObjectPool.erase(id);
+}
+
+uint32_t
+ShareGroup::GetShadingObjectCount(void)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
+    return mShadingObjectCount;
+}
+
+ShadingNamespace_t
+ShareGroup::GetShadingObject(GLuint index)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
+    return mShadingObjectPool[index];
+}
+
+bool
+ShareGroup::ShadingObjectExists(GLuint index)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
+    return mShadingObjectPool.find(index) != mShadingObjectPool.end();
+}
+
+GLboolean
+ShareGroup::IsShadingObject(GLuint index, shadingNamespaceType_t type)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
+
+    if(!index || index >= mShadingObjectCount || !ShadingObjectExists(index)) {
+        return GL_FALSE;
+    }
+
+    ShadingNamespace_t shadId = mShadingObjectPool.find(index)->second;
+    return (shadId.arrayIndex && shadId.type == type) ? GL_TRUE : GL_FALSE;
+}
+
+uint32_t
+ShareGroup::FindShaderID(const Shader *shader)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
+
+    uint32_t shaderID = mShaders.GetObjectId(shader);
+    for(shadingPoolIDs_t::iterator it = mShadingObjectPool.begin(); it != mShadingObjectPool.end(); ++it) {
+        if(it->second.type == SHADER_ID && shaderID == it->second.arrayIndex) {
+            return it->first;
+        }
+    }
+    return 0;
+}
+
+uint32_t
+ShareGroup::FindShaderProgramID(const ShaderProgram *program)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
+
+    uint32_t programID = mShaderPrograms.GetObjectId(program);
+    for(shadingPoolIDs_t::iterator it = mShadingObjectPool.begin(); it != mShadingObjectPool.end(); ++it) {
+        if(it->second.type == SHADER_PROGRAM_ID && programID == it->second.arrayIndex) {
+            return it->first;
+        }
+    }
+    return 0;
+}
+
+void
+ShareGroup::AddToPurgeList(BufferObject *object)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
+    mPurgeListBufferObject.push_back({object, GetSubmitSerials()});
+}
+
+void
+ShareGroup::AddToPurgeList(Texture *object)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
+    mPurgeListTexture.push_back({object, GetSubmitSerials()});
+}
+
+void
+ShareGroup::AddToPurgeList(Shader *object)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
+    mPurgeListShaders.push_back({object, GetSubmitSerials()});
+}
+
+void
+ShareGroup::AddToPurgeList(ShaderProgram *object)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
+    mPurgeListShaderPrograms.push_back({object, GetSubmitSerials()});
+}
+
+void
+ShareGroup::AddToPurgeList(Renderbuffer *object)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
+    mPurgeListRenderbuffers.push_back({object, GetSubmitSerials()});
+}
+
+void
+ShareGroup::RetireCaches(void)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    // the serials are taken after the objects are detached, so they cover every submission that used them
+    CacheManager *cacheManager = mCacheManager.DetachPendingCache();
+    if(cacheManager == nullptr) {
+        return;
+    }
+
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
+    mRetiredCaches.push_back({cacheManager, GetSubmitSerials()});
+}
+
+void
+ShareGroup::CleanPurgeList(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    std::lock_guard<std::recursive_mutex> lock(mMutex);
+
+    //Retired program objects
+    for (auto it = mRetiredCaches.begin(); it != mRetiredCaches.end(); ) {
+        if (AreSubmissionsCompleted(it->serials)) {
+            delete it->object;
+            it = mRetiredCaches.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    //Buffers
+    for (auto it = mPurgeListBufferObject.begin(); it != mPurgeListBufferObject.end(); ) {
+        if (it->object->GetRefCount() == 0 && AreSubmissionsCompleted(it->serials)) {
+            delete it->object;
+            it = mPurgeListBufferObject.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    //Textures
+    for (auto it = mPurgeListTexture.begin(); it != mPurgeListTexture.end(); ) {
+        if (it->object->GetRefCount() == 0 && AreSubmissionsCompleted(it->serials)) {
+            delete it->object;
+            it = mPurgeListTexture.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    //Shader Programs
+    for (auto it = mPurgeListShaderPrograms.begin(); it != mPurgeListShaderPrograms.end();) {
+        ShaderProgram* shaderProgramPtr = it->object;
+        if (shaderProgramPtr->FreeForDeletion() && AreSubmissionsCompleted(it->serials)) {
+            shaderProgramPtr->DetachShaders();
+            uint32_t id = FindShaderProgramID(shaderProgramPtr);
+            EraseShadingObject(id);
+            mShaderPrograms.Deallocate(mShaderPrograms.GetObjectId(shaderProgramPtr));
+            it = mPurgeListShaderPrograms.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    //Shaders
+    for (auto it = mPurgeListShaders.begin(); it != mPurgeListShaders.end();) {
+        Shader* shaderPtr = it->object;
+        if (shaderPtr->FreeForDeletion() && AreSubmissionsCompleted(it->serials)) {
+            uint32_t id = FindShaderID(shaderPtr);
+            EraseShadingObject(id);
+            mShaders.Deallocate(mShaders.GetObjectId(shaderPtr));
+            it = mPurgeListShaders.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    //Renderbuffer
+    for (auto it = mPurgeListRenderbuffers.begin(); it != mPurgeListRenderbuffers.end(); ) {
+        if (it->object->GetRefCount() == 0 && AreSubmissionsCompleted(it->serials)) {
+            delete it->object;
+            it = mPurgeListRenderbuffers.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
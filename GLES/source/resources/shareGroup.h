@@ -0,0 +1,148 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+/**
+ *  @file       shareGroup.h
+ *  @author     Think Silicon
+ *  @date       18/10/2026
+ *  @version    1.0
+ *
+ *  @brief      Objects shared by the contexts created with a share_context
+ *
+ */
+
+#ifndef __SHAREGROUP_H__
+#define __SHAREGROUP_H__
+
+#include "resources/bufferObject.h"
+#include "resources/shaderProgram.h"
+#include "resources/renderbuffer.h"
+#include "resources/shader.h"
+#include "resources/texture.h"
+#include "utils/arrays.hpp"
+#include "utils/cacheManager.h"
+#include <atomic>
+#include <mutex>
+
+namespace vulkanAPI {
+    class CommandBufferManager;
+}
+
+typedef enum {
+    NO_ID,
+    SHADER_ID,
+    SHADER_PROGRAM_ID
+} shadingNamespaceType_t;
+
+typedef struct {
+    shadingNamespaceType_t                 type;
+    uint32_t                               arrayIndex;
+} ShadingNamespace_t;
+
+class ShareGroup {
+public:
+    typedef ObjectArray<Texture>               TextureArray;
+    typedef ObjectArray<BufferObject>          BufferArray;
+    typedef ObjectArray<Shader>                ShaderArray;
+    typedef ObjectArray<ShaderProgram>         ShaderProgramArray;
+    typedef ObjectArray<Renderbuffer>          RenderbufferArray;
+
+private:
+    typedef map<uint32_t, ShadingNamespace_t>  shadingPoolIDs_t;
+
+    /// the last submission of every context of the group when an object was deleted
+    typedef std::vector<std::pair<const vulkanAPI::CommandBufferManager *, uint64_t> > submitSerials_t;
+
+    template<typename OBJECT>
+    struct purgeEntry_t {
+        OBJECT                                *object;
+        submitSerials_t                        serials;
+    };
+
+    std::atomic<uint32_t>                      mRefCount;
+    std::recursive_mutex                       mMutex;
+    std::vector<const vulkanAPI::CommandBufferManager *> mMembers;
+
+    /// objects the shared programs replace, whichever context draws with them;
+    /// declared before the programs, which still retire objects when destroyed
+    CacheManager                               mCacheManager;
+    std::vector<purgeEntry_t<CacheManager> >   mRetiredCaches;
+
+    BufferArray                                mBuffers;
+    RenderbufferArray                          mRenderbuffers;
+    TextureArray                               mTextures;
+
+    uint32_t                                   mShadingObjectCount;
+    shadingPoolIDs_t                           mShadingObjectPool;
+    ShaderArray                                mShaders;
+    ShaderProgramArray                         mShaderPrograms;
+
+    std::mutex                                 mCompilerMutex;
+    ShaderCompiler                            *mShaderCompiler;
+
+    std::vector<purgeEntry_t<BufferObject> >   mPurgeListBufferObject;
+    std::vector<purgeEntry_t<Texture> >        mPurgeListTexture;
+    std::vector<purgeEntry_t<Shader> >         mPurgeListShaders;
+    std::vector<purgeEntry_t<ShaderProgram> >  mPurgeListShaderPrograms;
+    std::vector<purgeEntry_t<Renderbuffer> >   mPurgeListRenderbuffers;
+
+    submitSerials_t                            GetSubmitSerials(void);
+    bool                                       AreSubmissionsCompleted(const submitSerials_t& serials);
+
+public:
+    explicit ShareGroup(const vulkanAPI::vkContext_t *vkContext);
+    ~ShareGroup();
+
+// Reference Functions
+    inline void                Ref(void)                                        { FUN_ENTRY(GL_LOG_TRACE); mRefCount++; }
+    inline uint32_t            Unref(void)                                      { FUN_ENTRY(GL_LOG_TRACE); return --mRefCount; }
+    inline bool                IsShared(void)                             const { FUN_ENTRY(GL_LOG_TRACE); return mRefCount > 1; }
+           void                AddMember(const vulkanAPI::CommandBufferManager *commandBufferManager);
+           void                RemoveMember(const vulkanAPI::CommandBufferManager *commandBufferManager);
+
+// Get Functions
+    inline TextureArray       *GetTextureArray(void)                            { FUN_ENTRY(GL_LOG_TRACE); return &mTextures; }
+    inline BufferArray        *GetBufferArray(void)                             { FUN_ENTRY(GL_LOG_TRACE); return &mBuffers; }
+    inline ShaderArray        *GetShaderArray(void)                             { FUN_ENTRY(GL_LOG_TRACE); return &mShaders;  }
+    inline ShaderProgramArray *GetShaderProgramArray(void)                      { FUN_ENTRY(GL_LOG_TRACE); return &mShaderPrograms; }
+    inline RenderbufferArray  *GetRenderbufferArray(void)                       { FUN_ENTRY(GL_LOG_TRACE); return &mRenderbuffers; }
+    inline CacheManager       *GetCacheManager(void)                            { FUN_ENTRY(GL_LOG_TRACE); return &mCacheManager; }
+
+// Shader Compiler Functions
+    /// compiling and linking are serialized, the compiler keeps the logs of the last compilation
+    inline std::mutex&         GetCompilerMutex(void)                           { FUN_ENTRY(GL_LOG_TRACE); return mCompilerMutex; }
+    inline ShaderCompiler     *GetShaderCompiler(void)                          { FUN_ENTRY(GL_LOG_TRACE); return mShaderCompiler; }
+           void                CreateShaderCompiler(void);
+           void                ReleaseShaderCompiler(void);
+
+// Map Functions
+           uint32_t            PushShadingObject(const ShadingNamespace_t& obj);
+           void                EraseShadingObject(GLuint index);
+           uint32_t            GetShadingObjectCount(void);
+           ShadingNamespace_t  GetShadingObject(GLuint index);
+           bool                ShadingObjectExists(GLuint index);
+           GLboolean           IsShadingObject(GLuint index, shadingNamespaceType_t type);
+           uint32_t            FindShaderID(const Shader *shader);
+           uint32_t            FindShaderProgramID(const ShaderProgram *program);
+
+//PurgeList Functions
+           void                AddToPurgeList(BufferObject *object);
+           void                AddToPurgeList(Texture *object);
+           void                AddToPurgeList(Shader *object);
+           void                AddToPurgeList(ShaderProgram *object);
+           void                AddToPurgeList(Renderbuffer *object);
+           void                RetireCaches(void);
+           void                CleanPurgeList(void);
+};
+
+#endif //__SHAREGROUP_H__
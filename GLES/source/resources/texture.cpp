@@ -147,10 +147,19 @@ Texture::IsCompleted(void)
 }
 
 void
-Texture::ReleaseVkResources(void)
+Texture::ReleaseVkResources(CacheManager *cacheManager)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
+    /// submitted work may still sample the texture, its objects are then destroyed when the cache manager retires them
+    if(cacheManager) {
+        mSampler->Release(cacheManager);
+        mImageView->Release(cacheManager);
+        mImage->Release(cacheManager);
+        mMemory->Release(cacheManager);
+        return;
+    }
+
     mSampler->Release();
     mImageView->Release();
     mImage->Release();
@@ -182,11 +191,11 @@ Texture::AllocateVkMemory(void)
 }
 
 bool
-Texture::CreateVkTexture(void)
+Texture::CreateVkTexture(CacheManager *cacheManager, bool prepareLayout)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    ReleaseVkResources();
+    ReleaseVkResources(cacheManager);
 
     if(!CreateVkImage()) {
         return false;
@@ -203,13 +212,15 @@ Texture::CreateVkTexture(void)
         return false;
     }
 
-    PrepareVkImageLayout(VK_IMAGE_LAYOUT_GENERAL);
+    if(prepareLayout) {
+        PrepareVkImageLayout(VK_IMAGE_LAYOUT_GENERAL);
+    }
 
     return true;
 }
 
 bool
-Texture::Allocate(void)
+Texture::Allocate(CacheManager *cacheManager)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
@@ -221,10 +232,24 @@ Texture::Allocate(void)
     SetType  (state->type);
     SetInternalFormat(GlFormatToGlInternalFormat(state->format, state->type));
 
-    mExplicitInternalFormat = VkFormatToGlInternalformat(mImage->GetFormat());
+    /// single/dual-channel images keep the luminance/alpha layout and expand it through the view swizzle
+    const VkFormat vkformat = mImage->GetFormat();
+    mExplicitInternalFormat = (vkformat == VK_FORMAT_R8_UNORM || vkformat == VK_FORMAT_R8G8_UNORM) ?
+                              mInternalFormat : VkFormatToGlInternalformat(vkformat);
     mExplicitType           = GlInternalFormatToGlType(mExplicitInternalFormat);
 
-    if(!CreateVkTexture()) {
+    mImageView->SetComponentMapping(GlColorFormatToVkComponentMapping(mFormat, vkformat));
+
+    // levels uploaded on the transfer queue start from the undefined layout, so the image is only
+    // moved to the general layout up front when some of its levels are left unwritten
+    bool uploadAllLevels = GetCurrentContext() && GetCurrentContext()->GetVkCommandBufferManager()->HasTransferQueue();
+    for(GLint layer = 0; layer < mLayersCount && uploadAllLevels; ++layer) {
+        for(GLint level = 0; level < mMipLevelsCount && uploadAllLevels; ++level) {
+            uploadAllLevels = mState[layer][level].data != nullptr;
+        }
+    }
+
+    if(!CreateVkTexture(cacheManager, !uploadAllLevels)) {
         return false;
     }
 
@@ -245,7 +270,7 @@ Texture::Allocate(void)
                                   GlInternalFormatTypeToNumElements(dstInternalFormat, dstType),
                                   GlTypeToElementSize(dstType),
                                   Texture::GetDefaultInternalAlignment());
-                CopyPixelsFromHost(&srcRect, &dstRect, level, layer, srcInternalFormat, static_cast<void *>(state->data));
+                CopyPixelsFromHost(&srcRect, &dstRect, level, layer, srcInternalFormat, static_cast<void *>(state->data), true);
             }
         }
     }
@@ -253,6 +278,117 @@ Texture::Allocate(void)
     return true;
 }
 
+bool
+Texture::BindSurfaceImage(VkImage image, VkFormat vkformat, GLenum format, GLsizei width, GLsizei height)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    /// the texture samples the color image of a pbuffer in place, the image stays owned by the surface
+    ReleaseVkResources();
+
+    if(mState != nullptr) {
+        delete [] mState;
+    }
+    InitState();
+    SetState(width, height, 0, 0, format, GL_UNSIGNED_BYTE, GetDefaultInternalAlignment(), nullptr);
+
+    SetWidth (width);
+    SetHeight(height);
+    SetFormat(format);
+    SetType  (GL_UNSIGNED_BYTE);
+    SetInternalFormat(GlFormatToGlInternalFormat(format, GL_UNSIGNED_BYTE));
+    mExplicitInternalFormat = VkFormatToGlInternalformat(vkformat);
+    mExplicitType           = GlInternalFormatToGlType(mExplicitInternalFormat);
+    mMipLevelsCount         = 1;
+
+    mImage->SetFormat(vkformat);
+    mImage->SetImageUsage(static_cast<VkImageUsageFlagBits>(VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT |
+                                                            VK_IMAGE_USAGE_TRANSFER_SRC_BIT     | VK_IMAGE_USAGE_TRANSFER_DST_BIT));
+    mImage->SetImageTiling();
+    mImage->SetImageTarget(vulkanAPI::Image::VK_IMAGE_TARGET_2D);
+    mImage->SetWidth(width);
+    mImage->SetHeight(height);
+    mImage->SetMipLevels(1);
+    mImage->SetImage(image);
+    mImage->SetImageLayout(VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    mImage->CreateImageSubresourceRange();
+
+    /// EGL_TEXTURE_RGB surfaces are sampled with an opaque alpha
+    VkComponentMapping mapping = GlColorFormatToVkComponentMapping(format, vkformat);
+    if(format == GL_RGB) {
+        mapping.a = VK_COMPONENT_SWIZZLE_ONE;
+    }
+    mImageView->SetComponentMapping(mapping);
+
+    mSampler->SetMaxLod(0.25f);
+
+    return CreateVkImageView();
+}
+
+void
+Texture::ReleaseSurfaceImage(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    /// after eglReleaseTexImage the texture has no image data left, as if it was never specified
+    ReleaseVkResources();
+
+    if(mState != nullptr) {
+        delete [] mState;
+    }
+    InitState();
+
+    SetWidth (0);
+    SetHeight(0);
+}
+
+void
+Texture::SelectVkFormat(GLenum format, GLenum type, bool colorAttachment)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    const VkFormat          vkformat    = GlColorFormatToVkColorFormat(format, type);
+    const VkImageUsageFlags sampleUsage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+    const VkImageUsageFlags renderUsage = sampleUsage | VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+
+    /// Only color-renderable formats ask for attachment support. When the
+    /// device can sample such a format but not render to it, keep it compact
+    /// and sample-only until the texture is attached to a framebuffer.
+    VkImageUsageFlags usage = sampleUsage;
+    if(GlFormatIsColorRenderable(GlFormatToGlInternalFormat(format, type))) {
+        usage = renderUsage;
+        if(!colorAttachment) {
+            mImage->SetImageUsage(static_cast<VkImageUsageFlagBits>(renderUsage));
+            if(!mImage->IsFormatSupported(vkformat, VK_IMAGE_TILING_OPTIMAL)) {
+                mImage->SetImageUsage(static_cast<VkImageUsageFlagBits>(sampleUsage));
+                if(mImage->IsFormatSupported(vkformat, VK_IMAGE_TILING_OPTIMAL)) {
+                    usage = sampleUsage;
+                }
+            }
+        }
+    }
+
+    mImage->SetImageUsage(static_cast<VkImageUsageFlagBits>(usage));
+    mImage->SetFormat(mImage->FindSupportedVkColorFormat(vkformat));
+    mImage->SetImageTiling();
+}
+
+bool
+Texture::EnableColorAttachment(CacheManager *cacheManager)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    if((GetVkImageUsage() & VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT) ||
+       !GlFormatIsColorRenderable(mInternalFormat) || !IsCompleted()) {
+        return true;
+    }
+
+    /// the texture was kept sample-only, move it to a format it can be rendered to
+    SelectVkFormat(mFormat, mType, true);
+
+    return Allocate(cacheManager);
+}
+
 void
 Texture::SetState(GLsizei width, GLsizei height, GLint level, GLint layer, GLenum format, GLenum type, GLint unpackAlignment, const void *pixels)
 {
@@ -307,37 +443,19 @@ Texture::SetSubState(ImageRect *srcRect, ImageRect *dstRect, GLint level, GLint
     if(srcData) {
         const GLenum dstFormat = mInternalFormat;
 
-        // create a buffer at the size of the requested subrectangle
-        const size_t dstSize = dstRect->GetRectBufferSize();
-        uint8_t *dstData = new uint8_t[dstSize];
-
-        // convert the source buffer to the internal format and alignment
-        // both buffers here are in the subtexture dimensions but may differ
-        // in format and alignment
+        // convert the source buffer straight into the subrectangle of the
+        // stored level, in the internal format and alignment, flipping it
+        // in the same pass when the texture was rendered to
         ImageRect tmp_srcRect = *srcRect;
         ImageRect tmp_dstRect = *dstRect;
         tmp_srcRect.x = 0; tmp_srcRect.y = 0;
-        tmp_dstRect.x = 0; tmp_dstRect.y = 0;
+        tmp_dstRect.width  = mState[layer][level].width;
+        tmp_dstRect.height = mState[layer][level].height;
         ConvertPixels(srcFormat, dstFormat,
                       &tmp_srcRect, srcData,
-                      &tmp_dstRect, dstData);
-
-        if(mFboColorAttached) {
-            InvertImageYAxis(static_cast<uint8_t *>(dstData), &tmp_dstRect);
-        }
+                      &tmp_dstRect, mState[layer][level].data,
+                      mFboColorAttached);
         mFboColorAttached = false;
-
-        // copy the converted buffer (containing the subtexture) to the target texture
-        // both buffers are now in the same format and alignment
-        tmp_srcRect = *srcRect;
-        tmp_dstRect = *dstRect;
-        tmp_srcRect.mAlignment = Texture::GetDefaultInternalAlignment();
-        tmp_dstRect.width = mState[layer][level].width;
-        tmp_dstRect.height = mState[layer][level].height;
-
-        CopyPixelsNoConversion(&tmp_srcRect, dstData,
-                              &tmp_dstRect, mState[layer][level].data);
-        delete[] dstData;
     }
 
     SetDataUpdated(true);
@@ -367,18 +485,15 @@ void Texture::CopyPixelsToHost(ImageRect *srcRect, ImageRect *dstRect, GLint mip
     tmp_dstRect.x = 0; tmp_dstRect.y = 0;
     ConvertPixels(srcFormat, dstFormat,
                   &tmp_srcRect, srcData,
-                  &tmp_dstRect, dstData);
-
-    if(!mDataNoInvertion) {
-        InvertImageYAxis(static_cast<uint8_t *>(dstData), &tmp_dstRect);
-    }
+                  &tmp_dstRect, dstData,
+                  !mDataNoInvertion);
     mDataNoInvertion = false;
 
     delete    tbo;
     delete[]  srcData;
 }
 
-void Texture::CopyPixelsFromHost(ImageRect *srcRect, ImageRect *dstRect, GLint miplevel, GLint layer, GLenum srcFormat, const void *srcData)
+void Texture::CopyPixelsFromHost(ImageRect *srcRect, ImageRect *dstRect, GLint miplevel, GLint layer, GLenum srcFormat, const void *srcData, bool unusedImage)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
@@ -386,25 +501,38 @@ void Texture::CopyPixelsFromHost(ImageRect *srcRect, ImageRect *dstRect, GLint m
 
     // create a buffer at the size of the requested subrectangle
     const size_t dstSize   = dstRect->GetRectBufferSize();
-    uint8_t *dstData = new uint8_t[dstSize];
+    BufferObject *tbo = new TransferSrcBufferObject(mVkContext);
+    tbo->Allocate(dstSize, nullptr);
 
-    // convert the destination buffer (both are similar dimensions) to the internal format
-    ImageRect tmp_srcRect = *srcRect;
-    ImageRect tmp_dstRect = *dstRect;
-    tmp_srcRect.x = 0; tmp_srcRect.y = 0;
-    tmp_dstRect.x = 0; tmp_dstRect.y = 0;
-    ConvertPixels(srcFormat, dstFormat,
-                  &tmp_srcRect, srcData,
-                  &tmp_dstRect, dstData);
+    // convert the source buffer (both are similar dimensions) to the internal
+    // format straight into the staging memory
+    void *dstData = tbo->Map(0, dstSize, GL_MAP_WRITE_BIT_EXT);
+    if(dstData) {
+        ImageRect tmp_srcRect = *srcRect;
+        ImageRect tmp_dstRect = *dstRect;
+        tmp_srcRect.x = 0; tmp_srcRect.y = 0;
+        tmp_dstRect.x = 0; tmp_dstRect.y = 0;
+        ConvertPixels(srcFormat, dstFormat,
+                      &tmp_srcRect, srcData,
+                      &tmp_dstRect, dstData);
+        tbo->Unmap();
+    }
 
-    BufferObject *tbo = new TransferSrcBufferObject(mVkContext);
-    tbo->Allocate(dstSize, dstData);
+    // a whole level of an image that no submission has used yet is uploaded on the transfer queue,
+    // and the staging buffer is released with the submission that waits for it
+    if(unusedImage && SubmitUploadPixels(dstRect, tbo, miplevel, layer)) {
+        GetCurrentContext()->GetCacheManager()->CacheVBO(tbo);
+    } else {
+        // the contents of a whole unused level are discarded, it may not have a defined layout yet
+        if(unusedImage) {
+            mImage->SetImageLayout(VK_IMAGE_LAYOUT_UNDEFINED);
+        }
 
-    // use the global rect offsets for transfering the subpixels to Vulkan
-    SubmitCopyPixels(dstRect, tbo, miplevel, layer, dstFormat, true);
+        // use the global rect offsets for transfering the subpixels to Vulkan
+        SubmitCopyPixels(dstRect, tbo, miplevel, layer, dstFormat, true);
 
-    delete    tbo;
-    delete[]  dstData;
+        delete    tbo;
+    }
 
 #if GLOVE_SAVE_TEXTURES_TO_FILE == true
     // TODO:: adjust for lod levels
@@ -431,6 +559,53 @@ void Texture::SubmitCopyPixels(const Rect *rect, BufferObject *tbo, GLint miplev
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
+    assert(GetCurrentContext());
+    vulkanAPI::CommandBufferManager *commandBufferManager = GetCurrentContext()->GetVkCommandBufferManager();
+    commandBufferManager->BeginVkAuxCommandBuffer();
+    VkCommandBuffer activeCmdBuffer = commandBufferManager->GetAuxCommandBuffer();
+    RecordCopyPixels(&activeCmdBuffer, rect, tbo, miplevel, layer, copyToImage);
+    commandBufferManager->EndVkAuxCommandBuffer();
+    commandBufferManager->SubmitVkAuxCommandBuffer();
+    commandBufferManager->WaitVkAuxCommandBuffer();
+}
+
+bool Texture::SubmitUploadPixels(const Rect *rect, BufferObject *tbo, GLint miplevel, GLint layer)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    assert(GetCurrentContext());
+    vulkanAPI::CommandBufferManager *commandBufferManager = GetCurrentContext()->GetVkCommandBufferManager();
+    if(!commandBufferManager->HasTransferQueue() || !commandBufferManager->BeginVkUploadCommandBuffer()) {
+        return false;
+    }
+    VkCommandBuffer transferCmdBuffer = commandBufferManager->GetUploadCommandBuffer();
+    VkCommandBuffer acquireCmdBuffer  = commandBufferManager->GetUploadAcquireCommandBuffer();
+
+    mImage->CreateBufferImageCopy(rect->x, rect->y, rect->width, rect->height, miplevel, layer, 1);
+    mImage->ModifyImageSubresourceRange(miplevel, 1, layer, 1);
+
+    // the whole level is written, so the transfer queue discards its contents instead of
+    // having the graphics queue hand them over; a new image is acquired in the general layout
+    VkImageLayout imageLayout = mImage->GetImageLayout();
+    imageLayout = (imageLayout != VK_IMAGE_LAYOUT_UNDEFINED &&
+                   imageLayout != VK_IMAGE_LAYOUT_PREINITIALIZED) ? imageLayout : VK_IMAGE_LAYOUT_GENERAL;
+    mImage->SetImageLayout(VK_IMAGE_LAYOUT_UNDEFINED);
+    mImage->ModifyImageLayout(&transferCmdBuffer, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+    mImage->CopyBufferToImage(&transferCmdBuffer, tbo->GetVkBuffer());
+    mImage->TransferQueueFamilyOwnership(&transferCmdBuffer, &acquireCmdBuffer, imageLayout,
+                                         commandBufferManager->GetTransferQueueFamily(),
+                                         commandBufferManager->GetGraphicsQueueFamily());
+
+    commandBufferManager->EndVkUploadCommandBuffer();
+    commandBufferManager->SubmitVkUploadCommandBuffer();
+
+    return true;
+}
+
+void Texture::RecordCopyPixels(VkCommandBuffer *activeCmdBuffer, const Rect *rect, BufferObject *tbo, GLint miplevel, GLint layer, bool copyToImage)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
     mImage->CreateBufferImageCopy(rect->x, rect->y, rect->width, rect->height, miplevel, layer, 1);
     mImage->ModifyImageSubresourceRange(miplevel, 1, layer, 1);
 
@@ -439,22 +614,14 @@ void Texture::SubmitCopyPixels(const Rect *rect, BufferObject *tbo, GLint miplev
                       oldImageLayout != VK_IMAGE_LAYOUT_PREINITIALIZED) ? oldImageLayout : VK_IMAGE_LAYOUT_GENERAL;
     VkImageLayout newImageLayout = copyToImage ? VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL : VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
 
-    assert(GetCurrentContext());
-    vulkanAPI::CommandBufferManager *commandBufferManager = GetCurrentContext()->GetVkCommandBufferManager();
-    commandBufferManager->BeginVkAuxCommandBuffer();
-    VkCommandBuffer activeCmdBuffer = commandBufferManager->GetAuxCommandBuffer();
-    {
-        mImage->ModifyImageLayout(&activeCmdBuffer, newImageLayout);
-        if(copyToImage) {
-            mImage->CopyBufferToImage(&activeCmdBuffer, tbo->GetVkBuffer());
-        } else {
-            mImage->CopyImageToBuffer(&activeCmdBuffer, tbo->GetVkBuffer());
-        }
-        mImage->ModifyImageLayout(&activeCmdBuffer, oldImageLayout);
+    mImage->ModifyImageLayout(activeCmdBuffer, newImageLayout);
+    if(copyToImage) {
+        mImage->CopyBufferToImage(activeCmdBuffer, tbo->GetVkBuffer());
+    } else {
+        mImage->CopyImageToBuffer(activeCmdBuffer, tbo->GetVkBuffer());
+        tbo->HostReadBarrier(activeCmdBuffer);
     }
-    commandBufferManager->EndVkAuxCommandBuffer();
-    commandBufferManager->SubmitVkAuxCommandBuffer();
-    commandBufferManager->WaitVkAuxCommandBuffer();
+    mImage->ModifyImageLayout(activeCmdBuffer, oldImageLayout);
 }
 
 void
@@ -462,6 +629,10 @@ Texture::PrepareVkImageLayout(VkImageLayout newImageLayout)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
+    if(mImage->GetImageLayout() == newImageLayout) {
+        return;
+    }
+
     assert(GetCurrentContext());
     vulkanAPI::CommandBufferManager *commandBufferManager = GetCurrentContext()->GetVkCommandBufferManager();
     commandBufferManager->BeginVkAuxCommandBuffer();
@@ -499,7 +670,7 @@ Texture::InvertPixels()
 }
 
 void
-Texture::GenerateMipmaps(GLenum hintMipmapMode)
+Texture::GenerateMipmaps(GLenum hintMipmapMode, CacheManager *cacheManager)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
@@ -514,16 +685,17 @@ Texture::GenerateMipmaps(GLenum hintMipmapMode)
     std::vector<uint8_t*> basePixels(mLayersCount);
     for(GLint layer = 0; layer < mLayersCount; ++layer) {
         basePixels[layer] = new uint8_t[baseSize];
+        // the pixels go straight back to the image, so keep their orientation
+        SetDataNoInvertion(true);
         CopyPixelsToHost(&srcRect, &dstRect, baseLevel, layer, GetExplicitInternalFormat(), basePixels[layer]);
     }
 
     // create Mipmapped Texture
     mMipLevelsCount = NUMBER_OF_MIP_LEVELS(GetWidth(), GetHeight());
-    CreateVkTexture();
+    CreateVkTexture(cacheManager);
 
     // set back base mipLevel for all layers
     for(GLint layer = 0; layer < mLayersCount; ++layer) {
-        InvertImageYAxis(static_cast<uint8_t *>(basePixels[layer]), &srcRect);
         CopyPixelsFromHost(&srcRect, &dstRect, baseLevel, layer, GetExplicitInternalFormat(), basePixels[layer]);
         delete[] basePixels[layer];
     }
@@ -32,6 +32,8 @@
 #include "vulkan/imageView.h"
 #include "utils/GlToVkConverter.h"
 
+class CacheManager;
+
 #define ISPOWEROFTWO(x)           ((x != 0) && !(x & (x - 1)))
 
 class Texture : public refObject {
@@ -83,7 +85,7 @@ private:
     static int                  mDefaultInternalAlignment;
 
     bool                        AllocateVkMemory(void);
-    void                        ReleaseVkResources(void);
+    void                        ReleaseVkResources(CacheManager *cacheManager = nullptr);
 
 public:
     Texture(const vulkanAPI::vkContext_t  *vkContext = nullptr,
@@ -91,10 +93,14 @@ public:
     ~Texture();
 
 // Generate Functions
-    bool                    Allocate();
+    bool                    Allocate(CacheManager *cacheManager = nullptr);
     void                    SetState(GLsizei width, GLsizei height, GLint level, GLint layer, GLenum format, GLenum type, GLint unpackAlignment, const void *pixels);
     void                    SetSubState(ImageRect *srcRect, ImageRect *dstRect, GLint miplevel, GLint layer, GLenum srcFormat, const void *srcData);
-    void                    GenerateMipmaps(GLenum hintMipmapMode);
+    void                    GenerateMipmaps(GLenum hintMipmapMode, CacheManager *cacheManager = nullptr);
+    void                    SelectVkFormat(GLenum format, GLenum type, bool colorAttachment);
+    bool                    EnableColorAttachment(CacheManager *cacheManager = nullptr);
+    bool                    BindSurfaceImage(VkImage image, VkFormat vkformat, GLenum format, GLsizei width, GLsizei height);
+    void                    ReleaseSurfaceImage(void);
 
 // Init Functions
     inline void             InitState(void)                                     { FUN_ENTRY(GL_LOG_TRACE); mLayersCount  = mTarget == GL_TEXTURE_2D ? TEXTURE_2D_LAYERS : TEXTURE_CUBE_MAP_LAYERS;
@@ -106,16 +112,18 @@ public:
     void                    PrepareVkImageLayout(VkImageLayout newImageLayout);
 
 // Create Functions
-    bool                    CreateVkTexture(void);
+    bool                    CreateVkTexture(CacheManager *cacheManager = nullptr, bool prepareLayout = true);
     bool                    CreateVkImage(void);
     bool                    CreateVkImageView(void)                             { FUN_ENTRY(GL_LOG_TRACE); return mImageView->Create(mImage); }
     bool                    CreateVkSampler(void)                               { FUN_ENTRY(GL_LOG_TRACE); return mSampler->Create(); }
     void                    CreateVkImageSubResourceRange(void)                 { FUN_ENTRY(GL_LOG_TRACE); return mImage->CreateImageSubresourceRange(); }
 
 // Copy Functions
-     void                   CopyPixelsFromHost (ImageRect *srcRect, ImageRect *dstRect, GLint miplevel, GLint layer, GLenum srcFormat, const void *srcData);
+     void                   CopyPixelsFromHost (ImageRect *srcRect, ImageRect *dstRect, GLint miplevel, GLint layer, GLenum srcFormat, const void *srcData, bool unusedImage = false);
      void                   CopyPixelsToHost   (ImageRect *srcRect, ImageRect *dstRect, GLint miplevel, GLint layer, GLenum dstFormat, void *dstData);
      void                   SubmitCopyPixels   (const Rect *rect, BufferObject *tbo, GLint miplevel, GLint layer, GLenum dstFormat, bool copyToImage);
+     void                   RecordCopyPixels   (VkCommandBuffer *activeCmdBuffer, const Rect *rect, BufferObject *tbo, GLint miplevel, GLint layer, bool copyToImage);
+     bool                   SubmitUploadPixels (const Rect *rect, BufferObject *tbo, GLint miplevel, GLint layer);
      void                   InvertPixels       (void);
 
 // Get Functions
@@ -143,6 +151,7 @@ public:
     inline VkSampler        GetVkSampler(void)                          const   { FUN_ENTRY(GL_LOG_TRACE); return mSampler->GetSampler(); }
     inline VkFormat         GetVkFormat(void)                           const   { FUN_ENTRY(GL_LOG_TRACE); return mImage->GetFormat(); }
     inline VkImageLayout    GetVkImageLayout(void)                      const   { FUN_ENTRY(GL_LOG_TRACE); return mImage->GetImageLayout(); }
+    inline VkImageUsageFlagBits GetVkImageUsage(void)                   const   { FUN_ENTRY(GL_LOG_TRACE); return mImage->GetImageUsage(); }
     inline VkImageView      GetVkImageView(void)                        const   { FUN_ENTRY(GL_LOG_TRACE); return mImageView->GetImageView(); }
     VkFormat                FindSupportedVkColorFormat(VkFormat format)         { FUN_ENTRY(GL_LOG_TRACE); return mImage->FindSupportedVkColorFormat(format); }
 
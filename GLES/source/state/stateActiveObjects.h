@@ -28,7 +28,9 @@
 #include "resources/bufferObject.h"
 #include "resources/texture.h"
 
-#define GL_BUFFER_TARGET_TO_TYPE(__target__)  ((__target__) == GL_ARRAY_BUFFER ? BUFFER_OBJECT_TARGET_ARRAY : BUFFER_OBJECT_TARGET_ELEMENT)
+#define GL_BUFFER_TARGET_TO_TYPE(__target__)  ((__target__) == GL_ARRAY_BUFFER         ? BUFFER_OBJECT_TARGET_ARRAY      : \
+                                               (__target__) == GL_PIXEL_PACK_BUFFER_NV ? BUFFER_OBJECT_TARGET_PIXEL_PACK : \
+                                                                                         BUFFER_OBJECT_TARGET_ELEMENT)
 #define GL_TEXTURE_TARGET_TO_TYPE(__target__) ((__target__) == GL_TEXTURE_2D ? 0 : 1)
 #define GL_TEXTURE_ENUM_TO_UNIT(__enum__)     ((__enum__) - GL_TEXTURE0)
 
@@ -37,6 +39,7 @@ private:
       typedef enum {
         BUFFER_OBJECT_TARGET_ARRAY = 0,
         BUFFER_OBJECT_TARGET_ELEMENT,
+        BUFFER_OBJECT_TARGET_PIXEL_PACK,
         BUFFER_OBJECT_TARGET_ALL
       } BufferObjectTarget_t;
 
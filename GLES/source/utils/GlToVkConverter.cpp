@@ -345,8 +345,8 @@ VkFormat GlColorFormatToVkColorFormat(GLenum format, GLenum type)
             switch(format) {
                 case GL_RGB:                        return VK_FORMAT_R8G8B8_UNORM;
                 case GL_LUMINANCE:
-                case GL_ALPHA:
-                case GL_LUMINANCE_ALPHA:
+                case GL_ALPHA:                      return VK_FORMAT_R8_UNORM;
+                case GL_LUMINANCE_ALPHA:            return VK_FORMAT_R8G8_UNORM;
                 case GL_RGBA:                       return VK_FORMAT_R8G8B8A8_UNORM;
                 default: { NOT_REACHED();           return VK_FORMAT_UNDEFINED; }
             }
@@ -369,6 +369,43 @@ VkFormat GlColorFormatToVkColorFormat(GLenum format, GLenum type)
     }
 }
 
+VkComponentMapping
+GlColorFormatToVkComponentMapping(GLenum format, VkFormat vkformat)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    VkComponentMapping mapping = { VK_COMPONENT_SWIZZLE_R, VK_COMPONENT_SWIZZLE_G,
+                                   VK_COMPONENT_SWIZZLE_B, VK_COMPONENT_SWIZZLE_A };
+
+    /// luminance/alpha textures that were expanded to RGBA need no swizzle
+    if(vkformat != VK_FORMAT_R8_UNORM && vkformat != VK_FORMAT_R8G8_UNORM) {
+        return mapping;
+    }
+
+    switch(format) {
+    case GL_LUMINANCE:
+        mapping.g = VK_COMPONENT_SWIZZLE_R;
+        mapping.b = VK_COMPONENT_SWIZZLE_R;
+        mapping.a = VK_COMPONENT_SWIZZLE_ONE;
+        break;
+    case GL_ALPHA:
+        mapping.r = VK_COMPONENT_SWIZZLE_ZERO;
+        mapping.g = VK_COMPONENT_SWIZZLE_ZERO;
+        mapping.b = VK_COMPONENT_SWIZZLE_ZERO;
+        mapping.a = VK_COMPONENT_SWIZZLE_R;
+        break;
+    case GL_LUMINANCE_ALPHA:
+        mapping.g = VK_COMPONENT_SWIZZLE_R;
+        mapping.b = VK_COMPONENT_SWIZZLE_R;
+        mapping.a = VK_COMPONENT_SWIZZLE_G;
+        break;
+    default:
+        break;
+    }
+
+    return mapping;
+}
+
 VkFormat
 GlAttribPointerToVkFormat(GLint nElements, GLenum type, GLboolean normalized)
 {
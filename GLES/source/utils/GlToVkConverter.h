@@ -50,5 +50,6 @@ VkFormat                GlInternalFormatToVkFormat(GLenum internalformatDepth, G
 VkFormat                GlAttribPointerToVkFormat(GLint nElements, GLenum type, GLboolean normalized);
 VkIndexType             GlToVkIndexType(GLenum type);
 VkFormat                GlColorFormatToVkColorFormat(GLenum format, GLenum type);
+VkComponentMapping      GlColorFormatToVkComponentMapping(GLenum format, VkFormat vkformat);
 
 #endif // __GLTOVKCONVERTER_H__
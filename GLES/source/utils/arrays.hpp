@@ -26,6 +26,7 @@
 #define __ARRAYS_HPP__
 
 #include <map>
+#include <mutex>
 
 /**
  * @brief A templated class for handling the memory allocation, indexing and
@@ -46,6 +47,9 @@ private:
     std::map<uint32_t, ELEMENT *> mObjects; /**< The templated map container (one
                                           for each different class that maps
                                           id to a specific object). */
+    mutable std::mutex mMutex;         /**< Guards the map, since the arrays
+                                          of a share group are accessed by the
+                                          contexts of several threads. */
 public:
 
     /**
@@ -76,6 +80,7 @@ public:
     */
     uint32_t Allocate()
     {
+        std::lock_guard<std::mutex> lock(mMutex);
         return ++mCounter;
     }
 
@@ -86,6 +91,7 @@ public:
     */
     bool Deallocate(uint32_t index)
     {
+        std::lock_guard<std::mutex> lock(mMutex);
         typename std::map<uint32_t, ELEMENT *>::iterator it = mObjects.find(index);
         if(it != mObjects.end()) {
             delete it->second;
@@ -103,6 +109,7 @@ public:
     */
     bool RemoveFromList(uint32_t index)
     {
+        std::lock_guard<std::mutex> lock(mMutex);
         typename std::map<uint32_t, ELEMENT *>::iterator it = mObjects.find(index);
         if(it != mObjects.end()) {
             mObjects.erase(it);
@@ -123,6 +130,7 @@ public:
      */
     ELEMENT *GetObject(uint32_t index)
     {
+        std::lock_guard<std::mutex> lock(mMutex);
         if(mCounter < index) {
             mCounter = index;
         }
@@ -142,6 +150,7 @@ public:
      */
     bool ObjectExists(uint32_t index) const
     {
+        std::lock_guard<std::mutex> lock(mMutex);
         typename std::map<uint32_t, ELEMENT *>::const_iterator it = mObjects.find(index);
         return it == mObjects.end() ? false : true;
     }
@@ -157,6 +166,7 @@ public:
      */
     uint32_t GetObjectId(const ELEMENT * element) const
     {
+        std::lock_guard<std::mutex> lock(mMutex);
         typename std::map<uint32_t, ELEMENT *>::const_iterator it;
         for(it = mObjects.begin(); it != mObjects.end(); it++) {
             if(it->second == element) {
@@ -170,11 +180,22 @@ public:
     /**
      * @brief Returns the map container for a specific class.
      * @return The map container.
+     *
+     * The map of a shared array must be traversed while holding its mutex.
      */
     std::map<uint32_t, ELEMENT *> *GetObjects(void)
     {
         return &mObjects;
     }
+
+    /**
+     * @brief Returns the mutex that guards the map container.
+     * @return The mutex.
+     */
+    std::mutex &GetMutex(void) const
+    {
+        return mMutex;
+    }
 };
 
 #endif // __ARRAYS_HPP__
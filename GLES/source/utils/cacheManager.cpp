@@ -19,76 +19,127 @@
  *
  *  @brief      Vulkan objects cache manager. These caches are needed to keep in memory Vulkan objects referred to by secondary command buffers.
  *
+ *  @section
+ *
+ *  Objects that are replaced while a command buffer is recorded are kept in a
+ *  pending cache. When the command buffer is submitted, the pending cache is
+ *  retired with the serial of that submission and it is only cleaned up once
+ *  the submission is known to be complete, so frames in flight keep their
+ *  objects alive without waiting for the GPU.
+ *
+ *  The cache of a share group is not tied to a single submission; its pending
+ *  cache is detached and released by the group once every one of its contexts
+ *  has completed the submissions that may still use the objects.
+ *
  */
 
 #include "cacheManager.h"
 
 void
-CacheManager::CleanUpUBOCache(void)
+CacheManager::CleanUpUBOCache(cache_t *cache)
 {
     FUN_ENTRY(GL_LOG_TRACE);
 
-    if(!mUBOCache.empty()) {
-        for(uint32_t i = 0; i < mUBOCache.size(); ++i) {
-            if(mUBOCache[i] != nullptr) {
-                delete mUBOCache[i];
-                mUBOCache[i] = nullptr;
+    if(!cache->uboCache.empty()) {
+        for(uint32_t i = 0; i < cache->uboCache.size(); ++i) {
+            if(cache->uboCache[i] != nullptr) {
+                delete cache->uboCache[i];
+                cache->uboCache[i] = nullptr;
             }
         }
 
-        mUBOCache.clear();
+        cache->uboCache.clear();
     }
 }
 
 void
-CacheManager::CleanUpVBOCache()
+CacheManager::CleanUpVBOCache(cache_t *cache)
 {
     FUN_ENTRY(GL_LOG_TRACE);
 
-    if(!mVBOCache.empty()) {
-        for(uint32_t i = 0; i < mVBOCache.size(); ++i) {
-            if(mVBOCache[i] != nullptr) {
-                delete mVBOCache[i];
-                mVBOCache[i] = nullptr;
+    if(!cache->vboCache.empty()) {
+        for(uint32_t i = 0; i < cache->vboCache.size(); ++i) {
+            if(cache->vboCache[i] != nullptr) {
+                delete cache->vboCache[i];
+                cache->vboCache[i] = nullptr;
             }
         }
 
-        mVBOCache.clear();
+        cache->vboCache.clear();
     }
 }
 
 void
-CacheManager::CleanUpTextureCache()
+CacheManager::CleanUpTextureCache(cache_t *cache)
 {
     FUN_ENTRY(GL_LOG_TRACE);
 
-    if(!mTextureCache.empty()) {
-        for(uint32_t i = 0; i < mTextureCache.size(); ++i) {
-            if(mTextureCache[i] != nullptr) {
-                delete mTextureCache[i];
-                mTextureCache[i] = nullptr;
+    if(!cache->textureCache.empty()) {
+        for(uint32_t i = 0; i < cache->textureCache.size(); ++i) {
+            if(cache->textureCache[i] != nullptr) {
+                delete cache->textureCache[i];
+                cache->textureCache[i] = nullptr;
             }
         }
 
-        mTextureCache.clear();
+        cache->textureCache.clear();
     }
 }
 
 void
-CacheManager::CleanUpVkPipelineObjectCache()
+CacheManager::CleanUpVkPipelineObjectCache(cache_t *cache)
 {
     FUN_ENTRY(GL_LOG_TRACE);
 
-    if(!mVkPipelineObjectCache.empty()) {
-        for(uint32_t i = 0; i < mVkPipelineObjectCache.size(); ++i) {
-            if(mVkPipelineObjectCache[i] != VK_NULL_HANDLE){
-                vkDestroyPipeline(mVkContext->vkDevice, mVkPipelineObjectCache[i], nullptr);
-                mVkPipelineObjectCache[i] = VK_NULL_HANDLE;
+    if(!cache->vkPipelineObjectCache.empty()) {
+        for(uint32_t i = 0; i < cache->vkPipelineObjectCache.size(); ++i) {
+            if(cache->vkPipelineObjectCache[i] != VK_NULL_HANDLE){
+                vkDestroyPipeline(mVkContext->vkDevice, cache->vkPipelineObjectCache[i], nullptr);
+                cache->vkPipelineObjectCache[i] = VK_NULL_HANDLE;
             }
         }
 
-        mVkPipelineObjectCache.clear();
+        cache->vkPipelineObjectCache.clear();
+    }
+}
+
+void
+CacheManager::CleanUpVkImageObjectCache(cache_t *cache)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    /// views are destroyed before their images and images before their memory
+    for(auto imageView : cache->vkImageViewCache) {
+        vkDestroyImageView(mVkContext->vkDevice, imageView, nullptr);
     }
+    cache->vkImageViewCache.clear();
+
+    for(auto sampler : cache->vkSamplerCache) {
+        vkDestroySampler(mVkContext->vkDevice, sampler, nullptr);
+    }
+    cache->vkSamplerCache.clear();
+
+    for(auto image : cache->vkImageCache) {
+        vkDestroyImage(mVkContext->vkDevice, image, nullptr);
+    }
+    cache->vkImageCache.clear();
+
+    for(auto memory : cache->vkDeviceMemoryCache) {
+        vkFreeMemory(mVkContext->vkDevice, memory, nullptr);
+    }
+    cache->vkDeviceMemoryCache.clear();
+}
+
+void
+CacheManager::CleanUpCache(cache_t *cache)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    CleanUpUBOCache(cache);
+    CleanUpVBOCache(cache);
+    CleanUpTextureCache(cache);
+    CleanUpVkPipelineObjectCache(cache);
+    CleanUpVkImageObjectCache(cache);
 }
 
 void
@@ -96,7 +147,8 @@ CacheManager::CacheUBO(UniformBufferObject *uniformBufferObject)
 {
     FUN_ENTRY(GL_LOG_TRACE);
 
-    mUBOCache.push_back(uniformBufferObject);
+    std::lock_guard<std::mutex> lock(mMutex);
+    mPendingCache.uboCache.push_back(uniformBufferObject);
 }
 
 void
@@ -104,7 +156,8 @@ CacheManager::CacheVBO(BufferObject *vbo)
 {
     FUN_ENTRY(GL_LOG_TRACE);
 
-    mVBOCache.push_back(vbo);
+    std::lock_guard<std::mutex> lock(mMutex);
+    mPendingCache.vboCache.push_back(vbo);
 }
 
 void
@@ -112,7 +165,8 @@ CacheManager::CacheTexture(Texture *tex)
 {
     FUN_ENTRY(GL_LOG_TRACE);
 
-    mTextureCache.push_back(tex);
+    std::lock_guard<std::mutex> lock(mMutex);
+    mPendingCache.textureCache.push_back(tex);
 }
 
 void
@@ -120,7 +174,90 @@ CacheManager::CacheVkPipelineObject(VkPipeline pipeline)
 {
     FUN_ENTRY(GL_LOG_TRACE);
 
-    mVkPipelineObjectCache.push_back(pipeline);
+    std::lock_guard<std::mutex> lock(mMutex);
+    mPendingCache.vkPipelineObjectCache.push_back(pipeline);
+}
+
+void
+CacheManager::CacheVkImageView(VkImageView imageView)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    mPendingCache.vkImageViewCache.push_back(imageView);
+}
+
+void
+CacheManager::CacheVkSampler(VkSampler sampler)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    mPendingCache.vkSamplerCache.push_back(sampler);
+}
+
+void
+CacheManager::CacheVkImage(VkImage image)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    mPendingCache.vkImageCache.push_back(image);
+}
+
+void
+CacheManager::CacheVkDeviceMemory(VkDeviceMemory memory)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    mPendingCache.vkDeviceMemoryCache.push_back(memory);
+}
+
+CacheManager *
+CacheManager::DetachPendingCache(void)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    if(mPendingCache.empty()) {
+        return nullptr;
+    }
+
+    CacheManager *cacheManager = new CacheManager(mVkContext);
+    std::swap(cacheManager->mPendingCache, mPendingCache);
+
+    return cacheManager;
+}
+
+void
+CacheManager::RetireCaches(uint64_t serial)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    if(mPendingCache.empty()) {
+        return;
+    }
+
+    mPendingCache.serial = serial;
+    mRetiredCaches.push_back(cache_t());
+    std::swap(mRetiredCaches.back(), mPendingCache);
+}
+
+void
+CacheManager::CleanUpCaches(uint64_t completedSerial)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    while(!mRetiredCaches.empty() && mRetiredCaches.front().serial <= completedSerial) {
+        CleanUpCache(&mRetiredCaches.front());
+        mRetiredCaches.pop_front();
+    }
 }
 
 void
@@ -128,8 +265,12 @@ CacheManager::CleanUpCaches()
 {
     FUN_ENTRY(GL_LOG_TRACE);
 
-    CleanUpUBOCache();
-    CleanUpVBOCache();
-    CleanUpTextureCache();
-    CleanUpVkPipelineObjectCache();
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    for(auto &cache : mRetiredCaches) {
+        CleanUpCache(&cache);
+    }
+    mRetiredCaches.clear();
+
+    CleanUpCache(&mPendingCache);
 }
@@ -24,6 +24,8 @@
 #define __CACHEMANAGER_H__
 
 #include <vector>
+#include <deque>
+#include <mutex>
 #include "vulkan/vulkan.h"
 #include "utils/glLogger.h"
 #include "resources/bufferObject.h"
@@ -31,27 +33,55 @@
 
 class CacheManager {
 private:
+    typedef struct cache {
+        std::vector<UniformBufferObject *>  uboCache;
+        std::vector<BufferObject *>         vboCache;
+        std::vector<Texture *>              textureCache;
+        std::vector<VkPipeline>             vkPipelineObjectCache;
+        std::vector<VkImageView>            vkImageViewCache;
+        std::vector<VkSampler>              vkSamplerCache;
+        std::vector<VkImage>                vkImageCache;
+        std::vector<VkDeviceMemory>         vkDeviceMemoryCache;
+        uint64_t                            serial;
+
+        cache() : serial(0) { }
+        bool empty(void) const { return uboCache.empty() && vboCache.empty() && textureCache.empty() && vkPipelineObjectCache.empty() &&
+                                        vkImageViewCache.empty() && vkSamplerCache.empty() && vkImageCache.empty() && vkDeviceMemoryCache.empty(); }
+    } cache_t;
+
     const
     vulkanAPI::vkContext_t *            mVkContext;
 
-    std::vector<UniformBufferObject *>  mUBOCache;
-    std::vector<BufferObject *>         mVBOCache;
-    std::vector<Texture *>              mTextureCache;
-    std::vector<VkPipeline>             mVkPipelineObjectCache;
+    /// the cache of a share group is filled by the contexts of different threads
+    std::mutex                          mMutex;
+
+    /// objects replaced since the last submission
+    cache_t                             mPendingCache;
+    /// objects still used by submissions, tagged with the serial of the last one of them
+    std::deque<cache_t>                 mRetiredCaches;
 
-    void                                CleanUpUBOCache();
-    void                                CleanUpVBOCache();
-    void                                CleanUpTextureCache();
-    void                                CleanUpVkPipelineObjectCache();
+    void                                CleanUpUBOCache(cache_t *cache);
+    void                                CleanUpVBOCache(cache_t *cache);
+    void                                CleanUpTextureCache(cache_t *cache);
+    void                                CleanUpVkPipelineObjectCache(cache_t *cache);
+    void                                CleanUpVkImageObjectCache(cache_t *cache);
+    void                                CleanUpCache(cache_t *cache);
 
 public:
      CacheManager(const vulkanAPI::vkContext_t *vkContext) : mVkContext(vkContext) { }
-    ~CacheManager() { }
+    ~CacheManager() { CleanUpCaches(); }
 
     void                                CacheUBO(UniformBufferObject *uniformBufferObject);
     void                                CacheVBO(BufferObject *vbo);
     void                                CacheTexture(Texture *tex);
     void                                CacheVkPipelineObject(VkPipeline pipeline);
+    void                                CacheVkImageView(VkImageView imageView);
+    void                                CacheVkSampler(VkSampler sampler);
+    void                                CacheVkImage(VkImage image);
+    void                                CacheVkDeviceMemory(VkDeviceMemory memory);
+    CacheManager                       *DetachPendingCache(void);
+    void                                RetireCaches(uint64_t serial);
+    void                                CleanUpCaches(uint64_t completedSerial);
     void                                CleanUpCaches();
 };
 
@@ -0,0 +1,183 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+/**
+ *  @file       workerPool.cpp
+ *  @author     Think Silicon
+ *  @date       18/10/2026
+ *  @version    1.0
+ *
+ *  @brief      Optional pool of worker threads that splits large host-side
+ *              conversions (pixel transfers, vertex data) into bands.
+ *
+ *  @section
+ *
+ *  The pool is disabled unless GLOVE_WORKER_THREADS names the number of
+ *  worker threads to start. A job is split into one band per worker plus
+ *  one for the calling thread, which works on its share and then waits for
+ *  the rest. Jobs that touch fewer bytes than GLOVE_WORKER_MIN_BYTES run
+ *  inline on the calling thread, so small transfers do not pay for the
+ *  hand-off.
+ *
+ */
+
+#include "workerPool.h"
+#include <algorithm>
+#include <cstdlib>
+
+#define GLOVE_WORKER_THREADS_ENV                        "GLOVE_WORKER_THREADS"
+#define GLOVE_WORKER_MIN_BYTES_ENV                      "GLOVE_WORKER_MIN_BYTES"
+#define GLOVE_WORKER_MAX_THREADS                        16
+#define GLOVE_WORKER_DEFAULT_MIN_BYTES                  (1 << 20)
+
+WorkerPool::WorkerPool()
+: mMinBytes(GLOVE_WORKER_DEFAULT_MIN_BYTES), mGeneration(0), mActiveWorkers(0), mStop(false)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    mJob.function     = nullptr;
+    mJob.data         = nullptr;
+    mJob.count        = 0;
+    mJob.numBands     = 0;
+    mJob.nextBand     = 0;
+    mJob.pendingBands = 0;
+
+    const char *minBytes = getenv(GLOVE_WORKER_MIN_BYTES_ENV);
+    if(minBytes) {
+        mMinBytes = static_cast<size_t>(strtoul(minBytes, nullptr, 10));
+    }
+
+    const char *numThreads = getenv(GLOVE_WORKER_THREADS_ENV);
+    if(numThreads) {
+        long numWorkers = strtol(numThreads, nullptr, 10);
+        numWorkers = numWorkers < 0 ? 0 : numWorkers > GLOVE_WORKER_MAX_THREADS ? GLOVE_WORKER_MAX_THREADS : numWorkers;
+
+        for(long i = 0; i < numWorkers; ++i) {
+            mWorkers.push_back(std::thread(&WorkerPool::WorkerLoop, this));
+        }
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStop = true;
+    }
+    mWorkCondition.notify_all();
+
+    for(auto &worker : mWorkers) {
+        worker.join();
+    }
+}
+
+WorkerPool *
+WorkerPool::GetInstance(void)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    static WorkerPool workerPool;
+
+    return &workerPool;
+}
+
+void
+WorkerPool::Run(size_t count, size_t bytes, bandFunction_t function, void *data)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    if(mWorkers.empty() || bytes < mMinBytes || count < 2) {
+        function(0, count, data);
+        return;
+    }
+
+    /// contexts on different threads take turns on the pool
+    std::lock_guard<std::mutex> submitLock(mSubmitMutex);
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mJob.function     = function;
+        mJob.data         = data;
+        mJob.count        = count;
+        mJob.numBands     = std::min(count, mWorkers.size() + 1);
+        mJob.nextBand     = 0;
+        mJob.pendingBands = mJob.numBands;
+        ++mGeneration;
+    }
+    mWorkCondition.notify_all();
+
+    RunBands();
+
+    /// wait until every band is done and no worker still looks at the job
+    std::unique_lock<std::mutex> lock(mMutex);
+    mDoneCondition.wait(lock, [this] { return mJob.pendingBands == 0 && mActiveWorkers == 0; });
+    mJob.function = nullptr;
+    mJob.data     = nullptr;
+}
+
+void
+WorkerPool::RunBands(void)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    while(true) {
+        const size_t band = mJob.nextBand.fetch_add(1);
+        if(band >= mJob.numBands) {
+            return;
+        }
+
+        const size_t begin = mJob.count *  band      / mJob.numBands;
+        const size_t end   = mJob.count * (band + 1) / mJob.numBands;
+        mJob.function(begin, end, mJob.data);
+
+        if(mJob.pendingBands.fetch_sub(1) == 1) {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mDoneCondition.notify_all();
+        }
+    }
+}
+
+void
+WorkerPool::WorkerLoop(void)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    uint64_t generation = 0;
+
+    while(true) {
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mWorkCondition.wait(lock, [this, generation] { return mStop || mGeneration != generation; });
+            if(mStop) {
+                return;
+            }
+            generation = mGeneration;
+
+            /// the job is already done, there is nothing left to claim
+            if(mJob.function == nullptr) {
+                continue;
+            }
+            ++mActiveWorkers;
+        }
+
+        RunBands();
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            --mActiveWorkers;
+        }
+        mDoneCondition.notify_all();
+    }
+}
@@ -0,0 +1,78 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+/**
+ *  @file       workerPool.h
+ *  @author     Think Silicon
+ *  @date       18/10/2026
+ *  @version    1.0
+ *
+ *  @brief      Optional pool of worker threads that splits large host-side
+ *              conversions (pixel transfers, vertex data) into bands.
+ *
+ */
+
+#ifndef __WORKERPOOL_H__
+#define __WORKERPOOL_H__
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "utils/glLogger.h"
+
+class WorkerPool {
+public:
+    /// processes the items [begin, end) of a job
+    typedef void (*bandFunction_t)(size_t begin, size_t end, void *data);
+
+private:
+    typedef struct job {
+        bandFunction_t              function;
+        void                       *data;
+        size_t                      count;
+        size_t                      numBands;
+        std::atomic<size_t>         nextBand;
+        std::atomic<size_t>         pendingBands;
+    } job_t;
+
+    std::vector<std::thread>        mWorkers;
+    size_t                          mMinBytes;
+
+    std::mutex                      mSubmitMutex;
+    std::mutex                      mMutex;
+    std::condition_variable         mWorkCondition;
+    std::condition_variable         mDoneCondition;
+    uint64_t                        mGeneration;
+    uint32_t                        mActiveWorkers;
+    bool                            mStop;
+    job_t                           mJob;
+
+    void                            WorkerLoop(void);
+    void                            RunBands(void);
+
+                                    WorkerPool();
+public:
+                                   ~WorkerPool();
+
+    static WorkerPool *             GetInstance(void);
+
+// Run Functions
+    void                            Run(size_t count, size_t bytes, bandFunction_t function, void *data);
+
+// Get Functions
+    inline size_t                   GetNumWorkers(void)                 const   { FUN_ENTRY(GL_LOG_TRACE); return mWorkers.size(); }
+};
+
+#endif // __WORKERPOOL_H__
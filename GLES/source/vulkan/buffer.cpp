@@ -91,4 +91,24 @@ Buffer::CreateVkDescriptorBufferInfo(void)
     mVkDescriptorBufferInfo.offset = mVkOffset;
 }
 
+void
+Buffer::HostReadBarrier(VkCommandBuffer *activeCmdBuffer) const
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    VkBufferMemoryBarrier bufferMemoryBarrier;
+    bufferMemoryBarrier.sType               = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    bufferMemoryBarrier.pNext               = nullptr;
+    bufferMemoryBarrier.srcAccessMask       = VK_ACCESS_TRANSFER_WRITE_BIT;
+    bufferMemoryBarrier.dstAccessMask       = VK_ACCESS_HOST_READ_BIT;
+    bufferMemoryBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    bufferMemoryBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    bufferMemoryBarrier.buffer              = mVkBuffer;
+    bufferMemoryBarrier.offset              = 0;
+    bufferMemoryBarrier.size                = VK_WHOLE_SIZE;
+
+    vkCmdPipelineBarrier(*activeCmdBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0,
+                         0, nullptr, 1, &bufferMemoryBarrier, 0, nullptr);
+}
+
 }
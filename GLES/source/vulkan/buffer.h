@@ -55,6 +55,9 @@ public:
 // Release Functions
     void                              Release(void);
 
+// Barrier Functions
+    void                              HostReadBarrier(VkCommandBuffer *activeCmdBuffer) const;
+
 // Get Functions
     inline VkBuffer &                 GetVkBuffer(void)                         { FUN_ENTRY(GL_LOG_TRACE); return mVkBuffer;                }
     inline VkDescriptorBufferInfo*    GetVkDescriptorBufferInfo(void)           { FUN_ENTRY(GL_LOG_TRACE); return &mVkDescriptorBufferInfo; }
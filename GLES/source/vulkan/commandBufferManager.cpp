@@ -36,8 +36,9 @@
 namespace vulkanAPI {
 
 #define GLOVE_NO_BUFFER_TO_WAIT                         0x7FFFFFFF
-#define GLOVE_NUM_COMMAND_BUFFERS                       2
+#define GLOVE_NUM_COMMAND_BUFFERS                       (GLOVE_MAX_FRAMES_IN_FLIGHT + 1)
 #define GLOVE_FENCE_WAIT_TIMEOUT                        UINT64_MAX
+#define GLOVE_MAX_PENDING_UPLOADS                       16
 
 CommandBufferManager::CommandBufferManager(const vkContext_t *context)
 : mVkContext(context)
@@ -46,10 +47,17 @@ CommandBufferManager::CommandBufferManager(const vkContext_t *context)
 
     mActiveCmdBuffer    = 0;
     mLastSubmittedBuffer= GLOVE_NO_BUFFER_TO_WAIT;
+    mChainedBuffer      = GLOVE_NO_BUFFER_TO_WAIT;
+    mSurfaceSyncItems   = nullptr;
+    mLastSubmitSerial   = 0;
+    mCompletedSerial    = 0;
+    mRecordingSerial    = 0;
 
     mVkCmdPool          = VK_NULL_HANDLE;
     mVkAuxCommandBuffer = VK_NULL_HANDLE;
-    mVkAuxFence         = VK_NULL_HANDLE;
+    mVkTransferCmdPool  = VK_NULL_HANDLE;
+    mActiveUpload       = -1;
+    mVkQueue            = AcquireQueue();
 
     if(!AllocateVkCmdPool()) {
         assert(false);
@@ -67,18 +75,33 @@ CommandBufferManager::~CommandBufferManager()
 {
     FUN_ENTRY(GL_LOG_TRACE);
 
-    FreeResources();
-
+    // only the submissions of this context are waited for, the others keep running on their queues
     if(mVkContext->vkDevice != VK_NULL_HANDLE ) {
+        FlushVkUploads();
+        WaitLastSubmition();
+    }
+
+    for(uint32_t i = 0; i < mVkCommandBuffers.secondaryCmdBufferPool.size(); ++i) {
+        FreeResources(i);
+    }
 
-        vkDeviceWaitIdle(mVkContext->vkDevice);
+    ReleaseQueue(mVkQueue);
+    mVkQueue = nullptr;
 
+    if(mVkContext->vkDevice != VK_NULL_HANDLE ) {
+
+        DestroyVkUploads();
         DestroyVkCmdBuffers();
 
         if(mVkCmdPool != VK_NULL_HANDLE) {
             vkDestroyCommandPool(mVkContext->vkDevice, mVkCmdPool, nullptr);
             mVkCmdPool = VK_NULL_HANDLE;
         }
+
+        if(mVkTransferCmdPool != VK_NULL_HANDLE) {
+            vkDestroyCommandPool(mVkContext->vkDevice, mVkTransferCmdPool, nullptr);
+            mVkTransferCmdPool = VK_NULL_HANDLE;
+        }
     }
 }
 
@@ -91,26 +114,42 @@ CommandBufferManager::DestroyVkCmdBuffers(void)
         mVkCommandBuffers.fence[i].Release();
     }
 
+    for(auto semaphore : mVkCommandBuffers.semaphore) {
+        if(semaphore != VK_NULL_HANDLE) {
+            vkDestroySemaphore(mVkContext->vkDevice, semaphore, nullptr);
+        }
+    }
+
+    for(auto &secondaryCmdBufferPool : mVkCommandBuffers.secondaryCmdBufferPool) {
+        uint32_t secondaryBuffersPoolSize = secondaryCmdBufferPool.GetSize();
+
+        for(uint32_t i = 0; i < secondaryBuffersPoolSize; ++i) {
+            VkCommandBuffer *removingSecondaryBuffer = secondaryCmdBufferPool.RemoveBuffer();
+            if(removingSecondaryBuffer) {
+                vkFreeCommandBuffers(mVkContext->vkDevice, mVkCmdPool, 1, removingSecondaryBuffer);
+                delete removingSecondaryBuffer;
+            }
+        }
+    }
+
     vkFreeCommandBuffers(mVkContext->vkDevice, mVkCmdPool, mVkCommandBuffers.commandBuffer.size(), mVkCommandBuffers.commandBuffer.data());
     mVkCommandBuffers.commandBuffer.clear();
     mVkCommandBuffers.commandBufferState.clear();
     mVkCommandBuffers.fence.clear();
-    memset(static_cast<void *>(&mVkCommandBuffers), 0, mVkCommandBuffers.commandBuffer.size()*sizeof(State));
+    mVkCommandBuffers.submitSerial.clear();
+    mVkCommandBuffers.semaphore.clear();
+    mVkCommandBuffers.secondaryCmdBufferPool.clear();
 
     if(mVkAuxCommandBuffer != VK_NULL_HANDLE) {
         vkFreeCommandBuffers(mVkContext->vkDevice, mVkCmdPool, 1, &mVkAuxCommandBuffer);
         mVkAuxCommandBuffer = VK_NULL_HANDLE;
     }
+    mVkAuxFence.Release();
 
-    uint32_t secondaryBuffersPoolSize = mSecondaryCmdBufferPool.GetSize();
-
-    for(uint32_t i = 0; i < secondaryBuffersPoolSize; ++i) {
-        VkCommandBuffer *removingSecondaryBuffer = mSecondaryCmdBufferPool.RemoveBuffer();
-        if(removingSecondaryBuffer) {
-            vkFreeCommandBuffers(mVkContext->vkDevice, mVkCmdPool, 1, removingSecondaryBuffer);
-            delete removingSecondaryBuffer;
-        }
-    }
+    mActiveCmdBuffer     = 0;
+    mLastSubmittedBuffer = GLOVE_NO_BUFFER_TO_WAIT;
+    mChainedBuffer       = GLOVE_NO_BUFFER_TO_WAIT;
+    mCompletedSerial     = mLastSubmitSerial.load();
 }
 
 void
@@ -124,7 +163,10 @@ CommandBufferManager::AllocateVkSecondaryCmdBuffers(uint32_t numOfBuffers)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    VkCommandBuffer *reusedCommandBuffer = mSecondaryCmdBufferPool.BindNextAvailableBuffer();
+    /// secondary buffers are recycled together with the primary buffer that executes them
+    CommandBufferPool *secondaryCmdBufferPool = &mVkCommandBuffers.secondaryCmdBufferPool[mActiveCmdBuffer];
+
+    VkCommandBuffer *reusedCommandBuffer = secondaryCmdBufferPool->BindNextAvailableBuffer();
 
     if(nullptr != reusedCommandBuffer) {
         return reusedCommandBuffer;
@@ -147,15 +189,15 @@ CommandBufferManager::AllocateVkSecondaryCmdBuffers(uint32_t numOfBuffers)
         return nullptr;
     }
 
-    mSecondaryCmdBufferPool.AddBuffer(commandBuffers);
+    secondaryCmdBufferPool->AddBuffer(commandBuffers);
 
     return commandBuffers;
 }
 
 void
-CommandBufferManager::FreeResources(void)
+CommandBufferManager::FreeResources(uint32_t index)
 {
-    mSecondaryCmdBufferPool.UnbindAllBuffers();
+    mVkCommandBuffers.secondaryCmdBufferPool[index].UnbindAllBuffers();
 }
 
 bool
@@ -177,9 +219,90 @@ CommandBufferManager::AllocateVkCmdPool(void)
         return false;
     }
 
+    if(mVkContext->vkTransferQueue.vkQueue != VK_NULL_HANDLE) {
+        cmdPoolInfo.queueFamilyIndex = mVkContext->vkTransferQueueNodeIndex;
+
+        err = vkCreateCommandPool(mVkContext->vkDevice, &cmdPoolInfo, nullptr, &mVkTransferCmdPool);
+        assert(!err);
+
+        if(err != VK_SUCCESS) {
+            return false;
+        }
+    }
+
     return true;
 }
 
+bool
+CommandBufferManager::AllocateVkUpload(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    upload_t upload;
+    upload.transferCmdBuffer = VK_NULL_HANDLE;
+    upload.acquireCmdBuffer  = VK_NULL_HANDLE;
+    upload.semaphore         = VK_NULL_HANDLE;
+    upload.state             = UPLOAD_FREE_STATE;
+    upload.acquireSerial     = 0;
+
+    VkCommandBufferAllocateInfo cmdAllocInfo;
+    cmdAllocInfo.sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    cmdAllocInfo.pNext              = nullptr;
+    cmdAllocInfo.commandPool        = mVkTransferCmdPool;
+    cmdAllocInfo.level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    cmdAllocInfo.commandBufferCount = 1;
+
+    VkResult err = vkAllocateCommandBuffers(mVkContext->vkDevice, &cmdAllocInfo, &upload.transferCmdBuffer);
+    assert(!err);
+
+    if(err != VK_SUCCESS) {
+        return false;
+    }
+
+    cmdAllocInfo.commandPool = mVkCmdPool;
+    err = vkAllocateCommandBuffers(mVkContext->vkDevice, &cmdAllocInfo, &upload.acquireCmdBuffer);
+    assert(!err);
+
+    if(err != VK_SUCCESS) {
+        vkFreeCommandBuffers(mVkContext->vkDevice, mVkTransferCmdPool, 1, &upload.transferCmdBuffer);
+        return false;
+    }
+
+    VkSemaphoreCreateInfo semaphoreCreateInfo;
+    semaphoreCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    semaphoreCreateInfo.pNext = nullptr;
+    semaphoreCreateInfo.flags = 0;
+
+    err = vkCreateSemaphore(mVkContext->vkDevice, &semaphoreCreateInfo, nullptr, &upload.semaphore);
+    assert(!err);
+
+    if(err != VK_SUCCESS) {
+        vkFreeCommandBuffers(mVkContext->vkDevice, mVkTransferCmdPool, 1, &upload.transferCmdBuffer);
+        vkFreeCommandBuffers(mVkContext->vkDevice, mVkCmdPool, 1, &upload.acquireCmdBuffer);
+        return false;
+    }
+
+    mVkUploads.push_back(upload);
+
+    return true;
+}
+
+void
+CommandBufferManager::DestroyVkUploads(void)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    for(auto &upload : mVkUploads) {
+        vkFreeCommandBuffers(mVkContext->vkDevice, mVkTransferCmdPool, 1, &upload.transferCmdBuffer);
+        vkFreeCommandBuffers(mVkContext->vkDevice, mVkCmdPool, 1, &upload.acquireCmdBuffer);
+        vkDestroySemaphore(mVkContext->vkDevice, upload.semaphore, nullptr);
+    }
+
+    mVkUploads.clear();
+    mPendingUploads.clear();
+    mActiveUpload = -1;
+}
+
 bool
 CommandBufferManager::AllocateVkCmdBuffers(void)
 {
@@ -188,6 +311,9 @@ CommandBufferManager::AllocateVkCmdBuffers(void)
     mVkCommandBuffers.commandBuffer.resize(GLOVE_NUM_COMMAND_BUFFERS);
     mVkCommandBuffers.commandBufferState.resize(GLOVE_NUM_COMMAND_BUFFERS);
     mVkCommandBuffers.fence.resize(GLOVE_NUM_COMMAND_BUFFERS);
+    mVkCommandBuffers.submitSerial.resize(GLOVE_NUM_COMMAND_BUFFERS);
+    mVkCommandBuffers.semaphore.resize(GLOVE_NUM_COMMAND_BUFFERS, VK_NULL_HANDLE);
+    mVkCommandBuffers.secondaryCmdBufferPool.resize(GLOVE_NUM_COMMAND_BUFFERS);
 
     VkCommandBufferAllocateInfo cmdAllocInfo;
     cmdAllocInfo.sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
@@ -211,8 +337,14 @@ CommandBufferManager::AllocateVkCmdBuffers(void)
         return false;
     }
 
+    mVkAuxFence.SetContext(mVkContext);
+    if(!mVkAuxFence.Create(false)) {
+        return false;
+    }
+
     for(uint32_t i = 0; i < GLOVE_NUM_COMMAND_BUFFERS; ++i) {
         mVkCommandBuffers.commandBufferState[i] = CMD_BUFFER_INITIAL_STATE;
+        mVkCommandBuffers.submitSerial[i]       = 0;
 
         mVkCommandBuffers.fence[i].SetContext(mVkContext);
         if(!mVkCommandBuffers.fence[i].Create(false)) {
@@ -220,6 +352,20 @@ CommandBufferManager::AllocateVkCmdBuffers(void)
         }
     }
 
+    VkSemaphoreCreateInfo semaphoreCreateInfo;
+    semaphoreCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    semaphoreCreateInfo.pNext = nullptr;
+    semaphoreCreateInfo.flags = 0;
+
+    for(uint32_t i = 0; i < GLOVE_NUM_COMMAND_BUFFERS; ++i) {
+        err = vkCreateSemaphore(mVkContext->vkDevice, &semaphoreCreateInfo, nullptr, &mVkCommandBuffers.semaphore[i]);
+        assert(!err);
+
+        if(err != VK_SUCCESS) {
+            return false;
+        }
+    }
+
     return true;
 }
 
@@ -246,6 +392,7 @@ CommandBufferManager::BeginVkDrawCommandBuffer(void)
     }
 
     mVkCommandBuffers.commandBufferState[mActiveCmdBuffer] = CMD_BUFFER_RECORDING_STATE;
+    mRecordingSerial = mLastSubmitSerial + 1;
 
     return true;
 }
@@ -309,74 +456,147 @@ CommandBufferManager::SubmitVkDrawCommandBuffer(void)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    if(mVkCommandBuffers.commandBufferState[mActiveCmdBuffer] == CMD_BUFFER_INITIAL_STATE) {
+    /// with nothing recorded, the submission only hands the images of the pending uploads over
+    const bool recorded = mVkCommandBuffers.commandBufferState[mActiveCmdBuffer] != CMD_BUFFER_INITIAL_STATE;
+    if(!recorded && mPendingUploads.empty()) {
         return true;
     }
 
+    std::unique_lock<std::mutex> queueLock(mVkQueue->vkMutex);
+
+    VkSubmitInfo submitInfo[2];
+    uint32_t     submitCount = 0;
+
+    vector<VkSemaphore> acquireSems;
+    vector<VkPipelineStageFlags> acquireFlags;
+    vector<VkCommandBuffer> acquireCmdBuffers;
+    if(!mPendingUploads.empty()) {
+        PrepareUploadAcquires(&submitInfo[submitCount++], &acquireSems, &acquireFlags, &acquireCmdBuffers);
+    }
+
     vector<VkSemaphore> pSems;
     vector<VkPipelineStageFlags> pFlags;
-    if(mVkContext->vkSyncItems->acquireSemaphoreFlag) {
-        pSems.push_back(mVkContext->vkSyncItems->vkAcquireSemaphore);
-        pFlags.push_back(VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT);
-    }
-    if(mVkContext->vkSyncItems->drawSemaphoreFlag) {
-        pSems.push_back(mVkContext->vkSyncItems->vkDrawSemaphore);
-        pFlags.push_back(VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT);
-    }
-
-    VkSubmitInfo submitInfo;
-    submitInfo.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    submitInfo.pNext                = nullptr;
-    submitInfo.commandBufferCount   = 1;
-    submitInfo.pCommandBuffers      = &mVkCommandBuffers.commandBuffer[mActiveCmdBuffer];
-    submitInfo.waitSemaphoreCount   = static_cast<uint32_t>(pSems.size());
-    submitInfo.pWaitSemaphores      = pSems.data();
-    submitInfo.pWaitDstStageMask    = pFlags.data();
-    submitInfo.signalSemaphoreCount = 1;
-    submitInfo.pSignalSemaphores    = &mVkContext->vkSyncItems->vkDrawSemaphore;
-
-    mVkContext->vkSyncItems->drawSemaphoreFlag    = true;
-    mVkContext->vkSyncItems->acquireSemaphoreFlag = false;
-
-    VkResult err = vkQueueSubmit(mVkContext->vkQueue, 1, &submitInfo, mVkCommandBuffers.fence[mActiveCmdBuffer].GetFence());
+    vector<VkSemaphore> signalSems;
+    if(recorded) {
+        /// the submissions of this context are chained on each other
+        if(mChainedBuffer != GLOVE_NO_BUFFER_TO_WAIT) {
+            pSems.push_back(mVkCommandBuffers.semaphore[mChainedBuffer]);
+            pFlags.push_back(VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+        }
+        signalSems.push_back(mVkCommandBuffers.semaphore[mActiveCmdBuffer]);
+
+        /// only a submission that renders to a swapchain image waits for its acquire
+        /// and signals the render-complete semaphore its presentation waits for
+        vkSyncItems_t *syncItems = mSurfaceSyncItems;
+        if(syncItems != nullptr) {
+            VkSemaphore drawSemaphore = syncItems->vkDrawSemaphores[syncItems->frameIndex];
+
+            /// the image is first written as a color attachment; the earlier rendering
+            /// of the frame is waited for by every command
+            if(syncItems->acquireSemaphoreFlag) {
+                pSems.push_back(syncItems->vkAcquireSemaphores[syncItems->frameIndex]);
+                pFlags.push_back(VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
+            }
+            if(syncItems->drawSemaphoreFlag) {
+                pSems.push_back(drawSemaphore);
+                pFlags.push_back(VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+            }
+            signalSems.push_back(drawSemaphore);
+        }
+
+        VkSubmitInfo *drawInfo = &submitInfo[submitCount++];
+        drawInfo->sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        drawInfo->pNext                = nullptr;
+        drawInfo->commandBufferCount   = 1;
+        drawInfo->pCommandBuffers      = &mVkCommandBuffers.commandBuffer[mActiveCmdBuffer];
+        drawInfo->waitSemaphoreCount   = static_cast<uint32_t>(pSems.size());
+        drawInfo->pWaitSemaphores      = pSems.data();
+        drawInfo->pWaitDstStageMask    = pFlags.data();
+        drawInfo->signalSemaphoreCount = static_cast<uint32_t>(signalSems.size());
+        drawInfo->pSignalSemaphores    = signalSems.data();
+    }
+
+    VkResult err = vkQueueSubmit(mVkQueue->vkQueue, submitCount, submitInfo, mVkCommandBuffers.fence[mActiveCmdBuffer].GetFence());
     assert(!err);
+    queueLock.unlock();
 
     if(err != VK_SUCCESS) {
         return false;
     }
 
+    if(recorded) {
+        mChainedBuffer = mActiveCmdBuffer;
+        if(mSurfaceSyncItems != nullptr) {
+            mSurfaceSyncItems->drawSemaphoreFlag    = true;
+            mSurfaceSyncItems->acquireSemaphoreFlag = false;
+        }
+    }
+    mSurfaceSyncItems = nullptr;
+
     mVkCommandBuffers.commandBufferState[mActiveCmdBuffer] = CMD_BUFFER_SUBMITED_STATE;
+    mVkCommandBuffers.submitSerial[mActiveCmdBuffer]       = ++mLastSubmitSerial;
+    MarkUploadsAcquired(mLastSubmitSerial);
 
     mLastSubmittedBuffer = mActiveCmdBuffer;
 
     mActiveCmdBuffer = (mActiveCmdBuffer + 1) % GLOVE_NUM_COMMAND_BUFFERS;
 
-    mVkCommandBuffers.commandBufferState[mActiveCmdBuffer] = CMD_BUFFER_INITIAL_STATE;
-
-    return true;
+    /// the next buffer of the ring may still be executing, it can only be recorded again once it is done
+    return WaitVkDrawCommandBuffer(mActiveCmdBuffer);
 }
 
 bool
-CommandBufferManager::WaitLastSubmition(void)
+CommandBufferManager::WaitVkDrawCommandBuffer(uint32_t index)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    if(mLastSubmittedBuffer != GLOVE_NO_BUFFER_TO_WAIT) {
+    if(mVkCommandBuffers.commandBufferState[index] != CMD_BUFFER_SUBMITED_STATE) {
+        return true;
+    }
 
-        if(!mVkCommandBuffers.fence[mLastSubmittedBuffer].Wait(VK_TRUE, GLOVE_FENCE_WAIT_TIMEOUT))
-            return false;
+    if(!mVkCommandBuffers.fence[index].Wait(VK_TRUE, GLOVE_FENCE_WAIT_TIMEOUT)) {
+        return false;
+    }
 
-        if(!mVkCommandBuffers.fence[mLastSubmittedBuffer].Reset()) {
-            return false;
-        }
+    if(!mVkCommandBuffers.fence[index].Reset()) {
+        return false;
+    }
+
+    FreeResources(index);
 
-        FreeResources();
+    if(mCompletedSerial < mVkCommandBuffers.submitSerial[index]) {
+        mCompletedSerial = mVkCommandBuffers.submitSerial[index];
+    }
 
+    mVkCommandBuffers.commandBufferState[index] = CMD_BUFFER_INITIAL_STATE;
+
+    if(mLastSubmittedBuffer == static_cast<int32_t>(index)) {
         mLastSubmittedBuffer = GLOVE_NO_BUFFER_TO_WAIT;
-        return true;
     }
 
-    return false;
+    return true;
+}
+
+bool
+CommandBufferManager::WaitSubmission(uint64_t serial)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    for(uint32_t i = 0; i < mVkCommandBuffers.commandBufferState.size(); ++i) {
+        if(mVkCommandBuffers.submitSerial[i] <= serial && !WaitVkDrawCommandBuffer(i)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool
+CommandBufferManager::WaitLastSubmition(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    return WaitSubmission(mLastSubmitSerial);
 }
 
 bool
@@ -412,27 +632,217 @@ CommandBufferManager::SubmitVkAuxCommandBuffer(void)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    VkSubmitInfo info = {};
-    info.sType                  = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    info.pNext                  = nullptr;
-    info.commandBufferCount     = 1;
-    info.pCommandBuffers        = &mVkAuxCommandBuffer;
+    VkSubmitInfo info[2] = {};
+    uint32_t     submitCount = 0;
 
-    VkResult err = vkQueueSubmit(mVkContext->vkQueue, 1, &info, mVkAuxFence);
+    /// the auxiliary commands may use the images of the pending uploads
+    vector<VkSemaphore> acquireSems;
+    vector<VkPipelineStageFlags> acquireFlags;
+    vector<VkCommandBuffer> acquireCmdBuffers;
+    if(!mPendingUploads.empty()) {
+        PrepareUploadAcquires(&info[submitCount++], &acquireSems, &acquireFlags, &acquireCmdBuffers);
+    }
+
+    VkSubmitInfo *auxInfo = &info[submitCount++];
+    auxInfo->sType              = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    auxInfo->pNext              = nullptr;
+    auxInfo->commandBufferCount = 1;
+    auxInfo->pCommandBuffers    = &mVkAuxCommandBuffer;
+
+    std::lock_guard<std::mutex> queueLock(mVkQueue->vkMutex);
+    VkResult err = vkQueueSubmit(mVkQueue->vkQueue, submitCount, info, mVkAuxFence.GetFence());
     assert(!err);
 
+    if(err == VK_SUCCESS) {
+        MarkUploadsAcquired(0);
+    }
+
     return (err != VK_ERROR_OUT_OF_HOST_MEMORY && err != VK_ERROR_OUT_OF_DEVICE_MEMORY && err != VK_ERROR_DEVICE_LOST);
 }
 
 bool
-CommandBufferManager::WaitVkAuxCommandBuffer(void)
+CommandBufferManager::BeginVkUploadCommandBuffer(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    /// hand the images of too many uploads over before recording more of them
+    if(mPendingUploads.size() >= GLOVE_MAX_PENDING_UPLOADS && !FlushVkUploads()) {
+        return false;
+    }
+
+    mActiveUpload = -1;
+    for(uint32_t i = 0; i < mVkUploads.size(); ++i) {
+        upload_t *upload = &mVkUploads[i];
+
+        /// once the submission that acquired the image is done, so is the transfer it waited for
+        if(upload->state == UPLOAD_ACQUIRED_STATE && upload->acquireSerial <= mCompletedSerial) {
+            upload->state = UPLOAD_FREE_STATE;
+        }
+        if(upload->state == UPLOAD_FREE_STATE && mActiveUpload < 0) {
+            mActiveUpload = static_cast<int32_t>(i);
+        }
+    }
+
+    if(mActiveUpload < 0) {
+        if(!AllocateVkUpload()) {
+            return false;
+        }
+        mActiveUpload = static_cast<int32_t>(mVkUploads.size() - 1);
+    }
+
+    VkCommandBufferBeginInfo info;
+    info.sType            = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    info.pNext            = nullptr;
+    info.flags            = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    info.pInheritanceInfo = nullptr;
+
+    upload_t *upload = &mVkUploads[mActiveUpload];
+    VkResult err = vkBeginCommandBuffer(upload->transferCmdBuffer, &info);
+    assert(!err);
+
+    if(err != VK_SUCCESS) {
+        return false;
+    }
+
+    err = vkBeginCommandBuffer(upload->acquireCmdBuffer, &info);
+    assert(!err);
+
+    if(err != VK_SUCCESS) {
+        return false;
+    }
+
+    upload->state = UPLOAD_RECORDING_STATE;
+
+    return true;
+}
+
+bool
+CommandBufferManager::EndVkUploadCommandBuffer(void)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    VkResult err = vkQueueWaitIdle(mVkContext->vkQueue);
+    upload_t *upload = &mVkUploads[mActiveUpload];
+    VkResult err = vkEndCommandBuffer(upload->transferCmdBuffer);
     assert(!err);
 
-    return (err != VK_ERROR_OUT_OF_HOST_MEMORY && err != VK_ERROR_OUT_OF_DEVICE_MEMORY && err != VK_ERROR_DEVICE_LOST);
+    if(err == VK_SUCCESS) {
+        err = vkEndCommandBuffer(upload->acquireCmdBuffer);
+        assert(!err);
+    }
+
+    return (err != VK_ERROR_OUT_OF_HOST_MEMORY && err != VK_ERROR_OUT_OF_DEVICE_MEMORY);
+}
+
+bool
+CommandBufferManager::SubmitVkUploadCommandBuffer(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    upload_t *upload = &mVkUploads[mActiveUpload];
+
+    VkSubmitInfo info = {};
+    info.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    info.pNext                = nullptr;
+    info.commandBufferCount   = 1;
+    info.pCommandBuffers      = &upload->transferCmdBuffer;
+    info.signalSemaphoreCount = 1;
+    info.pSignalSemaphores    = &upload->semaphore;
+
+    VkResult err;
+    {
+        std::lock_guard<std::mutex> queueLock(mVkContext->vkTransferQueue.vkMutex);
+        err = vkQueueSubmit(mVkContext->vkTransferQueue.vkQueue, 1, &info, VK_NULL_HANDLE);
+    }
+    assert(!err);
+
+    if(err != VK_SUCCESS) {
+        upload->state = UPLOAD_FREE_STATE;
+        mActiveUpload = -1;
+        return false;
+    }
+
+    /// the graphics queue waits for the upload with the next submission of this context
+    upload->state = UPLOAD_SUBMITED_STATE;
+    mPendingUploads.push_back(static_cast<uint32_t>(mActiveUpload));
+    mActiveUpload = -1;
+
+    return true;
+}
+
+bool
+CommandBufferManager::FlushVkUploads(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    if(mPendingUploads.empty()) {
+        return true;
+    }
+
+    VkSubmitInfo info;
+    vector<VkSemaphore> acquireSems;
+    vector<VkPipelineStageFlags> acquireFlags;
+    vector<VkCommandBuffer> acquireCmdBuffers;
+    PrepareUploadAcquires(&info, &acquireSems, &acquireFlags, &acquireCmdBuffers);
+
+    VkResult err;
+    {
+        std::lock_guard<std::mutex> queueLock(mVkQueue->vkMutex);
+        err = vkQueueSubmit(mVkQueue->vkQueue, 1, &info, mVkAuxFence.GetFence());
+    }
+    assert(!err);
+
+    if(err != VK_SUCCESS) {
+        return false;
+    }
+
+    MarkUploadsAcquired(0);
+
+    return WaitVkAuxCommandBuffer();
+}
+
+void
+CommandBufferManager::PrepareUploadAcquires(VkSubmitInfo *submitInfo, std::vector<VkSemaphore> *semaphores, std::vector<VkPipelineStageFlags> *stages, std::vector<VkCommandBuffer> *cmdBuffers)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    /// only the uploads of this context are waited for, not everything on the transfer queue
+    for(auto index : mPendingUploads) {
+        semaphores->push_back(mVkUploads[index].semaphore);
+        stages->push_back(VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+        cmdBuffers->push_back(mVkUploads[index].acquireCmdBuffer);
+    }
+
+    submitInfo->sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo->pNext                = nullptr;
+    submitInfo->waitSemaphoreCount   = static_cast<uint32_t>(semaphores->size());
+    submitInfo->pWaitSemaphores      = semaphores->data();
+    submitInfo->pWaitDstStageMask    = stages->data();
+    submitInfo->commandBufferCount   = static_cast<uint32_t>(cmdBuffers->size());
+    submitInfo->pCommandBuffers      = cmdBuffers->data();
+    submitInfo->signalSemaphoreCount = 0;
+    submitInfo->pSignalSemaphores    = nullptr;
+}
+
+void
+CommandBufferManager::MarkUploadsAcquired(uint64_t serial)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    /// the auxiliary submission, serial 0, is waited for right away
+    for(auto index : mPendingUploads) {
+        mVkUploads[index].state         = UPLOAD_ACQUIRED_STATE;
+        mVkUploads[index].acquireSerial = serial;
+    }
+    mPendingUploads.clear();
+}
+
+bool
+CommandBufferManager::WaitVkAuxCommandBuffer(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    // only the auxiliary submission is waited for, not the work of the other contexts on the queue
+    return mVkAuxFence.Wait(VK_TRUE, GLOVE_FENCE_WAIT_TIMEOUT) && mVkAuxFence.Reset();
 }
 
 }
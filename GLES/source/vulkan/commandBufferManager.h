@@ -24,6 +24,7 @@
 #ifndef __VKCBMANAGER_H__
 #define __VKCBMANAGER_H__
 
+#include <atomic>
 #include <vector>
 #include "context.h"
 #include "fence.h"
@@ -38,6 +39,13 @@ typedef enum {
     CMD_BUFFER_SUBMITED_STATE
 } cmdBufferState_t;
 
+typedef enum {
+    UPLOAD_FREE_STATE = 0,
+    UPLOAD_RECORDING_STATE,
+    UPLOAD_SUBMITED_STATE,
+    UPLOAD_ACQUIRED_STATE
+} uploadState_t;
+
 class CommandBufferManager final {
 private:
 
@@ -45,24 +53,59 @@ private:
         std::vector<VkCommandBuffer>         commandBuffer;
         std::vector<cmdBufferState_t>        commandBufferState;
         std::vector<Fence>                   fence;
+        std::vector<uint64_t>                submitSerial;
+        /// signaled by the submission of a buffer and waited for by the next one of this context
+        std::vector<VkSemaphore>             semaphore;
+        std::vector<CommandBufferPool>       secondaryCmdBufferPool;
 
         State()  { FUN_ENTRY(GL_LOG_TRACE); }
         ~State() { FUN_ENTRY(GL_LOG_TRACE); }
     } State;
 
+    /// a copy on the transfer queue and the barrier that hands its image over to the graphics queue
+    typedef struct Upload {
+        VkCommandBuffer                      transferCmdBuffer;
+        VkCommandBuffer                      acquireCmdBuffer;
+        VkSemaphore                          semaphore;
+        uploadState_t                        state;
+        /// draw submission that acquired the image, 0 for the auxiliary one
+        uint64_t                             acquireSerial;
+    } upload_t;
+
+    /// the pool and the queue belong to this context, only its current thread records and submits to them
     VkCommandPool                   mVkCmdPool;
+    vkQueueSlot_t                  *mVkQueue;
     const vkContext_t              *mVkContext;
 
     uint32_t                        mActiveCmdBuffer;
     int32_t                         mLastSubmittedBuffer;
+    /// buffer whose semaphore is signaled and not yet waited for
+    int32_t                         mChainedBuffer;
+    /// frame sync items of the window surface the active buffer renders to, if any
+    vkSyncItems_t                  *mSurfaceSyncItems;
+    /// read by the other contexts of the share group to tell when a deleted object is no longer in use
+    std::atomic<uint64_t>           mLastSubmitSerial;
+    std::atomic<uint64_t>           mCompletedSerial;
+    /// serial the commands being recorded will be submitted with
+    std::atomic<uint64_t>           mRecordingSerial;
 
     State                           mVkCommandBuffers;
 
     VkCommandBuffer                 mVkAuxCommandBuffer;
-    VkFence                         mVkAuxFence;
-    CommandBufferPool               mSecondaryCmdBufferPool;
+    Fence                           mVkAuxFence;
+
+    VkCommandPool                   mVkTransferCmdPool;
+    std::vector<upload_t>           mVkUploads;
+    int32_t                         mActiveUpload;
+    /// uploads submitted to the transfer queue whose images the graphics queue has not acquired yet
+    std::vector<uint32_t>           mPendingUploads;
 
-    void FreeResources(void);
+    void FreeResources(uint32_t index);
+    bool WaitVkDrawCommandBuffer(uint32_t index);
+    bool AllocateVkUpload(void);
+    void DestroyVkUploads(void);
+    void PrepareUploadAcquires(VkSubmitInfo *submitInfo, std::vector<VkSemaphore> *semaphores, std::vector<VkPipelineStageFlags> *stages, std::vector<VkCommandBuffer> *cmdBuffers);
+    void MarkUploadsAcquired(uint64_t serial);
 
 public:
 // Constructor
@@ -84,25 +127,47 @@ public:
 
 // Begin Functions
     bool BeginVkAuxCommandBuffer(void);
+    bool BeginVkUploadCommandBuffer(void);
     bool BeginVkDrawCommandBuffer(void);
     bool BeginVkSecondaryCommandBuffer(const VkCommandBuffer *cmdBuffer, VkRenderPass renderPass, VkFramebuffer framebuffer);
 
 // End Functions
     bool EndVkAuxCommandBuffer(void);
+    bool EndVkUploadCommandBuffer(void);
     void EndVkDrawCommandBuffer(void);
     void EndVkSecondaryCommandBuffer(const VkCommandBuffer *cmdBuffer);
 
 // Submit Functions
     bool SubmitVkDrawCommandBuffer(void);
     bool SubmitVkAuxCommandBuffer(void);
+    bool SubmitVkUploadCommandBuffer(void);
+    bool FlushVkUploads(void);
 
 // Wait Functions
     bool WaitLastSubmition(void);
+    bool WaitSubmission(uint64_t serial);
     bool WaitVkAuxCommandBuffer(void);
 
 // Get Functions
     inline VkCommandBuffer GetActiveCommandBuffer(void)                   const { FUN_ENTRY(GL_LOG_TRACE); return mVkCommandBuffers.commandBuffer[mActiveCmdBuffer]; }
     inline VkCommandBuffer GetAuxCommandBuffer(void)                      const { FUN_ENTRY(GL_LOG_TRACE); return mVkAuxCommandBuffer; }
+    inline VkCommandBuffer GetUploadCommandBuffer(void)                   const { FUN_ENTRY(GL_LOG_TRACE); return mVkUploads[mActiveUpload].transferCmdBuffer; }
+    inline VkCommandBuffer GetUploadAcquireCommandBuffer(void)            const { FUN_ENTRY(GL_LOG_TRACE); return mVkUploads[mActiveUpload].acquireCmdBuffer; }
+    inline uint32_t        GetGraphicsQueueFamily(void)                   const { FUN_ENTRY(GL_LOG_TRACE); return mVkContext->vkGraphicsQueueNodeIndex; }
+    inline uint32_t        GetTransferQueueFamily(void)                   const { FUN_ENTRY(GL_LOG_TRACE); return mVkContext->vkTransferQueueNodeIndex; }
+    inline uint64_t        GetLastSubmitSerial(void)                      const { FUN_ENTRY(GL_LOG_TRACE); return mLastSubmitSerial; }
+    inline uint64_t        GetCompletedSerial(void)                       const { FUN_ENTRY(GL_LOG_TRACE); return mCompletedSerial; }
+    inline uint64_t        GetRecordingSerial(void)                       const { FUN_ENTRY(GL_LOG_TRACE); return mRecordingSerial; }
+
+// Has Functions
+    inline bool HasTransferQueue(void)                                    const { FUN_ENTRY(GL_LOG_TRACE); return mVkTransferCmdPool != VK_NULL_HANDLE; }
+    inline bool HasPendingUploads(void)                                   const { FUN_ENTRY(GL_LOG_TRACE); return !mPendingUploads.empty(); }
+
+// Set Functions
+    inline void            SetSurfaceSyncItems(vkSyncItems_t *syncItems)        { FUN_ENTRY(GL_LOG_TRACE); mSurfaceSyncItems = syncItems; }
+
+// Is Functions
+    inline bool IsVkDrawCommandBufferRecording(void)                      const { FUN_ENTRY(GL_LOG_TRACE); return mVkCommandBuffers.commandBufferState[mActiveCmdBuffer] == CMD_BUFFER_RECORDING_STATE; }
 };
 
 }
@@ -28,11 +28,33 @@
  */
 
 #include "context.h"
+#include "pipelineCache.h"
+#include "pipelineStateLog.h"
+#include "renderPassCache.h"
+#include <algorithm>
 
 namespace vulkanAPI {
 
 #define GLOVE_VK_VALIDATION_LAYERS                      false
 
+/// Persisting the device-wide pipeline cache is opt-in: when GLOVE_PIPELINE_CACHE_FILE
+/// names a file, the cache is loaded from it at eglInitialize and stored at eglTerminate.
+#define GLOVE_VK_PIPELINE_CACHE_FILE_ENV                "GLOVE_PIPELINE_CACHE_FILE"
+
+/// Pipeline prewarming is opt-in: when GLOVE_PIPELINE_STATE_LOG_FILE names a file, the
+/// pipeline states used by each program are recorded to it and replayed on later runs.
+#define GLOVE_VK_PIPELINE_STATE_LOG_FILE_ENV            "GLOVE_PIPELINE_STATE_LOG_FILE"
+
+/// The physical device is picked by type, discrete GPUs first and CPU implementations last.
+/// GLOVE_DEVICE overrides the choice with a part of the device name, or with its index in
+/// the order the loader enumerates the devices, which is the one vulkaninfo reports.
+/// Devices without a graphics queue are never chosen.
+#define GLOVE_VK_DEVICE_ENV                             "GLOVE_DEVICE"
+
+/// Texture uploads go through a transfer-only queue when the device has one, unless
+/// GLOVE_NO_TRANSFER_QUEUE is set.
+#define GLOVE_VK_NO_TRANSFER_QUEUE_ENV                  "GLOVE_NO_TRANSFER_QUEUE"
+
 #ifdef VK_USE_PLATFORM_XCB_KHR
 static const std::vector<const char*> requiredInstanceExtensions = {VK_KHR_SURFACE_EXTENSION_NAME,
                                                                     VK_KHR_XCB_SURFACE_EXTENSION_NAME};
@@ -57,11 +79,19 @@ static const std::vector<const char*> requiredDeviceExtensions   = {VK_KHR_SWAPC
 
 static const std::vector<const char*> usefulDeviceExtensions     = {"VK_KHR_maintenance1"};
 
+/// Headless mode presents nothing, so it needs neither surface nor swapchain extensions
+static const std::vector<const char*> headlessExtensions;
+
 static       char **enabledInstanceLayers           = nullptr;
 
 vkContext_t GloveVkContext;
 
+/// guards the number of contexts of every queue
+static std::mutex queueSlotsMutex;
+
 bool InitVkLayers(uint32_t* nLayers);
+const std::vector<const char*> &GetRequiredInstanceExtensions(void);
+const std::vector<const char*> &GetRequiredDeviceExtensions(void);
 bool CheckVkInstanceExtensions(void);
 bool CheckVkDeviceExtensions(void);
 bool CreateVkInstance(void);
@@ -69,7 +99,11 @@ bool EnumerateVkGpus(void);
 bool InitVkQueueFamilyIndex(void);
 bool CreateVkDevice(void);
 bool CreateVkCommandPool(void);
-bool CreateVkSemaphores(void);
+bool CreateVkPipelineCache(void);
+void DestroyVkPipelineCache(void);
+const char *GetVkPipelineCacheFilename(void);
+bool CreateVkPipelineStateLog(void);
+void DestroyVkPipelineStateLog(void);
 void InitVkQueue(void);
 
 bool
@@ -114,11 +148,29 @@ InitVkLayers(uint32_t* nLayers)
     return true;
 }
 
+const std::vector<const char*> &
+GetRequiredInstanceExtensions(void)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    return GloveVkContext.mIsHeadless ? headlessExtensions : requiredInstanceExtensions;
+}
+
+const std::vector<const char*> &
+GetRequiredDeviceExtensions(void)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    return GloveVkContext.mIsHeadless ? headlessExtensions : requiredDeviceExtensions;
+}
+
 bool
 CheckVkInstanceExtensions(void)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
+    const std::vector<const char*> &requiredExtensions = GetRequiredInstanceExtensions();
+
     VkResult res;
     uint32_t extensionCount = 0;
     VkExtensionProperties *vkExtensionProperties = nullptr;
@@ -138,10 +190,10 @@ CheckVkInstanceExtensions(void)
         res = vkEnumerateInstanceExtensionProperties(nullptr, &extensionCount, vkExtensionProperties);
     } while(res == VK_INCOMPLETE);
 
-    std::vector<bool> requiredExtensionsAvailable(requiredInstanceExtensions.size(), false);
+    std::vector<bool> requiredExtensionsAvailable(requiredExtensions.size(), false);
     for(uint32_t i = 0; i < extensionCount; ++i) {
-        for(uint32_t j = 0; j < requiredInstanceExtensions.size(); ++j) {
-            if(!strcmp(requiredInstanceExtensions[j], vkExtensionProperties[i].extensionName)) {
+        for(uint32_t j = 0; j < requiredExtensions.size(); ++j) {
+            if(!strcmp(requiredExtensions[j], vkExtensionProperties[i].extensionName)) {
                 requiredExtensionsAvailable[j] = true;
                 break;
             }
@@ -153,7 +205,7 @@ CheckVkInstanceExtensions(void)
         vkExtensionProperties = nullptr;
     }
 
-    for(uint32_t j = 0; j < requiredInstanceExtensions.size(); ++j) {
+    for(uint32_t j = 0; j < requiredExtensions.size(); ++j) {
         if(!requiredExtensionsAvailable[j]) {
             return false;
         }
@@ -167,12 +219,14 @@ CheckVkDeviceExtensions(void)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
+    const std::vector<const char*> &requiredExtensions = GetRequiredDeviceExtensions();
+
     VkResult res;
     uint32_t extensionCount = 0;
     VkExtensionProperties *vkExtensionProperties = nullptr;
 
     do {
-        res = vkEnumerateDeviceExtensionProperties(GloveVkContext.vkGpus[0], nullptr, &extensionCount, nullptr);
+        res = vkEnumerateDeviceExtensionProperties(GloveVkContext.vkGpu, nullptr, &extensionCount, nullptr);
 
         if(!extensionCount || res) {
             break;
@@ -183,13 +237,13 @@ CheckVkDeviceExtensions(void)
             return false;
         }
 
-        res = vkEnumerateDeviceExtensionProperties(GloveVkContext.vkGpus[0], nullptr, &extensionCount, vkExtensionProperties);
+        res = vkEnumerateDeviceExtensionProperties(GloveVkContext.vkGpu, nullptr, &extensionCount, vkExtensionProperties);
     } while(res == VK_INCOMPLETE);
 
-    std::vector<bool> requiredExtensionsAvailable(requiredDeviceExtensions.size(), false);
+    std::vector<bool> requiredExtensionsAvailable(requiredExtensions.size(), false);
     for(uint32_t i = 0; i < extensionCount; ++i) {
-        for(uint32_t j = 0; j < requiredDeviceExtensions.size(); ++j) {
-            if(!strcmp(requiredDeviceExtensions[j], vkExtensionProperties[i].extensionName)) {
+        for(uint32_t j = 0; j < requiredExtensions.size(); ++j) {
+            if(!strcmp(requiredExtensions[j], vkExtensionProperties[i].extensionName)) {
                 requiredExtensionsAvailable[j] = true;
                 break;
             }
@@ -211,9 +265,9 @@ CheckVkDeviceExtensions(void)
         vkExtensionProperties = nullptr;
     }
 
-    for(uint32_t j = 0; j < requiredDeviceExtensions.size(); ++j) {
+    for(uint32_t j = 0; j < requiredExtensions.size(); ++j) {
         if(!requiredExtensionsAvailable[j]) {
-            printf("\n%s extension is mandatory for GLOVE\n", requiredDeviceExtensions[j]);
+            printf("\n%s extension is mandatory for GLOVE\n", requiredExtensions[j]);
             printf("Please link GLOVE to a Vulkan driver which supports the latter\n");
             return false;
         }
@@ -251,8 +305,8 @@ CreateVkInstance(void)
     instanceInfo.pApplicationInfo         = &applicationInfo;
     instanceInfo.enabledLayerCount        = enabledLayerCount;
     instanceInfo.ppEnabledLayerNames      = enabledInstanceLayers;
-    instanceInfo.enabledExtensionCount    = static_cast<uint32_t>(requiredInstanceExtensions.size());
-    instanceInfo.ppEnabledExtensionNames  = requiredInstanceExtensions.data();
+    instanceInfo.enabledExtensionCount    = static_cast<uint32_t>(GetRequiredInstanceExtensions().size());
+    instanceInfo.ppEnabledExtensionNames  = GetRequiredInstanceExtensions().data();
 
     VkResult err = vkCreateInstance(&instanceInfo, nullptr, &GloveVkContext.vkInstance);
     assert(!err);
@@ -289,36 +343,130 @@ EnumerateVkGpus(void)
         return false;
     }
 
-    vkGetPhysicalDeviceMemoryProperties(GloveVkContext.vkGpus[0], &GloveVkContext.vkDeviceMemoryProperties);
+    /// only the devices that can render are candidates, they keep their enumeration index
+    vector<VkPhysicalDeviceProperties> properties(gpuCount);
+    vector<bool>                       canRender(gpuCount, false);
+    for(uint32_t i = 0; i < gpuCount; ++i) {
+        vkGetPhysicalDeviceProperties(GloveVkContext.vkGpus[i], &properties[i]);
+
+        uint32_t queueFamilyCount = 0;
+        vkGetPhysicalDeviceQueueFamilyProperties(GloveVkContext.vkGpus[i], &queueFamilyCount, nullptr);
+
+        vector<VkQueueFamilyProperties> queueProperties(queueFamilyCount);
+        vkGetPhysicalDeviceQueueFamilyProperties(GloveVkContext.vkGpus[i], &queueFamilyCount, queueProperties.data());
+
+        for(auto &queueFamily : queueProperties) {
+            if(queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT) {
+                canRender[i] = true;
+                break;
+            }
+        }
+    }
+
+    int32_t index = SelectPhysicalDevice(properties, canRender, getenv(GLOVE_VK_DEVICE_ENV));
+    assert(index >= 0);
+    if(index < 0) {
+        return false;
+    }
+
+    GloveVkContext.vkGpu = GloveVkContext.vkGpus[index];
+    GLOVE_PRINT(GL_LOG_INFO, "GLOVE renders on %s", properties[index].deviceName);
+
+    vkGetPhysicalDeviceMemoryProperties(GloveVkContext.vkGpu, &GloveVkContext.vkDeviceMemoryProperties);
+    vkGetPhysicalDeviceProperties(GloveVkContext.vkGpu, &GloveVkContext.vkDeviceProperties);
 
     return true;
 }
 
+static uint32_t
+RankPhysicalDeviceType(VkPhysicalDeviceType type)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    switch(type) {
+    case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU:      return 4;
+    case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU:    return 3;
+    case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU:       return 2;
+    case VK_PHYSICAL_DEVICE_TYPE_CPU:               return 1;
+    default:                                        return 0;
+    }
+}
+
+int32_t
+SelectPhysicalDevice(const vector<VkPhysicalDeviceProperties> &properties, const vector<bool> &canRender, const char *deviceOverride)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    assert(properties.size() == canRender.size());
+
+    /// the override is either an index in the enumeration order, or a part of the device name
+    if(deviceOverride != nullptr && *deviceOverride != '\0') {
+        char *end = nullptr;
+        unsigned long index = strtoul(deviceOverride, &end, 10);
+        if(*end == '\0') {
+            if(index < properties.size() && canRender[index]) {
+                return static_cast<int32_t>(index);
+            }
+        } else {
+            for(uint32_t i = 0; i < properties.size(); ++i) {
+                if(canRender[i] && strstr(properties[i].deviceName, deviceOverride) != nullptr) {
+                    return static_cast<int32_t>(i);
+                }
+            }
+        }
+    }
+
+    /// the first device of the best type, so equal devices keep the order of the loader
+    int32_t best = -1;
+    for(uint32_t i = 0; i < properties.size(); ++i) {
+        if(canRender[i] &&
+           (best < 0 || RankPhysicalDeviceType(properties[i].deviceType) > RankPhysicalDeviceType(properties[best].deviceType))) {
+            best = static_cast<int32_t>(i);
+        }
+    }
+
+    return best;
+}
+
 bool
 InitVkQueueFamilyIndex(void)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
     uint32_t queueFamilyCount;
-    vkGetPhysicalDeviceQueueFamilyProperties(GloveVkContext.vkGpus[0], &queueFamilyCount, nullptr);
+    vkGetPhysicalDeviceQueueFamilyProperties(GloveVkContext.vkGpu, &queueFamilyCount, nullptr);
     assert(queueFamilyCount >= 1);
     if(!queueFamilyCount) {
         return false;
     }
 
     VkQueueFamilyProperties *queueProperties = new VkQueueFamilyProperties[queueFamilyCount];
-    vkGetPhysicalDeviceQueueFamilyProperties(GloveVkContext.vkGpus[0], &queueFamilyCount, queueProperties);
+    vkGetPhysicalDeviceQueueFamilyProperties(GloveVkContext.vkGpu, &queueFamilyCount, queueProperties);
 
     uint32_t i;
     for(i = 0; i < queueFamilyCount; ++i) {
         if(queueProperties[i].queueFlags & VK_QUEUE_GRAPHICS_BIT) {
             GloveVkContext.vkGraphicsQueueNodeIndex = i;
+            GloveVkContext.vkNumQueues              = std::min(queueProperties[i].queueCount, static_cast<uint32_t>(GLOVE_MAX_DEVICE_QUEUES));
             break;
         }
     }
+    const bool graphicsFound = i < queueFamilyCount;
+
+    /// a family that only transfers runs on its own engine, next to the rendering
+    GloveVkContext.vkTransferQueueNodeIndex = VK_QUEUE_FAMILY_IGNORED;
+    if(getenv(GLOVE_VK_NO_TRANSFER_QUEUE_ENV) == nullptr) {
+        for(uint32_t j = 0; j < queueFamilyCount; ++j) {
+            if((queueProperties[j].queueFlags & VK_QUEUE_TRANSFER_BIT) &&
+              !(queueProperties[j].queueFlags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT))) {
+                GloveVkContext.vkTransferQueueNodeIndex = j;
+                break;
+            }
+        }
+    }
 
     delete[] queueProperties;
-    return i < queueFamilyCount ? true : false;
+    return graphicsFound;
 }
 
 bool
@@ -326,16 +474,21 @@ CreateVkDevice(void)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    float queue_priorities[1] = {0.0};
-    VkDeviceQueueCreateInfo queueInfo;
-    queueInfo.sType            = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
-    queueInfo.pNext            = nullptr;
-    queueInfo.flags            = 0;
-    queueInfo.queueCount       = 1;
-    queueInfo.pQueuePriorities = queue_priorities;
-    queueInfo.queueFamilyIndex = GloveVkContext.vkGraphicsQueueNodeIndex;
+    float queue_priorities[GLOVE_MAX_DEVICE_QUEUES] = {0.0};
+    VkDeviceQueueCreateInfo queueInfo[2];
+    queueInfo[0].sType            = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+    queueInfo[0].pNext            = nullptr;
+    queueInfo[0].flags            = 0;
+    queueInfo[0].queueCount       = GloveVkContext.vkNumQueues;
+    queueInfo[0].pQueuePriorities = queue_priorities;
+    queueInfo[0].queueFamilyIndex = GloveVkContext.vkGraphicsQueueNodeIndex;
 
-    std::vector<const char*> enabledExtensions(requiredDeviceExtensions);
+    queueInfo[1]                  = queueInfo[0];
+    queueInfo[1].queueCount       = 1;
+    queueInfo[1].queueFamilyIndex = GloveVkContext.vkTransferQueueNodeIndex;
+    const uint32_t queueInfoCount = GloveVkContext.vkTransferQueueNodeIndex != VK_QUEUE_FAMILY_IGNORED ? 2 : 1;
+
+    std::vector<const char*> enabledExtensions(GetRequiredDeviceExtensions());
 
     if(true == GetContext()->mIsMaintenanceExtSupported) {
         enabledExtensions.insert(enabledExtensions.end(), usefulDeviceExtensions.begin(), usefulDeviceExtensions.end());
@@ -345,63 +498,149 @@ CreateVkDevice(void)
     deviceInfo.sType                   = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
     deviceInfo.pNext                   = nullptr;
     deviceInfo.flags                   = 0;
-    deviceInfo.queueCreateInfoCount    = 1;
-    deviceInfo.pQueueCreateInfos       = &queueInfo;
+    deviceInfo.queueCreateInfoCount    = queueInfoCount;
+    deviceInfo.pQueueCreateInfos       = queueInfo;
     deviceInfo.enabledLayerCount       = 0;
     deviceInfo.ppEnabledLayerNames     = nullptr;
     deviceInfo.enabledExtensionCount   = enabledExtensions.size();
     deviceInfo.ppEnabledExtensionNames = enabledExtensions.data();
     deviceInfo.pEnabledFeatures        = nullptr;
 
-    VkResult err = vkCreateDevice(GloveVkContext.vkGpus[0], &deviceInfo, nullptr, &GloveVkContext.vkDevice);
+    VkResult err = vkCreateDevice(GloveVkContext.vkGpu, &deviceInfo, nullptr, &GloveVkContext.vkDevice);
     assert(!err);
 
     return (err == VK_SUCCESS);
 }
 
+const char *
+GetVkPipelineCacheFilename(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    return getenv(GLOVE_VK_PIPELINE_CACHE_FILE_ENV);
+}
+
 bool
-CreateVkSemaphores(void)
+CreateVkPipelineCache(void)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    VkResult err;
+    GloveVkContext.vkPipelineCache = new PipelineCache(&GloveVkContext);
+
+    return GloveVkContext.vkPipelineCache->CreateFromFile(GetVkPipelineCacheFilename());
+}
+
+void
+DestroyVkPipelineCache(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
 
-    GloveVkContext.vkSyncItems = new vkSyncItems_t;
+    if(GloveVkContext.vkPipelineCache == nullptr) {
+        return;
+    }
 
-    VkSemaphoreCreateInfo semaphoreCreateInfo;
-    semaphoreCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
-    semaphoreCreateInfo.pNext = nullptr;
-    semaphoreCreateInfo.flags = 0;
+    GloveVkContext.vkPipelineCache->SaveToFile(GetVkPipelineCacheFilename());
+    SafeDelete(GloveVkContext.vkPipelineCache);
+}
 
-    err = vkCreateSemaphore(GloveVkContext.vkDevice, &semaphoreCreateInfo, nullptr, &GloveVkContext.vkSyncItems->vkDrawSemaphore);
-    assert(!err);
+bool
+CreateVkPipelineStateLog(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
 
-    if(err != VK_SUCCESS) {
-        return false;
+    const char *filename = getenv(GLOVE_VK_PIPELINE_STATE_LOG_FILE_ENV);
+    if(filename == nullptr || !filename[0]) {
+        return true;
     }
 
-    err = vkCreateSemaphore(GloveVkContext.vkDevice, &semaphoreCreateInfo, nullptr, &GloveVkContext.vkSyncItems->vkAcquireSemaphore);
-    assert(!err);
+    GloveVkContext.vkPipelineStateLog = new PipelineStateLog();
+    GloveVkContext.vkPipelineStateLog->LoadFromFile(filename);
 
-    if(err != VK_SUCCESS) {
-        return false;
+    return true;
+}
+
+void
+DestroyVkPipelineStateLog(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    if(GloveVkContext.vkPipelineStateLog == nullptr) {
+        return;
     }
 
-    GloveVkContext.vkSyncItems->acquireSemaphoreFlag = true;
-    GloveVkContext.vkSyncItems->drawSemaphoreFlag = false;
+    GloveVkContext.vkPipelineStateLog->SaveToFile(getenv(GLOVE_VK_PIPELINE_STATE_LOG_FILE_ENV));
+    SafeDelete(GloveVkContext.vkPipelineStateLog);
+}
+
+bool
+CreateVkRenderPassCache(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    GloveVkContext.vkRenderPassCache = new RenderPassCache(&GloveVkContext);
 
     return true;
 }
 
+void
+DestroyVkRenderPassCache(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    SafeDelete(GloveVkContext.vkRenderPassCache);
+}
+
 void
 InitVkQueue(void)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    vkGetDeviceQueue(GloveVkContext.vkDevice,
-                     GloveVkContext.vkGraphicsQueueNodeIndex,
-                     0,
-                     &GloveVkContext.vkQueue);
+    for(uint32_t i = 0; i < GloveVkContext.vkNumQueues; ++i) {
+        vkGetDeviceQueue(GloveVkContext.vkDevice,
+                         GloveVkContext.vkGraphicsQueueNodeIndex,
+                         i,
+                         &GloveVkContext.vkQueues[i].vkQueue);
+        GloveVkContext.vkQueues[i].numContexts = 0;
+    }
+
+    GloveVkContext.vkQueue = GloveVkContext.vkQueues[0].vkQueue;
+
+    if(GloveVkContext.vkTransferQueueNodeIndex != VK_QUEUE_FAMILY_IGNORED) {
+        vkGetDeviceQueue(GloveVkContext.vkDevice,
+                         GloveVkContext.vkTransferQueueNodeIndex,
+                         0,
+                         &GloveVkContext.vkTransferQueue.vkQueue);
+    }
+}
+
+vkQueueSlot_t *
+AcquireQueue()
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    std::lock_guard<std::mutex> lock(queueSlotsMutex);
+
+    /// each context submits to the queue with the fewest contexts
+    vkQueueSlot_t *queue = &GloveVkContext.vkQueues[0];
+    for(uint32_t i = 1; i < GloveVkContext.vkNumQueues; ++i) {
+        if(GloveVkContext.vkQueues[i].numContexts < queue->numContexts) {
+            queue = &GloveVkContext.vkQueues[i];
+        }
+    }
+    ++queue->numContexts;
+
+    return queue;
+}
+
+void
+ReleaseQueue(vkQueueSlot_t *queue)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    std::lock_guard<std::mutex> lock(queueSlotsMutex);
+
+    assert(queue->numContexts);
+    --queue->numContexts;
 }
 
 vkContext_t *
@@ -417,14 +656,27 @@ ResetContextResources()
 {
     GloveVkContext.vkInstance                   = VK_NULL_HANDLE;
     GloveVkContext.vkGpus.clear();
+    GloveVkContext.vkGpu                        = VK_NULL_HANDLE;
     GloveVkContext.vkQueue                      = VK_NULL_HANDLE;
+    for(uint32_t i = 0; i < GLOVE_MAX_DEVICE_QUEUES; ++i) {
+        GloveVkContext.vkQueues[i].vkQueue      = VK_NULL_HANDLE;
+        GloveVkContext.vkQueues[i].numContexts  = 0;
+    }
+    GloveVkContext.vkNumQueues                  = 0;
     GloveVkContext.vkGraphicsQueueNodeIndex     = 0;
+    GloveVkContext.vkTransferQueue.vkQueue      = VK_NULL_HANDLE;
+    GloveVkContext.vkTransferQueueNodeIndex     = 0;
     GloveVkContext.vkDevice                     = VK_NULL_HANDLE;
-    GloveVkContext.vkSyncItems                  = nullptr;
+    GloveVkContext.vkPipelineCache              = nullptr;
+    GloveVkContext.vkPipelineStateLog           = nullptr;
+    GloveVkContext.vkRenderPassCache            = nullptr;
     GloveVkContext.mIsMaintenanceExtSupported   = false;
+    GloveVkContext.mIsHeadless                  = false;
     GloveVkContext.mInitialized                 = false;
     memset(static_cast<void*>(&GloveVkContext.vkDeviceMemoryProperties), 0,
            sizeof(VkPhysicalDeviceMemoryProperties));
+    memset(static_cast<void*>(&GloveVkContext.vkDeviceProperties), 0,
+           sizeof(VkPhysicalDeviceProperties));
 }
 
 bool
@@ -438,13 +690,17 @@ InitContext()
 
     ResetContextResources();
 
+    GloveVkContext.mIsHeadless = getenv(GLOVE_HEADLESS_ENV) != nullptr;
+
     if( !CheckVkInstanceExtensions()  ||
         !CreateVkInstance()           ||
         !EnumerateVkGpus()            ||
         !InitVkQueueFamilyIndex()     ||
         !CheckVkDeviceExtensions()    ||
         !CreateVkDevice()             ||
-        !CreateVkSemaphores()
+        !CreateVkPipelineCache()      ||
+        !CreateVkPipelineStateLog()   ||
+        !CreateVkRenderPassCache()
       ) {
         assert(false);
         return false;
@@ -465,24 +721,16 @@ TerminateContext()
         return;
     }
 
-    if(GloveVkContext.vkSyncItems->vkAcquireSemaphore != VK_NULL_HANDLE) {
-        vkDestroySemaphore(GloveVkContext.vkDevice, GloveVkContext.vkSyncItems->vkAcquireSemaphore, nullptr);
-        GloveVkContext.vkSyncItems->vkAcquireSemaphore = VK_NULL_HANDLE;
-    }
-
-    if(GloveVkContext.vkSyncItems->vkDrawSemaphore != VK_NULL_HANDLE) {
-        vkDestroySemaphore(GloveVkContext.vkDevice, GloveVkContext.vkSyncItems->vkDrawSemaphore, nullptr);
-        GloveVkContext.vkSyncItems->vkDrawSemaphore = VK_NULL_HANDLE;
-    }
+    DestroyVkPipelineStateLog();
+    DestroyVkPipelineCache();
 
     if(GloveVkContext.vkDevice != VK_NULL_HANDLE ) {
         vkDeviceWaitIdle(GloveVkContext.vkDevice);
+        DestroyVkRenderPassCache();
         vkDestroyDevice(GloveVkContext.vkDevice, nullptr);
         vkDestroyInstance(GloveVkContext.vkInstance, nullptr);
     }
 
-    SafeDelete(GloveVkContext.vkSyncItems);
-
     ResetContextResources();
 }
 
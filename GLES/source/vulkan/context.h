@@ -25,6 +25,7 @@
 #define __VKCONTEXT_H__
 
 #include <map>
+#include <mutex>
 #include <vector>
 #include "utils/glLogger.h"
 #include "vulkan/vulkan.h"
@@ -32,30 +33,70 @@
 
 using namespace std;
 
+/// contexts are spread over up to this many queues of the graphics family
+#define GLOVE_MAX_DEVICE_QUEUES                         4
+
 namespace vulkanAPI {
 
+    class PipelineCache;
+    class PipelineStateLog;
+    class RenderPassCache;
+
+    /// a device queue and the contexts that submit to it
+    typedef struct vkQueueSlot_t {
+        vkQueueSlot_t() {
+            vkQueue     = VK_NULL_HANDLE;
+            numContexts = 0;
+        }
+
+        VkQueue                                             vkQueue;
+        uint32_t                                            numContexts;
+        /// Vulkan requires submissions to the same queue to be externally synchronized
+        mutable std::mutex                                  vkMutex;
+    } vkQueueSlot_t;
+
     typedef struct vkContext_t {
         vkContext_t() {
             vkInstance            = VK_NULL_HANDLE;
+            vkGpu                 = VK_NULL_HANDLE;
             vkQueue               = VK_NULL_HANDLE;
+            vkNumQueues           = 0;
+            vkTransferQueueNodeIndex = 0;
             mInitialized          = false;
             vkGraphicsQueueNodeIndex = 0;
             vkDevice = VK_NULL_HANDLE;
-            vkSyncItems             = nullptr;
+            vkPipelineCache         = nullptr;
+            vkPipelineStateLog      = nullptr;
+            vkRenderPassCache       = nullptr;
             mIsMaintenanceExtSupported = false;
+            mIsHeadless             = false;
             mInitialized            = false;
             memset(static_cast<void*>(&vkDeviceMemoryProperties), 0,
                    sizeof(VkPhysicalDeviceMemoryProperties));
+            memset(static_cast<void*>(&vkDeviceProperties), 0,
+                   sizeof(VkPhysicalDeviceProperties));
         }
 
         VkInstance                                          vkInstance;
         vector<VkPhysicalDevice>                            vkGpus;
+        /// the physical device chosen among vkGpus, used by everything else
+        VkPhysicalDevice                                    vkGpu;
+        /// presentation queue, the first of vkQueues
         VkQueue                                             vkQueue;
+        vkQueueSlot_t                                       vkQueues[GLOVE_MAX_DEVICE_QUEUES];
+        uint32_t                                            vkNumQueues;
         uint32_t                                            vkGraphicsQueueNodeIndex;
+        /// queue of a transfer-only family for texture uploads, VK_NULL_HANDLE if there is none
+        vkQueueSlot_t                                       vkTransferQueue;
+        uint32_t                                            vkTransferQueueNodeIndex;
         VkDevice                                            vkDevice;
         VkPhysicalDeviceMemoryProperties                    vkDeviceMemoryProperties;
-        vkSyncItems_t                                       *vkSyncItems;
+        VkPhysicalDeviceProperties                          vkDeviceProperties;
+        PipelineCache                                       *vkPipelineCache;
+        PipelineStateLog                                    *vkPipelineStateLog;
+        RenderPassCache                                     *vkRenderPassCache;
         bool                                                mIsMaintenanceExtSupported;
+        bool                                                mIsHeadless;
         bool                                                mInitialized;
     } vkContext_t;
 
@@ -63,6 +104,9 @@ namespace vulkanAPI {
     bool                              InitContext();
     void                              TerminateContext();
     void                              ClearContextResources();
+    int32_t                           SelectPhysicalDevice(const vector<VkPhysicalDeviceProperties> &properties, const vector<bool> &canRender, const char *deviceOverride);
+    vkQueueSlot_t *                   AcquireQueue();
+    void                              ReleaseQueue(vkQueueSlot_t *queue);
 
     template<typename T>  inline void SafeDelete(T*& ptr)                       { FUN_ENTRY(GL_LOG_TRACE); delete ptr; ptr = nullptr; }
 };
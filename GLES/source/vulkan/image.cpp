@@ -30,6 +30,7 @@
  */
 
 #include "image.h"
+#include "utils/cacheManager.h"
 
 namespace vulkanAPI {
 
@@ -58,10 +59,11 @@ Image::Release(void)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    if(mVkImage != VK_NULL_HANDLE) {
+    /// images wrapped through SetImage() belong to someone else
+    if(mVkImage != VK_NULL_HANDLE && mDelete) {
         vkDestroyImage(mVkContext->vkDevice, mVkImage, nullptr);
-        mVkImage = VK_NULL_HANDLE;
     }
+    mVkImage    = VK_NULL_HANDLE;
 
     mWidth      = 0;
     mHeight     = 0;
@@ -70,11 +72,24 @@ Image::Release(void)
     mDelete     = true;
 }
 
+void
+Image::Release(CacheManager *cacheManager)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    if(mVkImage != VK_NULL_HANDLE && mDelete) {
+        cacheManager->CacheVkImage(mVkImage);
+        mVkImage = VK_NULL_HANDLE;
+    }
+
+    Release();
+}
+
 void
 Image::SetImageTiling(void)
 {
     VkFormatProperties props;
-    vkGetPhysicalDeviceFormatProperties(mVkContext->vkGpus[0], mVkFormat, &props);
+    vkGetPhysicalDeviceFormatProperties(mVkContext->vkGpu, mVkFormat, &props);
 
     VkFormatFeatureFlagBits flagbits = static_cast<VkFormatFeatureFlagBits>(0);
     if(mVkImageUsage & VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT) {
@@ -364,32 +379,92 @@ Image::ModifyImageLayout(VkCommandBuffer *activeCmdBuffer, VkImageLayout newImag
     mVkImageLayout = newImageLayout;
 }
 
-VkFormat
-Image::FindSupportedVkColorFormat(VkFormat format)
+void
+Image::TransferQueueFamilyOwnership(VkCommandBuffer *releaseCmdBuffer, VkCommandBuffer *acquireCmdBuffer, VkImageLayout newImageLayout,
+                                    uint32_t srcQueueFamily, uint32_t dstQueueFamily)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    // The same barrier is recorded on both queues, releasing the image after the transfer
+    // writes and acquiring it, in its new layout, before any later use
+    VkImageMemoryBarrier imageMemoryBarrier;
+    imageMemoryBarrier.sType                = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    imageMemoryBarrier.pNext                = nullptr;
+    imageMemoryBarrier.srcAccessMask        = VK_ACCESS_TRANSFER_WRITE_BIT;
+    imageMemoryBarrier.dstAccessMask        = 0;
+    imageMemoryBarrier.oldLayout            = mVkImageLayout;
+    imageMemoryBarrier.newLayout            = newImageLayout;
+    imageMemoryBarrier.srcQueueFamilyIndex  = srcQueueFamily;
+    imageMemoryBarrier.dstQueueFamilyIndex  = dstQueueFamily;
+    imageMemoryBarrier.image                = mVkImage;
+    imageMemoryBarrier.subresourceRange     = mVkImageSubresourceRange;
+
+    vkCmdPipelineBarrier(*releaseCmdBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                         0, 0, nullptr, 0, nullptr, 1, &imageMemoryBarrier);
+
+    // the acquire follows the semaphore wait of its submission, which covers all commands
+    imageMemoryBarrier.srcAccessMask        = 0;
+    imageMemoryBarrier.dstAccessMask        = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+
+    vkCmdPipelineBarrier(*acquireCmdBuffer, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                         0, 0, nullptr, 0, nullptr, 1, &imageMemoryBarrier);
+
+    mVkImageLayout = newImageLayout;
+}
+
+VkFormatFeatureFlags
+Image::GetRequiredFormatFeatures(void) const
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    VkFormatFeatureFlags features = 0;
+    if(mVkImageUsage & VK_IMAGE_USAGE_SAMPLED_BIT) {
+        features |= VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT;
+    }
+    if(mVkImageUsage & VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT) {
+        features |= VK_FORMAT_FEATURE_COLOR_ATTACHMENT_BIT;
+    }
+    if(mVkImageUsage & VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT) {
+        features |= VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT;
+    }
+
+    return features;
+}
+
+bool
+Image::IsFormatSupported(VkFormat format, VkImageTiling tiling) const
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    //Check if the selected vkformat supports VK_FORMAT_FEATURE_COLOR_ATTACHMENT_BIT
     VkFormatProperties formatDeviceProps;
-    vkGetPhysicalDeviceFormatProperties(mVkContext->vkGpus[0], format, &formatDeviceProps);
+    vkGetPhysicalDeviceFormatProperties(mVkContext->vkGpu, format, &formatDeviceProps);
 
-    switch(mVkImageTiling) {
-    case VK_IMAGE_TILING_OPTIMAL:
-        if(formatDeviceProps.optimalTilingFeatures & VK_FORMAT_FEATURE_COLOR_ATTACHMENT_BIT) {
-            return format;
-        }
-        break;
+    const VkFormatFeatureFlags required = GetRequiredFormatFeatures();
 
-    case VK_IMAGE_TILING_LINEAR:
-        if(formatDeviceProps.linearTilingFeatures & VK_FORMAT_FEATURE_COLOR_ATTACHMENT_BIT) {
-            return format;
-        }
-        break;
+    switch(tiling) {
+    case VK_IMAGE_TILING_OPTIMAL:   return (formatDeviceProps.optimalTilingFeatures & required) == required;
+    case VK_IMAGE_TILING_LINEAR:    return (formatDeviceProps.linearTilingFeatures  & required) == required;
+    default: { NOT_REACHED();       return false; }
+    }
+}
 
-    default:
-        NOT_REACHED();
-        break;
+VkFormat
+Image::FindSupportedVkColorFormat(VkFormat format)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    /// Check the selected vkformat only against the features of the usage
+    /// the image is created with, so that sample-only formats are kept for
+    /// textures that are never rendered to
+    if(IsFormatSupported(format, mVkImageTiling)) {
+        return format;
     }
+
+    /// the tiling is selected afterwards for the returned format
+    if(IsFormatSupported(format, VK_IMAGE_TILING_OPTIMAL)) {
+        return format;
+    }
+
     return VK_FORMAT_R8G8B8A8_UNORM;
 }
 
@@ -30,6 +30,8 @@
 #define TEXTURE_2D_LAYERS         1
 #define TEXTURE_CUBE_MAP_LAYERS   6
 
+class CacheManager;
+
 namespace vulkanAPI {
 
 class Image {
@@ -90,9 +92,12 @@ public:
 // Modify Functions
     void                              ModifyImageSubresourceRange(uint32_t baseMipLevel, uint32_t levelCount, uint32_t baseArrayLayer, uint32_t layerCount);
     void                              ModifyImageLayout(VkCommandBuffer *activeCmdBuffer, VkImageLayout newImageLayout);
+    void                              TransferQueueFamilyOwnership(VkCommandBuffer *releaseCmdBuffer, VkCommandBuffer *acquireCmdBuffer, VkImageLayout newImageLayout,
+                                                                   uint32_t srcQueueFamily, uint32_t dstQueueFamily);
 
 // Release Functions
     void                              Release(void);
+    void                              Release(CacheManager *cacheManager);
 
 // Get Functions
     inline VkImage &                  GetImage(void)                            { FUN_ENTRY(GL_LOG_TRACE); return mVkImage;          }
@@ -103,6 +108,8 @@ public:
     inline VkImageSubresourceRange    GetImageSubresourceRange(void)      const { FUN_ENTRY(GL_LOG_TRACE); return mVkImageSubresourceRange; }
     inline uint32_t                   GetMipLevels(void)                  const { FUN_ENTRY(GL_LOG_TRACE); return mMipLevels;        }
     inline uint32_t                   GetLayers(void)                     const { FUN_ENTRY(GL_LOG_TRACE); return mLayers;           }
+    inline VkImageUsageFlagBits       GetImageUsage(void)                 const { FUN_ENTRY(GL_LOG_TRACE); return mVkImageUsage;     }
+           VkFormatFeatureFlags       GetRequiredFormatFeatures(void)     const;
 
 // Set Functions
     inline void                       SetContext(const vkContext_t *vkContext)  { FUN_ENTRY(GL_LOG_TRACE); mVkContext     = vkContext; }
@@ -120,6 +127,7 @@ public:
     inline void                       SetMipLevels(uint32_t levels)             { FUN_ENTRY(GL_LOG_TRACE); mMipLevels     = levels;    }
 
 // Find Functions
+    bool                              IsFormatSupported(VkFormat format, VkImageTiling tiling) const;
     VkFormat                          FindSupportedVkColorFormat(VkFormat format);
 };
 
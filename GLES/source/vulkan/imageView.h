@@ -26,6 +26,8 @@
 
 #include "image.h"
 
+class CacheManager;
+
 namespace vulkanAPI {
 
 class ImageView {
@@ -36,6 +38,7 @@ private:
     vkContext_t *                     mVkContext;
 
     VkImageView                       mVkImageView;
+    VkComponentMapping                mVkComponentMapping;
 
 public:
 // Constructor
@@ -49,12 +52,15 @@ public:
 
 // Release Functions
     void                              Release(void);
+    void                              Release(CacheManager *cacheManager);
 
 // Get Functions
     inline VkImageView                GetImageView(void)                  const { FUN_ENTRY(GL_LOG_TRACE); return mVkImageView; }
 
 // Set Functions
     inline void                       SetContext(const vkContext_t *vkContext)  { FUN_ENTRY(GL_LOG_TRACE); mVkContext = vkContext; }
+    inline void                       SetComponentMapping(VkComponentMapping mapping)
+                                                                                { FUN_ENTRY(GL_LOG_TRACE); mVkComponentMapping = mapping; }
 };
 
 }
@@ -29,6 +29,7 @@
  */
 
 #include "memory.h"
+#include "utils/cacheManager.h"
 
 namespace vulkanAPI {
 
@@ -56,6 +57,19 @@ Memory::Release(void)
     }
 }
 
+void
+Memory::Release(CacheManager *cacheManager)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    if(mVkMemory != VK_NULL_HANDLE) {
+        cacheManager->CacheVkDeviceMemory(mVkMemory);
+        mVkMemory = VK_NULL_HANDLE;
+    }
+
+    Release();
+}
+
 bool
 Memory::GetData(VkDeviceSize size, VkDeviceSize offset, void *data) const
 {
@@ -104,6 +118,26 @@ Memory::SetData(VkDeviceSize size, VkDeviceSize offset, const void *data)
     return (err != VK_ERROR_OUT_OF_HOST_MEMORY && err != VK_ERROR_OUT_OF_DEVICE_MEMORY);
 }
 
+void *
+Memory::Map(VkDeviceSize size, VkDeviceSize offset)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    void *pData = nullptr;
+    VkResult err = vkMapMemory(mVkContext->vkDevice, mVkMemory, offset, size, 0, &pData);
+    assert(!err);
+
+    return (err == VK_SUCCESS) ? pData : nullptr;
+}
+
+void
+Memory::Unmap(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    vkUnmapMemory(mVkContext->vkDevice, mVkMemory);
+}
+
 bool
 Memory::GetBufferMemoryRequirements(VkBuffer &buffer)
 {
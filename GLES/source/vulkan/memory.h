@@ -28,6 +28,8 @@
 #include "utils.h"
 #include "context.h"
 
+class CacheManager;
+
 namespace vulkanAPI {
 
 class Memory {
@@ -55,6 +57,7 @@ public:
 
 // Release Functions
     void                              Release(void);
+    void                              Release(CacheManager *cacheManager);
 
 // Bind Functions
     bool                              BindBufferMemory(VkBuffer &buffer);
@@ -70,6 +73,10 @@ public:
     bool                              SetData(VkDeviceSize size, VkDeviceSize offset, const void *data);
     void                              UpdateData(VkDeviceSize size, VkDeviceSize offset, const void *data);
 
+// Map Functions
+    void *                            Map(VkDeviceSize size, VkDeviceSize offset);
+    void                              Unmap(void);
+
     inline void                       SetContext(const vkContext_t *vkContext)  { FUN_ENTRY(GL_LOG_TRACE); mVkContext = vkContext; }
 };
 
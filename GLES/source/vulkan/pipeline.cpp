@@ -31,7 +31,7 @@
 namespace vulkanAPI {
 
 Pipeline::Pipeline(const vkContext_t *vkContext)
-: mVkContext(vkContext), mVkPipeline(VK_NULL_HANDLE), mVkPipelineLayout(VK_NULL_HANDLE),
+: mVkContext(vkContext), mVkPipeline(VK_NULL_HANDLE), mVkPipelineOwned(true), mVkPipelineLayout(VK_NULL_HANDLE),
   mVkPipelineCache(VK_NULL_HANDLE), mVkPipelineVertexInputState(VK_NULL_HANDLE),
   mVkPipelineShaderStageCount(0), mCacheManager(nullptr)
 {
@@ -78,10 +78,11 @@ Pipeline::MoveToCache()
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    if(mVkPipeline != VK_NULL_HANDLE) {
+    if(mVkPipeline != VK_NULL_HANDLE && mVkPipelineOwned) {
         mCacheManager->CacheVkPipelineObject(mVkPipeline);
-        mVkPipeline = VK_NULL_HANDLE;
     }
+    mVkPipeline      = VK_NULL_HANDLE;
+    mVkPipelineOwned = true;
 }
 
 void
@@ -89,10 +90,11 @@ Pipeline::Release()
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    if(mVkPipeline != VK_NULL_HANDLE) {
+    if(mVkPipeline != VK_NULL_HANDLE && mVkPipelineOwned) {
         vkDestroyPipeline(mVkContext->vkDevice, mVkPipeline, nullptr);
-        mVkPipeline = VK_NULL_HANDLE;
     }
+    mVkPipeline      = VK_NULL_HANDLE;
+    mVkPipelineOwned = true;
 }
 
 void
@@ -328,13 +330,16 @@ Pipeline::UpdateDynamicState(const VkCommandBuffer *CmdBuffer, float lineWidth)
     if(mEnabledDynamicStatesList[VK_DYNAMIC_STATE_LINE_WIDTH]) {
         vkCmdSetLineWidth (*CmdBuffer, lineWidth);
     }
+    if(mEnabledDynamicStatesList[VK_DYNAMIC_STATE_STENCIL_REFERENCE]) {
+        vkCmdSetStencilReference(*CmdBuffer, VK_STENCIL_FACE_FRONT_BIT, mVkPipelineDepthStencilState.front.reference);
+        vkCmdSetStencilReference(*CmdBuffer, VK_STENCIL_FACE_BACK_BIT , mVkPipelineDepthStencilState.back.reference);
+    }
     /*
     TODO:: fill the remaining dynamic states
     VK_DYNAMIC_STATE_BLEND_CONSTANTS
     VK_DYNAMIC_STATE_DEPTH_BOUNDS
     VK_DYNAMIC_STATE_STENCIL_COMPARE_MASK
     VK_DYNAMIC_STATE_STENCIL_WRITE_MASK
-    VK_DYNAMIC_STATE_STENCIL_REFERENCE
     */
 }
 
@@ -371,6 +376,79 @@ Pipeline::Create(const VkRenderPass *renderpass)
     return true;
 }
 
+void
+Pipeline::UsePrewarmed(VkPipeline pipeline)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    MoveToCache();
+
+    /// the pipeline belongs to the program that prewarmed it
+    mVkPipeline           = pipeline;
+    mVkPipelineOwned      = false;
+    mUpdateState.Pipeline = false;
+}
+
+void
+Pipeline::GetStateKey(pipelineStateKey_t *key, VkFormat colorFormat, VkFormat depthStencilFormat) const
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    memset(static_cast<void *>(key), 0, sizeof(*key));
+
+    key->colorFormat                = colorFormat;
+    key->depthStencilFormat         = depthStencilFormat;
+
+    key->topology                   = mVkPipelineInputAssemblyState.topology;
+    key->primitiveRestartEnable     = mVkPipelineInputAssemblyState.primitiveRestartEnable;
+
+    key->polygonMode                = mVkPipelineRasterizationState.polygonMode;
+    key->cullMode                   = mVkPipelineRasterizationState.cullMode;
+    key->frontFace                  = mVkPipelineRasterizationState.frontFace;
+    key->depthClampEnable           = mVkPipelineRasterizationState.depthClampEnable;
+    key->rasterizerDiscardEnable    = mVkPipelineRasterizationState.rasterizerDiscardEnable;
+    key->depthBiasEnable            = mVkPipelineRasterizationState.depthBiasEnable;
+    key->depthBiasConstantFactor    = mVkPipelineRasterizationState.depthBiasConstantFactor;
+    key->depthBiasClamp             = mVkPipelineRasterizationState.depthBiasClamp;
+    key->depthBiasSlopeFactor       = mVkPipelineRasterizationState.depthBiasSlopeFactor;
+    key->lineWidth                  = mVkPipelineRasterizationState.lineWidth;
+
+    key->rasterizationSamples       = mVkPipelineMultisampleState.rasterizationSamples;
+    key->sampleShadingEnable        = mVkPipelineMultisampleState.sampleShadingEnable;
+    key->minSampleShading           = mVkPipelineMultisampleState.minSampleShading;
+    key->alphaToCoverageEnable      = mVkPipelineMultisampleState.alphaToCoverageEnable;
+    key->alphaToOneEnable           = mVkPipelineMultisampleState.alphaToOneEnable;
+
+    key->logicOpEnable              = mVkPipelineColorBlendState.logicOpEnable;
+    key->logicOp                    = mVkPipelineColorBlendState.logicOp;
+    key->colorAttachmentCount       = mVkPipelineColorBlendState.attachmentCount;
+    key->colorBlendAttachment       = mVkPipelineColorBlendAttachmentState;
+    memcpy(key->blendConstants, mVkPipelineColorBlendState.blendConstants, sizeof(key->blendConstants));
+
+    key->depthTestEnable            = mVkPipelineDepthStencilState.depthTestEnable;
+    key->depthWriteEnable           = mVkPipelineDepthStencilState.depthWriteEnable;
+    key->depthCompareOp             = mVkPipelineDepthStencilState.depthCompareOp;
+    key->depthBoundsTestEnable      = mVkPipelineDepthStencilState.depthBoundsTestEnable;
+    key->stencilTestEnable          = mVkPipelineDepthStencilState.stencilTestEnable;
+    key->front                      = mVkPipelineDepthStencilState.front;
+    key->back                       = mVkPipelineDepthStencilState.back;
+    key->minDepthBounds             = mVkPipelineDepthStencilState.minDepthBounds;
+    key->maxDepthBounds             = mVkPipelineDepthStencilState.maxDepthBounds;
+
+    key->viewportCount              = mVkPipelineViewportState.viewportCount;
+    key->scissorCount               = mVkPipelineViewportState.scissorCount;
+
+    key->dynamicStateCount          = mVkPipelineDynamicState.dynamicStateCount;
+    memcpy(key->dynamicStates, mVkPipelineDynamicStateEnables, key->dynamicStateCount * sizeof(VkDynamicState));
+
+    if(mVkPipelineVertexInputState) {
+        key->vertexBindingCount     = std::min(mVkPipelineVertexInputState->vertexBindingDescriptionCount,   static_cast<uint32_t>(GLOVE_MAX_VERTEX_ATTRIBS));
+        key->vertexAttributeCount   = std::min(mVkPipelineVertexInputState->vertexAttributeDescriptionCount, static_cast<uint32_t>(GLOVE_MAX_VERTEX_ATTRIBS));
+        memcpy(key->vertexBindings,   mVkPipelineVertexInputState->pVertexBindingDescriptions,   key->vertexBindingCount   * sizeof(VkVertexInputBindingDescription));
+        memcpy(key->vertexAttributes, mVkPipelineVertexInputState->pVertexAttributeDescriptions, key->vertexAttributeCount * sizeof(VkVertexInputAttributeDescription));
+    }
+}
+
 bool
 Pipeline::CreateGraphicsPipeline(void)
 {
@@ -26,9 +26,68 @@
 
 #include "context.h"
 #include "utils/cacheManager.h"
+#include "utils/globals.h"
 
 namespace vulkanAPI {
 
+/// Snapshot of every piece of state that ends up in a VkGraphicsPipelineCreateInfo,
+/// apart from the shader stages and the pipeline layout, which are owned by the program.
+/// It holds no pointers and no padding, so it can be compared, hashed and stored as raw bytes.
+typedef struct pipelineStateKey_t {
+    VkFormat                                    colorFormat;
+    VkFormat                                    depthStencilFormat;
+
+    VkPrimitiveTopology                         topology;
+    VkBool32                                    primitiveRestartEnable;
+
+    VkPolygonMode                               polygonMode;
+    VkCullModeFlags                             cullMode;
+    VkFrontFace                                 frontFace;
+    VkBool32                                    depthClampEnable;
+    VkBool32                                    rasterizerDiscardEnable;
+    VkBool32                                    depthBiasEnable;
+    float                                       depthBiasConstantFactor;
+    float                                       depthBiasClamp;
+    float                                       depthBiasSlopeFactor;
+    float                                       lineWidth;
+
+    VkSampleCountFlagBits                       rasterizationSamples;
+    VkBool32                                    sampleShadingEnable;
+    float                                       minSampleShading;
+    VkBool32                                    alphaToCoverageEnable;
+    VkBool32                                    alphaToOneEnable;
+
+    VkBool32                                    logicOpEnable;
+    VkLogicOp                                   logicOp;
+    uint32_t                                    colorAttachmentCount;
+    VkPipelineColorBlendAttachmentState         colorBlendAttachment;
+    float                                       blendConstants[4];
+
+    VkBool32                                    depthTestEnable;
+    VkBool32                                    depthWriteEnable;
+    VkCompareOp                                 depthCompareOp;
+    VkBool32                                    depthBoundsTestEnable;
+    VkBool32                                    stencilTestEnable;
+    VkStencilOpState                            front;
+    VkStencilOpState                            back;
+    float                                       minDepthBounds;
+    float                                       maxDepthBounds;
+
+    uint32_t                                    viewportCount;
+    uint32_t                                    scissorCount;
+
+    uint32_t                                    dynamicStateCount;
+    VkDynamicState                              dynamicStates[VK_DYNAMIC_STATE_RANGE_SIZE];
+
+    uint32_t                                    vertexBindingCount;
+    uint32_t                                    vertexAttributeCount;
+    VkVertexInputBindingDescription             vertexBindings[GLOVE_MAX_VERTEX_ATTRIBS];
+    VkVertexInputAttributeDescription           vertexAttributes[GLOVE_MAX_VERTEX_ATTRIBS];
+
+    inline bool operator <  (const pipelineStateKey_t &other)             const { return memcmp(this, &other, sizeof(pipelineStateKey_t)) <  0; }
+    inline bool operator == (const pipelineStateKey_t &other)             const { return memcmp(this, &other, sizeof(pipelineStateKey_t)) == 0; }
+} pipelineStateKey_t;
+
 class Pipeline {
 private:
 
@@ -38,6 +97,7 @@ private:
     VkViewport                                  mVkViewport;
     VkRect2D                                    mVkScissorRect;
     VkPipeline                                  mVkPipeline;
+    bool                                        mVkPipelineOwned;
     VkPipelineLayout                            mVkPipelineLayout;
     VkPipelineCache                             mVkPipelineCache;
 
@@ -86,6 +146,9 @@ public:
     inline uint32_t & GetShaderStageCountRef(void)                              { FUN_ENTRY(GL_LOG_TRACE); return mVkPipelineShaderStageCount; }
     inline VkPipelineShaderStageCreateInfo * GetShaderStages(void)              { FUN_ENTRY(GL_LOG_TRACE); return mVkPipelineShaderStages; }
 
+           void GetStateKey(pipelineStateKey_t *key,
+                            VkFormat colorFormat, VkFormat depthStencilFormat) const;
+
     inline bool GetUpdatePipelineState(void)                              const { FUN_ENTRY(GL_LOG_TRACE); return mUpdateState.Pipeline; }
     inline bool GetUpdateViewportState(void)                              const { FUN_ENTRY(GL_LOG_TRACE); return mUpdateState.Viewport; }
     inline bool GetUpdateVertexAttribVBOs(void)                           const { FUN_ENTRY(GL_LOG_TRACE); return mUpdateState.VertexAttribVBOs; }
@@ -185,6 +248,9 @@ public:
 
 // Create Functions
           bool Create(const VkRenderPass *renderpass);
+          void UsePrewarmed(VkPipeline pipeline);
+    /// hands the current VkPipeline over to the caller, which becomes responsible for destroying it
+    inline VkPipeline DetachPipeline(void)                                      { FUN_ENTRY(GL_LOG_TRACE); mVkPipelineOwned = false; return mVkPipeline; }
 // Update Functions
           void UpdateDynamicState(const VkCommandBuffer *CmdBuffer, float lineWidth) const;
 };
@@ -53,12 +53,36 @@ PipelineCache::Release(void)
 bool
 PipelineCache::GetData(void* data, size_t* size) const
 {
+    // a shared cache may grow between the size query and the actual read
     VkResult err = vkGetPipelineCacheData(mVkContext->vkDevice, mVkPipelineCache, size, data);
-    assert(!err);
+    assert(!err || err == VK_INCOMPLETE);
 
     return (err != VK_ERROR_OUT_OF_HOST_MEMORY && err != VK_ERROR_OUT_OF_DEVICE_MEMORY);
 }
 
+bool
+PipelineCache::IsCompatible(const void *data, size_t size) const
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    // VkPipelineCacheHeaderVersionOne: headerSize, headerVersion, vendorID, deviceID, pipelineCacheUUID
+    const size_t headerSize = 4 * sizeof(uint32_t) + VK_UUID_SIZE;
+    if(data == nullptr || size < headerSize) {
+        return false;
+    }
+
+    uint32_t header[4];
+    memcpy(header, data, sizeof(header));
+    const uint8_t *uuid = static_cast<const uint8_t *>(data) + sizeof(header);
+
+    return header[0] >= headerSize                                      &&
+           header[0] <= size                                            &&
+           header[1] == VK_PIPELINE_CACHE_HEADER_VERSION_ONE            &&
+           header[2] == mVkContext->vkDeviceProperties.vendorID         &&
+           header[3] == mVkContext->vkDeviceProperties.deviceID         &&
+           !memcmp(uuid, mVkContext->vkDeviceProperties.pipelineCacheUUID, VK_UUID_SIZE);
+}
+
 bool
 PipelineCache::Create(const void *data, size_t size)
 {
@@ -66,6 +90,12 @@ PipelineCache::Create(const void *data, size_t size)
 
     Release();
 
+    // data produced by a different driver or device is silently discarded
+    if(!IsCompatible(data, size)) {
+        data = nullptr;
+        size = 0;
+    }
+
     VkPipelineCacheCreateInfo info;
     info.sType           = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
     info.pNext           = nullptr;
@@ -79,4 +109,58 @@ PipelineCache::Create(const void *data, size_t size)
     return (err != VK_ERROR_OUT_OF_HOST_MEMORY && err != VK_ERROR_OUT_OF_DEVICE_MEMORY);
 }
 
+bool
+PipelineCache::CreateFromFile(const char *filename)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    std::vector<uint8_t> data;
+
+    FILE *fp = (filename && filename[0]) ? fopen(filename, "rb") : nullptr;
+    if(fp) {
+        if(!fseek(fp, 0, SEEK_END)) {
+            long size = ftell(fp);
+            if(size > 0 && !fseek(fp, 0, SEEK_SET)) {
+                data.resize(static_cast<size_t>(size));
+                if(fread(data.data(), 1, data.size(), fp) != data.size()) {
+                    data.clear();
+                }
+            }
+        }
+        fclose(fp);
+    }
+
+    return Create(data.empty() ? nullptr : data.data(), data.size());
+}
+
+bool
+PipelineCache::SaveToFile(const char *filename) const
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    if(mVkPipelineCache == VK_NULL_HANDLE || filename == nullptr || !filename[0]) {
+        return false;
+    }
+
+    size_t size = 0;
+    if(!GetData(nullptr, &size) || !size) {
+        return false;
+    }
+
+    std::vector<uint8_t> data(size);
+    if(!GetData(data.data(), &size)) {
+        return false;
+    }
+
+    FILE *fp = fopen(filename, "wb");
+    if(!fp) {
+        return false;
+    }
+
+    bool written = (fwrite(data.data(), 1, size, fp) == size);
+    fclose(fp);
+
+    return written;
+}
+
 }
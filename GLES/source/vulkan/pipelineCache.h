@@ -38,6 +38,8 @@ private:
 
     VkPipelineCache                   mVkPipelineCache;
 
+    bool                              IsCompatible(const void *data, size_t size) const;
+
 public:
 // Constructor
     PipelineCache(const vkContext_t *vkContext = nullptr);
@@ -47,11 +49,13 @@ public:
 
 // Create Functions
     bool                              Create(const void *data, size_t size);
+    bool                              CreateFromFile(const char *filename);
 
 // Release Functions
     void                              Release(void);
 
-// Release Functions
+// Save Functions
+    bool                              SaveToFile(const char *filename)    const;
 
 // Get Functions
            bool                       GetData(void* data, size_t* size)   const;
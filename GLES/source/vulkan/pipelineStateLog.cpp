@@ -0,0 +1,167 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+/**
+ *  @file       pipelineStateLog.cpp
+ *  @author     Think Silicon
+ *  @date       18/10/2026
+ *  @version    1.0
+ *
+ *  @brief      Records the pipeline state keys created for each program (identified
+ *              by the hash of its SPIR-V) and stores them to a file, so that a later
+ *              run can build the same pipelines before they are first drawn with.
+ *
+ */
+
+#include <algorithm>
+#include "pipelineStateLog.h"
+
+namespace vulkanAPI {
+
+#define GLOVE_PIPELINE_STATE_LOG_MAGIC                  0x4C535047  // "GPSL"
+#define GLOVE_PIPELINE_STATE_LOG_VERSION                1
+/// Bounds the log for programs whose baked state (e.g. blend color) changes every frame
+#define GLOVE_PIPELINE_STATE_LOG_MAX_STATES             64
+
+typedef struct pipelineStateLogHeader_t {
+    uint32_t                          magic;
+    uint32_t                          version;
+    uint32_t                          keySize;
+    uint32_t                          recordCount;
+} pipelineStateLogHeader_t;
+
+typedef struct pipelineStateLogRecord_t {
+    uint64_t                          programHash;
+    pipelineStateKey_t                key;
+} pipelineStateLogRecord_t;
+
+PipelineStateLog::PipelineStateLog()
+: mUpdated(false)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+}
+
+PipelineStateLog::~PipelineStateLog()
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+}
+
+bool
+PipelineStateLog::LoadFromFile(const char *filename)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    FILE *fp = (filename && filename[0]) ? fopen(filename, "rb") : nullptr;
+    if(!fp) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    pipelineStateLogHeader_t header;
+    bool valid = fread(&header, sizeof(header), 1, fp) == 1                 &&
+                 header.magic   == GLOVE_PIPELINE_STATE_LOG_MAGIC           &&
+                 header.version == GLOVE_PIPELINE_STATE_LOG_VERSION         &&
+                 header.keySize == sizeof(pipelineStateKey_t);
+
+    pipelineStateLogRecord_t record;
+    for(uint32_t i = 0; valid && i < header.recordCount; ++i) {
+        if(fread(&record, sizeof(record), 1, fp) != 1) {
+            valid = false;
+            break;
+        }
+        mProgramStates[record.programHash].push_back(record.key);
+    }
+    fclose(fp);
+
+    if(!valid) {
+        mProgramStates.clear();
+    }
+    mUpdated = false;
+
+    return valid;
+}
+
+bool
+PipelineStateLog::SaveToFile(const char *filename) const
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    if(!mUpdated || filename == nullptr || !filename[0]) {
+        return false;
+    }
+
+    FILE *fp = fopen(filename, "wb");
+    if(!fp) {
+        return false;
+    }
+
+    pipelineStateLogHeader_t header;
+    header.magic       = GLOVE_PIPELINE_STATE_LOG_MAGIC;
+    header.version     = GLOVE_PIPELINE_STATE_LOG_VERSION;
+    header.keySize     = sizeof(pipelineStateKey_t);
+    header.recordCount = 0;
+    for(const auto &states : mProgramStates) {
+        header.recordCount += static_cast<uint32_t>(states.second.size());
+    }
+
+    bool written = fwrite(&header, sizeof(header), 1, fp) == 1;
+
+    pipelineStateLogRecord_t record;
+    for(const auto &states : mProgramStates) {
+        record.programHash = states.first;
+        for(const auto &key : states.second) {
+            record.key = key;
+            written = written && fwrite(&record, sizeof(record), 1, fp) == 1;
+        }
+    }
+    fclose(fp);
+
+    return written;
+}
+
+void
+PipelineStateLog::Record(uint64_t programHash, const pipelineStateKey_t *key)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    std::vector<pipelineStateKey_t> &states = mProgramStates[programHash];
+    if(states.size() >= GLOVE_PIPELINE_STATE_LOG_MAX_STATES ||
+       std::find(states.begin(), states.end(), *key) != states.end()) {
+        return;
+    }
+
+    states.push_back(*key);
+    mUpdated = true;
+}
+
+void
+PipelineStateLog::GetStates(uint64_t programHash, std::vector<pipelineStateKey_t> *keys) const
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    keys->clear();
+
+    programStates_t::const_iterator it = mProgramStates.find(programHash);
+    if(it != mProgramStates.end()) {
+        *keys = it->second;
+    }
+}
+
+}
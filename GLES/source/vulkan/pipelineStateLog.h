@@ -0,0 +1,63 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+/**
+ *  @file       pipelineStateLog.h
+ *  @author     Think Silicon
+ *  @date       18/10/2026
+ *  @version    1.0
+ *
+ *  @brief      Log of the pipeline states used by each program, replayed on later runs to prewarm pipelines
+ *
+ */
+
+#ifndef __VKPIPELINESTATELOG_H__
+#define __VKPIPELINESTATELOG_H__
+
+#include <mutex>
+#include "pipeline.h"
+
+namespace vulkanAPI {
+
+class PipelineStateLog {
+
+private:
+
+    typedef std::map<uint64_t, std::vector<pipelineStateKey_t>> programStates_t;
+
+    mutable
+    std::mutex                        mMutex;
+    programStates_t                   mProgramStates;
+    bool                              mUpdated;
+
+public:
+// Constructor
+    PipelineStateLog();
+
+// Destructor
+    ~PipelineStateLog();
+
+// Load/Save Functions
+    bool                              LoadFromFile(const char *filename);
+    bool                              SaveToFile(const char *filename)                                  const;
+
+// Record Functions
+    void                              Record(uint64_t programHash, const pipelineStateKey_t *key);
+
+// Get Functions
+    void                              GetStates(uint64_t programHash, std::vector<pipelineStateKey_t> *keys) const;
+};
+
+}
+
+#endif // __VKPIPELINESTATELOG_H__
@@ -0,0 +1,290 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+/**
+ *  @file       pipelineWarmup.cpp
+ *  @author     Think Silicon
+ *  @date       18/10/2026
+ *  @version    1.0
+ *
+ *  @brief      Builds the pipelines logged for a program on a worker thread, right
+ *              after it is linked. The resulting pipelines populate the device-wide
+ *              pipeline cache and are kept by the program, so that the first draw with
+ *              a logged state binds a ready pipeline instead of compiling one.
+ *
+ */
+
+#include "pipelineWarmup.h"
+#include "pipelineCache.h"
+#include "renderPass.h"
+
+namespace vulkanAPI {
+
+PipelineWarmup::PipelineWarmup(const vkContext_t *vkContext)
+: mVkContext(vkContext), mStop(false)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+}
+
+PipelineWarmup::~PipelineWarmup()
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    /// the owner hands the prewarmed pipelines over to its cache manager before, see Release()
+    Stop();
+    assert(mPipelines.empty());
+}
+
+bool
+PipelineWarmup::Start(const std::vector<pipelineStateKey_t> &keys, VkPipelineLayout layout,
+                      const std::vector<uint32_t> &vsSpirv, const std::vector<uint32_t> &fsSpirv)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    assert(!mThread.joinable());
+
+    if(keys.empty() || layout == VK_NULL_HANDLE || vsSpirv.empty() || fsSpirv.empty()) {
+        return false;
+    }
+
+    /// the worker owns copies of the SPIR-V, so the shaders may be recompiled meanwhile
+    mStop   = false;
+    mThread = std::thread(&PipelineWarmup::Run, this, keys, layout, vsSpirv, fsSpirv);
+
+    return true;
+}
+
+void
+PipelineWarmup::Stop(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    if(mThread.joinable()) {
+        mStop = true;
+        mThread.join();
+    }
+}
+
+void
+PipelineWarmup::Release(CacheManager *cacheManager)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    Stop();
+
+    /// prewarmed pipelines may still be referenced by submitted command buffers,
+    /// so they are only destroyed once the cache manager retires them
+    assert(cacheManager || mPipelines.empty());
+    if(cacheManager) {
+        for(auto &pipeline : mPipelines) {
+            cacheManager->CacheVkPipelineObject(pipeline.second);
+        }
+    }
+    mPipelines.clear();
+}
+
+VkPipeline
+PipelineWarmup::GetPipeline(const pipelineStateKey_t *key)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    pipelines_t::const_iterator it = mPipelines.find(*key);
+
+    return it != mPipelines.end() ? it->second : VK_NULL_HANDLE;
+}
+
+VkShaderModule
+PipelineWarmup::CreateShaderModule(const std::vector<uint32_t> &spirv) const
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    VkShaderModuleCreateInfo moduleCreateInfo;
+    moduleCreateInfo.sType    = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+    moduleCreateInfo.pNext    = nullptr;
+    moduleCreateInfo.flags    = 0;
+    moduleCreateInfo.codeSize = spirv.size() * sizeof(uint32_t);
+    moduleCreateInfo.pCode    = spirv.data();
+
+    VkShaderModule module = VK_NULL_HANDLE;
+    if(vkCreateShaderModule(mVkContext->vkDevice, &moduleCreateInfo, nullptr, &module)) {
+        return VK_NULL_HANDLE;
+    }
+
+    return module;
+}
+
+VkPipeline
+PipelineWarmup::CreatePipeline(const pipelineStateKey_t *key, VkPipelineLayout layout,
+                               const VkPipelineShaderStageCreateInfo *stages, RenderPass *renderPass) const
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    VkPipelineVertexInputStateCreateInfo vertexInputState;
+    memset(static_cast<void *>(&vertexInputState), 0, sizeof(vertexInputState));
+    vertexInputState.sType                              = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+    vertexInputState.vertexBindingDescriptionCount      = key->vertexBindingCount;
+    vertexInputState.pVertexBindingDescriptions         = key->vertexBindings;
+    vertexInputState.vertexAttributeDescriptionCount    = key->vertexAttributeCount;
+    vertexInputState.pVertexAttributeDescriptions       = key->vertexAttributes;
+
+    VkPipelineInputAssemblyStateCreateInfo inputAssemblyState;
+    memset(static_cast<void *>(&inputAssemblyState), 0, sizeof(inputAssemblyState));
+    inputAssemblyState.sType                            = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+    inputAssemblyState.topology                         = key->topology;
+    inputAssemblyState.primitiveRestartEnable           = key->primitiveRestartEnable;
+
+    VkPipelineRasterizationStateCreateInfo rasterizationState;
+    memset(static_cast<void *>(&rasterizationState), 0, sizeof(rasterizationState));
+    rasterizationState.sType                            = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+    rasterizationState.polygonMode                      = key->polygonMode;
+    rasterizationState.cullMode                         = key->cullMode;
+    rasterizationState.frontFace                        = key->frontFace;
+    rasterizationState.depthClampEnable                 = key->depthClampEnable;
+    rasterizationState.rasterizerDiscardEnable          = key->rasterizerDiscardEnable;
+    rasterizationState.depthBiasEnable                  = key->depthBiasEnable;
+    rasterizationState.depthBiasConstantFactor          = key->depthBiasConstantFactor;
+    rasterizationState.depthBiasClamp                   = key->depthBiasClamp;
+    rasterizationState.depthBiasSlopeFactor             = key->depthBiasSlopeFactor;
+    rasterizationState.lineWidth                        = key->lineWidth;
+
+    VkPipelineMultisampleStateCreateInfo multisampleState;
+    memset(static_cast<void *>(&multisampleState), 0, sizeof(multisampleState));
+    multisampleState.sType                              = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+    multisampleState.rasterizationSamples               = key->rasterizationSamples;
+    multisampleState.sampleShadingEnable                = key->sampleShadingEnable;
+    multisampleState.minSampleShading                   = key->minSampleShading;
+    multisampleState.alphaToCoverageEnable              = key->alphaToCoverageEnable;
+    multisampleState.alphaToOneEnable                   = key->alphaToOneEnable;
+
+    VkPipelineColorBlendStateCreateInfo colorBlendState;
+    memset(static_cast<void *>(&colorBlendState), 0, sizeof(colorBlendState));
+    colorBlendState.sType                               = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+    colorBlendState.logicOpEnable                       = key->logicOpEnable;
+    colorBlendState.logicOp                             = key->logicOp;
+    colorBlendState.attachmentCount                     = key->colorAttachmentCount;
+    colorBlendState.pAttachments                        = &key->colorBlendAttachment;
+    memcpy(colorBlendState.blendConstants, key->blendConstants, sizeof(colorBlendState.blendConstants));
+
+    VkPipelineDepthStencilStateCreateInfo depthStencilState;
+    memset(static_cast<void *>(&depthStencilState), 0, sizeof(depthStencilState));
+    depthStencilState.sType                             = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+    depthStencilState.depthTestEnable                   = key->depthTestEnable;
+    depthStencilState.depthWriteEnable                  = key->depthWriteEnable;
+    depthStencilState.depthCompareOp                    = key->depthCompareOp;
+    depthStencilState.depthBoundsTestEnable             = key->depthBoundsTestEnable;
+    depthStencilState.stencilTestEnable                 = key->stencilTestEnable;
+    depthStencilState.front                             = key->front;
+    depthStencilState.back                              = key->back;
+    depthStencilState.minDepthBounds                    = key->minDepthBounds;
+    depthStencilState.maxDepthBounds                    = key->maxDepthBounds;
+
+    VkPipelineViewportStateCreateInfo viewportState;
+    memset(static_cast<void *>(&viewportState), 0, sizeof(viewportState));
+    viewportState.sType                                 = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+    viewportState.viewportCount                         = key->viewportCount;
+    viewportState.scissorCount                          = key->scissorCount;
+
+    VkPipelineDynamicStateCreateInfo dynamicState;
+    memset(static_cast<void *>(&dynamicState), 0, sizeof(dynamicState));
+    dynamicState.sType                                  = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+    dynamicState.dynamicStateCount                      = key->dynamicStateCount;
+    dynamicState.pDynamicStates                         = key->dynamicStates;
+
+    VkGraphicsPipelineCreateInfo info;
+    memset(static_cast<void *>(&info), 0, sizeof(info));
+    info.sType                                          = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    info.stageCount                                     = 2;
+    info.pStages                                        = stages;
+    info.pVertexInputState                              = &vertexInputState;
+    info.pInputAssemblyState                            = &inputAssemblyState;
+    info.pViewportState                                 = &viewportState;
+    info.pRasterizationState                            = &rasterizationState;
+    info.pMultisampleState                              = &multisampleState;
+    info.pDepthStencilState                             = &depthStencilState;
+    info.pColorBlendState                               = &colorBlendState;
+    info.pDynamicState                                  = &dynamicState;
+    info.layout                                         = layout;
+    info.renderPass                                     = *renderPass->GetRenderPass();
+    info.subpass                                        = 0;
+    info.basePipelineHandle                             = VK_NULL_HANDLE;
+    info.basePipelineIndex                              = -1;
+
+    VkPipelineCache cache = mVkContext->vkPipelineCache ? mVkContext->vkPipelineCache->GetPipelineCache() : VK_NULL_HANDLE;
+
+    VkPipeline pipeline = VK_NULL_HANDLE;
+    if(vkCreateGraphicsPipelines(mVkContext->vkDevice, cache, 1, &info, nullptr, &pipeline) != VK_SUCCESS) {
+        return VK_NULL_HANDLE;
+    }
+
+    return pipeline;
+}
+
+void
+PipelineWarmup::Run(std::vector<pipelineStateKey_t> keys, VkPipelineLayout layout,
+                    std::vector<uint32_t> vsSpirv, std::vector<uint32_t> fsSpirv)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    VkPipelineShaderStageCreateInfo stages[2];
+    memset(static_cast<void *>(stages), 0, sizeof(stages));
+    stages[0].sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    stages[0].stage  = VK_SHADER_STAGE_VERTEX_BIT;
+    stages[0].module = CreateShaderModule(vsSpirv);
+    stages[0].pName  = "main\0";
+    stages[1].sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    stages[1].stage  = VK_SHADER_STAGE_FRAGMENT_BIT;
+    stages[1].module = CreateShaderModule(fsSpirv);
+    stages[1].pName  = "main\0";
+
+    /// pipelines only need a render pass compatible with the one they will be used
+    /// in, which is any render pass with the same attachment formats
+    std::map<std::pair<VkFormat, VkFormat>, RenderPass *> renderPasses;
+
+    for(size_t i = 0; i < keys.size() && !mStop; ++i) {
+        if(stages[0].module == VK_NULL_HANDLE || stages[1].module == VK_NULL_HANDLE) {
+            break;
+        }
+
+        const pipelineStateKey_t *key = &keys[i];
+
+        RenderPass *&renderPass = renderPasses[std::make_pair(key->colorFormat, key->depthStencilFormat)];
+        if(!renderPass) {
+            renderPass = new RenderPass(mVkContext);
+            renderPass->Create(key->colorFormat, key->depthStencilFormat);
+        }
+
+        VkPipeline pipeline = CreatePipeline(key, layout, stages, renderPass);
+        if(pipeline == VK_NULL_HANDLE) {
+            continue;
+        }
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        if(!mPipelines.insert(std::make_pair(*key, pipeline)).second) {
+            vkDestroyPipeline(mVkContext->vkDevice, pipeline, nullptr);
+        }
+    }
+
+    for(auto &renderPass : renderPasses) {
+        delete renderPass.second;
+    }
+
+    for(uint32_t i = 0; i < 2; ++i) {
+        if(stages[i].module != VK_NULL_HANDLE) {
+            vkDestroyShaderModule(mVkContext->vkDevice, stages[i].module, nullptr);
+        }
+    }
+}
+
+}
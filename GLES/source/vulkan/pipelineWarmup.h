@@ -0,0 +1,80 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+/**
+ *  @file       pipelineWarmup.h
+ *  @author     Think Silicon
+ *  @date       18/10/2026
+ *  @version    1.0
+ *
+ *  @brief      Background creation of the logged pipelines of a program
+ *
+ */
+
+#ifndef __VKPIPELINEWARMUP_H__
+#define __VKPIPELINEWARMUP_H__
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include "pipeline.h"
+
+namespace vulkanAPI {
+
+class RenderPass;
+
+class PipelineWarmup {
+
+private:
+
+    typedef std::map<pipelineStateKey_t, VkPipeline> pipelines_t;
+
+    const
+    vkContext_t *                     mVkContext;
+
+    std::thread                       mThread;
+    std::atomic<bool>                 mStop;
+    std::mutex                        mMutex;
+    pipelines_t                       mPipelines;
+
+    void                              Stop(void);
+    void                              Run(std::vector<pipelineStateKey_t> keys, VkPipelineLayout layout,
+                                          std::vector<uint32_t> vsSpirv, std::vector<uint32_t> fsSpirv);
+    VkPipeline                        CreatePipeline(const pipelineStateKey_t *key, VkPipelineLayout layout,
+                                                     const VkPipelineShaderStageCreateInfo *stages, RenderPass *renderPass) const;
+    VkShaderModule                    CreateShaderModule(const std::vector<uint32_t> &spirv) const;
+
+public:
+// Constructor
+    PipelineWarmup(const vkContext_t *vkContext = nullptr);
+
+// Destructor
+    ~PipelineWarmup();
+
+// Start Functions
+    bool                              Start(const std::vector<pipelineStateKey_t> &keys, VkPipelineLayout layout,
+                                            const std::vector<uint32_t> &vsSpirv, const std::vector<uint32_t> &fsSpirv);
+
+// Release Functions
+    void                              Release(CacheManager *cacheManager);
+
+// Get Functions
+    VkPipeline                        GetPipeline(const pipelineStateKey_t *key);
+
+// Set Functions
+    inline void                       SetContext(const vkContext_t *vkContext)  { FUN_ENTRY(GL_LOG_TRACE); mVkContext = vkContext; }
+};
+
+}
+
+#endif // __VKPIPELINEWARMUP_H__
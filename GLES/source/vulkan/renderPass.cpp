@@ -29,17 +29,22 @@
  */
 
 #include "renderPass.h"
+#include "renderPassCache.h"
 #include "utils.h"
 
 namespace vulkanAPI {
 
 RenderPass::RenderPass(const vkContext_t *vkContext)
 : mVkContext(vkContext),
-  mVkPipelineBindPoint(VK_PIPELINE_BIND_POINT_GRAPHICS),
   mVkRenderPass(VK_NULL_HANDLE),
+  mColorFormat(VK_FORMAT_UNDEFINED), mDepthStencilFormat(VK_FORMAT_UNDEFINED),
+  mColorInitialLayout(VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL), mColorFinalLayout(VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL),
+  mDepthStencilInitialLayout(VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL), mDepthStencilFinalLayout(VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL),
   mColorClearEnabled(false), mDepthClearEnabled(false), mStencilClearEnabled(false),
   mColorWriteEnabled(true), mDepthWriteEnabled(true), mStencilWriteEnabled(false),
-  mStarted(false)
+  mColorLoadEnabled(true), mDepthLoadEnabled(true), mStencilLoadEnabled(true),
+  mColorStoreEnabled(true), mDepthStoreEnabled(true), mStencilStoreEnabled(true),
+  mStarted(false), mVkFramebuffer(VK_NULL_HANDLE)
 {
     FUN_ENTRY(GL_LOG_TRACE);
 
@@ -58,10 +63,8 @@ RenderPass::Release(void)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
-    if(mVkRenderPass != VK_NULL_HANDLE) {
-        vkDestroyRenderPass(mVkContext->vkDevice, mVkRenderPass, nullptr);
-        mVkRenderPass = VK_NULL_HANDLE;
-    }
+    /// the handle is owned by the device-wide render pass cache
+    mVkRenderPass = VK_NULL_HANDLE;
 }
 
 bool
@@ -71,116 +74,110 @@ RenderPass::Create(VkFormat colorFormat, VkFormat depthstencilFormat)
 
     Release();
 
-    VkAttachmentReference           color;
-    VkAttachmentReference           depthstencil;
-    vector<VkAttachmentDescription> attachments;
+    mColorFormat        = colorFormat;
+    mDepthStencilFormat = depthstencilFormat;
 
-    if(colorFormat != VK_FORMAT_UNDEFINED) {
+    renderPassKey_t key;
+    key.colorFormat        = colorFormat;
+    key.depthStencilFormat = depthstencilFormat;
 
-        /// Color attachment
-        VkAttachmentDescription attachmentColor;
-        attachmentColor.flags           = 0;
-        attachmentColor.format          = colorFormat;
-        attachmentColor.samples         = VK_SAMPLE_COUNT_1_BIT;
-        attachmentColor.loadOp          = (mColorClearEnabled && mColorWriteEnabled) ? VK_ATTACHMENT_LOAD_OP_CLEAR  : VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-        attachmentColor.storeOp         = mColorWriteEnabled ? VK_ATTACHMENT_STORE_OP_STORE : VK_ATTACHMENT_STORE_OP_DONT_CARE;
-        attachmentColor.stencilLoadOp   = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-        attachmentColor.stencilStoreOp  = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-        attachmentColor.initialLayout   = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-        attachmentColor.finalLayout     = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-
-        attachments.push_back(attachmentColor);
-
-        color.attachment           = attachments.size() - 1;
-        color.layout               = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    if(colorFormat != VK_FORMAT_UNDEFINED) {
+        key.colorLoadOp        = GetLoadOp(mColorClearEnabled && mColorWriteEnabled, mColorLoadEnabled);
+        key.colorStoreOp       = mColorStoreEnabled ? VK_ATTACHMENT_STORE_OP_STORE : VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        key.colorInitialLayout = mColorInitialLayout;
+        key.colorFinalLayout   = mColorFinalLayout;
     }
 
-    /// Depth/Stencil attachment
     if(depthstencilFormat != VK_FORMAT_UNDEFINED) {
 
         bool isDepth   = VkFormatIsDepth(depthstencilFormat);
         bool isStencil = VkFormatIsStencil(depthstencilFormat);
 
-        VkAttachmentDescription attachmentDepthStencil;
-        attachmentDepthStencil.flags          = 0;
-        attachmentDepthStencil.format         = depthstencilFormat;
-        attachmentDepthStencil.samples        = VK_SAMPLE_COUNT_1_BIT;
-        attachmentDepthStencil.loadOp         = (isDepth   && mDepthClearEnabled && mDepthWriteEnabled)     ? VK_ATTACHMENT_LOAD_OP_CLEAR  : VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-        attachmentDepthStencil.storeOp        = (isDepth   && mDepthWriteEnabled)                           ? VK_ATTACHMENT_STORE_OP_STORE : VK_ATTACHMENT_STORE_OP_DONT_CARE;
-        attachmentDepthStencil.stencilLoadOp  = (isStencil && mStencilClearEnabled && mStencilWriteEnabled) ? VK_ATTACHMENT_LOAD_OP_CLEAR  : VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-        attachmentDepthStencil.stencilStoreOp = (isStencil && mStencilWriteEnabled)                         ? VK_ATTACHMENT_STORE_OP_STORE : VK_ATTACHMENT_STORE_OP_DONT_CARE;
-        attachmentDepthStencil.initialLayout  = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
-        attachmentDepthStencil.finalLayout    = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
-
-        attachments.push_back(attachmentDepthStencil);
-
-        depthstencil.attachment   = attachments.size() - 1;
-        depthstencil.layout       = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+        key.depthLoadOp               = isDepth   ? GetLoadOp(mDepthClearEnabled && mDepthWriteEnabled, mDepthLoadEnabled)
+                                                  : VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+        key.depthStoreOp              = (isDepth   && mDepthStoreEnabled)   ? VK_ATTACHMENT_STORE_OP_STORE : VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        key.stencilLoadOp             = isStencil ? GetLoadOp(mStencilClearEnabled && mStencilWriteEnabled, mStencilLoadEnabled)
+                                                  : VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+        key.stencilStoreOp            = (isStencil && mStencilStoreEnabled) ? VK_ATTACHMENT_STORE_OP_STORE : VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        key.depthStencilInitialLayout = mDepthStencilInitialLayout;
+        key.depthStencilFinalLayout   = mDepthStencilFinalLayout;
     }
 
-    VkSubpassDescription subpass;
-    subpass.pipelineBindPoint       = mVkPipelineBindPoint;
-    subpass.flags                   = 0;
-    subpass.colorAttachmentCount    = colorFormat        != VK_FORMAT_UNDEFINED ? 1             : 0;
-    subpass.pColorAttachments       = colorFormat        != VK_FORMAT_UNDEFINED ? &color        : nullptr;
-    subpass.pDepthStencilAttachment = depthstencilFormat != VK_FORMAT_UNDEFINED ? &depthstencil : nullptr;
-    subpass.pResolveAttachments     = nullptr;
-    subpass.inputAttachmentCount    = 0;
-    subpass.pInputAttachments       = nullptr;
-    subpass.preserveAttachmentCount = 0;
-    subpass.pPreserveAttachments    = nullptr;
-
-    VkRenderPassCreateInfo info;
-    info.sType            = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
-    info.pNext            = nullptr;
-    info.flags            = 0;
-    info.attachmentCount  = static_cast<uint32_t>(attachments.size());
-    info.pAttachments     = attachments.data();
-    info.subpassCount     = 1;
-    info.pSubpasses       = &subpass;
-    info.dependencyCount  = 0;
-    info.pDependencies    = nullptr;
-
-    VkResult err = vkCreateRenderPass(mVkContext->vkDevice, &info, nullptr, &mVkRenderPass);
-    assert(!err);
-
-    return (err != VK_ERROR_OUT_OF_HOST_MEMORY && err != VK_ERROR_OUT_OF_DEVICE_MEMORY);
+    mVkRenderPass = mVkContext->vkRenderPassCache->GetRenderPass(&key);
+
+    return mVkRenderPass != VK_NULL_HANDLE;
 }
 
+void
+RenderPass::Begin(VkFramebuffer *framebuffer)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    /// vkCmdBeginRenderPass is only recorded in End(), once it is known which
+    /// attachments have to be stored (e.g., after a glDiscardFramebufferEXT)
+    mVkFramebuffer = *framebuffer;
+    mVkSecondaryCmdBuffers.clear();
+
+    mStarted = true;
+}
 
 void
-RenderPass::Begin(VkCommandBuffer *activeCmdBuffer, VkFramebuffer *framebuffer, bool hasSecondary)
+RenderPass::Execute(const VkCommandBuffer *secondaryCmdBuffer)
 {
     FUN_ENTRY(GL_LOG_DEBUG);
 
+    assert(mStarted);
+
+    mVkSecondaryCmdBuffers.push_back(*secondaryCmdBuffer);
+}
+
+bool
+RenderPass::End(VkCommandBuffer *activeCmdBuffer)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    if(!mStarted) {
+        return false;
+    }
+    mStarted = false;
+
+    /// pick the variant with the final store ops; it is compatible with the one
+    /// the secondary command buffers were recorded against
+    if(!Create(mColorFormat, mDepthStencilFormat)) {
+        mVkSecondaryCmdBuffers.clear();
+        return false;
+    }
+
     VkRenderPassBeginInfo info;
     info.sType                     = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
     info.pNext                     = nullptr;
-    info.framebuffer               = *framebuffer;
+    info.framebuffer               = mVkFramebuffer;
     info.renderPass                = mVkRenderPass;
     info.renderArea                = mVkRenderArea;
     info.clearValueCount           = 2;
     info.pClearValues              = mVkClearValues;
 
-    const VkSubpassContents subpassContents = hasSecondary ? VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS : VK_SUBPASS_CONTENTS_INLINE;
+    vkCmdBeginRenderPass(*activeCmdBuffer, &info, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+    if(!mVkSecondaryCmdBuffers.empty()) {
+        vkCmdExecuteCommands(*activeCmdBuffer, static_cast<uint32_t>(mVkSecondaryCmdBuffers.size()), mVkSecondaryCmdBuffers.data());
+    }
+    vkCmdEndRenderPass(*activeCmdBuffer);
 
-    vkCmdBeginRenderPass(*activeCmdBuffer, &info, subpassContents);
+    mVkSecondaryCmdBuffers.clear();
 
-    mStarted = true;
+    return true;
 }
 
-bool
-RenderPass::End(VkCommandBuffer *activeCmdBuffer)
+VkAttachmentLoadOp
+RenderPass::GetLoadOp(bool clearEnabled, bool loadEnabled) const
 {
-    FUN_ENTRY(GL_LOG_DEBUG);
+    FUN_ENTRY(GL_LOG_TRACE);
 
-    if (mStarted) {
-        mStarted = false;
-        vkCmdEndRenderPass(*activeCmdBuffer);
-        return true;
-    } else {
-        return false;
+    if(clearEnabled) {
+        return VK_ATTACHMENT_LOAD_OP_CLEAR;
     }
+
+    return loadEnabled ? VK_ATTACHMENT_LOAD_OP_LOAD : VK_ATTACHMENT_LOAD_OP_DONT_CARE;
 }
 
 void
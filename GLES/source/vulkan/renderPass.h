@@ -35,11 +35,16 @@ private:
     const
     vkContext_t *           mVkContext;
 
-    const
-    VkPipelineBindPoint     mVkPipelineBindPoint;
     VkRenderPass            mVkRenderPass;
     VkClearValue            mVkClearValues[2];
     VkRect2D                mVkRenderArea;
+    VkFormat                mColorFormat;
+    VkFormat                mDepthStencilFormat;
+
+    VkImageLayout           mColorInitialLayout;
+    VkImageLayout           mColorFinalLayout;
+    VkImageLayout           mDepthStencilInitialLayout;
+    VkImageLayout           mDepthStencilFinalLayout;
 
     VkBool32                mColorClearEnabled;
     VkBool32                mDepthClearEnabled;
@@ -49,7 +54,19 @@ private:
     VkBool32                mDepthWriteEnabled;
     VkBool32                mStencilWriteEnabled;
 
+    VkBool32                mColorLoadEnabled;
+    VkBool32                mDepthLoadEnabled;
+    VkBool32                mStencilLoadEnabled;
+
+    VkBool32                mColorStoreEnabled;
+    VkBool32                mDepthStoreEnabled;
+    VkBool32                mStencilStoreEnabled;
+
     VkBool32                mStarted;
+    VkFramebuffer           mVkFramebuffer;
+    vector<VkCommandBuffer> mVkSecondaryCmdBuffers;
+
+    VkAttachmentLoadOp      GetLoadOp(bool clearEnabled, bool loadEnabled) const;
 
 public:
 
@@ -60,8 +77,8 @@ public:
     ~RenderPass();
 
 // Begin/End functions
-    void                    Begin   (VkCommandBuffer *activeCmdBuffer, VkFramebuffer *framebuffer, bool hasSecondary);
-
+    void                    Begin   (VkFramebuffer *framebuffer);
+    void                    Execute (const VkCommandBuffer *secondaryCmdBuffer);
     bool                    End     (VkCommandBuffer *activeCmdBuffer);
 
 // Create functions
@@ -77,7 +94,17 @@ public:
     inline VkBool32         GetColorWriteEnabled(void)                    const { FUN_ENTRY(GL_LOG_TRACE); return mColorWriteEnabled;   }
     inline VkBool32         GetDepthWriteEnabled(void)                    const { FUN_ENTRY(GL_LOG_TRACE); return mDepthWriteEnabled;   }
     inline VkBool32         GetStencilWriteEnabled(void)                  const { FUN_ENTRY(GL_LOG_TRACE); return mStencilWriteEnabled; }
+    inline VkBool32         GetColorLoadEnabled(void)                     const { FUN_ENTRY(GL_LOG_TRACE); return mColorLoadEnabled;    }
+    inline VkBool32         GetDepthLoadEnabled(void)                     const { FUN_ENTRY(GL_LOG_TRACE); return mDepthLoadEnabled;    }
+    inline VkBool32         GetStencilLoadEnabled(void)                   const { FUN_ENTRY(GL_LOG_TRACE); return mStencilLoadEnabled;  }
+    inline VkFormat         GetColorFormat(void)                          const { FUN_ENTRY(GL_LOG_TRACE); return mColorFormat;         }
+    inline VkFormat         GetDepthStencilFormat(void)                   const { FUN_ENTRY(GL_LOG_TRACE); return mDepthStencilFormat;  }
+    inline VkImageLayout    GetColorInitialLayout(void)                   const { FUN_ENTRY(GL_LOG_TRACE); return mColorInitialLayout;        }
+    inline VkImageLayout    GetColorFinalLayout(void)                     const { FUN_ENTRY(GL_LOG_TRACE); return mColorFinalLayout;          }
+    inline VkImageLayout    GetDepthStencilInitialLayout(void)            const { FUN_ENTRY(GL_LOG_TRACE); return mDepthStencilInitialLayout; }
+    inline VkImageLayout    GetDepthStencilFinalLayout(void)              const { FUN_ENTRY(GL_LOG_TRACE); return mDepthStencilFinalLayout;   }
     inline VkRenderPass*    GetRenderPass(void)                                 { FUN_ENTRY(GL_LOG_TRACE); return &mVkRenderPass; }
+    inline VkBool32         IsStarted(void)                               const { FUN_ENTRY(GL_LOG_TRACE); return mStarted;             }
 
 // Set Functions
     inline void             SetVkContext(const vkContext_t *vkContext)          { FUN_ENTRY(GL_LOG_TRACE); mVkContext           = vkContext; }
@@ -87,6 +114,14 @@ public:
     inline void             SetColorWriteEnabled(VkBool32 enable)               { FUN_ENTRY(GL_LOG_TRACE); mColorWriteEnabled   = enable;    }
     inline void             SetDepthWriteEnabled(VkBool32 enable)               { FUN_ENTRY(GL_LOG_TRACE); mDepthWriteEnabled   = enable;    }
     inline void             SetStencilWriteEnabled(VkBool32 enable)             { FUN_ENTRY(GL_LOG_TRACE); mStencilWriteEnabled = enable;    }
+    inline void             SetColorLoadEnabled(VkBool32 enable)                { FUN_ENTRY(GL_LOG_TRACE); mColorLoadEnabled    = enable;    }
+    inline void             SetDepthLoadEnabled(VkBool32 enable)                { FUN_ENTRY(GL_LOG_TRACE); mDepthLoadEnabled    = enable;    }
+    inline void             SetStencilLoadEnabled(VkBool32 enable)              { FUN_ENTRY(GL_LOG_TRACE); mStencilLoadEnabled  = enable;    }
+    inline void             SetColorStoreEnabled(VkBool32 enable)               { FUN_ENTRY(GL_LOG_TRACE); mColorStoreEnabled   = enable;    }
+    inline void             SetDepthStoreEnabled(VkBool32 enable)               { FUN_ENTRY(GL_LOG_TRACE); mDepthStoreEnabled   = enable;    }
+    inline void             SetStencilStoreEnabled(VkBool32 enable)             { FUN_ENTRY(GL_LOG_TRACE); mStencilStoreEnabled = enable;    }
+    inline void             SetColorLayouts(VkImageLayout initialLayout, VkImageLayout finalLayout)        { FUN_ENTRY(GL_LOG_TRACE); mColorInitialLayout        = initialLayout; mColorFinalLayout        = finalLayout; }
+    inline void             SetDepthStencilLayouts(VkImageLayout initialLayout, VkImageLayout finalLayout) { FUN_ENTRY(GL_LOG_TRACE); mDepthStencilInitialLayout = initialLayout; mDepthStencilFinalLayout = finalLayout; }
 
            void             SetClearArea(const VkRect2D *rect);
            void             SetClearColorValue(const float *value);
@@ -0,0 +1,187 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+/**
+ *  @file       renderPassCache.cpp
+ *  @author     Think Silicon
+ *  @date       18/10/2026
+ *  @version    1.0
+ *
+ *  @brief      Device-wide cache of the render passes used by all framebuffers
+ *
+ *  @section
+ *
+ *  Framebuffers switch between clearing and loading their attachments, and
+ *  between write masks, from one render pass to the next. Each variant is a
+ *  distinct VkRenderPass, but the set of variants an application uses is
+ *  small, so they are created once and kept until the device is destroyed.
+ *  All variants with the same attachment formats are compatible, so
+ *  pipelines and VkFramebuffers built against any of them stay valid.
+ *
+ */
+
+#include "renderPassCache.h"
+
+namespace vulkanAPI {
+
+RenderPassCache::RenderPassCache(const vkContext_t *vkContext)
+: mVkContext(vkContext)
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+}
+
+RenderPassCache::~RenderPassCache()
+{
+    FUN_ENTRY(GL_LOG_TRACE);
+
+    Release();
+}
+
+void
+RenderPassCache::Release(void)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    for(auto &renderPass : mRenderPasses) {
+        vkDestroyRenderPass(mVkContext->vkDevice, renderPass.second, nullptr);
+    }
+    mRenderPasses.clear();
+}
+
+VkRenderPass
+RenderPassCache::GetRenderPass(const renderPassKey_t *key)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    auto it = mRenderPasses.find(*key);
+    if(it != mRenderPasses.end()) {
+        return it->second;
+    }
+
+    VkRenderPass renderPass = CreateRenderPass(key);
+    if(renderPass != VK_NULL_HANDLE) {
+        mRenderPasses[*key] = renderPass;
+    }
+
+    return renderPass;
+}
+
+VkRenderPass
+RenderPassCache::CreateRenderPass(const renderPassKey_t *key) const
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    VkAttachmentReference           color;
+    VkAttachmentReference           depthstencil;
+    vector<VkAttachmentDescription> attachments;
+
+    if(key->colorFormat != VK_FORMAT_UNDEFINED) {
+
+        /// Color attachment
+        VkAttachmentDescription attachmentColor;
+        attachmentColor.flags           = 0;
+        attachmentColor.format          = key->colorFormat;
+        attachmentColor.samples         = VK_SAMPLE_COUNT_1_BIT;
+        attachmentColor.loadOp          = key->colorLoadOp;
+        attachmentColor.storeOp         = key->colorStoreOp;
+        attachmentColor.stencilLoadOp   = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+        attachmentColor.stencilStoreOp  = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        attachmentColor.initialLayout   = key->colorInitialLayout;
+        attachmentColor.finalLayout     = key->colorFinalLayout;
+
+        attachments.push_back(attachmentColor);
+
+        color.attachment           = attachments.size() - 1;
+        color.layout               = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    }
+
+    /// Depth/Stencil attachment
+    if(key->depthStencilFormat != VK_FORMAT_UNDEFINED) {
+
+        VkAttachmentDescription attachmentDepthStencil;
+        attachmentDepthStencil.flags          = 0;
+        attachmentDepthStencil.format         = key->depthStencilFormat;
+        attachmentDepthStencil.samples        = VK_SAMPLE_COUNT_1_BIT;
+        attachmentDepthStencil.loadOp         = key->depthLoadOp;
+        attachmentDepthStencil.storeOp        = key->depthStoreOp;
+        attachmentDepthStencil.stencilLoadOp  = key->stencilLoadOp;
+        attachmentDepthStencil.stencilStoreOp = key->stencilStoreOp;
+        attachmentDepthStencil.initialLayout  = key->depthStencilInitialLayout;
+        attachmentDepthStencil.finalLayout    = key->depthStencilFinalLayout;
+
+        attachments.push_back(attachmentDepthStencil);
+
+        depthstencil.attachment   = attachments.size() - 1;
+        depthstencil.layout       = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+    }
+
+    VkSubpassDescription subpass;
+    subpass.pipelineBindPoint       = VK_PIPELINE_BIND_POINT_GRAPHICS;
+    subpass.flags                   = 0;
+    subpass.colorAttachmentCount    = key->colorFormat        != VK_FORMAT_UNDEFINED ? 1             : 0;
+    subpass.pColorAttachments       = key->colorFormat        != VK_FORMAT_UNDEFINED ? &color        : nullptr;
+    subpass.pDepthStencilAttachment = key->depthStencilFormat != VK_FORMAT_UNDEFINED ? &depthstencil : nullptr;
+    subpass.pResolveAttachments     = nullptr;
+    subpass.inputAttachmentCount    = 0;
+    subpass.pInputAttachments       = nullptr;
+    subpass.preserveAttachmentCount = 0;
+    subpass.pPreserveAttachments    = nullptr;
+
+    /// The attachment layout transitions happen implicitly at the start and the end of the render pass.
+    /// Order them after any earlier use of the images (transfers, sampling, previous render passes)
+    /// and make the results visible to whoever consumes the images afterwards.
+    VkSubpassDependency dependencies[2];
+    dependencies[0].srcSubpass      = VK_SUBPASS_EXTERNAL;
+    dependencies[0].dstSubpass      = 0;
+    dependencies[0].srcStageMask    = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT |
+                                      VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT         | VK_PIPELINE_STAGE_TRANSFER_BIT;
+    dependencies[0].dstStageMask    = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT |
+                                      VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+    dependencies[0].srcAccessMask   = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT |
+                                      VK_ACCESS_TRANSFER_WRITE_BIT;
+    dependencies[0].dstAccessMask   = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT  | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
+                                      VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+    dependencies[0].dependencyFlags = 0;
+
+    dependencies[1].srcSubpass      = 0;
+    dependencies[1].dstSubpass      = VK_SUBPASS_EXTERNAL;
+    dependencies[1].srcStageMask    = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+    dependencies[1].dstStageMask    = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT         | VK_PIPELINE_STAGE_TRANSFER_BIT |
+                                      VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+    dependencies[1].srcAccessMask   = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+    dependencies[1].dstAccessMask   = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_TRANSFER_READ_BIT;
+    dependencies[1].dependencyFlags = 0;
+
+    VkRenderPassCreateInfo info;
+    info.sType            = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+    info.pNext            = nullptr;
+    info.flags            = 0;
+    info.attachmentCount  = static_cast<uint32_t>(attachments.size());
+    info.pAttachments     = attachments.data();
+    info.subpassCount     = 1;
+    info.pSubpasses       = &subpass;
+    info.dependencyCount  = 2;
+    info.pDependencies    = dependencies;
+
+    VkRenderPass renderPass = VK_NULL_HANDLE;
+    VkResult err = vkCreateRenderPass(mVkContext->vkDevice, &info, nullptr, &renderPass);
+    assert(!err);
+
+    return (err == VK_SUCCESS) ? renderPass : VK_NULL_HANDLE;
+}
+
+}
@@ -0,0 +1,79 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+/**
+ *  @file       renderPassCache.h
+ *  @author     Think Silicon
+ *  @date       18/10/2026
+ *  @version    1.0
+ *
+ *  @brief      Device-wide cache of the render passes used by all framebuffers
+ *
+ */
+
+#ifndef __VKRENDERPASSCACHE_H__
+#define __VKRENDERPASSCACHE_H__
+
+#include <mutex>
+#include <string.h>
+#include "context.h"
+
+namespace vulkanAPI {
+
+typedef struct renderPassKey_t {
+    VkFormat                          colorFormat;
+    VkFormat                          depthStencilFormat;
+    VkAttachmentLoadOp                colorLoadOp;
+    VkAttachmentStoreOp               colorStoreOp;
+    VkAttachmentLoadOp                depthLoadOp;
+    VkAttachmentStoreOp               depthStoreOp;
+    VkAttachmentLoadOp                stencilLoadOp;
+    VkAttachmentStoreOp               stencilStoreOp;
+    VkImageLayout                     colorInitialLayout;
+    VkImageLayout                     colorFinalLayout;
+    VkImageLayout                     depthStencilInitialLayout;
+    VkImageLayout                     depthStencilFinalLayout;
+
+    renderPassKey_t()                                                           { memset(static_cast<void *>(this), 0, sizeof(renderPassKey_t)); }
+    inline bool operator <  (const renderPassKey_t &other)                const { return memcmp(this, &other, sizeof(renderPassKey_t)) <  0; }
+} renderPassKey_t;
+
+class RenderPassCache {
+
+private:
+
+    const
+    vkContext_t *                     mVkContext;
+
+    std::mutex                        mMutex;
+    std::map<renderPassKey_t, VkRenderPass> mRenderPasses;
+
+    VkRenderPass                      CreateRenderPass(const renderPassKey_t *key)                      const;
+
+public:
+// Constructor
+    RenderPassCache(const vkContext_t *vkContext = nullptr);
+
+// Destructor
+    ~RenderPassCache();
+
+// Release Functions
+    void                              Release(void);
+
+// Get Functions
+    VkRenderPass                      GetRenderPass(const renderPassKey_t *key);
+};
+
+}
+
+#endif // __VKRENDERPASSCACHE_H__
@@ -28,6 +28,7 @@
  */
 
 #include "sampler.h"
+#include "utils/cacheManager.h"
 
 namespace vulkanAPI {
 
@@ -69,6 +70,19 @@ Sampler::Release(void)
     mUpdated = true;
 }
 
+void
+Sampler::Release(CacheManager *cacheManager)
+{
+    FUN_ENTRY(GL_LOG_DEBUG);
+
+    if(mVkSampler != VK_NULL_HANDLE) {
+        cacheManager->CacheVkSampler(mVkSampler);
+        mVkSampler = VK_NULL_HANDLE;
+    }
+
+    Release();
+}
+
 bool
 Sampler::Create()
 {
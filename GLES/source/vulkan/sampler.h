@@ -26,6 +26,8 @@
 
 #include "context.h"
 
+class CacheManager;
+
 namespace vulkanAPI {
 
 class Sampler {
@@ -65,6 +67,7 @@ public:
 
 // Release Functions
     void                              Release(void);
+    void                              Release(CacheManager *cacheManager);
 
 // Get Functions
     inline VkSampler                  GetSampler(void)                  const   { FUN_ENTRY(GL_LOG_TRACE); return mVkSampler; }
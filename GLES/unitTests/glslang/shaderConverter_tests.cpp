@@ -0,0 +1,130 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+#include "shaderConverter_tests.h"
+#include <sstream>
+#include <algorithm>
+
+namespace Testing {
+
+static const char * const vertexShader =
+    "#version 100\n"
+    "\n"
+    "// uniform vec4 commented;\n"
+    "uniform mediump mat4 mvp, normalMatrix[2];\n"
+    "uniform sampler2D\tdiffuse;\n"
+    "attribute vec4 position;\n"
+    "varying vec2 texCoord;\n"
+    "\n"
+    "#ifndef GL_ES\n"
+    "#endif\n"
+    "#if defined(GL_ES) && GL_ES\n"
+    "#endif\n"
+    "\n"
+    "void main()\n"
+    "{\n"
+    "    int line = __LINE__;\n"
+    "    gl_Position = mvp * position;\n"
+    "}\n";
+
+// Code here will be called immediately after the constructor (right
+// before each test).
+void ShaderConverterTest::SetUp(void) {
+    return;
+}
+
+// Code here will be called immediately after each test (right
+// before the destructor).
+void ShaderConverterTest::TearDown() {
+    return;
+}
+
+string ShaderConverterTest::Convert(const string &source, shader_type_t shaderType)
+{
+    ShaderConverter converter;
+    converter.Initialize(shaderType, ESSL_VERSION_100, ESSL_VERSION_400);
+    converter.SetIoMapResolver(&IoMapResolver);
+
+    string converted(source);
+    converter.Convert(converted, UniformBlockMap, &Reflection, false);
+    return converted;
+}
+
+TEST_F(ShaderConverterTest, ConvertVertexShader)
+{
+    const string converted = Convert(vertexShader, SHADER_TYPE_VERTEX);
+
+    ASSERT_EQ(0u, converted.find("#version 400\n"));
+    ASSERT_EQ(string::npos, converted.find("#version 100"));
+    ASSERT_EQ(string::npos, converted.find('\t'));
+
+    /// Inactive uniforms are moved to their own blocks, one per declarator
+    ASSERT_NE(string::npos, converted.find("// uniform vec4 commented;\n"));
+    ASSERT_NE(string::npos, converted.find("layout(std140, binding = 0) uniform uni0 {mediump mat4 mvp;}; "));
+    ASSERT_NE(string::npos, converted.find("layout(std140, binding = 1) uniform uni1 {mediump mat4 normalMatrix[2];};\n"));
+    ASSERT_NE(string::npos, converted.find("layout(binding = 2) uniform sampler2D diffuse;\n"));
+
+    /// Checks on GL_ES being defined are kept
+    ASSERT_NE(string::npos, converted.find("#ifndef GL_ES\n"));
+    ASSERT_NE(string::npos, converted.find("#if defined(GL_ES) && 1\n"));
+
+    ASSERT_NE(string::npos, converted.find("int line = __LINE__ - 29;"));
+    ASSERT_NE(string::npos, converted.find("gl_Position.z = (gl_Position.z + gl_Position.w) / 2.0;\n}"));
+}
+
+TEST_F(ShaderConverterTest, UniformKeepsLineNumbers)
+{
+    const string source = "#version 100\n"
+                          "uniform\n"
+                          "    mediump vec4 color,\n"
+                          "                 offset;\n"
+                          "void main()\n"
+                          "{\n"
+                          "    gl_FragColor = color + offset;\n"
+                          "}\n";
+
+    const string converted = Convert(source, SHADER_TYPE_FRAGMENT);
+
+    /// Each declarator stays on the line it was declared on
+    ASSERT_NE(string::npos, converted.find("\nlayout(std140, binding = 0) uniform uni0 {mediump vec4 color;};\n"));
+    ASSERT_NE(string::npos, converted.find("\nlayout(std140, binding = 1) uniform uni1 {mediump vec4 offset;};\nvoid main()"));
+    /// __LINE__ expects the 29 lines of the header before the source
+    ASSERT_EQ(std::count(source.begin(), source.begin() + source.find("void main()"), '\n') + 29,
+              std::count(converted.begin(), converted.begin() + converted.find("void main()"), '\n'));
+}
+
+TEST_F(ShaderConverterTest, LargeShader)
+{
+    /// Uber-shader of a few thousand lines, similar to the ones shipped by game engines
+    std::ostringstream uberShader;
+    uberShader << "#version 100\nprecision mediump float;\n";
+    for(int i = 0; i < 256; ++i) {
+        uberShader << "uniform vec4 color" << i << ", offset" << i << ";\n"
+                   << "varying vec4 var" << i << ";\n"
+                   << "#ifdef FEATURE_" << i << "\n"
+                   << "// feature " << i << " uses __LINE__ and GL_ES\n"
+                   << "vec4 feature" << i << "(vec4 c)\n"
+                   << "{\n"
+                   << "\treturn c * color" << i << " + offset" << i << " + float(GL_ES);\n"
+                   << "}\n"
+                   << "#endif\n";
+    }
+    uberShader << "void main()\n{\n    gl_FragColor = vec4(1.0);\n}\n";
+
+    const string converted = Convert(uberShader.str(), SHADER_TYPE_FRAGMENT);
+
+    ASSERT_NE(string::npos, converted.find("uniform uni511 {vec4 offset255;};"));
+    ASSERT_EQ(string::npos, converted.find("varying"));
+}
+
+} //end of namespace
@@ -0,0 +1,37 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+#ifndef __SHADER_CONVERTER_TESTS_H__
+#define __SHADER_CONVERTER_TESTS_H__
+
+#include "gtest/gtest.h"
+#include "glslang/shaderConverter.h"
+#include "resources/shaderReflection.h"
+
+namespace Testing {
+
+class ShaderConverterTest : public ::testing::Test {
+protected:
+    void SetUp(void);
+    void TearDown(void);
+
+    string Convert(const string &source, shader_type_t shaderType);
+
+    GlslangIoMapResolver        IoMapResolver;
+    ShaderReflection            Reflection;
+    uniformBlockMap_t           UniformBlockMap;
+};
+
+} //end of namespace
+
+#endif // __SHADER_CONVERTER_TESTS_H__
@@ -0,0 +1,116 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+#include "context_tests.h"
+#include <cstring>
+
+namespace Testing {
+
+// Code here will be called immediately after the constructor (right
+// before each test).
+void PhysicalDeviceTest::SetUp(void) {
+    Properties.clear();
+    CanRender.clear();
+}
+
+// Code here will be called immediately after each test (right
+// before the destructor).
+void PhysicalDeviceTest::TearDown() {
+    return;
+}
+
+void PhysicalDeviceTest::AddDevice(const char *name, VkPhysicalDeviceType type, bool canRender)
+{
+    VkPhysicalDeviceProperties properties;
+    memset(static_cast<void *>(&properties), 0, sizeof(properties));
+    strncpy(properties.deviceName, name, VK_MAX_PHYSICAL_DEVICE_NAME_SIZE - 1);
+    properties.deviceType = type;
+    Properties.push_back(properties);
+    CanRender.push_back(canRender);
+}
+
+TEST_F(PhysicalDeviceTest, NoDevice)
+{
+    ASSERT_EQ(-1, vulkanAPI::SelectPhysicalDevice(Properties, CanRender, nullptr));
+}
+
+TEST_F(PhysicalDeviceTest, DiscreteBeforeCpu)
+{
+    AddDevice("llvmpipe (LLVM 15.0.7, 256 bits)", VK_PHYSICAL_DEVICE_TYPE_CPU);
+    AddDevice("Intel(R) UHD Graphics 630", VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU);
+    AddDevice("NVIDIA GeForce RTX 3060", VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU);
+
+    ASSERT_EQ(2, vulkanAPI::SelectPhysicalDevice(Properties, CanRender, nullptr));
+}
+
+TEST_F(PhysicalDeviceTest, VirtualBeforeCpu)
+{
+    AddDevice("llvmpipe (LLVM 15.0.7, 256 bits)", VK_PHYSICAL_DEVICE_TYPE_CPU);
+    AddDevice("Virtio-GPU Venus", VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU);
+
+    ASSERT_EQ(1, vulkanAPI::SelectPhysicalDevice(Properties, CanRender, nullptr));
+}
+
+TEST_F(PhysicalDeviceTest, EqualTypesKeepOrder)
+{
+    AddDevice("llvmpipe (LLVM 15.0.7, 256 bits)", VK_PHYSICAL_DEVICE_TYPE_CPU);
+    AddDevice("llvmpipe (LLVM 15.0.7, 128 bits)", VK_PHYSICAL_DEVICE_TYPE_CPU);
+
+    ASSERT_EQ(0, vulkanAPI::SelectPhysicalDevice(Properties, CanRender, nullptr));
+}
+
+TEST_F(PhysicalDeviceTest, OverrideByIndex)
+{
+    AddDevice("NVIDIA GeForce RTX 3060", VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU);
+    AddDevice("llvmpipe (LLVM 15.0.7, 256 bits)", VK_PHYSICAL_DEVICE_TYPE_CPU);
+
+    ASSERT_EQ(1, vulkanAPI::SelectPhysicalDevice(Properties, CanRender, "1"));
+}
+
+TEST_F(PhysicalDeviceTest, OverrideByName)
+{
+    AddDevice("NVIDIA GeForce RTX 3060", VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU);
+    AddDevice("llvmpipe (LLVM 15.0.7, 256 bits)", VK_PHYSICAL_DEVICE_TYPE_CPU);
+
+    ASSERT_EQ(1, vulkanAPI::SelectPhysicalDevice(Properties, CanRender, "llvmpipe"));
+}
+
+TEST_F(PhysicalDeviceTest, InvalidOverrideFallsBack)
+{
+    AddDevice("llvmpipe (LLVM 15.0.7, 256 bits)", VK_PHYSICAL_DEVICE_TYPE_CPU);
+    AddDevice("NVIDIA GeForce RTX 3060", VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU);
+
+    ASSERT_EQ(1, vulkanAPI::SelectPhysicalDevice(Properties, CanRender, "7"));
+    ASSERT_EQ(1, vulkanAPI::SelectPhysicalDevice(Properties, CanRender, "lavapipe"));
+}
+
+TEST_F(PhysicalDeviceTest, OverrideByEnumerationIndex)
+{
+    AddDevice("Compute Accelerator", VK_PHYSICAL_DEVICE_TYPE_OTHER, false);
+    AddDevice("NVIDIA GeForce RTX 3060", VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU);
+    AddDevice("llvmpipe (LLVM 15.0.7, 256 bits)", VK_PHYSICAL_DEVICE_TYPE_CPU);
+
+    ASSERT_EQ(2, vulkanAPI::SelectPhysicalDevice(Properties, CanRender, "2"));
+}
+
+TEST_F(PhysicalDeviceTest, DevicesThatCannotRenderAreSkipped)
+{
+    AddDevice("Compute Accelerator", VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU, false);
+    AddDevice("llvmpipe (LLVM 15.0.7, 256 bits)", VK_PHYSICAL_DEVICE_TYPE_CPU);
+
+    ASSERT_EQ(1, vulkanAPI::SelectPhysicalDevice(Properties, CanRender, nullptr));
+    ASSERT_EQ(1, vulkanAPI::SelectPhysicalDevice(Properties, CanRender, "0"));
+    ASSERT_EQ(1, vulkanAPI::SelectPhysicalDevice(Properties, CanRender, "Compute"));
+}
+
+} //end of namespace
@@ -0,0 +1,35 @@
+/**
+ * Copyright (C) 2015-2018 Think Silicon S.A. (https://think-silicon.com/)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public v3
+ * License as published by the Free Software Foundation;
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ */
+
+#ifndef __CONTEXT_TESTS_H__
+#define __CONTEXT_TESTS_H__
+
+#include "gtest/gtest.h"
+#include "vulkan/context.h"
+
+namespace Testing {
+
+class PhysicalDeviceTest : public ::testing::Test {
+protected:
+    void SetUp(void);
+    void TearDown(void);
+
+    void AddDevice(const char *name, VkPhysicalDeviceType type, bool canRender = true);
+
+    std::vector<VkPhysicalDeviceProperties> Properties;
+    std::vector<bool>                       CanRender;
+};
+
+} //end of namespace
+
+#endif // __CONTEXT_TESTS_H__
@@ -69,6 +69,7 @@ LOCAL_SRC_FILES :=  $(SRC_PATH)/GLES/source/api/gl.cpp \
                     $(SRC_PATH)/GLES/source/resources/shaderProgram.cpp \
                     $(SRC_PATH)/GLES/source/resources/shaderReflection.cpp \
                     $(SRC_PATH)/GLES/source/resources/shaderResourceInterface.cpp \
+                    $(SRC_PATH)/GLES/source/resources/shareGroup.cpp \
                     $(SRC_PATH)/GLES/source/resources/texture.cpp \
                     $(SRC_PATH)/GLES/source/resources/rect.cpp \
                     $(SRC_PATH)/GLES/source/resources/sampler.cpp \
@@ -87,10 +88,12 @@ LOCAL_SRC_FILES :=  $(SRC_PATH)/GLES/source/api/gl.cpp \
                     $(SRC_PATH)/GLES/source/utils/glLogger.cpp \
                     $(SRC_PATH)/GLES/source/utils/glUtils.cpp \
                     $(SRC_PATH)/GLES/source/utils/cacheManager.cpp \
+                    $(SRC_PATH)/GLES/source/utils/workerPool.cpp \
                     $(SRC_PATH)/GLES/source/vulkan/cbManager.cpp \
                     $(SRC_PATH)/GLES/source/vulkan/clearPass.cpp \
                     $(SRC_PATH)/GLES/source/vulkan/commandBufferPool.cpp \
                     $(SRC_PATH)/GLES/source/vulkan/renderPass.cpp \
+                    $(SRC_PATH)/GLES/source/vulkan/renderPassCache.cpp \
                     $(SRC_PATH)/GLES/source/vulkan/buffer.cpp \
                     $(SRC_PATH)/GLES/source/vulkan/memory.cpp \
                     $(SRC_PATH)/GLES/source/vulkan/sampler.cpp \
@@ -98,6 +101,8 @@ LOCAL_SRC_FILES :=  $(SRC_PATH)/GLES/source/api/gl.cpp \
                     $(SRC_PATH)/GLES/source/vulkan/imageView.cpp \
                     $(SRC_PATH)/GLES/source/vulkan/pipeline.cpp \
                     $(SRC_PATH)/GLES/source/vulkan/pipelineCache.cpp \
+                    $(SRC_PATH)/GLES/source/vulkan/pipelineStateLog.cpp \
+                    $(SRC_PATH)/GLES/source/vulkan/pipelineWarmup.cpp \
                     $(SRC_PATH)/GLES/source/vulkan/framebuffer.cpp \
                     $(SRC_PATH)/GLES/source/vulkan/context.cpp \
                     $(SRC_PATH)/GLES/source/vulkan/utils.cpp \
@@ -152,6 +157,7 @@ LOCAL_SRC_FILES := $(SRC_PATH)/EGL/source/api/eglContext.cpp \
                    $(SRC_PATH)/EGL/source/thread/renderingThread.cpp \
                    $(SRC_PATH)/EGL/source/platform/platformFactory.cpp \
                    $(SRC_PATH)/EGL/source/platform/vulkan/WSIPlaneDisplay.cpp \
+                   $(SRC_PATH)/EGL/source/platform/vulkan/WSIHeadless.cpp \
                    $(SRC_PATH)/EGL/source/platform/vulkan/WSIAndroid.cpp \
                    $(SRC_PATH)/EGL/source/platform/vulkan/vulkanWindowInterface.cpp \
                    $(SRC_PATH)/EGL/source/platform/vulkan/vulkanWSI.cpp \